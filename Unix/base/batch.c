@@ -9,6 +9,7 @@
 
 #include <assert.h>
 #include "batch.h"
+#include "serverstats.h"
 #include <pal/strings.h>
 #include <pal/intsafe.h>
 
@@ -61,6 +62,7 @@ void* Batch_Get(
 
         /* Update number of pages */
         self->numPages++;
+        Batch_CountPage(page, 1);
 
         /* Return pointer to memory */
         return ptr;
@@ -86,6 +88,7 @@ void* Batch_Get(
 
         page->u.s.next = self->pages;
         self->pages = page;
+        Batch_CountPage(page, 1);
 
         /* Return pointer to memory */
         return page + 1;
@@ -103,6 +106,8 @@ void Batch_Destroy(
     {
         Page* next = p->u.s.next;
 
+        Batch_CountPage(p, -1);
+
         /* If memory object contains this batch, delete it last */
         if ((char*)self>=(char*)(p + 1) && (char*)self<(char*)p + p->u.s.size)
             selfPtr = p;
@@ -194,6 +199,7 @@ void Batch_Put(
             else
                 self->pages = p->u.s.next;
 
+            Batch_CountPage(p, -1);
             PAL_Free(p);
             return;
         }
@@ -347,6 +353,24 @@ size_t Batch_GetPageInfo(
     return res;
 }
 
+MI_Boolean Batch_Contains(
+    Batch* self,
+    const void* ptr)
+{
+    const char* p = (const char*)ptr;
+    Page* page;
+
+    for (page = self->pages; page; page = page->u.s.next)
+    {
+        const char* start = (const char*)(page + 1);
+
+        if (p >= start && p < start + page->u.s.size)
+            return MI_TRUE;
+    }
+
+    return MI_FALSE;
+}
+
 void* Batch_GetPageByIndex(
     Batch* self,
     size_t index)
@@ -440,6 +464,7 @@ MI_Boolean Batch_CreateBatchByPageInfo(
         /* Link new page onto list */
         page->u.s.next = (*self)->pages;
         (*self)->pages = page;
+        Batch_CountPage(page, 1);
     }
 
     return MI_TRUE;
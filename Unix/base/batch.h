@@ -13,6 +13,7 @@
 #include "config.h"
 #include <string.h>
 #include <common.h>
+#include "serverstats.h"
 
 BEGIN_EXTERNC
 
@@ -194,6 +195,11 @@ size_t Batch_GetPageInfo(
     Batch* self,
     Header_BatchInfoItem* buffer);
 
+/* Returns true if 'ptr' points into one of the pages of the batch */
+MI_Boolean Batch_Contains(
+    Batch* self,
+    const void* ptr);
+
 MI_Boolean Batch_CreateBatchByPageInfo(
     Batch** self,
     const Header_BatchInfoItem* buffer,
@@ -205,6 +211,16 @@ MI_Boolean Batch_FixPointer(
     size_t ptrAdjustmentInfoCount,
     void** ptrInOut);
 
+/* Counts the page (delta 1) or its release (delta -1) in ServerStats */
+MI_INLINE void Batch_CountPage(
+    Page* page,
+    int delta)
+{
+    ServerStats_AddGauge(SERVERSTATS_GAUGE_BATCHPAGES, delta);
+    ServerStats_AddGauge(SERVERSTATS_GAUGE_BATCHBYTES,
+        delta * (ptrdiff_t)(sizeof(Page) + page->u.s.size));
+}
+
 /* Add this block to list of individual blocks */
 MI_INLINE void Batch_AttachPage(
     Batch* self,
@@ -213,6 +229,7 @@ MI_INLINE void Batch_AttachPage(
     page->u.s.next = self->pages;
     self->pages = page;
     page->u.s.independent = 0;
+    Batch_CountPage(page, 1);
 }
 
 END_EXTERNC
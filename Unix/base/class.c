@@ -14,6 +14,7 @@
 #include "naming.h"
 #include <base/instance.h>
 #include <base/field.h>
+#include <base/propertyindex.h>
 #include <pal/atomic.h>
 
 MI_PropertyDecl * Class_Clone_Property(
@@ -35,7 +36,7 @@ typedef struct _MI_ClassInternal
     /* Reserved properties */
     Batch *batch;
     ptrdiff_t refcount;
-    ptrdiff_t reserved3;
+    volatile ptrdiff_t propertyIndex; /* PropertyIndex*, see Class_GetPropertyIndex() */
     ptrdiff_t reserved4;
 
 } MI_ClassInternal;
@@ -3346,6 +3347,11 @@ MI_Result MI_CALL Class_Delete(
                     Class_Delete(rcParent->owningClass);
                 }
             }
+            if (internalSelf->propertyIndex)
+            {
+                PropertyIndex_Delete((PropertyIndex*)internalSelf->propertyIndex);
+            }
+
             /* Now release ourself */
             Batch_Delete((Batch *)internalSelf->batch);
         }
@@ -3356,6 +3362,55 @@ MI_Result MI_CALL Class_Delete(
 
 
 
+/* Property indexes are kept in the owning MI_Class since the MI_ClassDecl
+ * structure has no room for them. They are built lazily and published with a
+ * compare-and-swap so that concurrent readers may race to build one.
+ */
+const PropertyIndex* Class_GetPropertyIndex(
+    _In_ const MI_ClassDecl *classDecl)
+{
+    MI_ClassInternal *owner;
+    PropertyIndex *index;
+
+    /* Method declarations double as parameter class declarations and do not
+     * have an owningClass field */
+    if (!(classDecl->flags & (MI_FLAG_CLASS|MI_FLAG_ASSOCIATION|MI_FLAG_INDICATION)) ||
+        !classDecl->owningClass || classDecl->owningClass == (MI_Class*)-1 ||
+        classDecl->numProperties < PROPERTYINDEX_MIN_PROPERTIES)
+    {
+        return NULL;
+    }
+
+    owner = (MI_ClassInternal*)classDecl->owningClass;
+    if (owner->classDecl != classDecl)
+        return NULL;
+
+    index = (PropertyIndex*)Atomic_Read(&owner->propertyIndex);
+    if (!index)
+    {
+        PropertyIndex *newIndex = PropertyIndex_New(classDecl, 0, NULL);
+        if (!newIndex)
+        {
+            /* Not fatal (lookups fall back to the linear scan) */
+            NitsIgnoringError();
+            return NULL;
+        }
+
+        index = (PropertyIndex*)Atomic_CompareAndSwap(
+            &owner->propertyIndex, 0, (ptrdiff_t)newIndex);
+        if (index)
+            PropertyIndex_Delete(newIndex);
+        else
+            index = newIndex;
+    }
+
+    /* Properties were added after the index was built */
+    if (index->numProperties != classDecl->numProperties)
+        return NULL;
+
+    return index;
+}
+
 /*============================================================================
  * Traditional clone where we just copy everything
  *============================================================================
@@ -418,6 +418,12 @@ MI_EXTERN_C   MI_ClassDecl* Class_Clone_ClassDecl(
         _Inout_ Batch *batch,
         _In_ const MI_ClassDecl *classDecl);
 
+/* Returns the property index shared by all users of a class declaration that
+ * is owned by an MI_Class (built on first use), or NULL if there is none.
+ */
+MI_EXTERN_C   const struct _PropertyIndex* Class_GetPropertyIndex(
+        _In_ const MI_ClassDecl *classDecl);
+
 BEGIN_EXTERNC
 
 extern const MI_ClassExtendedFTInternal g_ClassExtendedFTInternal;
@@ -10,6 +10,8 @@
 #include <assert.h>
 #include "classdecl.h"
 #include "naming.h"
+#include "class.h"
+#include "propertyindex.h"
 #include <pal/strings.h>
 
 static MI_Uint32 _Find(
@@ -58,11 +60,21 @@ MI_PropertyDecl* ClassDecl_FindPropertyDecl(
     const ZChar* name)
 {
     MI_Uint32 i;
+    const OMI_ClassDeclExtension* ext;
+    const PropertyIndex* index;
 
     if (!self || !name)
         return NULL;
 
-    i = _Find((MI_FeatureDecl**)self->properties, self->numProperties, name);
+    ext = PropertyIndex_GetExtension(self);
+    index = ext ? NULL : Class_GetPropertyIndex(self);
+
+    if (ext)
+        i = PropertyIndex_FindExtension(ext, self, name);
+    else if (index)
+        i = PropertyIndex_Find(index, self, name);
+    else
+        i = _Find((MI_FeatureDecl**)self->properties, self->numProperties, name);
 
     return i == (MI_Uint32)-1 ? NULL : self->properties[i];
 }
@@ -15,6 +15,12 @@
 
 BEGIN_EXTERNC
 
+/* Receives a class declaration (or NULL) that stays valid only until the
+ * callback returns */
+typedef void (*ClassDeclProc)(
+    void* data,
+    const MI_ClassDecl* classDecl);
+
 MI_MethodDecl* ClassDecl_FindMethodDecl(
     const MI_ClassDecl* self,
     const ZChar* name);
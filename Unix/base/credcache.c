@@ -10,6 +10,7 @@
 #include "credcache.h"
 #include "log.h"
 #include <pal/sleep.h>
+#include <pal/once.h>
 
 #if defined (CONFIG_POSIX)
 # include <openssl/evp.h>
@@ -27,7 +28,7 @@
 /* since pre-defined structures are used, user name is limited in size */
 #define CRED_USER_NAME_MAX_LEN  32
 /* Max hash length (sha512) */
-#define CRED_HASH_MAX_LEN       64
+#define CRED_HASH_MAX_LEN       CREDCACHE_HASH_SIZE
 /* Salt size */
 #define CRED_SALT_SIZE          16
 /* Max entries in cache (number of simultaneously identified users) */
@@ -47,6 +48,7 @@ static int s_init;
 static int s_initAttempted;
 static const EVP_MD* s_md;
 static MI_Uint64    s_expirationTime_us = CRED_CACHE_TIME_TO_KEEP_USEC;
+static Once         s_once = ONCE_INITIALIZER;
 
 static int _Init()
 {
@@ -87,6 +89,20 @@ static int _Init()
     return 0;
 }
 
+/* Initializes once when called from client threads */
+_Success_(return == 0) static int _InitOnce(
+    _In_ void* data,
+    _Outptr_result_maybenull_ void** value)
+{
+    MI_UNUSED(data);
+    *value = NULL;
+
+    if (s_init)
+        return 0;
+
+    return _Init();
+}
+
 /* Calculates hash:
     uses 3 parts:
     - user name
@@ -234,13 +250,52 @@ int CredCache_CheckUser(const char* user, const char* password)
 
     assert(pos < MI_COUNT(s_cache));
 
-    if (0 != memcmp(hash, s_cache[pos].hash, sizeof(hash)))
+    if (0 != CredCache_CompareHash(hash, s_cache[pos].hash))
         return -1;
 
     /* Credentials are valid */
     return 0;
 }
 
+/*
+    Calculates the salted hash of user credentials
+    Returns:
+    '0' on success
+    '-1' if no digest is available
+*/
+int CredCache_HashUser(
+    const char* user,
+    const char* password,
+    unsigned char hash[CREDCACHE_HASH_SIZE])
+{
+    if (0 != Once_Invoke(&s_once, _InitOnce, NULL) || !s_init)
+        return -1;
+
+    /* The user name terminator keeps ("ab","c") apart from ("a","bc") */
+    memset(hash, 0, CREDCACHE_HASH_SIZE);
+    _Hash(user, strlen(user) + 1, password, strlen(password), hash);
+    return 0;
+}
+
+/*
+    Compares two hashes in constant time (so the time taken does not tell
+    how many bytes match)
+    Returns:
+    '0' if hashes match; '-1' otherwise
+*/
+int CredCache_CompareHash(
+    const unsigned char hash1[CREDCACHE_HASH_SIZE],
+    const unsigned char hash2[CREDCACHE_HASH_SIZE])
+{
+    unsigned char diff = 0;
+    size_t i;
+
+    for (i = 0; i < CREDCACHE_HASH_SIZE; i++)
+        diff |= hash1[i] ^ hash2[i];
+
+    return diff ? -1 : 0;
+}
+
 /* Unit-test support - updating expiration timeout */
 void CredCache_SetExpirationTimeout(MI_Uint64 expirationTimeUS)
 {
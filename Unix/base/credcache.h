@@ -31,6 +31,30 @@ void CredCache_PutUser(const char* user, const char* password);
 */
 int CredCache_CheckUser(const char* user, const char* password);
 
+/* Size of the hash calculated by CredCache_HashUser */
+#define CREDCACHE_HASH_SIZE     64
+
+/*
+    Calculates the salted hash of user credentials (unique per process
+    run), so that callers can match credentials without keeping the password
+    Returns:
+    '0' on success
+    '-1' if no digest is available
+*/
+int CredCache_HashUser(
+    const char* user,
+    const char* password,
+    unsigned char hash[CREDCACHE_HASH_SIZE]);
+
+/*
+    Compares two hashes in constant time
+    Returns:
+    '0' if hashes match; '-1' otherwise
+*/
+int CredCache_CompareHash(
+    const unsigned char hash1[CREDCACHE_HASH_SIZE],
+    const unsigned char hash2[CREDCACHE_HASH_SIZE]);
+
 /* Unit-test support - updating expiration timeout */
 void CredCache_SetExpirationTimeout(MI_Uint64 expirationTimeUS);
 /* Unit-test support mostly - clear all cached items */
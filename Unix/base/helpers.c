@@ -8,7 +8,9 @@
 */
 
 #include <ctype.h>
+#include <limits.h>
 #include "helpers.h"
+#include "numconv.h"
 #include "types.h"
 #include <pal/strings.h>
 #include "alloc.h"
@@ -22,6 +24,14 @@
 static const ZChar* _ParseNumber(const ZChar* p, unsigned long* n)
 {
     ZChar* end;
+    MI_Uint64 x;
+    const ZChar* q = NumConv_ZStrToUint64(p, &x);
+
+    if (q && x <= ULONG_MAX)
+    {
+        *n = (unsigned long)x;
+        return q;
+    }
 
     *n = Tcstoul(p, &end, 10);
 
@@ -39,6 +49,25 @@ static const ZChar* _ParseDecimalPart(
     int i;
     ZChar buf[7];
 
+    if (*p >= '0' && *p <= '9')
+    {
+        /* The first 6 digits, padded with zeros */
+        *n = 0;
+
+        for (i = 0; i < 6; i++)
+        {
+            *n *= 10;
+
+            if (*p >= '0' && *p <= '9')
+                *n += (unsigned long)(*p++ - '0');
+        }
+
+        while (*p >= '0' && *p <= '9')
+            p++;
+
+        return p;
+    }
+
     Tcstoul(p, &end, 10);
 
     if (end == p)
@@ -463,108 +492,7 @@ int ParseWSManDatetime(const ZChar* str, MI_Datetime* x)
 _Use_decl_annotations_
 void FormatWSManDatetime(const MI_Datetime* x, ZChar buffer[64])
 {
-    int n = 64;
-
-    *buffer = '\0';
-
-    if (x->isTimestamp)
-    {
-        /* Example output: "2010-12-31T12:30:03.123456+06:00" */
-        ZChar tmpbuf[64];
-
-        /* As per section 8.2 in DSP0230_1.1.0 date (year, month, day) containing all zero's is considered valida date.
-            Time containing all zeros is also considred as valid time.
-
-            MI_Datetime cannot store asterics ('*') as part of date or time.
-            So with MI_Datetime we will never get into case of not having time or date */
-        Stprintf(tmpbuf, MI_COUNT(tmpbuf), ZT("%04u-%02u-%02u"),
-            x->u.timestamp.year,
-            x->u.timestamp.month,
-            x->u.timestamp.day);
-        Tcslcat(buffer, tmpbuf, n);
-
-        Tcslcat(buffer, ZT("T"), n);
-
-        Stprintf(tmpbuf, MI_COUNT(tmpbuf), ZT("%02u:%02u:%02u"),
-            x->u.timestamp.hour,
-            x->u.timestamp.minute,
-            x->u.timestamp.second);
-        Tcslcat(buffer, tmpbuf, n);
-
-        if (x->u.timestamp.microseconds)
-        {
-            Stprintf(tmpbuf, MI_COUNT(tmpbuf), ZT(".%06u"),
-                x->u.timestamp.microseconds);
-            Tcslcat(buffer, tmpbuf, n);
-        }
-
-        if (x->u.timestamp.utc > 0)
-        {
-            Stprintf(tmpbuf, MI_COUNT(tmpbuf), ZT("+%02u:%02u"),
-                x->u.timestamp.utc / 60, x->u.timestamp.utc % 60);
-            Tcslcat(buffer, tmpbuf, n);
-        }
-        else if (x->u.timestamp.utc < 0)
-        {
-            Stprintf(tmpbuf, MI_COUNT(tmpbuf), ZT("-%02u:%02u"),
-                -x->u.timestamp.utc / 60, -x->u.timestamp.utc % 60);
-            Tcslcat(buffer, tmpbuf, n);
-        }
-        else
-        {
-            Tcslcat(buffer, ZT("Z"), n);
-        }
-    }
-    else
-    {
-        ZChar tmpbuf[64];
-
-        /* Example: "P1Y1M22DT10H11M12S" */
-
-        Tcslcat(buffer, ZT("P"), n);
-
-        if (x->u.interval.days)
-        {
-            Stprintf(tmpbuf, MI_COUNT(tmpbuf), ZT("%uD"), x->u.interval.days);
-            Tcslcat(buffer, tmpbuf, n);
-        }
-
-        if (x->u.interval.hours || x->u.interval.minutes ||
-            x->u.interval.seconds || x->u.interval.microseconds)
-        {
-            Tcslcat(buffer, ZT("T"), n);
-        }
-
-        if (x->u.interval.hours)
-        {
-            Stprintf(tmpbuf, MI_COUNT(tmpbuf), ZT("%uH"), x->u.interval.hours);
-            Tcslcat(buffer, tmpbuf, n);
-        }
-
-        if (x->u.interval.minutes)
-        {
-            Stprintf(tmpbuf, MI_COUNT(tmpbuf), ZT("%uM"), x->u.interval.minutes);
-            Tcslcat(buffer, tmpbuf, n);
-        }
-
-        if (x->u.interval.seconds && x->u.interval.microseconds)
-        {
-            Stprintf(tmpbuf, MI_COUNT(tmpbuf), ZT("%u.%06uS"),
-                x->u.interval.seconds, x->u.interval.microseconds);
-            Tcslcat(buffer, tmpbuf, n);
-        }
-        else if (x->u.interval.seconds && !x->u.interval.microseconds)
-        {
-            Stprintf(tmpbuf, MI_COUNT(tmpbuf), ZT("%uS"), x->u.interval.seconds);
-            Tcslcat(buffer, tmpbuf, n);
-        }
-        else if (!x->u.interval.seconds && x->u.interval.microseconds)
-        {
-            Stprintf(tmpbuf, MI_COUNT(tmpbuf), ZT("0.%06uS"),
-                x->u.interval.microseconds);
-            Tcslcat(buffer, tmpbuf, n);
-        }
-    }
+    NumConv_WSManDatetimeToZStr(buffer, x);
 }
 
 int StrToChar16(const ZChar* str, MI_Char16* x)
@@ -623,6 +551,10 @@ static int _StrDatetime_CheckAsterisk_ToU32(const ZChar* s, size_t offset, size_
 
 int StrToDatetime(const ZChar* s, MI_Datetime* x)
 {
+    /* All digits */
+    if (NumConv_ZStrToDatetime(s, x) == 0)
+        return 0;
+
     if (Tcslen(s) != 25)
         return -1;
 
@@ -698,9 +630,59 @@ int StrToBoolean(const ZChar* str, MI_Boolean* x)
     return 0;
 }
 
+/* Decimal strings within [0, max] take the fast path; the others
+ * (hexadecimal or octal, spaces, out of range values, ...) are left to
+ * strtoul() */
+static int _StrToUnsignedFast(const ZChar* str, MI_Uint64 max, MI_Uint64* x)
+{
+    const ZChar* end;
+
+    /* Octal or hexadecimal in base 0 */
+    if (str[0] == '0' && str[1] != '\0')
+        return -1;
+
+    end = NumConv_ZStrToUint64(str, x);
+
+    if (!end || *end != '\0' || *x > max)
+        return -1;
+
+    return 0;
+}
+
+static int _StrToSignedFast(
+    const ZChar* str,
+    MI_Sint64 min,
+    MI_Sint64 max,
+    MI_Sint64* x)
+{
+    const ZChar* p = str;
+    const ZChar* end;
+
+    if (*p == '-' || *p == '+')
+        p++;
+
+    if (p[0] == '0' && p[1] != '\0')
+        return -1;
+
+    end = NumConv_ZStrToSint64(str, x);
+
+    if (!end || *end != '\0' || *x < min || *x > max)
+        return -1;
+
+    return 0;
+}
+
 int StrToUint8(const ZChar* str, MI_Uint8* x)
 {
     ZChar* end;
+    MI_Uint64 value;
+
+    if (_StrToUnsignedFast(str, 0xFF, &value) == 0)
+    {
+        *x = (MI_Uint8)value;
+        return 0;
+    }
+
     *x = (MI_Uint8)Tcstoul(str, &end, 0);
 
     if (*end != '\0')
@@ -712,6 +694,14 @@ int StrToUint8(const ZChar* str, MI_Uint8* x)
 int StrToSint8(const ZChar* str, MI_Sint8* x)
 {
     ZChar* end;
+    MI_Sint64 value;
+
+    if (_StrToSignedFast(str, -128, 127, &value) == 0)
+    {
+        *x = (MI_Sint8)value;
+        return 0;
+    }
+
     *x = (MI_Sint8)Tcstol(str, &end, 0);
 
     if (*end != '\0')
@@ -723,6 +713,14 @@ int StrToSint8(const ZChar* str, MI_Sint8* x)
 int StrToUint16(const ZChar* str, MI_Uint16* x)
 {
     ZChar* end;
+    MI_Uint64 value;
+
+    if (_StrToUnsignedFast(str, 0xFFFF, &value) == 0)
+    {
+        *x = (MI_Uint16)value;
+        return 0;
+    }
+
     *x = (MI_Uint16)Tcstoul(str, &end, 0);
 
     if (*end != '\0')
@@ -734,6 +732,14 @@ int StrToUint16(const ZChar* str, MI_Uint16* x)
 int StrToSint16(const ZChar* str, MI_Sint16* x)
 {
     ZChar* end;
+    MI_Sint64 value;
+
+    if (_StrToSignedFast(str, -32768, 32767, &value) == 0)
+    {
+        *x = (MI_Sint16)value;
+        return 0;
+    }
+
     *x = (MI_Sint16)Tcstol(str, &end, 0);
 
     if (*end != '\0')
@@ -745,6 +751,14 @@ int StrToSint16(const ZChar* str, MI_Sint16* x)
 int StrToUint32(const ZChar* str, MI_Uint32* x)
 {
     ZChar* end;
+    MI_Uint64 value;
+
+    if (_StrToUnsignedFast(str, 0xFFFFFFFF, &value) == 0)
+    {
+        *x = (MI_Uint32)value;
+        return 0;
+    }
+
     *x = (MI_Uint32)Tcstoul(str, &end, 0);
 
     if (*end != '\0')
@@ -756,6 +770,14 @@ int StrToUint32(const ZChar* str, MI_Uint32* x)
 int StrToSint32(const ZChar* str, MI_Sint32* x)
 {
     ZChar* end;
+    MI_Sint64 value;
+
+    if (_StrToSignedFast(str, PAL_SINT32_MIN, PAL_SINT32_MAX, &value) == 0)
+    {
+        *x = (MI_Sint32)value;
+        return 0;
+    }
+
     *x = (MI_Sint32)Tcstol(str, &end, 0);
 
     if (*end != '\0')
@@ -767,6 +789,14 @@ int StrToSint32(const ZChar* str, MI_Sint32* x)
 int StrToUint64(const ZChar* str, MI_Uint64* x)
 {
     ZChar* end;
+    MI_Uint64 value;
+
+    if (_StrToUnsignedFast(str, PAL_UINT64_MAX, &value) == 0)
+    {
+        *x = (MI_Uint64)value;
+        return 0;
+    }
+
     *x = (MI_Uint64)Tcstoull(str, &end, 0);
 
     if (*end != '\0')
@@ -778,6 +808,14 @@ int StrToUint64(const ZChar* str, MI_Uint64* x)
 int StrToSint64(const ZChar* str, MI_Sint64* x)
 {
     ZChar* end;
+    MI_Sint64 value;
+
+    if (_StrToSignedFast(str, PAL_SINT64_MIN, PAL_SINT64_MAX, &value) == 0)
+    {
+        *x = (MI_Sint64)value;
+        return 0;
+    }
+
     *x = (MI_Sint64)Tcstoll(str, &end, 0);
 
     if (*end != '\0')
@@ -789,6 +827,15 @@ int StrToSint64(const ZChar* str, MI_Sint64* x)
 int StrToReal32(const ZChar* str, MI_Real32* x)
 {
     ZChar* end;
+    MI_Real64 value;
+    const ZChar* p = NumConv_ZStrToReal64(str, &value);
+
+    if (p && *p == '\0')
+    {
+        *x = (MI_Real32)value;
+        return 0;
+    }
+
     *x = (MI_Real32)Tcstod(str, &end);
 
     if (*end != '\0')
@@ -800,6 +847,15 @@ int StrToReal32(const ZChar* str, MI_Real32* x)
 int StrToReal64(const ZChar* str, MI_Real64* x)
 {
     ZChar* end;
+    MI_Real64 value;
+    const ZChar* p = NumConv_ZStrToReal64(str, &value);
+
+    if (p && *p == '\0')
+    {
+        *x = (MI_Real64)value;
+        return 0;
+    }
+
     *x = (MI_Real64)Tcstod(str, &end);
 
     if (*end != '\0')
@@ -898,10 +954,12 @@ MI_Result MI_CALL Instance_SetElementFromString(
     }
 
 
+    /* A value that does not parse as the property type is an invalid
+     * parameter (as it is for array items) */
     result = StringToMiValue(str, type, &value);
     if (result != MI_RESULT_OK)
     {
-        MI_RETURN(result);
+        MI_RETURN(MI_RESULT_INVALID_PARAMETER);
     }
 
     MI_RETURN(MI_Instance_SetElement(self, name, &value, type, 0));
@@ -1210,31 +1268,7 @@ MI_Result MI_CALL Instance_GetValue(
 _Use_decl_annotations_
 void DatetimeToStr(const MI_Datetime* x, ZChar buf[26])
 {
-    if (x->isTimestamp)
-    {
-        const ZChar FMT[] =  MI_T("%04d%02d%02d%02d%02d%02d.%06d%c%03d");
-        MI_Sint32 utc = x->u.timestamp.utc;
-        Stprintf(buf, 26, FMT,
-            x->u.timestamp.year,
-            x->u.timestamp.month,
-            x->u.timestamp.day,
-            x->u.timestamp.hour,
-            x->u.timestamp.minute,
-            x->u.timestamp.second,
-            x->u.timestamp.microseconds,
-            utc < 0 ? '-' : '+',
-            utc < 0 ? -utc : utc);
-    }
-    else
-    {
-        const ZChar FMT[] = MI_T("%08u%02u%02u%02u.%06u:000");
-        Stprintf(buf, 26, FMT,
-            x->u.interval.days,
-            x->u.interval.hours,
-            x->u.interval.minutes,
-            x->u.interval.seconds,
-            x->u.interval.microseconds);
-    }
+    NumConv_DatetimeToZStr(buf, x);
 }
 
 int DatetimeToUsec(
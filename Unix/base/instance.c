@@ -16,6 +16,7 @@
 #include "alloc.h"
 #include "field.h"
 #include "class.h"
+#include "propertyindex.h"
 #include <pal/intsafe.h>
 #include <stdio.h>
 #ifdef _MSC_VER
@@ -111,17 +112,6 @@ MI_Uint32 _FindFeatureDecl(
     return (MI_Uint32)-1;
 }
 
-/* Return the index of the given property */
-MI_INLINE MI_Uint32 _FindPropertyDeclIndex(
-    const MI_ClassDecl* cd,
-    const MI_Char* name)
-{
-    return _FindFeatureDecl(
-        (MI_FeatureDecl**)cd->properties,
-        cd->numProperties,
-        name);
-}
-
 /* Return the index of the given property or (MI_Uin32)-1 if not found */
 static MI_Uint32 _FindPropertyDecl(
     const MI_ClassDecl* cd,
@@ -131,6 +121,21 @@ static MI_Uint32 _FindPropertyDecl(
     MI_PropertyDecl** end = start + cd->numProperties;
     MI_PropertyDecl** p = start;
     MI_Uint32 code;
+    const OMI_ClassDeclExtension* ext;
+
+    /* Use the perfect hash emitted by the generator if there is one */
+    ext = PropertyIndex_GetExtension(cd);
+    if (ext)
+        return PropertyIndex_FindExtension(ext, cd, name);
+
+    /* Use the index of the owning MI_Class if there is one */
+    if (cd->numProperties >= PROPERTYINDEX_MIN_PROPERTIES)
+    {
+        const PropertyIndex* index = Class_GetPropertyIndex(cd);
+
+        if (index)
+            return PropertyIndex_Find(index, cd, name);
+    }
 
     code = Hash(name);
 
@@ -144,6 +149,19 @@ static MI_Uint32 _FindPropertyDecl(
     return (MI_Uint32)-1;
 }
 
+/* Like _FindPropertyDecl() but also consults the index kept by dynamic
+ * instances, whose class declaration belongs to the instance itself */
+static MI_Uint32 _FindInstancePropertyDecl(
+    const Instance* self,
+    const ZChar* name)
+{
+    const PropertyIndex* index = self->index;
+
+    if (index && index->numProperties == self->classDecl->numProperties)
+        return PropertyIndex_Find(index, self->classDecl, name);
+
+    return _FindPropertyDecl(self->classDecl, name);
+}
 
 static MI_PropertyDecl* _LookupPropertyDecl(
     const MI_ClassDecl* cd,
@@ -678,7 +696,7 @@ MI_Result MI_CALL Instance_InitConvert(
             {
                 MI_Uint32 index;
 
-                index = _FindPropertyDecl(cd2, pd1->name);
+                index = _FindInstancePropertyDecl(inst, pd1->name);
                 if (index == (MI_Uint32)-1)
                 {
                     if (pd1->value)
@@ -1057,6 +1075,16 @@ MI_Result MI_CALL Instance_Clone(
 
         if (!inst->classDecl)
             MI_RETURN(MI_RESULT_FAILED);
+
+        /* The new classDecl is private to this instance, so index it here */
+        if (self->index)
+        {
+            inst->index = PropertyIndex_New(inst->classDecl, 0, batch);
+
+            /* Not fatal (lookups fall back to the linear scan) */
+            if (!inst->index)
+                NitsIgnoringError();
+        }
     }
     else if (self->classDecl->owningClass)  //has a proper MI_Class owner so can clone it to bump refcount
     {
@@ -1336,7 +1364,7 @@ MI_Boolean Instance_MatchKeys(
 
             if (pd1->flags & MI_FLAG_KEY)
             {
-                index = _FindPropertyDecl(cd2, pd1->name);
+                index = _FindInstancePropertyDecl(inst, pd1->name);
 
                 if (index == (MI_Uint32)-1)
                 {
@@ -1643,7 +1671,7 @@ MI_Result MI_CALL __MI_Instance_AddElement(
         MI_RETURN(MI_RESULT_INVALID_PARAMETER);
 
     /* Find the property with this name */
-    index = _FindPropertyDecl(self->classDecl, name);
+    index = _FindInstancePropertyDecl(self, name);
 
     if (index != (MI_Uint32)-1)
         MI_RETURN(MI_RESULT_ALREADY_EXISTS);
@@ -1723,6 +1751,26 @@ MI_Result MI_CALL __MI_Instance_AddElement(
 
         /* Adjust size */
         cd->size += sizeof(Field);
+
+        /* Keep the property index up to date (wide instances only) */
+        if (!self->index ||
+            self->index->numProperties + 1 != cd->numProperties ||
+            !PropertyIndex_Add(self->index, pd->name))
+        {
+            if (self->index)
+                BFree(self->batch, self->index, CALLSITE);
+
+            self->index = NULL;
+
+            /* Failure to build the index is not fatal (see _FindPropertyDecl) */
+            if (cd->numProperties >= PROPERTYINDEX_MIN_PROPERTIES)
+            {
+                self->index = PropertyIndex_New(cd, 2 * cd->numProperties, self->batch);
+
+                if (!self->index)
+                    NitsIgnoringError();
+            }
+        }
     }
 
     /* Reassign 'self' field (it may have changed) */
@@ -1751,7 +1799,7 @@ MI_Result MI_CALL __MI_Instance_SetElement(
         MI_RETURN(MI_RESULT_INVALID_PARAMETER);
 
     /* Find the property with this name */
-    index = _FindPropertyDecl(self->classDecl, name);
+    index = _FindInstancePropertyDecl(self, name);
 
     if (index == (MI_Uint32)-1)
         MI_RETURN(MI_RESULT_NO_SUCH_PROPERTY);
@@ -1821,7 +1869,7 @@ MI_Result MI_CALL __MI_Instance_GetElement(
         MI_RETURN(MI_RESULT_INVALID_PARAMETER);
 
     /* Find the property with this name */
-    index = _FindPropertyDecl(self->classDecl, name);
+    index = _FindInstancePropertyDecl(self, name);
 
     if (index == (MI_Uint32)-1)
         MI_RETURN(MI_RESULT_NO_SUCH_PROPERTY);
@@ -1981,7 +2029,7 @@ MI_Result MI_CALL __MI_Instance_ClearElement(
         MI_RETURN(MI_RESULT_INVALID_PARAMETER);
 
     /* Find the property with this name */
-    index = _FindPropertyDecl(self->classDecl, name);
+    index = _FindInstancePropertyDecl(self, name);
 
     if (index == (MI_Uint32)-1)
         MI_RETURN(MI_RESULT_NO_SUCH_PROPERTY);
@@ -2113,7 +2161,7 @@ MI_Result Instance_SetElementArray(
         MI_RETURN(MI_RESULT_INVALID_PARAMETER);
 
     /* Find the property with this name */
-    index = _FindPropertyDeclIndex(self->classDecl, name);
+    index = _FindInstancePropertyDecl(self, name);
 
     if (index == (MI_Uint32)-1)
         MI_RETURN(MI_RESULT_NO_SUCH_PROPERTY);
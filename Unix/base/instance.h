@@ -61,6 +61,9 @@ typedef struct _Instance /* extends MI_Instance */
 
     /* If true, instances releases batch upon destruction */
     MI_Boolean releaseBatch;
+
+    /* Property name index of a dynamic instance (see propertyindex.h) */
+    struct _PropertyIndex* index;
 }
 Instance;
 
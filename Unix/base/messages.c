@@ -54,6 +54,7 @@ static const MessageField baseMessageFields[] =
     {MFT_POINTER_SET_NULL,offsetof(Message, prev),0,0},
     {MFT_POINTER_SET_NULL,offsetof(Message, dtor),0,0},
     {MFT_POINTER_SET_NULL,offsetof(Message, dtorData),0,0},
+    {MFT_POINTER_SET_NULL,offsetof(Message, payload),0,0},
     {MFT_END_OF_LIST, 0, 0, 0}
 };
 
@@ -357,7 +358,15 @@ void __Message_Release(
             (*self->dtor)(self, self->dtorData);
         }
 
-        Batch_Destroy(self->batch);
+        /* (the batch of this message may point to the payload's one) */
+        if (self->payload)
+        {
+            Message* payload = self->payload;
+            Batch_Destroy(self->batch);
+            Message_Release(payload);
+        }
+        else
+            Batch_Destroy(self->batch);
     }
     else
     {
@@ -384,6 +393,7 @@ static MI_Boolean _UnpackInstance(
     Batch* batch,
     void* ptr,
     MI_Uint32 size,
+    InstanceSchemaDict* instanceSchemas,
     MI_Instance** instanceOut)
 {
     MI_Result r;
@@ -393,7 +403,8 @@ static MI_Boolean _UnpackInstance(
     buf.data = ptr;
     buf.size = size;
 
-    r = Instance_Unpack(instanceOut, &buf, batch, MI_FALSE);
+    r = Instance_UnpackWithSchemas(
+        instanceOut, &buf, batch, MI_FALSE, instanceSchemas);
     return r == MI_RESULT_OK;
 }
 
@@ -402,6 +413,7 @@ static MI_Result _RestoreMessage(
     const Header_BatchInfoItem* ptrAdjustmentInfo,
     size_t ptrAdjustmentInfoCount,
     MI_Boolean skipInstanceUnpack,
+    InstanceSchemaDict* instanceSchemas,
     const MessageField* messageFields)
 {
     char* chunk = (char*)msg;
@@ -462,6 +474,7 @@ static MI_Result _RestoreMessage(
                         batch,
                         *ptrPacked,
                         packedSize,
+                        instanceSchemas,
                         (MI_Instance**)ptr))
                     {
                         trace_RestoreMsgFailed_UnpackingInstance();
@@ -487,10 +500,24 @@ static MI_Result _RestoreMessage(
     return MI_RESULT_OK;
 }
 
+/* What cloning a message for the binary protocol copied or shared */
+typedef struct _CloneStats
+{
+    MI_Uint64 copied;
+    MI_Uint64 shared;
+    MI_Boolean referenced;
+}
+CloneStats;
+
+/* Clones the fields of the message; the strings and packed instances found
+ * in 'shared' (the batch of the source message, if it can be sent along)
+ * are referenced rather than copied */
 static MI_Result _CloneMessageFields(
     _In_        const Message*      msgSrc,
     _Inout_     Message*            msg,
-    _In_        const MessageField* messageFields )
+    _In_        const MessageField* messageFields,
+    _In_opt_    Batch*              shared,
+    _Inout_     CloneStats*         stats )
 {
     char* chunk = (char*)msg;
     Batch* batch = msg->batch;
@@ -514,10 +541,22 @@ static MI_Result _CloneMessageFields(
             {
                 if (*ptrSrc)
                 {
+                    size_t size = (Tcslen((const ZChar*)*ptrSrc) + 1) * sizeof(ZChar);
+
+                    if (shared && Batch_Contains(shared, *ptrSrc))
+                    {
+                        *ptr = *ptrSrc;
+                        stats->shared += size;
+                        stats->referenced = MI_TRUE;
+                        break;
+                    }
+
                     *ptr = Batch_Tcsdup(batch, (const ZChar*)*ptrSrc);
 
                     if (!*ptr)
                         return MI_RESULT_FAILED;
+
+                    stats->copied += size;
                 }
                 else if (messageFields->type == MFT_POINTER)
                     return MI_RESULT_INVALID_PARAMETER;
@@ -542,7 +581,17 @@ static MI_Result _CloneMessageFields(
 
                 *ptr = 0;
 
-                if (ptrPackedSrc)
+                if (ptrPackedSrc && shared && Batch_Contains(shared, ptrPackedSrc))
+                {
+                    /* Existing packed instance (received from binary
+                     * protocol) sent along with the source message
+                     */
+                    *packedSize = packedSizeSrc;
+                    *ptrPacked = (void*)ptrPackedSrc;
+                    stats->shared += packedSizeSrc;
+                    stats->referenced = MI_TRUE;
+                }
+                else if (ptrPackedSrc)
                 {
                     /* Take existing packed instance if exist (received from
                      * binary protocol
@@ -554,6 +603,7 @@ static MI_Result _CloneMessageFields(
                         return MI_RESULT_FAILED;
 
                     memcpy(*ptrPacked, ptrPackedSrc, packedSizeSrc);
+                    stats->copied += packedSizeSrc;
                 }
                 else if (*ptrSrc)
                 {
@@ -565,6 +615,8 @@ static MI_Result _CloneMessageFields(
                         batch,
                         ptrPacked, packedSize))
                         return MI_RESULT_FAILED;
+
+                    stats->copied += *packedSize;
                 }
                 else if (messageFields->type == MFT_INSTANCE)
                     /* Return error if non-optional parameter is missing */
@@ -583,7 +635,9 @@ static MI_Result _CloneMessageFields(
 static MI_Result _CloneMessage(
     _In_        const Message*      msgSrc,
     _Inout_     Message*            msg,
-                MI_Uint32           messageTag )
+                MI_Uint32           messageTag,
+    _In_opt_    Batch*              shared,
+    _Inout_     CloneStats*         stats )
 {
     char* chunk = (char*)msg;
     const char* chunkSrc = (const char*)msgSrc;
@@ -598,14 +652,15 @@ static MI_Result _CloneMessage(
 
     /* copy all primitive data first */
     memcpy(chunk + sizeof(Message), chunkSrc + sizeof(Message), allMessages[messageIndex].size - sizeof(Message));
+    stats->copied += allMessages[messageIndex].size - sizeof(Message);
 
     if( MessageTag_IsRequest( messageTag ) )
     {
-        result = _CloneMessageFields(msgSrc, msg, requestMessageFields);
+        result = _CloneMessageFields(msgSrc, msg, requestMessageFields, shared, stats);
     }
     if( MI_RESULT_OK == result )
     {
-        result = _CloneMessageFields(msgSrc, msg, allMessages[messageIndex].fields);
+        result = _CloneMessageFields(msgSrc, msg, allMessages[messageIndex].fields, shared, stats);
     }
 
     return result;
@@ -617,6 +672,7 @@ MI_Result __MessageFromBatch(
     const Header_BatchInfoItem* ptrAdjustmentInfo,
     size_t ptrAdjustmentInfoCount,
     MI_Boolean skipInstanceUnpack,
+    InstanceSchemaDict* instanceSchemas,
     Message** msgOut,
     CallSite cs)
 {
@@ -642,6 +698,7 @@ MI_Result __MessageFromBatch(
         ptrAdjustmentInfo,
         ptrAdjustmentInfoCount,
         skipInstanceUnpack,
+        instanceSchemas,
         baseMessageFields))
     {
         trace_RestoreMsgFailed_FirstTime();
@@ -665,6 +722,7 @@ MI_Result __MessageFromBatch(
             ptrAdjustmentInfo,
             ptrAdjustmentInfoCount,
             skipInstanceUnpack,
+            instanceSchemas,
             requestMessageFields))
         {
             trace_RestoreMsgFailed_SecondTime(msg->tag);
@@ -677,6 +735,7 @@ MI_Result __MessageFromBatch(
         ptrAdjustmentInfo,
         ptrAdjustmentInfoCount,
         skipInstanceUnpack,
+        instanceSchemas,
         allMessages[index].fields))
     {
         trace_RestoreMsgFailed_ThirdTime(msg->tag);
@@ -700,6 +759,47 @@ MI_Result __MessageFromBatch(
     return MI_RESULT_OK;
 }
 
+static const ZChar* _InstanceClassName(
+    _In_opt_ const MI_Instance* instance)
+{
+    if (!instance || !instance->classDecl)
+        return NULL;
+
+    return instance->classDecl->name;
+}
+
+const ZChar* RequestMsg_GetClassName(
+    const RequestMsg* msg)
+{
+    switch (msg->base.tag)
+    {
+        case GetInstanceReqTag:
+            return _InstanceClassName(((GetInstanceReq*)msg)->instanceName);
+        case GetClassReqTag:
+            return ((GetClassReq*)msg)->className;
+        case CreateInstanceReqTag:
+            return _InstanceClassName(((CreateInstanceReq*)msg)->instance);
+        case ModifyInstanceReqTag:
+            return _InstanceClassName(((ModifyInstanceReq*)msg)->instance);
+        case DeleteInstanceReqTag:
+            return _InstanceClassName(((DeleteInstanceReq*)msg)->instanceName);
+        case InvokeReqTag:
+        {
+            InvokeReq* req = (InvokeReq*)msg;
+            return req->className ? req->className : _InstanceClassName(req->instance);
+        }
+        case AssociatorsOfReqTag:
+        case ReferencesOfReqTag:
+            return _InstanceClassName(((AssociationsOfReq*)msg)->instance);
+        case EnumerateInstancesReqTag:
+            return ((EnumerateInstancesReq*)msg)->className;
+        case SubscribeReqTag:
+            return ((SubscribeReq*)msg)->className;
+        default:
+            return NULL;
+    }
+}
+
 MI_Result MessagePackCloneForBinarySending(
     Message* msgSrc,
     Message** msgOut)
@@ -707,12 +807,16 @@ MI_Result MessagePackCloneForBinarySending(
     Message* msg = msgSrc;
     MI_Uint32 index;
     MI_Result result;
+    Batch* shared = NULL;
+    CloneStats stats;
 
     index = MessageTagIndex( msg->tag );
 
     if (index >= MI_COUNT(allMessages))
         return MI_RESULT_INVALID_PARAMETER;
 
+    ServerStats_AddCounter(SERVERSTATS_COUNTER_WIREMESSAGES, 1);
+
     if (!allMessages[index].cloneRequired)
     {
         *msgOut = msg;
@@ -720,6 +824,13 @@ MI_Result MessagePackCloneForBinarySending(
         return MI_RESULT_OK;
     }
 
+    /* Source messages with too many pages are copied rather than sent
+     * along (the protocol sends a limited number of pages) */
+    if (Batch_GetPageCount(msgSrc->batch) <= MESSAGE_MAX_PAYLOAD_PAGES)
+        shared = msgSrc->batch;
+
+    memset(&stats, 0, sizeof(stats));
+
     /* create a copy */
     msg = __Message_New((MessageTag)msgSrc->tag, allMessages[index].size, msgSrc->operationId, msgSrc->flags, CALLSITE);
 
@@ -729,7 +840,15 @@ MI_Result MessagePackCloneForBinarySending(
         return MI_RESULT_FAILED;
     }
 
-    result = _CloneMessage( msgSrc, msg, msg->tag );
+    result = _CloneMessage( msgSrc, msg, msg->tag, shared, &stats );
+
+    /* Keep the source message as long as the clone points to its batch */
+    if (stats.referenced)
+    {
+        Message_AddRef(msgSrc);
+        msg->payload = msgSrc;
+    }
+
     if( MI_RESULT_OK != result )
     {
         trace_MessagePackCloneForBinarySending_CloneFailed(msg->tag, result);
@@ -737,10 +856,37 @@ MI_Result MessagePackCloneForBinarySending(
         return result;
     }
 
+    ServerStats_AddCounter(SERVERSTATS_COUNTER_WIRECOPIES, 1);
+    ServerStats_AddCounter(SERVERSTATS_COUNTER_WIREBYTESCOPIED, stats.copied);
+    ServerStats_AddCounter(SERVERSTATS_COUNTER_WIREBYTESSHARED, stats.shared);
+
     *msgOut = msg;
     return MI_RESULT_OK;
 }
 
+size_t Message_GetPageCount(
+    Message* msg)
+{
+    size_t count = Batch_GetPageCount(msg->batch);
+
+    if (msg->payload)
+        count += Batch_GetPageCount(msg->payload->batch);
+
+    return count;
+}
+
+size_t Message_GetPageInfo(
+    Message* msg,
+    Header_BatchInfoItem* buffer)
+{
+    size_t count = Batch_GetPageInfo(msg->batch, buffer);
+
+    if (msg->payload)
+        count += Batch_GetPageInfo(msg->payload->batch, buffer + count);
+
+    return count;
+}
+
 /*
 **==============================================================================
 **
@@ -15,9 +15,11 @@
 #include <stdio.h>
 #include "batch.h"
 #include "instance.h"
+#include "packing.h"
 #include "stringarray.h"
 #include <pal/atomic.h>
 #include "user.h"
+#include "serverstats.h"
 #include <pal/thread.h>
 
 BEGIN_EXTERNC
@@ -118,7 +120,11 @@ typedef enum _MessageFlag
     WSMAN_MethodInParameter =           0x8000,
 
     WSMAN_IsShellRequest =              0x10000,
-    WSMAN_IsShellResponse =             0x20000
+    WSMAN_IsShellResponse =             0x20000,
+
+    /* Binary-specific encoding options (the client understands instances
+     * packed by Instance_PackCompact) */
+    BinaryCompactInstancesFlag =        0x40000
 }
 MessageFlag;
 
@@ -190,6 +196,11 @@ struct _Message
 
     /* Data passed as 2nd argument of 'dtor' */
     void* dtorData;
+
+    /* [opt] Message whose batch pages are sent along with this message's
+     * ones by the binary protocol (see MessagePackCloneForBinarySending);
+     * released with this message */
+    struct _Message* payload;
 };
 
 Message* __Message_New(
@@ -287,9 +298,16 @@ typedef struct _RequestMsg
     MI_Instance*    options;
     void*           packedOptionsPtr;
     MI_Uint32       packedOptionsSize;
+
+    /* Stages reached by the request (see ServerStats_EndTrace()) */
+    ServerStatsTrace trace;
 }
 RequestMsg;
 
+/* Returns the name of the class targeted by the request (NULL if unknown) */
+const ZChar* RequestMsg_GetClassName(
+    const RequestMsg* msg);
+
 
 /*
 **==============================================================================
@@ -316,6 +334,9 @@ typedef struct _PostResultMsg
 
     /* Flags for request message processing - like instance encoding type (see MessageFlag enum above) */
     MI_Uint32 requestFlags;
+
+    /* Stages reached by the request, sent back by the agents */
+    ServerStatsTrace trace;
 }
 PostResultMsg;
 
@@ -1546,8 +1567,10 @@ MI_INLINE void __ProtocolEventConnect_Release(
 **==============================================================================
 */
 
-#define MessageFromBatch(batch, originalMsgPtr, ptrAdjustmentInfo, ptrAdjustmentInfoCount, skipInstanceUnpack, msgOut) \
-    __MessageFromBatch(batch, originalMsgPtr, ptrAdjustmentInfo, ptrAdjustmentInfoCount, skipInstanceUnpack, msgOut, CALLSITE)
+/* 'instanceSchemas' (optional) holds the schemas of the compact instances
+ * received so far on the connection (see Instance_PackCompact) */
+#define MessageFromBatch(batch, originalMsgPtr, ptrAdjustmentInfo, ptrAdjustmentInfoCount, skipInstanceUnpack, instanceSchemas, msgOut) \
+    __MessageFromBatch(batch, originalMsgPtr, ptrAdjustmentInfo, ptrAdjustmentInfoCount, skipInstanceUnpack, instanceSchemas, msgOut, CALLSITE)
 
 MI_Result __MessageFromBatch(
     Batch* batch,
@@ -1555,6 +1578,7 @@ MI_Result __MessageFromBatch(
     const Header_BatchInfoItem* ptrAdjustmentInfo,
     size_t ptrAdjustmentInfoCount,
     MI_Boolean skipInstanceUnpack,
+    InstanceSchemaDict* instanceSchemas,
     Message** msgOut,
     CallSite cs);
 
@@ -1570,12 +1594,37 @@ MI_Result __MessageFromBatch(
 **      Note: requests without instances (like Enum) don't need a copy -
 **      add-ref-ed original message is returned in that case
 **
+**      The strings and packed instances already in the batch of the
+**      original message (like the ones of messages received from the
+**      binary protocol) are not copied: the clone points to them and
+**      keeps the original message as its payload, whose pages are sent
+**      along with the clone's ones. Only the fixed part of the message and
+**      what is outside of the original batch is copied.
+**
 **==============================================================================
 */
 MI_Result MessagePackCloneForBinarySending(
     Message* msgSrc,
     Message** msgOut);
 
+/* Most pages of an original message sent along with its clone */
+#define MESSAGE_MAX_PAYLOAD_PAGES 32
+
+/*
+**==============================================================================
+**
+**     Pages the binary protocol sends for the message: the ones of its
+**      batch followed by the ones of its payload (if any)
+**
+**==============================================================================
+*/
+size_t Message_GetPageCount(
+    Message* msg);
+
+size_t Message_GetPageInfo(
+    Message* msg,
+    Header_BatchInfoItem* buffer);
+
 
 /*
 **==============================================================================
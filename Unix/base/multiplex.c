@@ -8,6 +8,7 @@
 */
 
 #include "multiplex.h"
+#include "serverstats.h"
 #include <omi_error/errorutil.h>
 
 #define MUX_HASHTABLESIZE   100
@@ -35,6 +36,13 @@ typedef struct _OperationOut
     StrandEntry     strand;  
 
     MI_Uint64       key;  // for now OperationOut address
+
+    // request tag and start time (for ServerStats)
+    MI_Uint32       tag;
+    MI_Uint64       startUsec;
+
+    // request held until its trace is aggregated (for ServerStats)
+    RequestMsg*     request;
 } 
 OperationOut;
 
@@ -67,15 +75,39 @@ void _OperationOut_Cancel( _In_ Strand* self)
 
 void _OperationOut_Close( _In_ Strand* self_)
 {
-    //OperationOut* self = (OperationOut*)StrandEntry_FromStrand(self_);
+    OperationOut* self = (OperationOut*)StrandEntry_FromStrand(self_);
     DEBUG_ASSERT( NULL != self_ );
     trace_OperationOut_Close( &self_->info.interaction, self_->info.interaction.other );
 
+    // the operation is complete
+    ServerStats_EndRequest( self->tag, self->startUsec );
+
+    if( NULL != self->request )
+    {
+        ServerStats_EndTrace( self->tag, RequestMsg_GetClassName(self->request), &self->request->trace );
+        Message_Release( &self->request->base );
+        self->request = NULL;
+    }
+
     // Just close the other side
     if( !self_->info.thisClosedOther )
         Strand_Close( self_ );
 }
 
+void _OperationOut_Finish( _In_ Strand* self_)
+{
+    OperationOut* self = (OperationOut*)StrandEntry_FromStrand(self_);
+
+    // release request if the operation never completed
+    if( NULL != self->request )
+    {
+        Message_Release( &self->request->base );
+        self->request = NULL;
+    }
+
+    StrandEntry_Delete( &self->strand );
+}
+
 /*
     Object that implements a single operation coming out of a binary protocol 
     connection. Uses that one-to-many interface to multiplex multiple operations
@@ -99,7 +131,7 @@ static StrandFT _OperationOut_FT = {
     _OperationOut_Ack, 
     _OperationOut_Cancel, 
     _OperationOut_Close,
-    NULL,
+    _OperationOut_Finish,
     NULL,
     NULL,
     NULL,
@@ -209,6 +241,21 @@ void _ConnectionIn_Post( _In_ Strand* self_, _In_ Message* msg )
                 }
                 else
                 {
+                    newOperation->tag = msg->tag;
+                    newOperation->startUsec = ServerStats_BeginRequest( msg->tag );
+
+                    if( Message_IsRequest( msg ) )
+                    {
+                        // (requests the server sends to the agents already
+                        // carry the stamps of the server)
+                        RequestMsg* request = (RequestMsg*)msg;
+
+                        ServerStats_Stamp( &request->trace, SERVERSTATS_STAGE_PARSE );
+
+                        Message_AddRef( msg );
+                        newOperation->request = request;
+                    }
+
                     // open interaction to the right
                     // Leave also OperationOut strand on open, otherwise any Post in the same thread will be delayed
                     // and the stack will eventually deadlock on in-proc providers that send
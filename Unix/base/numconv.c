@@ -0,0 +1,757 @@
+/*
+**==============================================================================
+**
+** Copyright (c) Microsoft Corporation. All rights reserved. See file LICENSE
+** for license information.
+**
+**==============================================================================
+*/
+
+#include "numconv.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <pal/strings.h>
+#include <pal/format.h>
+
+/* "00", "01", ..., "99" */
+static const char _digitPairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/* Exact powers of ten as doubles (up to 10^22) */
+static const double _powersOfTen[] =
+{
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+#define MAX_EXACT_POWER 22
+
+/* Largest integer below which every integer is a double (2^53) */
+#define MAX_EXACT_INTEGER MI_ULL(9007199254740992)
+
+static size_t _CountDigits(
+    MI_Uint64 x)
+{
+    size_t n = 1;
+
+    for (;;)
+    {
+        if (x < 10)
+            return n;
+        if (x < 100)
+            return n + 1;
+        if (x < 1000)
+            return n + 2;
+        if (x < 10000)
+            return n + 3;
+
+        x /= 10000;
+        n += 4;
+    }
+}
+
+/* Writes the digits of 'x' backwards from 'end' (exclusive) */
+static void _PutDigitsBackwards(
+    _Inout_ ZChar* end,
+    MI_Uint64 x)
+{
+    while (x >= 100)
+    {
+        size_t i = (size_t)(x % 100) * 2;
+        x /= 100;
+        *--end = (ZChar)_digitPairs[i + 1];
+        *--end = (ZChar)_digitPairs[i];
+    }
+
+    if (x >= 10)
+    {
+        size_t i = (size_t)x * 2;
+        *--end = (ZChar)_digitPairs[i + 1];
+        *--end = (ZChar)_digitPairs[i];
+    }
+    else
+    {
+        *--end = (ZChar)('0' + (size_t)x);
+    }
+}
+
+/* Writes 'x' with at least 'width' digits (like "%0<width>u") and returns
+ * the position after it */
+static ZChar* _PutUint(
+    _Inout_ ZChar* p,
+    MI_Uint64 x,
+    size_t width)
+{
+    size_t n = _CountDigits(x);
+
+    while (width > n)
+    {
+        *p++ = '0';
+        width--;
+    }
+
+    _PutDigitsBackwards(p + n, x);
+    return p + n;
+}
+
+size_t NumConv_Uint64ToZStr(
+    ZChar buf[NUMCONV_INT_SIZE],
+    MI_Uint64 x)
+{
+    ZChar* end = _PutUint(buf, x, 0);
+
+    *end = '\0';
+    return (size_t)(end - buf);
+}
+
+size_t NumConv_Sint64ToZStr(
+    ZChar buf[NUMCONV_INT_SIZE],
+    MI_Sint64 x)
+{
+    ZChar* p = buf;
+    MI_Uint64 magnitude = (MI_Uint64)x;
+
+    if (x < 0)
+    {
+        *p++ = '-';
+        magnitude = 0 - magnitude;
+    }
+
+    p = _PutUint(p, magnitude, 0);
+    *p = '\0';
+    return (size_t)(p - buf);
+}
+
+/*
+**==============================================================================
+**
+** Reals
+**
+**==============================================================================
+*/
+
+/* Formats integral values like "%.<precision>e" (returns 0 if it cannot) */
+static size_t _IntegralToExponent(
+    ZChar buf[NUMCONV_REAL_SIZE],
+    MI_Uint64 magnitude,
+    MI_Boolean negative,
+    int precision,
+    char format)
+{
+    ZChar digits[NUMCONV_INT_SIZE];
+    ZChar* p = buf;
+    size_t n;
+    size_t i;
+    size_t exponent;
+
+    if (magnitude == 0)
+    {
+        digits[0] = '0';
+        n = 1;
+    }
+    else
+    {
+        n = _CountDigits(magnitude);
+
+        /* Rounding needed */
+        if (n > (size_t)precision + 1)
+            return 0;
+
+        _PutDigitsBackwards(digits + n, magnitude);
+    }
+
+    exponent = magnitude == 0 ? 0 : n - 1;
+
+    if (negative)
+        *p++ = '-';
+
+    *p++ = digits[0];
+
+    if (precision > 0)
+    {
+        *p++ = '.';
+
+        for (i = 1; i <= (size_t)precision; i++)
+            *p++ = i < n ? digits[i] : '0';
+    }
+
+    *p++ = (ZChar)format;
+    *p++ = '+';
+    p = _PutUint(p, exponent, 2);
+    *p = '\0';
+
+    return (size_t)(p - buf);
+}
+
+/* Goes through the C library, then makes sure the decimal point is '.'
+ * whatever the locale */
+static size_t _Real64ToZStrSlow(
+    ZChar buf[NUMCONV_REAL_SIZE],
+    MI_Real64 x,
+    int precision,
+    char format)
+{
+    char tmp[NUMCONV_REAL_SIZE];
+    char fmt[] = "%.*g";
+    int n;
+    int i;
+
+    fmt[3] = format;
+    n = snprintf(tmp, sizeof(tmp), fmt, precision, x);
+
+    if (n < 0)
+        n = 0;
+    else if (n >= (int)sizeof(tmp))
+        n = (int)sizeof(tmp) - 1;
+
+    for (i = 0; i < n; i++)
+    {
+        char c = tmp[i];
+
+        if ((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') ||
+            (c >= 'A' && c <= 'Z') || c == '-' || c == '+')
+        {
+            buf[i] = (ZChar)c;
+        }
+        else
+        {
+            buf[i] = '.';
+        }
+    }
+
+    buf[n] = '\0';
+    return (size_t)n;
+}
+
+size_t NumConv_Real64ToZStr(
+    ZChar buf[NUMCONV_REAL_SIZE],
+    MI_Real64 x,
+    int precision,
+    char format)
+{
+    if (precision < 0)
+        precision = 6;
+    else if (precision > NUMCONV_MAX_PRECISION)
+        precision = NUMCONV_MAX_PRECISION;
+
+    /* Integral values below 2^53 */
+    if (x > -(double)MAX_EXACT_INTEGER && x < (double)MAX_EXACT_INTEGER)
+    {
+        MI_Sint64 i = (MI_Sint64)x;
+
+        if ((double)i == x)
+        {
+            MI_Boolean negative = x < 0 || (x == 0 && signbit(x));
+            MI_Uint64 magnitude = i < 0 ? (MI_Uint64)-i : (MI_Uint64)i;
+
+            if (format == 'g')
+            {
+                /* Written without exponent when it has at most
+                 * 'precision' digits */
+                if (_CountDigits(magnitude) <= (size_t)(precision ? precision : 1))
+                {
+                    ZChar* p = buf;
+
+                    if (negative)
+                        *p++ = '-';
+
+                    p = _PutUint(p, magnitude, 0);
+                    *p = '\0';
+                    return (size_t)(p - buf);
+                }
+            }
+            else
+            {
+                size_t n = _IntegralToExponent(
+                    buf, magnitude, negative, precision, format);
+
+                if (n)
+                    return n;
+            }
+        }
+    }
+
+    return _Real64ToZStrSlow(buf, x, precision, format);
+}
+
+/*
+**==============================================================================
+**
+** Datetimes
+**
+**==============================================================================
+*/
+
+void NumConv_DatetimeToZStr(
+    ZChar buf[NUMCONV_DATETIME_SIZE],
+    const MI_Datetime* x)
+{
+    ZChar* p = buf;
+
+    if (x->isTimestamp)
+    {
+        const MI_Timestamp* ts = &x->u.timestamp;
+        MI_Sint32 utc = ts->utc;
+        MI_Uint32 utcMagnitude = utc < 0 ? 0 - (MI_Uint32)utc : (MI_Uint32)utc;
+
+        /* Out of range fields keep the printf() behavior */
+        if (ts->year > 9999 || ts->month > 99 || ts->day > 99 ||
+            ts->hour > 99 || ts->minute > 99 || ts->second > 99 ||
+            ts->microseconds > 999999 || utcMagnitude > 999)
+        {
+            const ZChar FMT[] =  MI_T("%04d%02d%02d%02d%02d%02d.%06d%c%03d");
+            Stprintf(buf, NUMCONV_DATETIME_SIZE, FMT,
+                ts->year, ts->month, ts->day,
+                ts->hour, ts->minute, ts->second,
+                ts->microseconds,
+                utc < 0 ? '-' : '+',
+                utc < 0 ? -utc : utc);
+            return;
+        }
+
+        p = _PutUint(p, ts->year, 4);
+        p = _PutUint(p, ts->month, 2);
+        p = _PutUint(p, ts->day, 2);
+        p = _PutUint(p, ts->hour, 2);
+        p = _PutUint(p, ts->minute, 2);
+        p = _PutUint(p, ts->second, 2);
+        *p++ = '.';
+        p = _PutUint(p, ts->microseconds, 6);
+        *p++ = utc < 0 ? '-' : '+';
+        p = _PutUint(p, utcMagnitude, 3);
+    }
+    else
+    {
+        const MI_Interval* in = &x->u.interval;
+
+        if (in->days > 99999999 || in->hours > 99 || in->minutes > 99 ||
+            in->seconds > 99 || in->microseconds > 999999)
+        {
+            const ZChar FMT[] = MI_T("%08u%02u%02u%02u.%06u:000");
+            Stprintf(buf, NUMCONV_DATETIME_SIZE, FMT,
+                in->days, in->hours, in->minutes, in->seconds,
+                in->microseconds);
+            return;
+        }
+
+        p = _PutUint(p, in->days, 8);
+        p = _PutUint(p, in->hours, 2);
+        p = _PutUint(p, in->minutes, 2);
+        p = _PutUint(p, in->seconds, 2);
+        *p++ = '.';
+        p = _PutUint(p, in->microseconds, 6);
+        *p++ = ':';
+        *p++ = '0';
+        *p++ = '0';
+        *p++ = '0';
+    }
+
+    *p = '\0';
+}
+
+void NumConv_WSManDatetimeToZStr(
+    ZChar buf[NUMCONV_WSMAN_DATETIME_SIZE],
+    const MI_Datetime* x)
+{
+    /* Large enough for any field values (the result is truncated to the
+     * size of 'buf' as it used to be) */
+    ZChar tmp[128];
+    ZChar* p = tmp;
+    size_t n;
+
+    if (x->isTimestamp)
+    {
+        const MI_Timestamp* ts = &x->u.timestamp;
+
+        /* As per section 8.2 in DSP0230_1.1.0, a date or a time of all
+         * zeros is valid; MI_Datetime cannot hold the asterisks for a
+         * missing date or time */
+        p = _PutUint(p, ts->year, 4);
+        *p++ = '-';
+        p = _PutUint(p, ts->month, 2);
+        *p++ = '-';
+        p = _PutUint(p, ts->day, 2);
+        *p++ = 'T';
+        p = _PutUint(p, ts->hour, 2);
+        *p++ = ':';
+        p = _PutUint(p, ts->minute, 2);
+        *p++ = ':';
+        p = _PutUint(p, ts->second, 2);
+
+        if (ts->microseconds)
+        {
+            *p++ = '.';
+            p = _PutUint(p, ts->microseconds, 6);
+        }
+
+        if (ts->utc)
+        {
+            MI_Uint32 utc = ts->utc < 0 ?
+                0 - (MI_Uint32)ts->utc : (MI_Uint32)ts->utc;
+
+            *p++ = ts->utc < 0 ? '-' : '+';
+            p = _PutUint(p, utc / 60, 2);
+            *p++ = ':';
+            p = _PutUint(p, utc % 60, 2);
+        }
+        else
+        {
+            *p++ = 'Z';
+        }
+    }
+    else
+    {
+        const MI_Interval* in = &x->u.interval;
+
+        *p++ = 'P';
+
+        if (in->days)
+        {
+            p = _PutUint(p, in->days, 0);
+            *p++ = 'D';
+        }
+
+        if (in->hours || in->minutes || in->seconds || in->microseconds)
+            *p++ = 'T';
+
+        if (in->hours)
+        {
+            p = _PutUint(p, in->hours, 0);
+            *p++ = 'H';
+        }
+
+        if (in->minutes)
+        {
+            p = _PutUint(p, in->minutes, 0);
+            *p++ = 'M';
+        }
+
+        if (in->seconds || in->microseconds)
+        {
+            p = _PutUint(p, in->seconds, 0);
+
+            if (in->microseconds)
+            {
+                *p++ = '.';
+                p = _PutUint(p, in->microseconds, 6);
+            }
+
+            *p++ = 'S';
+        }
+    }
+
+    n = (size_t)(p - tmp);
+
+    if (n > NUMCONV_WSMAN_DATETIME_SIZE - 1)
+        n = NUMCONV_WSMAN_DATETIME_SIZE - 1;
+
+    memcpy(buf, tmp, n * sizeof(ZChar));
+    buf[n] = '\0';
+}
+
+/*
+**==============================================================================
+**
+** Parsers
+**
+**==============================================================================
+*/
+
+#define _IsDigit(c) ((c) >= '0' && (c) <= '9')
+
+const ZChar* NumConv_ZStrToUint64(
+    const ZChar* str,
+    MI_Uint64* x)
+{
+    const ZChar* p = str;
+    MI_Uint64 value = 0;
+
+    *x = 0;
+
+    if (!_IsDigit(*p))
+        return NULL;
+
+    /* No overflow is possible for the first 19 digits */
+    while (_IsDigit(*p) && p - str < 19)
+        value = value * 10 + (MI_Uint64)(*p++ - '0');
+
+    while (_IsDigit(*p))
+    {
+        MI_Uint64 digit = (MI_Uint64)(*p++ - '0');
+
+        if (value > (PAL_UINT64_MAX - digit) / 10)
+            return NULL;
+
+        value = value * 10 + digit;
+    }
+
+    *x = value;
+    return p;
+}
+
+const ZChar* NumConv_ZStrToSint64(
+    const ZChar* str,
+    MI_Sint64* x)
+{
+    const ZChar* p = str;
+    MI_Boolean negative = MI_FALSE;
+    MI_Uint64 magnitude;
+
+    *x = 0;
+
+    if (*p == '-')
+    {
+        negative = MI_TRUE;
+        p++;
+    }
+    else if (*p == '+')
+    {
+        p++;
+    }
+
+    p = NumConv_ZStrToUint64(p, &magnitude);
+
+    if (!p)
+        return NULL;
+
+    if (negative)
+    {
+        if (magnitude > (MI_Uint64)PAL_SINT64_MAX + 1)
+            return NULL;
+
+        *x = (MI_Sint64)(0 - magnitude);
+    }
+    else
+    {
+        if (magnitude > (MI_Uint64)PAL_SINT64_MAX)
+            return NULL;
+
+        *x = (MI_Sint64)magnitude;
+    }
+
+    return p;
+}
+
+/* Converts [sign] digits [. digits] [e [sign] digits] exactly when the
+ * significand has at most 19 digits, is below 2^53 and the power of ten
+ * is exact (at most 10^22); returns NULL for the others */
+static const ZChar* _ZStrToReal64Fast(
+    const ZChar* str,
+    MI_Real64* x)
+{
+    const ZChar* p = str;
+    MI_Boolean negative = MI_FALSE;
+    MI_Boolean sawDigits = MI_FALSE;
+    MI_Uint64 significand = 0;
+    int numDigits = 0;
+    int exponent = 0;
+    MI_Real64 value;
+
+    if (*p == '-')
+    {
+        negative = MI_TRUE;
+        p++;
+    }
+    else if (*p == '+')
+    {
+        p++;
+    }
+
+    for (; _IsDigit(*p); p++)
+    {
+        sawDigits = MI_TRUE;
+
+        /* Leading zeros do not count */
+        if (significand == 0 && *p == '0')
+            continue;
+
+        if (++numDigits > 19)
+            return NULL;
+
+        significand = significand * 10 + (MI_Uint64)(*p - '0');
+    }
+
+    if (*p == '.')
+    {
+        for (p++; _IsDigit(*p); p++)
+        {
+            sawDigits = MI_TRUE;
+            exponent--;
+
+            if (significand == 0 && *p == '0')
+                continue;
+
+            if (++numDigits > 19)
+                return NULL;
+
+            significand = significand * 10 + (MI_Uint64)(*p - '0');
+        }
+    }
+
+    if (!sawDigits)
+        return NULL;
+
+    if (*p == 'e' || *p == 'E')
+    {
+        const ZChar* q = p + 1;
+        MI_Boolean negativeExponent = MI_FALSE;
+        int e = 0;
+
+        if (*q == '-')
+        {
+            negativeExponent = MI_TRUE;
+            q++;
+        }
+        else if (*q == '+')
+        {
+            q++;
+        }
+
+        if (!_IsDigit(*q))
+            return NULL;
+
+        while (_IsDigit(*q))
+        {
+            if (e > 1000)
+                return NULL;
+
+            e = e * 10 + (*q++ - '0');
+        }
+
+        exponent += negativeExponent ? -e : e;
+        p = q;
+    }
+
+    /* Left to strtod() (hexadecimal reals, "inf", "nan", ...) */
+    if ((*p >= 'a' && *p <= 'z') || (*p >= 'A' && *p <= 'Z') || *p == '.')
+        return NULL;
+
+    if (significand >= MAX_EXACT_INTEGER)
+        return NULL;
+
+    if (significand == 0)
+        exponent = 0;
+
+    if (exponent < -MAX_EXACT_POWER || exponent > MAX_EXACT_POWER)
+        return NULL;
+
+    value = (MI_Real64)significand;
+
+    if (exponent < 0)
+        value /= _powersOfTen[-exponent];
+    else
+        value *= _powersOfTen[exponent];
+
+    *x = negative ? -value : value;
+    return p;
+}
+
+const ZChar* NumConv_ZStrToReal64(
+    const ZChar* str,
+    MI_Real64* x)
+{
+    const ZChar* p = _ZStrToReal64Fast(str, x);
+    ZChar* end;
+
+    if (p)
+        return p;
+
+    *x = Tcstod(str, &end);
+
+    if (end == str)
+        return NULL;
+
+    return end;
+}
+
+/* Reads exactly 'n' digits */
+static int _ParseFixed(
+    const ZChar* p,
+    size_t n,
+    MI_Uint32* x)
+{
+    MI_Uint32 value = 0;
+    size_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        if (!_IsDigit(p[i]))
+            return -1;
+
+        value = value * 10 + (MI_Uint32)(p[i] - '0');
+    }
+
+    *x = value;
+    return 0;
+}
+
+int NumConv_ZStrToDatetime(
+    const ZChar* s,
+    MI_Datetime* x)
+{
+    size_t i;
+
+    memset(x, 0, sizeof(MI_Datetime));
+
+    for (i = 0; i < 25; i++)
+    {
+        if (s[i] == '\0')
+            return -1;
+    }
+
+    if (s[25] != '\0' || s[14] != '.')
+        return -1;
+
+    if (s[21] == '+' || s[21] == '-')
+    {
+        MI_Timestamp* ts = &x->u.timestamp;
+        MI_Uint32 utc;
+
+        if (_ParseFixed(s, 4, &ts->year) != 0 ||
+            _ParseFixed(s + 4, 2, &ts->month) != 0 ||
+            _ParseFixed(s + 6, 2, &ts->day) != 0 ||
+            _ParseFixed(s + 8, 2, &ts->hour) != 0 ||
+            _ParseFixed(s + 10, 2, &ts->minute) != 0 ||
+            _ParseFixed(s + 12, 2, &ts->second) != 0 ||
+            _ParseFixed(s + 15, 6, &ts->microseconds) != 0 ||
+            _ParseFixed(s + 22, 3, &utc) != 0)
+        {
+            return -1;
+        }
+
+        ts->utc = s[21] == '+' ? (MI_Sint32)utc : -(MI_Sint32)utc;
+        x->isTimestamp = 1;
+    }
+    else if (s[21] == ':')
+    {
+        MI_Interval* in = &x->u.interval;
+
+        if (_ParseFixed(s, 8, &in->days) != 0 ||
+            _ParseFixed(s + 8, 2, &in->hours) != 0 ||
+            _ParseFixed(s + 10, 2, &in->minutes) != 0 ||
+            _ParseFixed(s + 12, 2, &in->seconds) != 0 ||
+            _ParseFixed(s + 15, 6, &in->microseconds) != 0 ||
+            s[22] != '0' || s[23] != '0' || s[24] != '0')
+        {
+            return -1;
+        }
+
+        x->isTimestamp = 0;
+    }
+    else
+    {
+        return -1;
+    }
+
+    return 0;
+}
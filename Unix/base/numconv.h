@@ -0,0 +1,112 @@
+/*
+**==============================================================================
+**
+** Copyright (c) Microsoft Corporation. All rights reserved. See file LICENSE
+** for license information.
+**
+**==============================================================================
+*/
+
+#ifndef _omi_numconv_h
+#define _omi_numconv_h
+
+#include <common.h>
+
+BEGIN_EXTERNC
+
+/*
+**==============================================================================
+**
+** NumConv
+**
+**     Conversions between numbers (and CIM datetimes) and strings for the
+**     serializers and the parsers. The integers and the datetimes are
+**     written two digits at a time from a table and read without going
+**     through strtoul() and friends; the output is the same as the printf()
+**     formats they replace, whatever the locale.
+**
+**     The reals keep their printf() formats (%.15g for WS-Man, %.7e/%.16e
+**     for CIM-XML, ...): the integral values, the most common ones, are
+**     formatted directly and the others fall back to the C library (then
+**     the decimal point is always '.'). The parser converts the decimal
+**     strings of up to 19 digits with an exponent within +/-22 exactly
+**     (Clinger's fast path) and falls back to strtod() for the others.
+**
+**==============================================================================
+*/
+
+/* Sizes of the buffers (including the terminating zero) */
+#define NUMCONV_INT_SIZE 21
+#define NUMCONV_REAL_SIZE 64
+#define NUMCONV_DATETIME_SIZE 26
+#define NUMCONV_WSMAN_DATETIME_SIZE 64
+
+/* Longest precision of NumConv_Real64ToZStr() */
+#define NUMCONV_MAX_PRECISION 52
+
+/* Write the decimal representation of 'x' into 'buf' and return its length */
+size_t NumConv_Uint64ToZStr(
+    _Pre_writable_size_(NUMCONV_INT_SIZE) ZChar buf[NUMCONV_INT_SIZE],
+    MI_Uint64 x);
+
+size_t NumConv_Sint64ToZStr(
+    _Pre_writable_size_(NUMCONV_INT_SIZE) ZChar buf[NUMCONV_INT_SIZE],
+    MI_Sint64 x);
+
+/* Writes 'x' like printf("%.<precision><format>") where 'format' is one
+ * of 'g', 'e' or 'E'; returns the length of the string */
+size_t NumConv_Real64ToZStr(
+    _Pre_writable_size_(NUMCONV_REAL_SIZE) ZChar buf[NUMCONV_REAL_SIZE],
+    MI_Real64 x,
+    int precision,
+    char format);
+
+/* Writes the CIM form of the datetime:
+ *     timestamp: "YYYYMMDDHHMMSS.MMMMMMSUTC"
+ *     interval:  "DDDDDDDDHHMMSS.MMMMMM:000"
+ */
+void NumConv_DatetimeToZStr(
+    _Pre_writable_size_(NUMCONV_DATETIME_SIZE)
+        ZChar buf[NUMCONV_DATETIME_SIZE],
+    _In_ const MI_Datetime* x);
+
+/* Writes the WS-Man form of the datetime (xs:dateTime or xs:duration):
+ *     timestamp: "2010-12-31T12:30:03.123456+06:00"
+ *     interval:  "P1DT10H11M12.000001S"
+ */
+void NumConv_WSManDatetimeToZStr(
+    _Pre_writable_size_(NUMCONV_WSMAN_DATETIME_SIZE)
+        ZChar buf[NUMCONV_WSMAN_DATETIME_SIZE],
+    _In_ const MI_Datetime* x);
+
+/* Read the decimal digits at the start of 'str' (no spaces, no sign);
+ * return the first character after them or NULL if there is none or the
+ * value overflows */
+_Success_(return != NULL)
+const ZChar* NumConv_ZStrToUint64(
+    _In_z_ const ZChar* str,
+    _Out_ MI_Uint64* x);
+
+/* Same with an optional sign */
+_Success_(return != NULL)
+const ZChar* NumConv_ZStrToSint64(
+    _In_z_ const ZChar* str,
+    _Out_ MI_Sint64* x);
+
+/* Reads a real like strtod(); returns the first character after it or
+ * NULL if 'str' does not start with a real */
+_Success_(return != NULL)
+const ZChar* NumConv_ZStrToReal64(
+    _In_z_ const ZChar* str,
+    _Out_ MI_Real64* x);
+
+/* Reads the CIM form of a datetime; returns -1 if 'str' is not exactly
+ * in that form, including the wildcard ('*') fields StrToDatetime()
+ * accepts */
+int NumConv_ZStrToDatetime(
+    _In_z_ const ZChar* str,
+    _Out_ MI_Datetime* x);
+
+END_EXTERNC
+
+#endif /* _omi_numconv_h */
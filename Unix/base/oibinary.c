@@ -0,0 +1,394 @@
+/*
+**==============================================================================
+**
+** Copyright (c) Microsoft Corporation. All rights reserved. See file LICENSE
+** for license information.
+**
+**==============================================================================
+*/
+
+#include "oibinary.h"
+#include <stdio.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <pal/atomic.h>
+#include <pal/once.h>
+#include <pal/sleep.h>
+#include <pal/strings.h>
+#include <pal/thread.h>
+#include <pal/tls.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/* Marks a slot claimed by a writer */
+#define _SLOT_BUSY ((ptrdiff_t)-1)
+
+typedef struct _OIBinaryRing
+{
+    /* Last reserved position */
+    ptrdiff_t next;
+
+    /* Position of each record once written (0 if empty, _SLOT_BUSY while
+     * written) */
+    ptrdiff_t seqs[OIBINARY_RING_RECORDS];
+
+    OIBinaryRecord records[OIBINARY_RING_RECORDS];
+}
+OIBinaryRing;
+
+volatile MI_Uint64 __oiBinaryGroups;
+
+/* The rings are allocated by the threads that first write an event (so
+ * only once a group is enabled) and are kept until the process exits */
+static OIBinaryRing* s_rings[OIBINARY_MAX_RINGS];
+static ptrdiff_t s_numRings;
+
+static TLS s_tls;
+static Once s_tlsOnce = ONCE_INITIALIZER;
+
+static _Success_(return == 0) int _InitTLS(
+    _In_ void* data,
+    _Outptr_result_maybenull_ void** value)
+{
+    *value = NULL;
+    return TLS_Init(&s_tls);
+}
+
+/* Returns the ring of the current thread (taken the first time; once all
+ * the rings are taken, the threads share them), or NULL if out of memory */
+static OIBinaryRing* _GetRing()
+{
+    OIBinaryRing* ring;
+    ptrdiff_t index;
+
+    if (Once_Invoke(&s_tlsOnce, _InitTLS, NULL) != 0)
+        return NULL;
+
+    ring = (OIBinaryRing*)TLS_Get(&s_tls);
+    if (ring)
+        return ring;
+
+    index = Atomic_Inc(&s_numRings) - 1;
+
+    if (index >= OIBINARY_MAX_RINGS)
+    {
+        /* (NULL while the thread that took it is still allocating it) */
+        index = (ptrdiff_t)(Thread_TID() % OIBINARY_MAX_RINGS);
+        ring = (OIBinaryRing*)Atomic_Read((ptrdiff_t*)&s_rings[index]);
+    }
+    else
+    {
+        /* Not PAL_Calloc(): the rings outlive the leak checks at exit */
+        ring = (OIBinaryRing*)SystemCalloc(1, sizeof(OIBinaryRing));
+
+        if (ring)
+            Atomic_Swap((ptrdiff_t*)&s_rings[index], (ptrdiff_t)ring);
+    }
+
+    if (ring)
+        TLS_Set(&s_tls, (ptrdiff_t)ring);
+
+    return ring;
+}
+
+/* Returns a ring taken so far, or NULL */
+static OIBinaryRing* _RingAt(
+    ptrdiff_t index)
+{
+    ptrdiff_t numRings = Atomic_Read(&s_numRings);
+
+    if (index >= numRings || index >= OIBINARY_MAX_RINGS)
+        return NULL;
+
+    return (OIBinaryRing*)Atomic_Read((ptrdiff_t*)&s_rings[index]);
+}
+
+void OIBinary_EnableGroup(
+    MI_Uint32 group,
+    MI_Boolean enable)
+{
+    MI_Uint64 bit;
+
+    if (group >= OIBINARY_MAX_GROUPS)
+        return;
+
+    bit = (MI_Uint64)1 << group;
+
+    if (enable)
+        __oiBinaryGroups |= bit;
+    else
+        __oiBinaryGroups &= ~bit;
+}
+
+void OIBinary_SetGroups(
+    MI_Uint64 groups)
+{
+    __oiBinaryGroups = groups;
+}
+
+MI_Uint64 OIBinary_GetGroups()
+{
+    return __oiBinaryGroups;
+}
+
+int OIBinary_SetGroupsFromString(
+    _In_z_ const char* str)
+{
+    MI_Uint64 groups = 0;
+    const char* p = str;
+
+    if (Strcasecmp(str, "all") == 0)
+    {
+        OIBinary_SetGroups(~(MI_Uint64)0);
+        return 0;
+    }
+
+    if (Strcasecmp(str, "none") == 0)
+    {
+        OIBinary_SetGroups(0);
+        return 0;
+    }
+
+    for (;;)
+    {
+        char* end;
+        unsigned long group = strtoul(p, &end, 10);
+
+        if (end == p || group >= OIBINARY_MAX_GROUPS)
+            return -1;
+
+        groups |= (MI_Uint64)1 << group;
+
+        if (*end == '\0')
+            break;
+
+        if (*end != ',')
+            return -1;
+
+        p = end + 1;
+    }
+
+    OIBinary_SetGroups(groups);
+    return 0;
+}
+
+/* Copies a string into the strings area of the record */
+static MI_Uint64 _PutString(
+    _Inout_ OIBinaryRecord* record,
+    _In_opt_z_ const char* str,
+    _In_opt_z_ const TChar* tstr)
+{
+    size_t offset = record->stringsSize;
+    size_t space = sizeof(record->strings) - offset;
+    size_t length = 0;
+
+    if (space == 0)
+        return OIBINARY_STRING(offset, 0);
+
+    /* (leave room for the terminating zero) */
+    space--;
+
+    if (space > OIBINARY_MAX_STRING)
+        space = OIBINARY_MAX_STRING;
+
+    if (str)
+    {
+        while (length < space && str[length])
+        {
+            record->strings[offset + length] = str[length];
+            length++;
+        }
+    }
+    else if (tstr)
+    {
+        /* Only ASCII characters are kept as is */
+        while (length < space && tstr[length])
+        {
+            TChar c = tstr[length];
+            record->strings[offset + length] = (c > 0 && c < 128) ? (char)c : '?';
+            length++;
+        }
+    }
+
+    record->strings[offset + length] = '\0';
+    record->stringsSize = (MI_Uint16)(offset + length + 1);
+
+    return OIBINARY_STRING(offset, length);
+}
+
+void OIBinary_Put(
+    MI_Uint32 eventId,
+    int priority,
+    _In_z_ const char* kinds,
+    _In_reads_opt_(argc) const OIBinaryArg* args,
+    int argc)
+{
+    OIBinaryRing* ring = _GetRing();
+    OIBinaryRecord* record;
+    ptrdiff_t seq;
+    size_t index;
+    PAL_Uint64 now = 0;
+    int i;
+
+    if (!ring)
+        return;
+
+    if (argc > OIBINARY_MAX_ARGS)
+        argc = OIBINARY_MAX_ARGS;
+
+    seq = Atomic_Inc(&ring->next);
+    index = (size_t)(seq - 1) & (OIBINARY_RING_RECORDS - 1);
+    record = &ring->records[index];
+
+    /* Claim the slot while it is written; a shared ring may wrap around
+     * onto a slot another thread is still writing, in which case the
+     * event is dropped rather than mixed with the other one */
+    for (;;)
+    {
+        ptrdiff_t old = Atomic_Read(&ring->seqs[index]);
+
+        if (old == _SLOT_BUSY)
+            return;
+
+        if (Atomic_CompareAndSwap(&ring->seqs[index], old, _SLOT_BUSY) == old)
+            break;
+    }
+
+    PAL_Time(&now);
+    record->timestamp = now;
+    record->tid = Thread_TID();
+    record->eventId = eventId;
+    record->priority = (MI_Uint8)priority;
+    record->argc = (MI_Uint8)argc;
+    record->stringsSize = 0;
+
+    for (i = 0; i < argc; i++)
+    {
+        switch (kinds[i])
+        {
+            case 'S':
+                record->args[i] = _PutString(record, args[i].str, NULL);
+                break;
+            case 'T':
+                record->args[i] = _PutString(record, NULL, args[i].tstr);
+                break;
+            default:
+                record->args[i] = args[i].value;
+                break;
+        }
+    }
+
+    Atomic_Swap(&ring->seqs[index], seq);
+}
+
+/* Writes all of 'size' bytes (retrying interrupted writes) */
+static int _Write(
+    int fd,
+    _In_reads_bytes_(size) const void* data,
+    size_t size)
+{
+    const char* p = (const char*)data;
+
+    while (size)
+    {
+        ssize_t n = write(fd, p, size);
+
+        if (n < 0 && errno == EINTR)
+            continue;
+
+        if (n <= 0)
+            return -1;
+
+        p += n;
+        size -= (size_t)n;
+    }
+
+    return 0;
+}
+
+int OIBinary_Dump(
+    _In_z_ const char* path)
+{
+    OIBinaryFileHeader header;
+    OIBinaryRecord record;
+    ptrdiff_t r;
+    size_t i;
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+
+    if (fd < 0)
+        return -1;
+
+    memset(&header, 0, sizeof(header));
+    header.magic = OIBINARY_MAGIC;
+    header.version = OIBINARY_VERSION;
+    header.recordSize = sizeof(OIBinaryRecord);
+
+    if (_Write(fd, &header, sizeof(header)) != 0)
+        goto failed;
+
+    for (r = 0; r < OIBINARY_MAX_RINGS; r++)
+    {
+        OIBinaryRing* ring = _RingAt(r);
+
+        if (!ring)
+            continue;
+
+        for (i = 0; i < OIBINARY_RING_RECORDS; i++)
+        {
+            ptrdiff_t seq = Atomic_Read(&ring->seqs[i]);
+
+            if (seq == 0 || seq == _SLOT_BUSY)
+                continue;
+
+            memcpy(&record, &ring->records[i], sizeof(record));
+            NonX86MemoryBarrier();
+
+            /* Skip the records overwritten while they were copied */
+            if (Atomic_Read(&ring->seqs[i]) != seq)
+                continue;
+
+            record.seq = (MI_Uint64)seq;
+
+            if (_Write(fd, &record, sizeof(record)) != 0)
+                goto failed;
+
+            header.numRecords++;
+        }
+    }
+
+    if (lseek(fd, 0, SEEK_SET) != 0 ||
+        _Write(fd, &header, sizeof(header)) != 0)
+    {
+        goto failed;
+    }
+
+    close(fd);
+    return 0;
+
+failed:
+    close(fd);
+    return -1;
+}
+
+void OIBinary_Reset()
+{
+    ptrdiff_t r;
+    size_t i;
+
+    for (r = 0; r < OIBINARY_MAX_RINGS; r++)
+    {
+        OIBinaryRing* ring = _RingAt(r);
+
+        if (!ring)
+            continue;
+
+        for (i = 0; i < OIBINARY_RING_RECORDS; i++)
+        {
+            ptrdiff_t seq = Atomic_Read(&ring->seqs[i]);
+
+            /* (the slots being written are left to their writers) */
+            if (seq != _SLOT_BUSY)
+                Atomic_CompareAndSwap(&ring->seqs[i], seq, 0);
+        }
+    }
+}
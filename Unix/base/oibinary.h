@@ -0,0 +1,157 @@
+/*
+**==============================================================================
+**
+** Copyright (c) Microsoft Corporation. All rights reserved. See file LICENSE
+** for license information.
+**
+**==============================================================================
+*/
+
+#ifndef _omi_oibinary_h
+#define _omi_oibinary_h
+
+#include <common.h>
+
+BEGIN_EXTERNC
+
+/*
+**==============================================================================
+**
+** OIBinary
+**
+**     Runtime of the binary trace backend (see 'oigenc BINARY'). Events are
+**     written as fixed-size records holding the raw arguments into per-thread
+**     ring buffers; nothing is formatted on the hot path. The slots of a ring
+**     are reserved and claimed with atomics, so once all the rings are taken
+**     the threads left share them safely (an event that wraps around onto a
+**     slot still being written is dropped). A ring is allocated by the first
+**     event its thread records, so nothing is allocated while all groups are
+**     disabled.
+**
+**     Events are grouped by thousands of event ids (see OIBINARY_GROUP()),
+**     matching the STARTID blocks of the event header; the groups are enabled
+**     at runtime and all of them are disabled by default.
+**
+**     OIBinary_Dump() writes the rings to a file, which 'oigenc DECODE'
+**     renders offline with the formats of the same event header.
+**
+**==============================================================================
+*/
+
+#define OIBINARY_MAGIC 0x5442494F
+#define OIBINARY_VERSION 1
+
+#define OIBINARY_RECORD_SIZE 256
+#define OIBINARY_MAX_ARGS 10
+
+/* Longest string argument kept (longer ones are truncated) */
+#define OIBINARY_MAX_STRING 63
+
+/* Records per ring (power of two) and number of rings */
+#define OIBINARY_RING_RECORDS 1024
+#define OIBINARY_MAX_RINGS 64
+
+#define OIBINARY_MAX_GROUPS 64
+
+#define OIBINARY_GROUP(eventId) \
+    ((eventId) / 1000 < OIBINARY_MAX_GROUPS ? \
+        (eventId) / 1000 : OIBINARY_MAX_GROUPS - 1)
+
+/* String arguments are stored in OIBinaryRecord.strings; the argument slot
+ * holds the offset and the length of the string */
+#define OIBINARY_STRING(offset, length) \
+    ((MI_Uint64)(offset) | ((MI_Uint64)(length) << 16))
+#define OIBINARY_STRING_OFFSET(arg) ((MI_Uint32)((arg) & 0xFFFF))
+#define OIBINARY_STRING_LENGTH(arg) ((MI_Uint32)(((arg) >> 16) & 0xFFFF))
+
+typedef struct _OIBinaryRecord
+{
+    /* Position of the record in its ring (starts at 1) */
+    MI_Uint64 seq;
+
+    /* Microseconds since the epoch */
+    MI_Uint64 timestamp;
+
+    MI_Uint64 tid;
+    MI_Uint32 eventId;
+    MI_Uint8 priority;
+    MI_Uint8 argc;
+    MI_Uint16 stringsSize;
+    MI_Uint64 args[OIBINARY_MAX_ARGS];
+    char strings[OIBINARY_RECORD_SIZE - 32 - 8 * OIBINARY_MAX_ARGS];
+}
+OIBinaryRecord;
+
+/* Trace file: the header followed by 'numRecords' records, in no
+ * particular order (the decoder sorts them by timestamp) */
+typedef struct _OIBinaryFileHeader
+{
+    MI_Uint32 magic;
+    MI_Uint32 version;
+    MI_Uint32 recordSize;
+    MI_Uint32 numRecords;
+}
+OIBinaryFileHeader;
+
+/* Argument kinds (the generated code passes one letter per argument):
+ *     'V' - integer value
+ *     'P' - pointer (recorded as a value)
+ *     'S' - char string
+ *     'T' - TChar string
+ */
+typedef union _OIBinaryArg
+{
+    MI_Uint64 value;
+    const char* str;
+    const TChar* tstr;
+}
+OIBinaryArg;
+
+#define OIBINARY_ARG_V(arg, a) ((arg).value = (MI_Uint64)(a))
+#define OIBINARY_ARG_P(arg, a) ((arg).value = (MI_Uint64)(ptrdiff_t)(a))
+#define OIBINARY_ARG_S(arg, a) ((arg).str = (a))
+#define OIBINARY_ARG_T(arg, a) ((arg).tstr = (a))
+
+extern volatile MI_Uint64 __oiBinaryGroups;
+
+PAL_INLINE MI_Boolean OIBinary_IsEnabled(
+    MI_Uint32 eventId)
+{
+    return (__oiBinaryGroups >> OIBINARY_GROUP(eventId)) & 1 ?
+        MI_TRUE : MI_FALSE;
+}
+
+void OIBinary_EnableGroup(
+    MI_Uint32 group,
+    MI_Boolean enable);
+
+void OIBinary_SetGroups(
+    MI_Uint64 groups);
+
+MI_Uint64 OIBinary_GetGroups();
+
+/* Enables the groups from one of the following strings:
+ *     "all", "none" or a comma separated list of groups ("45,55")
+ */
+int OIBinary_SetGroupsFromString(
+    _In_z_ const char* str);
+
+/* Records an event ('kinds' has one letter per argument) */
+void OIBinary_Put(
+    MI_Uint32 eventId,
+    int priority,
+    _In_z_ const char* kinds,
+    _In_reads_opt_(argc) const OIBinaryArg* args,
+    int argc);
+
+/* Writes the records of all the rings to 'path'; only async-signal-safe
+ * calls are made, so this may be called by the handler of a fatal signal */
+int OIBinary_Dump(
+    _In_z_ const char* path);
+
+/* Discards the records of all the rings */
+void OIBinary_Reset();
+
+END_EXTERNC
+
+#endif /* _omi_oibinary_h */
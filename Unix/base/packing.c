@@ -9,6 +9,7 @@
 
 #include "packing.h"
 #include "naming.h"
+#include "field.h"
 #include <pal/format.h>
 
 /** Magic number for MI_Instance objects (binary buffer pack/unpack) */
@@ -22,7 +23,7 @@ MI_INLINE void* _Alloc(Batch* batch, size_t size)
     return batch ?  Batch_Get(batch, size) : PAL_Malloc(size);
 }
 
-static MI_Result _PackField(Buf* buf, const void* field, MI_Type type)
+static MI_Result _PackValue(Buf* buf, const MI_Value* value, MI_Type type)
 {
     switch (type)
     {
@@ -30,77 +31,48 @@ static MI_Result _PackField(Buf* buf, const void* field, MI_Type type)
         case MI_SINT8:
         case MI_UINT8:
         {
-            MI_Uint8Field* f = (MI_Uint8Field*)field;
-            MI_RETURN_ERR(Buf_PackU8(buf, f->exists));
-
-            if (f->exists)
-                MI_RETURN_ERR(Buf_PackU8(buf, f->value));
+            MI_RETURN_ERR(Buf_PackU8(buf, value->uint8));
             break;
         }
         case MI_SINT16:
         case MI_UINT16:
         case MI_CHAR16:
         {
-            MI_Uint16Field* f = (MI_Uint16Field*)field;
-            MI_RETURN_ERR(Buf_PackU8(buf, f->exists));
-
-            if (f->exists)
-                MI_RETURN_ERR(Buf_PackU16(buf, f->value));
+            MI_RETURN_ERR(Buf_PackU16(buf, value->uint16));
             break;
         }
         case MI_SINT32:
         case MI_UINT32:
         case MI_REAL32:
         {
-            MI_Uint32Field* f = (MI_Uint32Field*)field;
-            MI_RETURN_ERR(Buf_PackU8(buf, f->exists));
-
-            if (f->exists)
-                MI_RETURN_ERR(Buf_PackU32(buf, f->value));
+            MI_RETURN_ERR(Buf_PackU32(buf, value->uint32));
             break;
         }
         case MI_SINT64:
         case MI_UINT64:
         case MI_REAL64:
         {
-            MI_Uint64Field* f = (MI_Uint64Field*)field;
-            MI_RETURN_ERR(Buf_PackU8(buf, f->exists));
-
-            if (f->exists)
-                MI_RETURN_ERR(Buf_PackU64(buf, f->value));
+            MI_RETURN_ERR(Buf_PackU64(buf, value->uint64));
             break;
         }
         case MI_DATETIME:
         {
-            MI_DatetimeField* f = (MI_DatetimeField*)field;
-            MI_RETURN_ERR(Buf_PackU8(buf, f->exists));
-
-            if (f->exists)
-                Buf_PackDT(buf, &f->value);
+            Buf_PackDT(buf, &value->datetime);
             break;
         }
         case MI_STRING:
         {
-            MI_StringField* f = (MI_StringField*)field;
-            MI_RETURN_ERR(Buf_PackU8(buf, f->exists));
-
-            if (f->exists)
-                MI_RETURN_ERR(Buf_PackStr(buf, f->value));
+            MI_RETURN_ERR(Buf_PackStr(buf, value->string));
             break;
         }
         case MI_INSTANCE:
         case MI_REFERENCE:
         {
-            MI_InstanceField* f = ((MI_InstanceField*)field);
-
-            if (f->exists && !f->value)
+            if (!value->instance)
                 MI_RETURN(MI_RESULT_FAILED);
 
-            MI_RETURN_ERR(Buf_PackU8(buf, f->exists));
-
-            if (f->exists)
-                MI_RETURN_ERR(Instance_Pack(f->value, type == MI_REFERENCE, 
-                    NULL, NULL, buf));
+            MI_RETURN_ERR(Instance_Pack(value->instance, type == MI_REFERENCE, 
+                NULL, NULL, buf));
 
             break;
         }
@@ -108,115 +80,71 @@ static MI_Result _PackField(Buf* buf, const void* field, MI_Type type)
         case MI_SINT8A:
         case MI_UINT8A:
         {
-            MI_Uint8AField* f = (MI_Uint8AField*)field;
-            MI_RETURN_ERR(Buf_PackU8(buf, f->exists));
-
-            if (f->exists)
-            {
-                if (!f->value.data && f->value.size)
-                    MI_RETURN(MI_RESULT_FAILED);
+            if (!value->uint8a.data && value->uint8a.size)
+                MI_RETURN(MI_RESULT_FAILED);
 
-                MI_RETURN_ERR(Buf_PackU8A(buf, f->value.data, 
-                    f->value.size));
-            }
+            MI_RETURN_ERR(Buf_PackU8A(buf, value->uint8a.data, 
+                value->uint8a.size));
             break;
         }
         case MI_SINT16A:
         case MI_UINT16A:
         case MI_CHAR16A:
         {
-            MI_Uint16AField* f = (MI_Uint16AField*)field;
-            MI_RETURN_ERR(Buf_PackU8(buf, f->exists));
-
-            if (f->exists)
-            {
-                if (!f->value.data && f->value.size)
-                    MI_RETURN(MI_RESULT_FAILED);
+            if (!value->uint16a.data && value->uint16a.size)
+                MI_RETURN(MI_RESULT_FAILED);
 
-                MI_RETURN_ERR(Buf_PackU16A(buf, f->value.data, 
-                    f->value.size));
-            }
+            MI_RETURN_ERR(Buf_PackU16A(buf, value->uint16a.data, 
+                value->uint16a.size));
             break;
         }
         case MI_SINT32A:
         case MI_UINT32A:
         case MI_REAL32A:
         {
-            MI_Uint32AField* f = (MI_Uint32AField*)field;
-            MI_RETURN_ERR(Buf_PackU8(buf, f->exists));
-
-            if (f->exists)
-            {
-                if (!f->value.data && f->value.size)
-                    MI_RETURN(MI_RESULT_FAILED);
+            if (!value->uint32a.data && value->uint32a.size)
+                MI_RETURN(MI_RESULT_FAILED);
 
-                MI_RETURN_ERR(Buf_PackU32A(buf, f->value.data, 
-                    f->value.size));
-            }
+            MI_RETURN_ERR(Buf_PackU32A(buf, value->uint32a.data, 
+                value->uint32a.size));
             break;
         }
         case MI_SINT64A:
         case MI_UINT64A:
         case MI_REAL64A:
         {
-            MI_Uint64AField* f = (MI_Uint64AField*)field;
-            MI_RETURN_ERR(Buf_PackU8(buf, f->exists));
-
-            if (f->exists)
-            {
-                if (!f->value.data && f->value.size)
-                    MI_RETURN(MI_RESULT_FAILED);
+            if (!value->uint64a.data && value->uint64a.size)
+                MI_RETURN(MI_RESULT_FAILED);
 
-                MI_RETURN_ERR(Buf_PackU64A(buf, f->value.data, 
-                    f->value.size));
-            }
+            MI_RETURN_ERR(Buf_PackU64A(buf, value->uint64a.data, 
+                value->uint64a.size));
             break;
         }
         case MI_DATETIMEA:
         {
-            MI_DatetimeAField* f = (MI_DatetimeAField*)field;
-            MI_RETURN_ERR(Buf_PackU8(buf, f->exists));
-
-            if (f->exists)
-            {
-                if (!f->value.data && f->value.size)
-                    MI_RETURN(MI_RESULT_FAILED);
+            if (!value->datetimea.data && value->datetimea.size)
+                MI_RETURN(MI_RESULT_FAILED);
 
-                MI_RETURN_ERR(Buf_PackDTA(buf, f->value.data,
-                    f->value.size));
-            }
+            MI_RETURN_ERR(Buf_PackDTA(buf, value->datetimea.data,
+                value->datetimea.size));
             break;
         }
         case MI_STRINGA:
         {
-            MI_StringAField* f = (MI_StringAField*)field;
-
-            MI_RETURN_ERR(Buf_PackU8(buf, f->exists));
-
-            if (f->exists)
-            {
-                MI_RETURN_ERR(Buf_PackStrA(buf, 
-                    (const ZChar**)f->value.data, f->value.size));
-            }
+            MI_RETURN_ERR(Buf_PackStrA(buf, 
+                (const ZChar**)value->stringa.data, value->stringa.size));
             break;
         }
         case MI_INSTANCEA:
         case MI_REFERENCEA:
         {
-            MI_InstanceAField* f = ((MI_InstanceAField*)field);
+            MI_Uint32 index;
+            MI_RETURN_ERR(Buf_PackU32(buf, value->instancea.size));
 
-            MI_RETURN_ERR(Buf_PackU8(buf, f->exists));
-
-            if (f->exists)
+            for ( index = 0; index < value->instancea.size; index++ )
             {
-                MI_Uint32 index;
-                MI_RETURN_ERR(Buf_PackU32(buf, f->value.size));
-
-                for ( index = 0; index < f->value.size; index++ )
-                {
-                    MI_RETURN_ERR(Instance_Pack(f->value.data[index], 
-                        type == MI_REFERENCEA, NULL, NULL, buf));
-                }
+                MI_RETURN_ERR(Instance_Pack(value->instancea.data[index], 
+                    type == MI_REFERENCEA, NULL, NULL, buf));
             }
             break;
         }
@@ -227,24 +155,26 @@ static MI_Result _PackField(Buf* buf, const void* field, MI_Type type)
     MI_RETURN(MI_RESULT_OK);
 }
 
-static MI_Result _UnpackField(
+static MI_Result _PackField(Buf* buf, const void* field, MI_Type type)
+{
+    MI_Boolean exists = Field_GetExists((const Field*)field, type);
+
+    MI_RETURN_ERR(Buf_PackU8(buf, exists));
+
+    /* (the value of a field comes first) */
+    if (exists)
+        MI_RETURN_ERR(_PackValue(buf, (const MI_Value*)field, type));
+
+    MI_RETURN(MI_RESULT_OK);
+}
+
+static MI_Result _UnpackValue(
     Buf* buf, 
     MI_Value* value,
-    MI_Boolean* exists,
     MI_Type type,
     Batch* batch,
     MI_Boolean copy)
 {
-    /* Get exists flag */
-    MI_RETURN_ERR(Buf_UnpackU8(buf, exists));
-
-    if (!*exists)
-    {
-        memset(value, 0, sizeof(MI_Value));
-        MI_RETURN(MI_RESULT_OK);
-    }
-
-    /* Get value */
     switch (type)
     {
         case MI_UINT8:
@@ -374,6 +304,41 @@ static MI_Result _UnpackField(
     MI_RETURN(MI_RESULT_OK);
 }
 
+/* Returns the name a property is packed with */
+static const ZChar* _PackedName(const MI_PropertyDecl* pd)
+{
+    const ZChar* name = pd->name;
+
+    if ((pd->flags & MI_FLAG_PARAMETER) && (pd->flags & MI_FLAG_OUT))
+    {
+        if (name && name[0] == ZT('M') && Tcscmp(name, ZT("MIReturn"))== 0)
+            name = ZT("ReturnValue");
+    }
+
+    return name;
+}
+
+static MI_Result _UnpackField(
+    Buf* buf, 
+    MI_Value* value,
+    MI_Boolean* exists,
+    MI_Type type,
+    Batch* batch,
+    MI_Boolean copy)
+{
+    /* Get exists flag */
+    MI_RETURN_ERR(Buf_UnpackU8(buf, exists));
+
+    if (!*exists)
+    {
+        memset(value, 0, sizeof(MI_Value));
+        MI_RETURN(MI_RESULT_OK);
+    }
+
+    /* Get value */
+    MI_RETURN(_UnpackValue(buf, value, type, batch, copy));
+}
+
 MI_Result Instance_Pack(
     const MI_Instance* self_,
     MI_Boolean keysOnly,
@@ -445,7 +410,7 @@ MI_Result Instance_Pack(
     {
         const MI_PropertyDecl* pd = cd->properties[i];
         const void* value = (char*)self + pd->offset;
-        MI_Char* pName;
+        const MI_Char* pName;
 
         /* Skip non-key properties (for references) */
         if (keysOnly && (pd->flags & MI_FLAG_KEY) == 0)
@@ -461,12 +426,7 @@ MI_Result Instance_Pack(
         /* Pack the flags */
         MI_RETURN_ERR(Buf_PackU32(buf, pd->flags));
 
-        pName = pd->name;
-        if ((pd->flags & MI_FLAG_PARAMETER) && (pd->flags & MI_FLAG_OUT))
-        {
-            if (pName && pName[0] == ZT('M') && Tcscmp(pName, ZT("MIReturn"))== 0)
-                pName = ZT("ReturnValue");
-        }
+        pName = _PackedName(pd);
 
         /* Pack the propety name */
         MI_RETURN_ERR(Buf_PackStrLen(
@@ -485,31 +445,18 @@ MI_Result Instance_Pack(
     MI_RETURN(MI_RESULT_OK);
 }
 
-MI_Result Instance_Unpack(
+/* Unpacks the rest of an instance packed by Instance_Pack() */
+static MI_Result _UnpackInstance(
     MI_Instance** selfOut,
     Buf* buf,
     Batch* batch,
     MI_Boolean copy)
 {
-    MI_Uint32 magic;
     MI_Uint32 flags;
     const ZChar* className;
     const ZChar* nameSpace = 0;
     MI_Instance* self;
 
-    /* Check parameters */
-    if (!selfOut || !buf)
-        MI_RETURN(MI_RESULT_INVALID_PARAMETER);
-
-    /* Clear output parameter */
-    *selfOut = NULL;
-
-    /* Unpack magic number */
-    MI_RETURN_ERR(Buf_UnpackU32(buf, &magic));
-
-    if (INSTANCE_MAGIC != magic)
-        MI_RETURN(MI_RESULT_FAILED);
-
     /* Unpack flags */
     MI_RETURN_ERR(Buf_UnpackU32(buf, &flags));
 
@@ -587,38 +534,940 @@ MI_Result Instance_Unpack(
     MI_RETURN(MI_RESULT_OK);
 }
 
-MI_Result InstanceToBatch(
-    const MI_Instance* instance,
-    MI_Boolean (*filterProperty)(const ZChar* name, void* data),
-    void* filterPropertyData,
-    Batch* batch,
-    void** ptrOut,
-    MI_Uint32* sizeOut)
+/*
+**==============================================================================
+**
+** Compact encoding
+**
+**     [magic] [flags] [class name] [namespace] [fingerprint] [has schema]
+**     [schema: count, then flags, name and type of each property]
+**     [presence bitmap] [values of the present properties] [end magic]
+**
+**     The integers are encoded as varints (zigzag for signed ones), the
+**     strings as their varint size followed by their characters; the other
+**     types are encoded as by Instance_Pack().
+**
+**==============================================================================
+*/
+
+/* Magic number of the compact encoding */
+#define COMPACT_INSTANCE_MAGIC ((MI_Uint32)0x462b9958)
+
+#define _FNV_OFFSET MI_ULL(0xcbf29ce484222325)
+#define _FNV_PRIME MI_ULL(0x100000001b3)
+
+typedef struct _InstanceSchemaProperty
 {
-    Buf buf;
-    MI_Result r;
-    Page* page;
+    const ZChar* name;
+    MI_Uint32 flags;
+    MI_Uint32 type;
 
-    r = Buf_Init(&buf, 16*1024);
+    /* Index of the property in the class (typed instances) */
+    MI_Uint32 index;
+}
+InstanceSchemaProperty;
 
-    if (MI_RESULT_OK != r)
-        return r;
+typedef struct _InstanceSchema
+{
+    struct _InstanceSchema* next;
+    MI_Uint64 fingerprint;
+    const ZChar* className;
+    MI_Uint32 numProperties;
+    InstanceSchemaProperty* properties;
 
-    r = Instance_Pack(
-        instance, MI_FALSE, filterProperty, filterPropertyData, &buf);
+    /* Class of the unpacked instances (null for dynamic instances) */
+    const MI_ClassDecl* classDecl;
+}
+InstanceSchema;
 
-    if (MI_RESULT_OK != r)
+static MI_Result _PackVarint(Buf* buf, MI_Uint64 x)
+{
+    MI_Uint8 bytes[10];
+    MI_Uint32 n = 0;
+
+    while (x >= 0x80)
     {
-        Buf_Destroy(&buf);
-        return r;
+        bytes[n++] = (MI_Uint8)(x | 0x80);
+        x >>= 7;
     }
 
-    page = Buf_StealPage(&buf);
-    page->u.s.size = buf.size;
+    bytes[n++] = (MI_Uint8)x;
 
-    Batch_AttachPage(batch, page);
+    return Buf_App(buf, bytes, n);
+}
 
-    *ptrOut = page + 1;
-    *sizeOut = (MI_Uint32)page->u.s.size;
+static MI_Result _UnpackVarint(Buf* buf, MI_Uint64* x)
+{
+    const MI_Uint8* data = (const MI_Uint8*)buf->data;
+    MI_Uint32 offset = buf->offset;
+    MI_Uint64 result = 0;
+    MI_Uint32 shift;
+
+    for (shift = 0; shift < 64; shift += 7)
+    {
+        MI_Uint8 byte;
+
+        if (offset >= buf->size)
+            return MI_RESULT_FAILED;
+
+        byte = data[offset++];
+        result |= (MI_Uint64)(byte & 0x7F) << shift;
+
+        if ((byte & 0x80) == 0)
+        {
+            *x = result;
+            buf->offset = offset;
+            return MI_RESULT_OK;
+        }
+    }
+
+    return MI_RESULT_FAILED;
+}
+
+static MI_Result _UnpackVarint32(Buf* buf, MI_Uint32* x)
+{
+    MI_Uint64 value;
+
+    MI_RETURN_ERR(_UnpackVarint(buf, &value));
+
+    if (value > 0xFFFFFFFF)
+        return MI_RESULT_FAILED;
+
+    *x = (MI_Uint32)value;
+    return MI_RESULT_OK;
+}
+
+MI_INLINE MI_Uint64 _ZigZag(MI_Sint64 x)
+{
+    return ((MI_Uint64)x << 1) ^ (MI_Uint64)(x >> 63);
+}
+
+MI_INLINE MI_Sint64 _UnZigZag(MI_Uint64 x)
+{
+    return (MI_Sint64)(x >> 1) ^ -(MI_Sint64)(x & 1);
+}
+
+/* Copies bytes out of the buffer (no alignment) */
+static MI_Result _UnpackBytes(Buf* buf, void* data, MI_Uint32 size)
+{
+    if (size > buf->size - buf->offset)
+        return MI_RESULT_FAILED;
+
+    memcpy(data, (char*)buf->data + buf->offset, size);
+    buf->offset += size;
+    return MI_RESULT_OK;
+}
+
+static MI_Result _PackCompactStr(Buf* buf, const ZChar* str, MI_Uint32 len)
+{
+    if (!str)
+        return _PackVarint(buf, 0);
+
+    MI_RETURN_ERR(_PackVarint(buf, (MI_Uint64)len + 1));
+
+    /* The strings are unpacked in place */
+    if (sizeof(ZChar) == 2)
+    {
+        MI_RETURN_ERR(Buf_Pad16(buf));
+    }
+    else if (sizeof(ZChar) == 4)
+    {
+        MI_RETURN_ERR(Buf_Pad32(buf));
+    }
+
+    return Buf_App(buf, str, (len + 1) * sizeof(ZChar));
+}
+
+static MI_Result _UnpackCompactStr(Buf* buf, const ZChar** str)
+{
+    MI_Uint32 size;
+    const ZChar* data;
+
+    MI_RETURN_ERR(_UnpackVarint32(buf, &size));
+
+    if (size == 0)
+    {
+        *str = NULL;
+        return MI_RESULT_OK;
+    }
+
+    if (sizeof(ZChar) == 2)
+    {
+        MI_RETURN_ERR(Buf_Align16(buf));
+    }
+    else if (sizeof(ZChar) == 4)
+    {
+        MI_RETURN_ERR(Buf_Align32(buf));
+    }
+
+    if (size > (buf->size - buf->offset) / sizeof(ZChar))
+        return MI_RESULT_FAILED;
+
+    data = (const ZChar*)((char*)buf->data + buf->offset);
+
+    if (data[size - 1] != 0)
+        return MI_RESULT_FAILED;
+
+    *str = data;
+    buf->offset += size * sizeof(ZChar);
     return MI_RESULT_OK;
 }
+
+static MI_Result _PackCompactValue(Buf* buf, const MI_Value* value, MI_Type type)
+{
+    switch (type)
+    {
+        case MI_BOOLEAN:
+        case MI_SINT8:
+        case MI_UINT8:
+            return Buf_PackU8(buf, value->uint8);
+        case MI_UINT16:
+        case MI_CHAR16:
+            return _PackVarint(buf, value->uint16);
+        case MI_UINT32:
+            return _PackVarint(buf, value->uint32);
+        case MI_UINT64:
+            return _PackVarint(buf, value->uint64);
+        case MI_SINT16:
+            return _PackVarint(buf, _ZigZag(value->sint16));
+        case MI_SINT32:
+            return _PackVarint(buf, _ZigZag(value->sint32));
+        case MI_SINT64:
+            return _PackVarint(buf, _ZigZag(value->sint64));
+        case MI_REAL32:
+            return Buf_App(buf, &value->real32, sizeof(MI_Real32));
+        case MI_REAL64:
+            return Buf_App(buf, &value->real64, sizeof(MI_Real64));
+        case MI_STRING:
+            return _PackCompactStr(buf, value->string,
+                value->string ? (MI_Uint32)Tcslen(value->string) : 0);
+        default:
+            return _PackValue(buf, value, type);
+    }
+}
+
+static MI_Result _UnpackCompactValue(
+    Buf* buf,
+    MI_Value* value,
+    MI_Type type,
+    Batch* batch,
+    MI_Boolean copy)
+{
+    MI_Uint64 x;
+
+    switch (type)
+    {
+        case MI_BOOLEAN:
+        case MI_SINT8:
+        case MI_UINT8:
+            return Buf_UnpackU8(buf, &value->uint8);
+        case MI_UINT16:
+        case MI_CHAR16:
+            MI_RETURN_ERR(_UnpackVarint(buf, &x));
+            value->uint16 = (MI_Uint16)x;
+            return MI_RESULT_OK;
+        case MI_UINT32:
+            MI_RETURN_ERR(_UnpackVarint(buf, &x));
+            value->uint32 = (MI_Uint32)x;
+            return MI_RESULT_OK;
+        case MI_UINT64:
+            return _UnpackVarint(buf, &value->uint64);
+        case MI_SINT16:
+            MI_RETURN_ERR(_UnpackVarint(buf, &x));
+            value->sint16 = (MI_Sint16)_UnZigZag(x);
+            return MI_RESULT_OK;
+        case MI_SINT32:
+            MI_RETURN_ERR(_UnpackVarint(buf, &x));
+            value->sint32 = (MI_Sint32)_UnZigZag(x);
+            return MI_RESULT_OK;
+        case MI_SINT64:
+            MI_RETURN_ERR(_UnpackVarint(buf, &x));
+            value->sint64 = _UnZigZag(x);
+            return MI_RESULT_OK;
+        case MI_REAL32:
+            return _UnpackBytes(buf, &value->real32, sizeof(MI_Real32));
+        case MI_REAL64:
+            return _UnpackBytes(buf, &value->real64, sizeof(MI_Real64));
+        case MI_STRING:
+            return _UnpackCompactStr(buf, (const ZChar**)&value->string);
+        default:
+            return _UnpackValue(buf, value, type, batch, copy);
+    }
+}
+
+MI_INLINE MI_Uint64 _HashBytes(MI_Uint64 hash, const void* data, size_t size)
+{
+    const MI_Uint8* p = (const MI_Uint8*)data;
+    size_t i;
+
+    for (i = 0; i < size; i++)
+    {
+        hash ^= p[i];
+        hash *= _FNV_PRIME;
+    }
+
+    return hash;
+}
+
+/* Computes the fingerprint of the schema of the packed properties (and
+ * counts them) */
+static MI_Uint64 _Fingerprint(
+    const MI_ClassDecl* cd,
+    MI_Boolean (*filterProperty)(const ZChar* name, void* data),
+    void* filterPropertyData,
+    MI_Uint32* numPropertiesOut)
+{
+    MI_Uint64 hash = _FNV_OFFSET;
+    MI_Uint32 n = 0;
+    MI_Uint32 i;
+
+    hash = _HashBytes(hash, cd->name,
+        (NameLen(cd->name, cd->code) + 1) * sizeof(ZChar));
+
+    for (i = 0; i < cd->numProperties; i++)
+    {
+        const MI_PropertyDecl* pd = cd->properties[i];
+        const ZChar* name;
+
+        if (filterProperty && (*filterProperty)(pd->name, filterPropertyData))
+            continue;
+
+        name = _PackedName(pd);
+        hash = _HashBytes(hash, &pd->flags, sizeof(pd->flags));
+        hash = _HashBytes(hash, &pd->type, sizeof(pd->type));
+        hash = _HashBytes(hash, name,
+            (NameLen(name, pd->code) + 1) * sizeof(ZChar));
+        n++;
+    }
+
+    *numPropertiesOut = n;
+    return hash;
+}
+
+static InstanceSchemaSetEntry* _FindSetEntry(
+    InstanceSchemaSet* self,
+    const MI_ClassDecl* classDecl,
+    MI_Uint64 fingerprint)
+{
+    MI_Uint32 i;
+
+    for (i = 0; i < self->count; i++)
+    {
+        InstanceSchemaSetEntry* entry = &self->entries[i];
+
+        if (classDecl ? entry->classDecl == classDecl :
+            entry->fingerprint == fingerprint)
+        {
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+void InstanceSchemaSet_Commit(
+    InstanceSchemaSet* self)
+{
+    MI_Uint32 i;
+
+    for (i = 0; i < self->count; i++)
+        self->entries[i].sent = MI_TRUE;
+}
+
+static MI_Result _PackCompact(
+    const MI_Instance* self_,
+    MI_Boolean (*filterProperty)(const ZChar* name, void* data),
+    void* filterPropertyData,
+    InstanceSchemaSet* schemas,
+    Buf* buf)
+{
+    Instance* self = Instance_GetSelf( self_ );
+    const MI_ClassDecl* cd;
+    const MI_ClassDecl* staticClassDecl;
+    InstanceSchemaSetEntry* entry = NULL;
+    MI_Uint64 fingerprint;
+    MI_Uint32 numProperties;
+    MI_Boolean packSchema;
+    MI_Uint32 bitmapOffset;
+    MI_Uint32 bitmapSize;
+    MI_Uint32 i;
+    MI_Uint32 n;
+
+    /* Check for null arguments */
+    if (!self || !buf)
+        MI_RETURN(MI_RESULT_INVALID_PARAMETER);
+
+    cd = self->classDecl;
+
+    /* The class of a dynamic instance is its own (and may be reused for an
+     * other schema once the instance is gone) */
+    staticClassDecl = Instance_IsDynamic((MI_Instance*)self_) ? NULL : cd;
+
+    if (schemas && staticClassDecl)
+        entry = _FindSetEntry(schemas, staticClassDecl, 0);
+
+    if (entry)
+    {
+        fingerprint = entry->fingerprint;
+        numProperties = entry->numProperties;
+    }
+    else
+    {
+        fingerprint = _Fingerprint(
+            cd, filterProperty, filterPropertyData, &numProperties);
+
+        if (schemas)
+        {
+            entry = _FindSetEntry(schemas, NULL, fingerprint);
+
+            if (!entry && schemas->count < INSTANCESCHEMASET_SIZE)
+            {
+                entry = &schemas->entries[schemas->count++];
+                entry->classDecl = staticClassDecl;
+                entry->fingerprint = fingerprint;
+                entry->numProperties = numProperties;
+                entry->sent = MI_FALSE;
+            }
+        }
+    }
+
+    packSchema = (entry && entry->sent) ? MI_FALSE : MI_TRUE;
+
+    /* Pack the header */
+    MI_RETURN_ERR(Buf_PackU32(buf, COMPACT_INSTANCE_MAGIC));
+    MI_RETURN_ERR(_PackVarint(buf, cd->flags));
+    MI_RETURN_ERR(_PackCompactStr(buf, cd->name, NameLen(cd->name, cd->code)));
+    MI_RETURN_ERR(_PackCompactStr(buf, self->nameSpace,
+        self->nameSpace ? (MI_Uint32)Tcslen(self->nameSpace) : 0));
+    MI_RETURN_ERR(Buf_App(buf, &fingerprint, sizeof(fingerprint)));
+    MI_RETURN_ERR(Buf_PackU8(buf, packSchema));
+
+    /* Pack the schema */
+    if (packSchema)
+    {
+        MI_RETURN_ERR(_PackVarint(buf, numProperties));
+
+        for (i = 0; i < cd->numProperties; i++)
+        {
+            const MI_PropertyDecl* pd = cd->properties[i];
+            const ZChar* name;
+
+            if (filterProperty &&
+                (*filterProperty)(pd->name, filterPropertyData))
+            {
+                continue;
+            }
+
+            name = _PackedName(pd);
+            MI_RETURN_ERR(_PackVarint(buf, pd->flags));
+            MI_RETURN_ERR(_PackCompactStr(buf, name, NameLen(name, pd->code)));
+            MI_RETURN_ERR(Buf_PackU8(buf, (MI_Uint8)pd->type));
+        }
+    }
+
+    /* Reserve the presence bitmap (filled along with the values) */
+    bitmapOffset = buf->size;
+    bitmapSize = (numProperties + 7) / 8;
+
+    if (bitmapOffset + bitmapSize > buf->capacity)
+    {
+        MI_RETURN_ERR(Buf_Reserve(buf, bitmapOffset + bitmapSize));
+    }
+
+    memset((char*)buf->data + bitmapOffset, 0, bitmapSize);
+    buf->size += bitmapSize;
+
+    /* Pack the values */
+    for (i = 0, n = 0; i < cd->numProperties; i++)
+    {
+        const MI_PropertyDecl* pd = cd->properties[i];
+        const Field* field = (const Field*)((char*)self + pd->offset);
+
+        if (filterProperty &&
+            (*filterProperty)(pd->name, filterPropertyData))
+        {
+            continue;
+        }
+
+        if (n >= numProperties)
+            MI_RETURN(MI_RESULT_FAILED);
+
+        if (Field_GetExists(field, (MI_Type)pd->type))
+        {
+            ((MI_Uint8*)buf->data)[bitmapOffset + n / 8] |=
+                (MI_Uint8)(1 << (n % 8));
+
+            /* (the value of a field comes first) */
+            MI_RETURN_ERR(_PackCompactValue(
+                buf, (const MI_Value*)field, (MI_Type)pd->type));
+        }
+
+        n++;
+    }
+
+    /* Pack ending magic number */
+    MI_RETURN_ERR(Buf_PackU32(buf, _END_MAGIC));
+
+    MI_RETURN(MI_RESULT_OK);
+}
+
+MI_Result Instance_PackCompact(
+    const MI_Instance* self,
+    MI_Boolean (*filterProperty)(const ZChar* name, void* data),
+    void* filterPropertyData,
+    InstanceSchemaSet* schemas,
+    Buf* buf)
+{
+    MI_Uint32 count = schemas ? schemas->count : 0;
+    MI_Result r;
+
+    r = _PackCompact(self, filterProperty, filterPropertyData, schemas, buf);
+
+    /* Forget the schema added for an instance that is not sent (it would be
+     * marked as delivered by the commit of the next instance) */
+    if (r != MI_RESULT_OK && schemas)
+        schemas->count = count;
+
+    return r;
+}
+
+static InstanceSchema* _FindSchema(
+    InstanceSchemaDict* self,
+    MI_Uint64 fingerprint,
+    const ZChar* className)
+{
+    InstanceSchema* p;
+
+    for (p = self->buckets[fingerprint % INSTANCESCHEMADICT_BUCKETS]; p; p = p->next)
+    {
+        if (p->fingerprint == fingerprint && Tcscmp(p->className, className) == 0)
+            return p;
+    }
+
+    return NULL;
+}
+
+/* Finds the class the instances of this schema are unpacked into */
+static const MI_ClassDecl* _BindClassDecl(
+    InstanceSchemaDict* self,
+    InstanceSchema* schema)
+{
+    MI_Uint32 i;
+
+    for (i = 0; i < self->numClassDecls; i++)
+    {
+        const MI_ClassDecl* cd = self->classDecls[i];
+        MI_Uint32 j;
+
+        if (Tcscasecmp(cd->name, schema->className) != 0)
+            continue;
+
+        /* Each property must be a property of the class */
+        for (j = 0; j < schema->numProperties; j++)
+        {
+            InstanceSchemaProperty* p = &schema->properties[j];
+            MI_Uint32 k;
+
+            for (k = 0; k < cd->numProperties; k++)
+            {
+                const MI_PropertyDecl* pd = cd->properties[k];
+
+                if (pd->type == p->type && Tcscasecmp(pd->name, p->name) == 0)
+                    break;
+            }
+
+            if (k == cd->numProperties)
+                return NULL;
+
+            p->index = k;
+        }
+
+        return cd;
+    }
+
+    return NULL;
+}
+
+/* Adds a schema to the dictionary (unless already there) */
+static MI_Result _LearnSchema(
+    InstanceSchemaDict* self,
+    const InstanceSchema* schema,
+    InstanceSchema** schemaOut)
+{
+    InstanceSchema* p = _FindSchema(self, schema->fingerprint, schema->className);
+    MI_Uint32 i;
+
+    if (p)
+    {
+        *schemaOut = p;
+        return MI_RESULT_OK;
+    }
+
+    if (self->numSchemas >= INSTANCESCHEMADICT_MAX_SCHEMAS)
+        return MI_RESULT_FAILED;
+
+    if (!self->batch)
+    {
+        self->batch = Batch_New(BATCH_MAX_PAGES);
+
+        if (!self->batch)
+            return MI_RESULT_FAILED;
+    }
+
+    p = (InstanceSchema*)Batch_GetClear(self->batch, sizeof(InstanceSchema));
+
+    if (!p)
+        return MI_RESULT_FAILED;
+
+    p->fingerprint = schema->fingerprint;
+    p->numProperties = schema->numProperties;
+    p->className = Batch_Tcsdup(self->batch, schema->className);
+
+    if (!p->className)
+        return MI_RESULT_FAILED;
+
+    if (p->numProperties)
+    {
+        p->properties = (InstanceSchemaProperty*)Batch_Get(self->batch,
+            p->numProperties * sizeof(InstanceSchemaProperty));
+
+        if (!p->properties)
+            return MI_RESULT_FAILED;
+
+        for (i = 0; i < p->numProperties; i++)
+        {
+            p->properties[i] = schema->properties[i];
+            p->properties[i].name =
+                Batch_Tcsdup(self->batch, schema->properties[i].name);
+
+            if (!p->properties[i].name)
+                return MI_RESULT_FAILED;
+        }
+    }
+
+    p->classDecl = _BindClassDecl(self, p);
+
+    p->next = self->buckets[p->fingerprint % INSTANCESCHEMADICT_BUCKETS];
+    self->buckets[p->fingerprint % INSTANCESCHEMADICT_BUCKETS] = p;
+    self->numSchemas++;
+
+    *schemaOut = p;
+    return MI_RESULT_OK;
+}
+
+/* Unpacks a schema (the names are left in the buffer) */
+static MI_Result _UnpackSchema(
+    Buf* buf,
+    InstanceSchema* schema)
+{
+    MI_Uint32 i;
+
+    MI_RETURN_ERR(_UnpackVarint32(buf, &schema->numProperties));
+
+    /* (each property takes 3 bytes at least) */
+    if (schema->numProperties > (buf->size - buf->offset) / 3)
+        MI_RETURN(MI_RESULT_FAILED);
+
+    if (!schema->numProperties)
+        MI_RETURN(MI_RESULT_OK);
+
+    schema->properties = (InstanceSchemaProperty*)PAL_Malloc(
+        schema->numProperties * sizeof(InstanceSchemaProperty));
+
+    if (!schema->properties)
+        MI_RETURN(MI_RESULT_FAILED);
+
+    for (i = 0; i < schema->numProperties; i++)
+    {
+        InstanceSchemaProperty* p = &schema->properties[i];
+        MI_Uint8 type;
+
+        MI_RETURN_ERR(_UnpackVarint32(buf, &p->flags));
+        MI_RETURN_ERR(_UnpackCompactStr(buf, &p->name));
+        MI_RETURN_ERR(Buf_UnpackU8(buf, &type));
+
+        if (!p->name || type > MI_INSTANCEA)
+            MI_RETURN(MI_RESULT_FAILED);
+
+        p->type = type;
+        p->index = i;
+    }
+
+    MI_RETURN(MI_RESULT_OK);
+}
+
+/* Unpacks the presence bitmap and the values of a compact instance */
+static MI_Result _UnpackCompactProperties(
+    MI_Instance* self,
+    Buf* buf,
+    Batch* batch,
+    MI_Boolean copy,
+    const InstanceSchema* schema)
+{
+    const MI_Uint8* bitmap;
+    MI_Uint32 bitmapSize = (schema->numProperties + 7) / 8;
+    MI_Uint32 i;
+
+    if (bitmapSize > buf->size - buf->offset)
+        MI_RETURN(MI_RESULT_FAILED);
+
+    bitmap = (const MI_Uint8*)buf->data + buf->offset;
+    buf->offset += bitmapSize;
+
+    for (i = 0; i < schema->numProperties; i++)
+    {
+        const InstanceSchemaProperty* p = &schema->properties[i];
+        MI_Boolean exists = (bitmap[i / 8] >> (i % 8)) & 1;
+        MI_Value value;
+
+        if (exists)
+        {
+            MI_RETURN_ERR(_UnpackCompactValue(buf, &value, (MI_Type)p->type,
+                batch, copy));
+        }
+
+        if (schema->classDecl)
+        {
+            /* Properties of typed instances are null by default */
+            if (exists)
+            {
+                MI_RETURN_ERR(MI_Instance_SetElementAt(self, p->index, &value,
+                    (MI_Type)p->type, copy ? 0 : MI_FLAG_BORROW));
+            }
+        }
+        else
+        {
+            MI_RETURN_ERR(MI_Instance_AddElement(self, p->name,
+                exists ? &value : NULL, (MI_Type)p->type,
+                copy ? p->flags : p->flags | MI_FLAG_BORROW));
+        }
+    }
+
+    /* Check the ending magic number */
+    {
+        MI_Uint32 endMagic;
+        MI_RETURN_ERR(Buf_UnpackU32(buf, &endMagic));
+
+        if (endMagic != _END_MAGIC)
+            MI_RETURN(MI_RESULT_INVALID_PARAMETER);
+    }
+
+    MI_RETURN(MI_RESULT_OK);
+}
+
+/* Unpacks the rest of an instance packed by Instance_PackCompact() */
+static MI_Result _UnpackCompactInstance(
+    MI_Instance** selfOut,
+    Buf* buf,
+    Batch* batch,
+    MI_Boolean copy,
+    InstanceSchemaDict* schemas)
+{
+    MI_Uint32 flags;
+    const ZChar* className;
+    const ZChar* nameSpace;
+    MI_Uint64 fingerprint;
+    MI_Uint8 hasSchema;
+    InstanceSchema packedSchema;
+    InstanceSchema* schema = NULL;
+    MI_Instance* self = NULL;
+    MI_Result result;
+
+    memset(&packedSchema, 0, sizeof(packedSchema));
+
+    MI_RETURN_ERR(_UnpackVarint32(buf, &flags));
+    MI_RETURN_ERR(_UnpackCompactStr(buf, &className));
+    MI_RETURN_ERR(_UnpackCompactStr(buf, &nameSpace));
+    MI_RETURN_ERR(_UnpackBytes(buf, &fingerprint, sizeof(fingerprint)));
+    MI_RETURN_ERR(Buf_UnpackU8(buf, &hasSchema));
+
+    if (!className)
+        MI_RETURN(MI_RESULT_FAILED);
+
+    if (hasSchema)
+    {
+        packedSchema.fingerprint = fingerprint;
+        packedSchema.className = className;
+
+        result = _UnpackSchema(buf, &packedSchema);
+
+        if (result == MI_RESULT_OK && schemas)
+            result = _LearnSchema(schemas, &packedSchema, &schema);
+        else
+            schema = &packedSchema;
+    }
+    else if (schemas)
+    {
+        schema = _FindSchema(schemas, fingerprint, className);
+        result = schema ? MI_RESULT_OK : MI_RESULT_FAILED;
+    }
+    else
+    {
+        result = MI_RESULT_FAILED;
+    }
+
+    if (result != MI_RESULT_OK)
+        goto done;
+
+    /* Create the instance */
+    if (schema->classDecl)
+        result = Instance_New(&self, schema->classDecl, batch);
+    else
+        result = Instance_NewDynamic(&self, className, flags, batch);
+
+    if (result != MI_RESULT_OK)
+        goto done;
+
+    result = MI_Instance_SetNameSpace(self, nameSpace);
+
+    if (result != MI_RESULT_OK)
+        goto done;
+
+    result = _UnpackCompactProperties(self, buf, batch, copy, schema);
+
+    if (result != MI_RESULT_OK)
+        goto done;
+
+    *selfOut = self;
+    self = NULL;
+
+done:
+    if (self)
+        MI_Instance_Delete(self);
+
+    if (packedSchema.properties)
+        PAL_Free(packedSchema.properties);
+
+    MI_RETURN(result);
+}
+
+void InstanceSchemaDict_Destroy(
+    InstanceSchemaDict* self)
+{
+    if (self->batch)
+        Batch_Delete(self->batch);
+
+    memset(self, 0, sizeof(InstanceSchemaDict));
+}
+
+MI_Result InstanceSchemaDict_AddClassDecl(
+    InstanceSchemaDict* self,
+    const MI_ClassDecl* classDecl)
+{
+    if (!self || !classDecl)
+        MI_RETURN(MI_RESULT_INVALID_PARAMETER);
+
+    if (self->numClassDecls == INSTANCESCHEMADICT_MAX_CLASSDECLS)
+        MI_RETURN(MI_RESULT_FAILED);
+
+    self->classDecls[self->numClassDecls++] = classDecl;
+    MI_RETURN(MI_RESULT_OK);
+}
+
+MI_Result Instance_UnpackWithSchemas(
+    MI_Instance** selfOut,
+    Buf* buf,
+    Batch* batch,
+    MI_Boolean copy,
+    InstanceSchemaDict* schemas)
+{
+    MI_Uint32 magic;
+
+    /* Check parameters */
+    if (!selfOut || !buf)
+        MI_RETURN(MI_RESULT_INVALID_PARAMETER);
+
+    /* Clear output parameter */
+    *selfOut = NULL;
+
+    /* Unpack magic number */
+    MI_RETURN_ERR(Buf_UnpackU32(buf, &magic));
+
+    if (INSTANCE_MAGIC == magic)
+        MI_RETURN(_UnpackInstance(selfOut, buf, batch, copy));
+
+    if (COMPACT_INSTANCE_MAGIC == magic)
+        MI_RETURN(_UnpackCompactInstance(selfOut, buf, batch, copy, schemas));
+
+    MI_RETURN(MI_RESULT_FAILED);
+}
+
+MI_Result Instance_Unpack(
+    MI_Instance** selfOut,
+    Buf* buf,
+    Batch* batch,
+    MI_Boolean copy)
+{
+    return Instance_UnpackWithSchemas(selfOut, buf, batch, copy, NULL);
+}
+
+static MI_Result _InstanceToBatch(
+    const MI_Instance* instance,
+    MI_Boolean (*filterProperty)(const ZChar* name, void* data),
+    void* filterPropertyData,
+    MI_Boolean compact,
+    InstanceSchemaSet* schemas,
+    Batch* batch,
+    void** ptrOut,
+    MI_Uint32* sizeOut)
+{
+    Buf buf;
+    MI_Result r;
+    Page* page;
+
+    r = Buf_Init(&buf, 16*1024);
+
+    if (MI_RESULT_OK != r)
+        return r;
+
+    if (compact)
+    {
+        r = Instance_PackCompact(
+            instance, filterProperty, filterPropertyData, schemas, &buf);
+    }
+    else
+    {
+        r = Instance_Pack(
+            instance, MI_FALSE, filterProperty, filterPropertyData, &buf);
+    }
+
+    if (MI_RESULT_OK != r)
+    {
+        Buf_Destroy(&buf);
+        return r;
+    }
+
+    page = Buf_StealPage(&buf);
+    page->u.s.size = buf.size;
+
+    Batch_AttachPage(batch, page);
+
+    *ptrOut = page + 1;
+    *sizeOut = (MI_Uint32)page->u.s.size;
+    return MI_RESULT_OK;
+}
+
+MI_Result InstanceToBatch(
+    const MI_Instance* instance,
+    MI_Boolean (*filterProperty)(const ZChar* name, void* data),
+    void* filterPropertyData,
+    Batch* batch,
+    void** ptrOut,
+    MI_Uint32* sizeOut)
+{
+    return _InstanceToBatch(instance, filterProperty, filterPropertyData,
+        MI_FALSE, NULL, batch, ptrOut, sizeOut);
+}
+
+MI_Result InstanceToBatchCompact(
+    const MI_Instance* instance,
+    MI_Boolean (*filterProperty)(const ZChar* name, void* data),
+    void* filterPropertyData,
+    InstanceSchemaSet* schemas,
+    Batch* batch,
+    void** ptrOut,
+    MI_Uint32* sizeOut)
+{
+    return _InstanceToBatch(instance, filterProperty, filterPropertyData,
+        MI_TRUE, schemas, batch, ptrOut, sizeOut);
+}
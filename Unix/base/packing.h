@@ -88,6 +88,140 @@ MI_Result InstanceToBatch(
     void** ptrOut,
     MI_Uint32* sizeOut);
 
+/*
+**==============================================================================
+**
+** Compact instance encoding
+**
+**     Instance_PackCompact() writes instances in a more compact format than
+**     Instance_Pack(): the properties are addressed by their position in a
+**     schema (their names, types and flags), followed by a presence bitmap
+**     and the values, the integers being encoded as varints.
+**
+**     The schema is identified by a fingerprint; it is sent with the first
+**     instance of its kind only and the following instances just refer to
+**     it. The sender keeps track of the schemas sent in an InstanceSchemaSet
+**     and the receiver learns them into an InstanceSchemaDict, which must see
+**     the instances in the order they were packed in.
+**
+**     Instance_Unpack() accepts both formats.
+**
+**==============================================================================
+*/
+
+#define INSTANCESCHEMASET_SIZE 16
+
+typedef struct _InstanceSchemaSetEntry
+{
+    /* Class of the instances (only for non-dynamic instances) */
+    const MI_ClassDecl* classDecl;
+    MI_Uint64 fingerprint;
+    MI_Uint32 numProperties;
+
+    /* Whether an instance carrying the schema was delivered */
+    MI_Boolean sent;
+}
+InstanceSchemaSetEntry;
+
+/* Schemas sent to a receiver (zero-initialized); schemas past the capacity
+ * of the set are sent with each instance */
+typedef struct _InstanceSchemaSet
+{
+    InstanceSchemaSetEntry entries[INSTANCESCHEMASET_SIZE];
+    MI_Uint32 count;
+}
+InstanceSchemaSet;
+
+/* Marks the schemas packed so far as delivered; to be called once the
+ * instances carrying them were sent */
+void InstanceSchemaSet_Commit(
+    InstanceSchemaSet* self);
+
+#define INSTANCESCHEMADICT_BUCKETS 64
+#define INSTANCESCHEMADICT_MAX_SCHEMAS 4096
+#define INSTANCESCHEMADICT_MAX_CLASSDECLS 16
+
+struct _InstanceSchema;
+
+/* Schemas learned by a receiver (zero-initialized) */
+typedef struct _InstanceSchemaDict
+{
+    /* Memory of the schemas (created on first use) */
+    Batch* batch;
+    struct _InstanceSchema* buckets[INSTANCESCHEMADICT_BUCKETS];
+    MI_Uint32 numSchemas;
+
+    /* Classes the instances are unpacked into (as typed instances) */
+    const MI_ClassDecl* classDecls[INSTANCESCHEMADICT_MAX_CLASSDECLS];
+    MI_Uint32 numClassDecls;
+}
+InstanceSchemaDict;
+
+void InstanceSchemaDict_Destroy(
+    InstanceSchemaDict* self);
+
+/* Unpacks the compact instances of this class into typed instances (as long
+ * as their properties are properties of the class); only affects the
+ * schemas learned afterwards. The binary protocol does not register any
+ * class, so the instances it receives are unpacked as dynamic ones */
+MI_Result InstanceSchemaDict_AddClassDecl(
+    InstanceSchemaDict* self,
+    const MI_ClassDecl* classDecl);
+
+/*
+**==============================================================================
+**
+** Instance_PackCompact()
+**
+**     Serializes an instance into a buffer (compact encoding).
+**
+** Parameters:
+**     self - the instance to be serialized.
+**     filterProperty - if non-null, the properties to leave out.
+**     schemas - if non-null, the schemas already sent (the schema is only
+**         packed when not there, and is then added to it unless packing
+**         fails).
+**     buf - the buffer to put instance into.
+**
+** Returns:
+**     MI_RESULT_OK on success.
+**
+**==============================================================================
+*/
+MI_Result Instance_PackCompact(
+    const MI_Instance* self,
+    MI_Boolean (*filterProperty)(const ZChar* name, void* data),
+    void* filterPropertyData,
+    InstanceSchemaSet* schemas,
+    Buf* buf);
+
+/*
+**==============================================================================
+**
+** Instance_UnpackWithSchemas()
+**
+**     Same as Instance_Unpack(), resolving the schemas of compact instances
+**     from (and adding the schemas they carry to) 'schemas'.
+**
+**==============================================================================
+*/
+MI_Result Instance_UnpackWithSchemas(
+    MI_Instance** self,
+    Buf* buf,
+    Batch* batch,
+    MI_Boolean copy,
+    InstanceSchemaDict* schemas);
+
+/* Same as InstanceToBatch(), with the compact encoding */
+MI_Result InstanceToBatchCompact(
+    const MI_Instance* instance,
+    MI_Boolean (*filterProperty)(const ZChar* name, void* data),
+    void* filterPropertyData,
+    InstanceSchemaSet* schemas,
+    Batch* batch,
+    void** ptrOut,
+    MI_Uint32* sizeOut);
+
 END_EXTERNC
 
 #endif /* _base_packing_h */
@@ -0,0 +1,425 @@
+/*
+**==============================================================================
+**
+** Copyright (c) Microsoft Corporation. All rights reserved. See file LICENSE
+** for license information.
+**
+**==============================================================================
+*/
+
+#include "propertyindex.h"
+#include "naming.h"
+#include <pal/strings.h>
+#include <pal/memory.h>
+#include <pal/lock.h>
+#include <pal/atomic.h>
+
+/* Smallest number of slots in an index */
+#define _MIN_SLOTS 32
+
+/* Number of slots needed for 'n' properties (load factor at most 1/2) */
+static MI_Uint32 _NumSlots(MI_Uint32 n)
+{
+    MI_Uint32 r = _MIN_SLOTS;
+
+    while (r < 2 * n)
+        r <<= 1;
+
+    return r;
+}
+
+static void _Insert(
+    PropertyIndex* self,
+    MI_Uint32 hash,
+    MI_Uint32 pos)
+{
+    MI_Uint32 i = hash & self->mask;
+
+    while (self->slots[i].pos)
+        i = (i + 1) & self->mask;
+
+    self->slots[i].hash = hash;
+    self->slots[i].pos = pos + 1;
+}
+
+MI_Uint32 PropertyIndex_Hash(
+    _In_z_ const ZChar* name)
+{
+    /* FNV-1a over lower-cased characters (see Hash() in naming.h) */
+    MI_Uint32 h = 2166136261U;
+
+    while (*name)
+    {
+        h ^= ToLower((MI_Uint8)*name++);
+        h *= 16777619U;
+    }
+
+    return h;
+}
+
+MI_Uint32 PropertyIndex_SeededHash(
+    _In_z_ const ZChar* name,
+    MI_Uint32 seed)
+{
+    /* Same as above but mix the seed in and fold the high bits down, since
+     * tables are indexed by the low bits only. Generated code depends on
+     * this function so it must never change. */
+    MI_Uint32 h = 2166136261U ^ (seed * 2654435761U);
+
+    while (*name)
+    {
+        h ^= ToLower((MI_Uint8)*name++);
+        h *= 16777619U;
+    }
+
+    return h ^ (h >> 16);
+}
+
+PropertyIndex* PropertyIndex_New(
+    _In_ const MI_ClassDecl* classDecl,
+    MI_Uint32 capacity,
+    _In_opt_ Batch* batch)
+{
+    PropertyIndex* self;
+    MI_Uint32 numSlots;
+    size_t size;
+    MI_Uint32 i;
+
+    if (capacity < classDecl->numProperties)
+        capacity = classDecl->numProperties;
+
+    numSlots = _NumSlots(capacity);
+    size = sizeof(PropertyIndex) + (numSlots - 1) * sizeof(PropertyIndexSlot);
+
+    if (batch)
+        self = (PropertyIndex*)Batch_GetClear(batch, size);
+    else
+        self = (PropertyIndex*)PAL_Calloc(1, size);
+
+    if (!self)
+        return NULL;
+
+    self->mask = numSlots - 1;
+
+    for (i = 0; i < classDecl->numProperties; i++)
+    {
+        _Insert(self, PropertyIndex_Hash(classDecl->properties[i]->name), i);
+    }
+
+    self->numProperties = classDecl->numProperties;
+    return self;
+}
+
+void PropertyIndex_Delete(
+    _In_ PropertyIndex* self)
+{
+    PAL_Free(self);
+}
+
+MI_Boolean PropertyIndex_Add(
+    _Inout_ PropertyIndex* self,
+    _In_z_ const ZChar* name)
+{
+    if (2 * (self->numProperties + 1) > self->mask + 1)
+        return MI_FALSE;
+
+    _Insert(self, PropertyIndex_Hash(name), self->numProperties);
+    self->numProperties++;
+    return MI_TRUE;
+}
+
+MI_Uint32 PropertyIndex_Find(
+    _In_ const PropertyIndex* self,
+    _In_ const MI_ClassDecl* classDecl,
+    _In_z_ const ZChar* name)
+{
+    MI_Uint32 hash = PropertyIndex_Hash(name);
+    MI_Uint32 i = hash & self->mask;
+
+    while (self->slots[i].pos)
+    {
+        if (self->slots[i].hash == hash)
+        {
+            MI_Uint32 pos = self->slots[i].pos - 1;
+
+            if (Tcscasecmp(classDecl->properties[pos]->name, name) == 0)
+                return pos;
+        }
+
+        i = (i + 1) & self->mask;
+    }
+
+    return (MI_Uint32)-1;
+}
+
+/* Number of seeds PropertyIndex_MakePerfectHash() tries for each table size */
+#define _MAX_SEEDS 4096
+
+MI_Boolean PropertyIndex_MakePerfectHash(
+    _In_ const MI_ClassDecl* classDecl,
+    MI_Uint32 numSlots,
+    _Out_ MI_Uint32* seed,
+    _Out_writes_(numSlots) MI_Uint16* slots)
+{
+    MI_Uint32 mask = numSlots - 1;
+    MI_Uint32 s;
+    MI_Uint32 i;
+
+    if (classDecl->numProperties > 0xFFFE || numSlots < classDecl->numProperties)
+        return MI_FALSE;
+
+    for (s = 0; s < _MAX_SEEDS; s++)
+    {
+        memset(slots, 0, numSlots * sizeof(MI_Uint16));
+
+        for (i = 0; i < classDecl->numProperties; i++)
+        {
+            MI_Uint32 j = PropertyIndex_SeededHash(
+                classDecl->properties[i]->name, s) & mask;
+
+            if (slots[j])
+                break;
+
+            slots[j] = (MI_Uint16)(i + 1);
+        }
+
+        if (i == classDecl->numProperties)
+        {
+            *seed = s;
+            return MI_TRUE;
+        }
+    }
+
+    return MI_FALSE;
+}
+
+MI_Uint32 PropertyIndex_FindExtension(
+    _In_ const OMI_ClassDeclExtension* ext,
+    _In_ const MI_ClassDecl* classDecl,
+    _In_z_ const ZChar* name)
+{
+    MI_Uint32 pos = ext->slots[PropertyIndex_SeededHash(name, ext->seed) & ext->mask];
+
+    if (pos && Tcscasecmp(classDecl->properties[pos - 1]->name, name) == 0)
+        return pos - 1;
+
+    return (MI_Uint32)-1;
+}
+
+/*
+**==============================================================================
+**
+** Registered extensions
+**
+**     The extensions of the loaded provider libraries are kept in an open
+**     addressing table keyed by the address of their class declaration.
+**     Lookups do not lock: the table is published with Atomic_Swap() and
+**     its slots are only ever filled (extension first, then key) or marked
+**     as removed, so a reader sees either the old or the new state of a
+**     slot. Libraries are loaded and unloaded under s_extLock.
+**
+**     A table is replaced (with a larger one or to drop the removed slots)
+**     only when it is three quarters full. Readers may still walk the old
+**     one, so it is not freed but kept on the 'retired' list of its
+**     successor; a table at least twice as large must be filled before this
+**     happens again. The tables are freed by PropertyIndex_DeleteExtensions()
+**     once no lookup can run any more.
+**
+**==============================================================================
+*/
+
+/* Key of a slot whose extension was unregistered */
+#define _EXTENSION_REMOVED ((ptrdiff_t)1)
+
+typedef struct _ExtensionSlot
+{
+    /* Address of the class declaration (zero if empty) */
+    volatile ptrdiff_t classDecl;
+    const OMI_ClassDeclExtension* ext;
+}
+ExtensionSlot;
+
+typedef struct _ExtensionTable
+{
+    /* Replaced table (see above) */
+    struct _ExtensionTable* retired;
+
+    /* Number of slots minus one (number of slots is a power of two) */
+    MI_Uint32 mask;
+
+    /* Number of non-empty slots (including removed ones) */
+    MI_Uint32 used;
+
+    /* Slots (extends beyond end of structure) */
+    ExtensionSlot slots[1];
+}
+ExtensionTable;
+
+static Lock s_extLock = LOCK_INITIALIZER;
+static ExtensionTable* volatile s_extTable;
+static MI_Uint32 s_extCount;
+
+static MI_Uint32 _HashClassDecl(const MI_ClassDecl* classDecl)
+{
+    size_t x = (size_t)classDecl >> 3;
+    return (MI_Uint32)x * 2654435761U;
+}
+
+/* Fill the first empty or removed slot of the chain of ext->classDecl */
+static void _InsertExtension(
+    ExtensionTable* table,
+    const OMI_ClassDeclExtension* ext)
+{
+    MI_Uint32 i = _HashClassDecl(ext->classDecl) & table->mask;
+
+    while (table->slots[i].classDecl &&
+        table->slots[i].classDecl != _EXTENSION_REMOVED)
+    {
+        i = (i + 1) & table->mask;
+    }
+
+    if (!table->slots[i].classDecl)
+        table->used++;
+
+    table->slots[i].ext = ext;
+    Atomic_Swap(&table->slots[i].classDecl, (ptrdiff_t)ext->classDecl);
+}
+
+/* Make room for 'count' more extensions (s_extLock is held) */
+static MI_Result _ReserveExtensions(MI_Uint32 count)
+{
+    ExtensionTable* table = s_extTable;
+    ExtensionTable* newTable;
+    MI_Uint32 numSlots;
+    MI_Uint32 i;
+
+    if (table && 4 * (table->used + count) <= 3 * (table->mask + 1))
+        return MI_RESULT_OK;
+
+    numSlots = _NumSlots(s_extCount + count);
+
+    if (table && numSlots <= table->mask + 1)
+        numSlots = 2 * (table->mask + 1);
+
+    newTable = (ExtensionTable*)PAL_Calloc(1,
+        sizeof(ExtensionTable) + (numSlots - 1) * sizeof(ExtensionSlot));
+
+    if (!newTable)
+        return MI_RESULT_SERVER_LIMITS_EXCEEDED;
+
+    newTable->mask = numSlots - 1;
+    newTable->retired = table;
+
+    for (i = 0; table && i <= table->mask; i++)
+    {
+        if (table->slots[i].classDecl &&
+            table->slots[i].classDecl != _EXTENSION_REMOVED)
+        {
+            _InsertExtension(newTable, table->slots[i].ext);
+        }
+    }
+
+    Atomic_Swap((volatile ptrdiff_t*)&s_extTable, (ptrdiff_t)newTable);
+    return MI_RESULT_OK;
+}
+
+MI_Result PropertyIndex_RegisterExtensions(
+    _In_ OMI_ClassDeclExtension MI_CONST* MI_CONST* exts)
+{
+    OMI_ClassDeclExtension MI_CONST* MI_CONST* p;
+    MI_Uint32 count = 0;
+    MI_Result r;
+
+    for (p = exts; *p; p++)
+        count++;
+
+    Lock_Acquire(&s_extLock);
+
+    r = _ReserveExtensions(count);
+
+    if (r == MI_RESULT_OK)
+    {
+        for (p = exts; *p; p++)
+            _InsertExtension(s_extTable, *p);
+
+        s_extCount += count;
+    }
+
+    Lock_Release(&s_extLock);
+    return r;
+}
+
+void PropertyIndex_UnregisterExtensions(
+    _In_ OMI_ClassDeclExtension MI_CONST* MI_CONST* exts)
+{
+    OMI_ClassDeclExtension MI_CONST* MI_CONST* p;
+    ExtensionTable* table;
+
+    Lock_Acquire(&s_extLock);
+
+    table = s_extTable;
+
+    for (p = exts; table && *p; p++)
+    {
+        MI_Uint32 i = _HashClassDecl((*p)->classDecl) & table->mask;
+
+        while (table->slots[i].classDecl)
+        {
+            if (table->slots[i].classDecl == (ptrdiff_t)(*p)->classDecl &&
+                table->slots[i].ext == *p)
+            {
+                Atomic_Swap(&table->slots[i].classDecl, _EXTENSION_REMOVED);
+                s_extCount--;
+                break;
+            }
+
+            i = (i + 1) & table->mask;
+        }
+    }
+
+    Lock_Release(&s_extLock);
+}
+
+void PropertyIndex_DeleteExtensions(void)
+{
+    ExtensionTable* table = NULL;
+
+    Lock_Acquire(&s_extLock);
+
+    if (s_extCount == 0)
+        table = (ExtensionTable*)Atomic_Swap((volatile ptrdiff_t*)&s_extTable, 0);
+
+    Lock_Release(&s_extLock);
+
+    while (table)
+    {
+        ExtensionTable* retired = table->retired;
+        PAL_Free(table);
+        table = retired;
+    }
+}
+
+const OMI_ClassDeclExtension* PropertyIndex_GetExtension(
+    _In_ const MI_ClassDecl* classDecl)
+{
+    /* Dependent loads through the published table (see Once_Invoke) */
+    const ExtensionTable* table = s_extTable;
+    MI_Uint32 i;
+    ptrdiff_t key;
+
+    /* Only static class declarations are registered */
+    if (!table || classDecl->owningClass)
+        return NULL;
+
+    i = _HashClassDecl(classDecl) & table->mask;
+
+    while ((key = table->slots[i].classDecl) != 0)
+    {
+        if (key == (ptrdiff_t)classDecl)
+            return table->slots[i].ext;
+
+        i = (i + 1) & table->mask;
+    }
+
+    return NULL;
+}
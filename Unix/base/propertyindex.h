@@ -0,0 +1,175 @@
+/*
+**==============================================================================
+**
+** Copyright (c) Microsoft Corporation. All rights reserved. See file LICENSE
+** for license information.
+**
+**==============================================================================
+*/
+
+#ifndef _omi_propertyindex_h
+#define _omi_propertyindex_h
+
+#include "config.h"
+#include <common.h>
+#include "batch.h"
+
+BEGIN_EXTERNC
+
+/*
+**==============================================================================
+**
+** PropertyIndex
+**
+**     Open-addressing hash table that maps property names to their position
+**     in MI_ClassDecl.properties. Classes with fewer than
+**     PROPERTYINDEX_MIN_PROPERTIES properties are not indexed since a linear
+**     scan over MI_PropertyDecl.code is faster for them.
+**
+**     An index covers the first 'numProperties' properties of the class
+**     declaration it was built from. Callers must fall back to a linear scan
+**     when the class declaration has a different number of properties.
+**
+**     Static class declarations emitted by the generator may instead have
+**     a precomputed perfect hash (see OMI_ClassDeclExtension below), kept
+**     in a table keyed by the class declaration once registered.
+**
+**==============================================================================
+*/
+
+#define PROPERTYINDEX_MIN_PROPERTIES 16
+
+/*
+**==============================================================================
+**
+** struct OMI_ClassDeclExtension
+**
+**     Optional run-time type information emitted by the generator for static
+**     class declarations. It is not reachable from MI_ClassDecl: schema.c
+**     exports a NULL terminated array of pointers to these structures named
+**     OMI_ClassDeclExtensions, which the provider manager registers when it
+**     loads the provider library.
+**
+**     The 'slots' array is a perfect hash of the property names: the slot of
+**     a property is obtained by hashing its name with 'seed' (see
+**     PropertyIndex_SeededHash) and masking the result with 'mask'. Each slot
+**     holds the position of the property plus one (or zero for empty slots).
+**
+**     This is not part of MI.h: the generator emits the same definition
+**     (under the same guard) into schema.c, so this layout must not change.
+**
+**==============================================================================
+*/
+
+#ifndef OMI_CLASSDECLEXTENSION_DEFINED
+#define OMI_CLASSDECLEXTENSION_DEFINED
+
+typedef struct _OMI_ClassDeclExtension
+{
+    /* The class declaration this extension belongs to */
+    MI_ClassDecl MI_CONST* classDecl;
+
+    /* Perfect hash of property names */
+    MI_Uint32 seed;
+    MI_Uint32 mask;
+    MI_Uint16 MI_CONST* slots;
+}
+OMI_ClassDeclExtension;
+
+#endif /* OMI_CLASSDECLEXTENSION_DEFINED */
+
+typedef struct _PropertyIndexSlot
+{
+    /* PropertyIndex_Hash() of the property name */
+    MI_Uint32 hash;
+
+    /* Position of the property plus one (zero marks an empty slot) */
+    MI_Uint32 pos;
+}
+PropertyIndexSlot;
+
+typedef struct _PropertyIndex
+{
+    /* Number of properties in this index */
+    MI_Uint32 numProperties;
+
+    /* Number of slots minus one (number of slots is a power of two) */
+    MI_Uint32 mask;
+
+    /* Slots (extends beyond end of structure) */
+    PropertyIndexSlot slots[1];
+}
+PropertyIndex;
+
+/* Case-insensitive hash of a property name */
+MI_Uint32 PropertyIndex_Hash(
+    _In_z_ const ZChar* name);
+
+/* Case-insensitive hash of a property name used by the perfect hash tables of
+ * OMI_ClassDeclExtension (shared with the generator) */
+MI_Uint32 PropertyIndex_SeededHash(
+    _In_z_ const ZChar* name,
+    MI_Uint32 seed);
+
+/* Build an index for the given class declaration. The index is allocated
+ * from 'batch' or with PAL_Malloc() if 'batch' is null. Room is reserved
+ * for at least 'capacity' properties. */
+PropertyIndex* PropertyIndex_New(
+    _In_ const MI_ClassDecl* classDecl,
+    MI_Uint32 capacity,
+    _In_opt_ Batch* batch);
+
+/* Release an index allocated with PAL_Malloc() */
+void PropertyIndex_Delete(
+    _In_ PropertyIndex* self);
+
+/* Append the property at position self->numProperties. Returns MI_FALSE if
+ * the index is too full, in which case the caller should rebuild it. */
+MI_Boolean PropertyIndex_Add(
+    _Inout_ PropertyIndex* self,
+    _In_z_ const ZChar* name);
+
+/* Return position of the named property or (MI_Uint32)-1 if not found */
+MI_Uint32 PropertyIndex_Find(
+    _In_ const PropertyIndex* self,
+    _In_ const MI_ClassDecl* classDecl,
+    _In_z_ const ZChar* name);
+
+/* Search for a seed that maps the property names of the given class onto
+ * distinct slots of a table with 'numSlots' entries (a power of two). On
+ * success, 'slots' holds property positions plus one and zero elsewhere. */
+MI_Boolean PropertyIndex_MakePerfectHash(
+    _In_ const MI_ClassDecl* classDecl,
+    MI_Uint32 numSlots,
+    _Out_ MI_Uint32* seed,
+    _Out_writes_(numSlots) MI_Uint16* slots);
+
+/* Register the generator-emitted extensions of a provider library, a NULL
+ * terminated array (see OMI_ClassDeclExtension). The array must stay valid
+ * until it is unregistered. Lookups do not lock (see propertyindex.c). */
+MI_Result PropertyIndex_RegisterExtensions(
+    _In_ OMI_ClassDeclExtension MI_CONST* MI_CONST* exts);
+
+/* Unregister an array given to PropertyIndex_RegisterExtensions(), before
+ * the library holding it is unloaded */
+void PropertyIndex_UnregisterExtensions(
+    _In_ OMI_ClassDeclExtension MI_CONST* MI_CONST* exts);
+
+/* Free the registration tables once every array is unregistered and no
+ * lookup can run any more (when the provider manager is destroyed) */
+void PropertyIndex_DeleteExtensions(void);
+
+/* Return the registered extension of a static class declaration or NULL if
+ * the class declaration does not have one */
+const OMI_ClassDeclExtension* PropertyIndex_GetExtension(
+    _In_ const MI_ClassDecl* classDecl);
+
+/* Return position of the named property or (MI_Uint32)-1 if not found */
+MI_Uint32 PropertyIndex_FindExtension(
+    _In_ const OMI_ClassDeclExtension* ext,
+    _In_ const MI_ClassDecl* classDecl,
+    _In_z_ const ZChar* name);
+
+END_EXTERNC
+
+#endif /* _omi_propertyindex_h */
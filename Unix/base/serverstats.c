@@ -0,0 +1,455 @@
+/*
+**==============================================================================
+**
+** Copyright (c) Microsoft Corporation. All rights reserved. See file LICENSE
+** for license information.
+**
+**==============================================================================
+*/
+
+#include "serverstats.h"
+#include "messages.h"
+#include <pal/atomic.h>
+#include <pal/cpu.h>
+#include <pal/lock.h>
+#include <pal/sleep.h>
+#include <pal/strings.h>
+
+#define CACHE_LINE_SIZE 128
+
+/* Number of stripes (power of two; CPUs beyond share the stripes) */
+#define STRIPES 16
+
+#define ALIGN(x, size) (((x) + (size) - 1) & -(size))
+
+typedef struct _Stripe
+{
+    ptrdiff_t requests[SERVERSTATS_OP_COUNT];
+    ptrdiff_t latencyUsec[SERVERSTATS_OP_COUNT];
+    ptrdiff_t latency[SERVERSTATS_OP_COUNT][SERVERSTATS_LATENCY_BUCKETS];
+    ptrdiff_t gauges[SERVERSTATS_GAUGE_COUNT];
+    ptrdiff_t counters[SERVERSTATS_COUNTER_COUNT];
+}
+Stripe;
+
+/* Each stripe starts on its own cache line */
+#define STRIPE_SIZE ALIGN(sizeof(Stripe), CACHE_LINE_SIZE)
+
+/* The buffer contains an extra cache line for manual alignment */
+static char s_stripes[STRIPE_SIZE * STRIPES + CACHE_LINE_SIZE];
+
+static ptrdiff_t s_selectorLagUsec;
+static ptrdiff_t s_selectorMaxLagUsec;
+
+static Lock s_agentUsersLock = LOCK_INITIALIZER;
+static ServerStatsAgentUser s_agentUsers[SERVERSTATS_MAX_AGENT_USERS];
+static MI_Uint32 s_numAgentUsers;
+
+typedef struct _TraceSlot
+{
+    /* Hash of the class name and operation (see _HashTraceKey()) */
+    MI_Uint32 hash;
+    ServerStatsTraceEntry entry;
+}
+TraceSlot;
+
+/* The traces are only aggregated once the requests complete, so a lock is
+ * enough here */
+static Lock s_tracesLock = LOCK_INITIALIZER;
+static TraceSlot s_traces[SERVERSTATS_MAX_TRACE_ENTRIES];
+static MI_Uint32 s_numTraces;
+
+static const ZChar* s_stageNames[SERVERSTATS_STAGE_COUNT] =
+{
+    PAL_T("Parse"),
+    PAL_T("Dispatch"),
+    PAL_T("AgentSend"),
+    PAL_T("ProviderCall"),
+    PAL_T("FirstInstance"),
+    PAL_T("Result"),
+    PAL_T("Serialize"),
+    PAL_T("Write"),
+};
+
+static const ZChar* s_operationNames[SERVERSTATS_OP_COUNT] =
+{
+    PAL_T("GetInstance"),
+    PAL_T("EnumerateInstances"),
+    PAL_T("Associators"),
+    PAL_T("References"),
+    PAL_T("Invoke"),
+    PAL_T("CreateInstance"),
+    PAL_T("ModifyInstance"),
+    PAL_T("DeleteInstance"),
+    PAL_T("Subscribe"),
+    PAL_T("GetClass"),
+    PAL_T("Other"),
+};
+
+static Stripe* _GetStripe(
+    int index)
+{
+    ptrdiff_t buffer = ALIGN((ptrdiff_t)s_stripes, CACHE_LINE_SIZE);
+
+    return (Stripe*)(buffer + STRIPE_SIZE * index);
+}
+
+MI_INLINE Stripe* _CurrentStripe()
+{
+    return _GetStripe(CPU_GetCurrent() & (STRIPES - 1));
+}
+
+static int _GetLatencyBucket(
+    MI_Uint64 usec)
+{
+    int bucket = 0;
+
+    usec /= SERVERSTATS_LATENCY_BASE_USEC;
+
+    while (usec && bucket < SERVERSTATS_LATENCY_BUCKETS - 1)
+    {
+        usec >>= 1;
+        bucket++;
+    }
+
+    return bucket;
+}
+
+ServerStatsOperation ServerStats_GetOperation(
+    MI_Uint32 tag)
+{
+    switch (tag)
+    {
+        case GetInstanceReqTag:
+            return SERVERSTATS_OP_GETINSTANCE;
+        case EnumerateInstancesReqTag:
+            return SERVERSTATS_OP_ENUMERATEINSTANCES;
+        case AssociatorsOfReqTag:
+            return SERVERSTATS_OP_ASSOCIATORS;
+        case ReferencesOfReqTag:
+            return SERVERSTATS_OP_REFERENCES;
+        case InvokeReqTag:
+            return SERVERSTATS_OP_INVOKE;
+        case CreateInstanceReqTag:
+            return SERVERSTATS_OP_CREATEINSTANCE;
+        case ModifyInstanceReqTag:
+            return SERVERSTATS_OP_MODIFYINSTANCE;
+        case DeleteInstanceReqTag:
+            return SERVERSTATS_OP_DELETEINSTANCE;
+        case SubscribeReqTag:
+            return SERVERSTATS_OP_SUBSCRIBE;
+        case GetClassReqTag:
+            return SERVERSTATS_OP_GETCLASS;
+        default:
+            return SERVERSTATS_OP_OTHER;
+    }
+}
+
+const ZChar* ServerStats_GetOperationName(
+    ServerStatsOperation op)
+{
+    if ((unsigned int)op >= SERVERSTATS_OP_COUNT)
+        return NULL;
+
+    return s_operationNames[op];
+}
+
+MI_Uint64 ServerStats_BeginRequest(
+    MI_Uint32 tag)
+{
+    MI_Uint64 now = 0;
+
+    MI_UNUSED(tag);
+
+    Atomic_Inc(&_CurrentStripe()->gauges[SERVERSTATS_GAUGE_ACTIVEREQUESTS]);
+
+    if (PAL_TRUE != PAL_Time(&now))
+        return 0;
+
+    return now;
+}
+
+void ServerStats_EndRequest(
+    MI_Uint32 tag,
+    MI_Uint64 startUsec)
+{
+    ServerStatsOperation op = ServerStats_GetOperation(tag);
+    Stripe* stripe = _CurrentStripe();
+    MI_Uint64 now = 0;
+    MI_Uint64 elapsed = 0;
+
+    if (startUsec && PAL_TRUE == PAL_Time(&now) && now > startUsec)
+        elapsed = now - startUsec;
+
+    Atomic_Inc(&stripe->requests[op]);
+    Atomic_Add(&stripe->latencyUsec[op], (ptrdiff_t)elapsed);
+    Atomic_Inc(&stripe->latency[op][_GetLatencyBucket(elapsed)]);
+    Atomic_Dec(&stripe->gauges[SERVERSTATS_GAUGE_ACTIVEREQUESTS]);
+}
+
+const ZChar* ServerStats_GetStageName(
+    ServerStatsStage stage)
+{
+    if ((unsigned int)stage >= SERVERSTATS_STAGE_COUNT)
+        return NULL;
+
+    return s_stageNames[stage];
+}
+
+void ServerStats_Stamp(
+    ServerStatsTrace* trace,
+    ServerStatsStage stage)
+{
+    MI_Uint64 now = 0;
+
+    if (trace->stamps[stage] == 0 && PAL_TRUE == PAL_Time(&now))
+        trace->stamps[stage] = now;
+}
+
+void ServerStats_MergeTrace(
+    ServerStatsTrace* trace,
+    const ServerStatsTrace* other)
+{
+    int i;
+
+    for (i = 0; i < SERVERSTATS_STAGE_COUNT; i++)
+    {
+        if (trace->stamps[i] == 0)
+            trace->stamps[i] = other->stamps[i];
+    }
+}
+
+/* Class names are case insensitive (and truncated as they are kept) */
+static MI_Uint32 _HashTraceKey(
+    _In_z_ const ZChar* className,
+    ServerStatsOperation op)
+{
+    MI_Uint32 hash = 2166136261U ^ (MI_Uint32)op;
+    size_t i;
+
+    for (i = 0; className[i] && i < SERVERSTATS_MAX_TRACE_CLASSNAME - 1; i++)
+    {
+        ZChar c = className[i];
+
+        if (c >= 'A' && c <= 'Z')
+            c += 'a' - 'A';
+
+        hash = (hash ^ (MI_Uint32)c) * 16777619U;
+    }
+
+    return hash;
+}
+
+/* Called with s_tracesLock acquired */
+static ServerStatsTraceEntry* _FindTraceEntry(
+    _In_z_ const ZChar* className,
+    ServerStatsOperation op)
+{
+    MI_Uint32 hash = _HashTraceKey(className, op);
+    MI_Uint32 i;
+
+    for (i = 0; i < s_numTraces; i++)
+    {
+        ServerStatsTraceEntry* entry = &s_traces[i].entry;
+
+        if (s_traces[i].hash == hash && entry->operation == op &&
+            Tcsncasecmp(entry->className, className,
+                SERVERSTATS_MAX_TRACE_CLASSNAME - 1) == 0)
+        {
+            return entry;
+        }
+    }
+
+    if (s_numTraces == SERVERSTATS_MAX_TRACE_ENTRIES)
+        return NULL;
+
+    s_traces[i].hash = hash;
+    Tcslcpy(s_traces[i].entry.className, className,
+        SERVERSTATS_MAX_TRACE_CLASSNAME);
+    s_traces[i].entry.operation = op;
+    s_numTraces++;
+
+    return &s_traces[i].entry;
+}
+
+void ServerStats_EndTrace(
+    MI_Uint32 tag,
+    _In_opt_z_ const ZChar* className,
+    const ServerStatsTrace* trace)
+{
+    ServerStatsOperation op = ServerStats_GetOperation(tag);
+    ServerStatsTraceEntry* entry;
+    MI_Uint64 stageUsec[SERVERSTATS_STAGE_COUNT];
+    MI_Uint64 start = 0;
+    MI_Uint64 last = 0;
+    MI_Uint64 now = 0;
+    MI_Uint64 total = 0;
+    int i;
+
+    /* The time of each stage is counted from the previous stage reached (the
+     * stages are not always reached in order, e.g. the instances of an
+     * enumeration are serialized before its result is posted) */
+    for (i = 0; i < SERVERSTATS_STAGE_COUNT; i++)
+    {
+        MI_Uint64 stamp = trace->stamps[i];
+
+        stageUsec[i] = 0;
+
+        if (stamp == 0)
+            continue;
+
+        if (start == 0)
+            start = last = stamp;
+
+        if (stamp > last)
+        {
+            stageUsec[i] = stamp - last;
+            last = stamp;
+        }
+    }
+
+    if (start == 0)
+        return;
+
+    if (PAL_TRUE == PAL_Time(&now) && now > start)
+        total = now - start;
+
+    Lock_Acquire(&s_tracesLock);
+
+    entry = _FindTraceEntry(className ? className : PAL_T(""), op);
+
+    if (entry)
+    {
+        entry->requests++;
+        entry->totalUsec += total;
+
+        if (total > entry->maxUsec)
+            entry->maxUsec = total;
+
+        for (i = 0; i < SERVERSTATS_STAGE_COUNT; i++)
+        {
+            if (trace->stamps[i] == 0)
+                continue;
+
+            entry->stageUsec[i] += stageUsec[i];
+            entry->stageRequests[i]++;
+        }
+    }
+
+    Lock_Release(&s_tracesLock);
+}
+
+MI_Uint32 ServerStats_GetTraceEntries(
+    ServerStatsTraceEntry* entries,
+    MI_Uint32 maxEntries)
+{
+    MI_Uint32 i;
+
+    Lock_Acquire(&s_tracesLock);
+
+    for (i = 0; i < s_numTraces && i < maxEntries; i++)
+        entries[i] = s_traces[i].entry;
+
+    Lock_Release(&s_tracesLock);
+
+    return i;
+}
+
+void ServerStats_AddGauge(
+    ServerStatsGauge gauge,
+    ptrdiff_t delta)
+{
+    Atomic_Add(&_CurrentStripe()->gauges[gauge], delta);
+}
+
+void ServerStats_AddCounter(
+    ServerStatsCounter counter,
+    MI_Uint64 delta)
+{
+    Atomic_Add(&_CurrentStripe()->counters[counter], (ptrdiff_t)delta);
+}
+
+void ServerStats_SelectorLag(
+    MI_Uint64 lagUsec)
+{
+    ptrdiff_t lag = (ptrdiff_t)lagUsec;
+    ptrdiff_t max;
+
+    Atomic_Swap(&s_selectorLagUsec, lag);
+
+    while ((max = Atomic_Read(&s_selectorMaxLagUsec)) < lag)
+    {
+        if (Atomic_CompareAndSwap(&s_selectorMaxLagUsec, max, lag) == max)
+            break;
+    }
+}
+
+void ServerStats_UpdateAgents(
+    MI_Uint32 uid,
+    int delta)
+{
+    MI_Uint32 i;
+
+    Lock_Acquire(&s_agentUsersLock);
+
+    for (i = 0; i < s_numAgentUsers; i++)
+    {
+        if (s_agentUsers[i].uid == uid)
+            break;
+    }
+
+    if (i < s_numAgentUsers)
+    {
+        s_agentUsers[i].agents += delta;
+
+        /* Keep only the users with running agents */
+        if (s_agentUsers[i].agents == 0)
+            s_agentUsers[i] = s_agentUsers[--s_numAgentUsers];
+    }
+    else if (delta > 0 && s_numAgentUsers < SERVERSTATS_MAX_AGENT_USERS)
+    {
+        s_agentUsers[s_numAgentUsers].uid = uid;
+        s_agentUsers[s_numAgentUsers].agents = (MI_Uint32)delta;
+        s_numAgentUsers++;
+    }
+
+    Lock_Release(&s_agentUsersLock);
+}
+
+void ServerStats_GetSnapshot(
+    ServerStatsSnapshot* snapshot)
+{
+    int i;
+    int op;
+    int j;
+
+    memset(snapshot, 0, sizeof(*snapshot));
+
+    for (i = 0; i < STRIPES; i++)
+    {
+        Stripe* stripe = _GetStripe(i);
+
+        for (op = 0; op < SERVERSTATS_OP_COUNT; op++)
+        {
+            snapshot->requests[op] += (size_t)Atomic_Read(&stripe->requests[op]);
+            snapshot->latencyUsec[op] += (size_t)Atomic_Read(&stripe->latencyUsec[op]);
+
+            for (j = 0; j < SERVERSTATS_LATENCY_BUCKETS; j++)
+                snapshot->latency[op][j] += (size_t)Atomic_Read(&stripe->latency[op][j]);
+        }
+
+        for (j = 0; j < SERVERSTATS_GAUGE_COUNT; j++)
+            snapshot->gauges[j] += Atomic_Read(&stripe->gauges[j]);
+
+        for (j = 0; j < SERVERSTATS_COUNTER_COUNT; j++)
+            snapshot->counters[j] += (size_t)Atomic_Read(&stripe->counters[j]);
+    }
+
+    snapshot->selectorLagUsec = (size_t)Atomic_Read(&s_selectorLagUsec);
+    snapshot->selectorMaxLagUsec = (size_t)Atomic_Read(&s_selectorMaxLagUsec);
+
+    Lock_Acquire(&s_agentUsersLock);
+    memcpy(snapshot->agentUsers, s_agentUsers, sizeof(s_agentUsers[0]) * s_numAgentUsers);
+    snapshot->numAgentUsers = s_numAgentUsers;
+    Lock_Release(&s_agentUsersLock);
+}
@@ -0,0 +1,258 @@
+/*
+**==============================================================================
+**
+** Copyright (c) Microsoft Corporation. All rights reserved. See file LICENSE
+** for license information.
+**
+**==============================================================================
+*/
+
+#ifndef _omi_serverstats_h
+#define _omi_serverstats_h
+
+#include <common.h>
+
+BEGIN_EXTERNC
+
+/*
+**==============================================================================
+**
+** ServerStats
+**
+**     Live performance counters of the process (reported by the
+**     OMI_ServerStatistics provider). The counters are updated on the hot
+**     paths, so they are spread over per-CPU stripes (each one on its own
+**     cache lines) updated with atomics; they are only summed up when a
+**     snapshot is taken.
+**
+**==============================================================================
+*/
+
+/* Operation groups the requests are counted under */
+typedef enum _ServerStatsOperation
+{
+    SERVERSTATS_OP_GETINSTANCE,
+    SERVERSTATS_OP_ENUMERATEINSTANCES,
+    SERVERSTATS_OP_ASSOCIATORS,
+    SERVERSTATS_OP_REFERENCES,
+    SERVERSTATS_OP_INVOKE,
+    SERVERSTATS_OP_CREATEINSTANCE,
+    SERVERSTATS_OP_MODIFYINSTANCE,
+    SERVERSTATS_OP_DELETEINSTANCE,
+    SERVERSTATS_OP_SUBSCRIBE,
+    SERVERSTATS_OP_GETCLASS,
+    SERVERSTATS_OP_OTHER,
+    SERVERSTATS_OP_COUNT
+}
+ServerStatsOperation;
+
+/* Gauges (current values, may go up and down) */
+typedef enum _ServerStatsGauge
+{
+    SERVERSTATS_GAUGE_ACTIVEREQUESTS,
+    SERVERSTATS_GAUGE_HTTPCONNECTIONS,
+    SERVERSTATS_GAUGE_BINARYCONNECTIONS,
+    SERVERSTATS_GAUGE_ENUMERATIONCONTEXTS,
+    SERVERSTATS_GAUGE_BATCHPAGES,
+    SERVERSTATS_GAUGE_BATCHBYTES,
+    SERVERSTATS_GAUGE_COUNT
+}
+ServerStatsGauge;
+
+/* Counters (only go up) */
+typedef enum _ServerStatsCounter
+{
+    /* Messages prepared for the binary protocol hop to the agents, and
+     * how many of them had to be copied into a new message */
+    SERVERSTATS_COUNTER_WIREMESSAGES,
+    SERVERSTATS_COUNTER_WIRECOPIES,
+
+    /* Bytes copied into those messages, and bytes of the original messages
+     * sent along as they were (see MessagePackCloneForBinarySending()) */
+    SERVERSTATS_COUNTER_WIREBYTESCOPIED,
+    SERVERSTATS_COUNTER_WIREBYTESSHARED,
+    SERVERSTATS_COUNTER_COUNT
+}
+ServerStatsCounter;
+
+/* Stages of a request, in the order they are normally reached */
+typedef enum _ServerStatsStage
+{
+    /* Request parsed (WS-Man) or received (binary protocol) */
+    SERVERSTATS_STAGE_PARSE,
+
+    /* Request handled by the dispatcher */
+    SERVERSTATS_STAGE_DISPATCH,
+
+    /* Request sent to the agent (out of process providers only) */
+    SERVERSTATS_STAGE_AGENTSEND,
+
+    /* Request handed to the provider manager (in the agent or in the
+     * server) */
+    SERVERSTATS_STAGE_PROVIDERCALL,
+
+    /* First instance posted by the provider */
+    SERVERSTATS_STAGE_FIRSTINSTANCE,
+
+    /* Result posted by the provider */
+    SERVERSTATS_STAGE_RESULT,
+
+    /* WS-Man started serializing the response */
+    SERVERSTATS_STAGE_SERIALIZE,
+
+    /* Response handed to the HTTP connection */
+    SERVERSTATS_STAGE_WRITE,
+    SERVERSTATS_STAGE_COUNT
+}
+ServerStatsStage;
+
+/* Operation trace context carried by the request messages (and by the final
+ * results coming back from the agents): the time (see PAL_Time(), which is
+ * monotonic and so comparable between the server and the agents) each stage
+ * was first reached at, 0 for the stages not reached */
+typedef struct _ServerStatsTrace
+{
+    MI_Uint64 stamps[SERVERSTATS_STAGE_COUNT];
+}
+ServerStatsTrace;
+
+/* Maximum number of class/operation pairs the traces are aggregated under
+ * (the completed requests of the pairs beyond are not aggregated) */
+#define SERVERSTATS_MAX_TRACE_ENTRIES 128
+
+/* Longest class name kept (longer ones are truncated) */
+#define SERVERSTATS_MAX_TRACE_CLASSNAME 64
+
+/* Latency breakdown of the completed requests of a class and operation */
+typedef struct _ServerStatsTraceEntry
+{
+    ZChar className[SERVERSTATS_MAX_TRACE_CLASSNAME];
+    ServerStatsOperation operation;
+    MI_Uint64 requests;
+
+    /* Sum and maximum of the time from the first stage reached to the
+     * completion of the requests */
+    MI_Uint64 totalUsec;
+    MI_Uint64 maxUsec;
+
+    /* Sum of the time each stage took to be reached from the previous stage
+     * reached, and number of requests that reached the stage */
+    MI_Uint64 stageUsec[SERVERSTATS_STAGE_COUNT];
+    MI_Uint64 stageRequests[SERVERSTATS_STAGE_COUNT];
+}
+ServerStatsTraceEntry;
+
+/* Latency histogram: bucket i counts the requests that completed in less
+ * than (SERVERSTATS_LATENCY_BASE_USEC << i) microseconds (and not in the
+ * previous bucket); the last bucket counts all the slower ones */
+#define SERVERSTATS_LATENCY_BUCKETS 16
+#define SERVERSTATS_LATENCY_BASE_USEC 64
+
+/* Maximum number of distinct users whose agents are counted */
+#define SERVERSTATS_MAX_AGENT_USERS 64
+
+typedef struct _ServerStatsAgentUser
+{
+    MI_Uint32 uid;
+    MI_Uint32 agents;
+}
+ServerStatsAgentUser;
+
+typedef struct _ServerStatsSnapshot
+{
+    MI_Uint64 requests[SERVERSTATS_OP_COUNT];
+
+    /* Sum of the latencies of the completed requests */
+    MI_Uint64 latencyUsec[SERVERSTATS_OP_COUNT];
+
+    MI_Uint64 latency[SERVERSTATS_OP_COUNT][SERVERSTATS_LATENCY_BUCKETS];
+
+    MI_Sint64 gauges[SERVERSTATS_GAUGE_COUNT];
+
+    MI_Uint64 counters[SERVERSTATS_COUNTER_COUNT];
+
+    /* Duration of the last and of the longest event dispatching pass of
+     * the selector loops (time the loop could not pick up new events) */
+    MI_Uint64 selectorLagUsec;
+    MI_Uint64 selectorMaxLagUsec;
+
+    /* Running agents per user */
+    ServerStatsAgentUser agentUsers[SERVERSTATS_MAX_AGENT_USERS];
+    MI_Uint32 numAgentUsers;
+}
+ServerStatsSnapshot;
+
+/* Maps a request message tag to its operation group */
+ServerStatsOperation ServerStats_GetOperation(
+    MI_Uint32 tag);
+
+const ZChar* ServerStats_GetOperationName(
+    ServerStatsOperation op);
+
+/* Called when a request is dispatched; returns its start time, to be passed
+ * back to ServerStats_EndRequest() once it completes */
+MI_Uint64 ServerStats_BeginRequest(
+    MI_Uint32 tag);
+
+void ServerStats_EndRequest(
+    MI_Uint32 tag,
+    MI_Uint64 startUsec);
+
+const ZChar* ServerStats_GetStageName(
+    ServerStatsStage stage);
+
+/* Records that the request of the trace reached the given stage (only the
+ * first time the stage is reached is kept) */
+void ServerStats_Stamp(
+    ServerStatsTrace* trace,
+    ServerStatsStage stage);
+
+/* Takes the stages reached in 'other' (the trace of the same request in
+ * another process) not reached yet in 'trace' */
+void ServerStats_MergeTrace(
+    ServerStatsTrace* trace,
+    const ServerStatsTrace* other);
+
+/* Called when a request completes; aggregates its trace under its class
+ * and operation */
+void ServerStats_EndTrace(
+    MI_Uint32 tag,
+    _In_opt_z_ const ZChar* className,
+    const ServerStatsTrace* trace);
+
+/* Copies the latency breakdowns aggregated so far; returns their number */
+MI_Uint32 ServerStats_GetTraceEntries(
+    ServerStatsTraceEntry* entries,
+    MI_Uint32 maxEntries);
+
+typedef MI_Uint32 (*ServerStats_GetTraceEntriesProc)(
+    ServerStatsTraceEntry* entries,
+    MI_Uint32 maxEntries);
+
+void ServerStats_AddGauge(
+    ServerStatsGauge gauge,
+    ptrdiff_t delta);
+
+void ServerStats_AddCounter(
+    ServerStatsCounter counter,
+    MI_Uint64 delta);
+
+void ServerStats_SelectorLag(
+    MI_Uint64 lagUsec);
+
+/* Called when an agent is started (+1) or is gone (-1) */
+void ServerStats_UpdateAgents(
+    MI_Uint32 uid,
+    int delta);
+
+/* Sums up the counters; this is the function providers find by name
+ * through ProvMgrFT.FindSymbol() */
+void ServerStats_GetSnapshot(
+    ServerStatsSnapshot* snapshot);
+
+typedef void (*ServerStats_GetSnapshotProc)(
+    ServerStatsSnapshot* snapshot);
+
+END_EXTERNC
+
+#endif /* _omi_serverstats_h */
@@ -2871,6 +2871,15 @@ void _Strand_ExecuteLoop( _In_ Strand* self, ptrdiff_t state )
                 STRAND_DEBUG_GETMETHODINDEX(self,bitIndex),
                 STRAND_DEBUG_GETINFOSTATE_STORED );
 
+            if( STRAND_ISTYPE_ENTRY( self ) && BitEntryOperation == methodBit )
+            {
+                // The method schedules the next entry operation on the parent, which may
+                // execute it synchronously and schedule its completion back on this entry
+                // before the method returns (so the bit is cleared beforehand)
+                _DisableMethodBit( self, methodBit );
+                methodBit = 0;
+            }
+
             (*self->strandMethods[ bitIndex-FirstRealMethodBit ])(self);
 
             if( strandStealedFlag )
@@ -0,0 +1,174 @@
+/*
+**==============================================================================
+**
+** Copyright (c) Microsoft Corporation. All rights reserved. See file LICENSE
+** for license information.
+**
+**==============================================================================
+*/
+
+/*
+**==============================================================================
+**
+** micxxpostbench
+**
+**     Microbenchmark of a C++ provider building and posting instances: fills
+**     the string and array properties of the Outer class (tests/base) and
+**     posts each instance to a context that only counts them, first copying
+**     the values into the instance (const& setters, PushBack()) then moving
+**     them (Reserve(), EmplaceBack(), Append(), the && setters), and prints
+**     the nanoseconds per posted instance.
+**
+**         micxxpostbench [INSTANCES]
+**
+**==============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <common.h>
+#include <micxx/micxx.h>
+#include <pal/strings.h>
+#include <pal/format.h>
+#include <pal/sleep.h>
+#include "Outer.h"
+
+using namespace mi;
+
+#define NUM_STRINGS 8
+#define NUM_VALUES 16
+
+static size_t _posted;
+
+static MI_Result MI_CALL _PostInstance(
+    MI_Context* context,
+    const MI_Instance* instance)
+{
+    MI_UNREFERENCED_PARAMETER(context);
+
+    if (instance)
+        _posted++;
+    return MI_RESULT_OK;
+}
+
+static ZChar _names[NUM_STRINGS][32];
+static Uint32 _values[NUM_VALUES];
+
+static void _InitValues()
+{
+    for (size_t i = 0; i < NUM_STRINGS; i++)
+        Stprintf(_names[i], MI_COUNT(_names[i]), ZT("Element of the array %u"),
+            (unsigned)i);
+
+    for (size_t i = 0; i < NUM_VALUES; i++)
+        _values[i] = (Uint32)(i * 7919);
+}
+
+typedef void (*BenchFunc)(Context& context, size_t i);
+
+/* Values copied into the instance */
+static void _PostCopy(Context& context, size_t i)
+{
+    Outer_Class instance;
+    StringA strings;
+    Uint32A values;
+
+    String name(_names[i % NUM_STRINGS]);
+    name += ZT(" posted by the copy path");
+
+    for (size_t j = 0; j < NUM_STRINGS; j++)
+        strings.PushBack(String(_names[j]));
+
+    for (size_t j = 0; j < NUM_VALUES; j++)
+        values.PushBack(_values[j]);
+
+    instance.Key_value((Uint32)i);
+    instance.stringScalar_value(name);
+    instance.stringArray_value(strings);
+    instance.uint32Array_value(values);
+
+    context.Post(instance);
+}
+
+/* Values moved into the instance */
+static void _PostMove(Context& context, size_t i)
+{
+    Outer_Class instance;
+    StringA strings;
+    Uint32A values;
+
+    String name(_names[i % NUM_STRINGS]);
+    name += ZT(" posted by the move path");
+
+    strings.Reserve(NUM_STRINGS);
+    for (size_t j = 0; j < NUM_STRINGS; j++)
+        strings.EmplaceBack(_names[j]);
+
+    values.Append(_values, NUM_VALUES);
+
+    instance.Key_value((Uint32)i);
+    instance.stringScalar_value(std::move(name));
+    instance.stringArray_value(std::move(strings));
+    instance.uint32Array_value(std::move(values));
+
+    context.Post(instance);
+}
+
+/* Nanoseconds per posted instance */
+static double _Time(BenchFunc func, Context& context, size_t count)
+{
+    PAL_Uint64 start = 0;
+    PAL_Uint64 end = 0;
+
+    _posted = 0;
+    PAL_Time(&start);
+
+    for (size_t i = 0; i < count; i++)
+        func(context, i);
+
+    PAL_Time(&end);
+
+    if (_posted != count)
+    {
+        fprintf(stderr, "posted %u instances out of %u\n", (unsigned)_posted,
+            (unsigned)count);
+        exit(1);
+    }
+
+    return (double)(end - start) * 1000.0 / (double)count;
+}
+
+int MI_MAIN_CALL main(int argc, const char* argv[])
+{
+    size_t count = 1000000;
+    MI_ContextFT ft;
+    MI_Context ctx;
+
+    if (argc > 1)
+        count = (size_t)strtoul(argv[1], NULL, 10);
+
+    if (argc > 2 || count == 0)
+    {
+        fprintf(stderr, "Usage: %s [INSTANCES]\n", argv[0]);
+        return 1;
+    }
+
+    memset(&ft, 0, sizeof(ft));
+    ft.PostInstance = _PostInstance;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.ft = &ft;
+
+    _InitValues();
+
+    Context context(&ctx);
+    double copy = _Time(_PostCopy, context, count);
+    double move = _Time(_PostMove, context, count);
+
+    printf("%-12s %12s %12s %8s\n", "instances", "copy ns", "move ns",
+        "speedup");
+    printf("%-12u %12.1f %12.1f %7.2fx\n", (unsigned)count, copy, move,
+        move > 0 ? copy / move : 0.0);
+
+    return 0;
+}
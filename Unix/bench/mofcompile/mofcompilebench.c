@@ -0,0 +1,241 @@
+/*
+**==============================================================================
+**
+** Copyright (c) Microsoft Corporation. All rights reserved. See file LICENSE
+** for license information.
+**
+**==============================================================================
+*/
+
+/*
+**==============================================================================
+**
+** mofcompilebench
+**
+**     Compile-time benchmark of the two MOF compilers over a large generated
+**     schema: the omigen front end (mof/) and the MOF deserializer of the MI
+**     codec (codec/mof/parser). The schema declares CLASSES classes deriving
+**     from one another and one qualifier for every 10 classes, then every
+**     class refers to its superclass and to the qualifiers in another case,
+**     so that each lookup goes through the class and qualifier tables. The
+**     schema is compiled at 1/8, 1/4, 1/2 and all of its size and the
+**     milliseconds printed should grow linearly.
+**
+**         mofcompilebench [CLASSES]
+**
+**==============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <common.h>
+#include <pal/strings.h>
+#include <pal/format.h>
+#include <pal/file.h>
+#include <pal/sleep.h>
+#include <base/paths.h>
+#include <mof.h>
+#include <micodec.h>
+
+typedef struct _Schema
+{
+    char* data;
+    size_t size;
+    size_t capacity;
+}
+Schema;
+
+static void _Append(Schema* self, const char* str)
+{
+    size_t n = strlen(str);
+
+    if (self->size + n + 1 > self->capacity)
+    {
+        self->capacity = (self->size + n + 1) * 2;
+        self->data = (char*)realloc(self->data, self->capacity);
+
+        if (!self->data)
+        {
+            fprintf(stderr, "out of memory\n");
+            exit(1);
+        }
+    }
+
+    memcpy(self->data + self->size, str, n + 1);
+    self->size += n;
+}
+
+static void _MakeSchema(Schema* self, size_t numClasses)
+{
+    size_t numQualifiers = numClasses / 10 + 1;
+    char buf[256];
+    size_t i;
+
+    self->size = 0;
+
+    for (i = 0; i < numQualifiers; i++)
+    {
+        Snprintf(buf, sizeof(buf),
+            "Qualifier Q%u : boolean = false, Scope(any);\n", (unsigned int)i);
+        _Append(self, buf);
+    }
+
+    _Append(self, "class Base { [Q0] uint32 Id; };\n");
+
+    for (i = 0; i < numClasses; i++)
+    {
+        if (i == 0)
+            Snprintf(buf, sizeof(buf), "[q%u] class Class0 : BASE\n",
+                (unsigned int)(numQualifiers - 1));
+        else
+            Snprintf(buf, sizeof(buf), "[q%u] class Class%u : CLASS%u\n",
+                (unsigned int)(i % numQualifiers), (unsigned int)i,
+                (unsigned int)((i - 1) / 2));
+        _Append(self, buf);
+
+        Snprintf(buf, sizeof(buf), "{ [Q%u] string P%u; uint32 N%u; };\n",
+            (unsigned int)((i * 7) % numQualifiers), (unsigned int)i,
+            (unsigned int)i);
+        _Append(self, buf);
+    }
+}
+
+static void _ErrorCallback(const char* msg, const wchar_t* wmsg, void* data)
+{
+    MI_UNUSED(wmsg);
+    MI_UNUSED(data);
+    fprintf(stderr, "mofcompilebench: %s\n", msg);
+}
+
+/* Milliseconds to compile 'path' with the omigen front end */
+static double _TimeFrontEnd(const char* path)
+{
+    MOF_Parser* parser;
+    PAL_Uint64 start = 0;
+    PAL_Uint64 end = 0;
+    int r;
+
+    parser = MOF_Parser_New(NULL, 0);
+
+    if (!parser)
+        return -1;
+
+    MOF_Parser_SetErrorCallback(parser, _ErrorCallback, NULL);
+
+    PAL_Time(&start);
+    r = MOF_Parser_Parse(parser, path);
+    PAL_Time(&end);
+
+    MOF_Parser_Delete(parser);
+
+    return r == 0 ? (double)(end - start) / 1000.0 : -1;
+}
+
+/* Milliseconds to deserialize 'schema' with the MOF codec */
+static double _TimeCodec(MI_Application* app, const Schema* schema)
+{
+    MI_OperationOptions options;
+    MI_Deserializer de;
+    MI_ClassA* classes = NULL;
+    MI_Uint32 read = 0;
+    PAL_Uint64 start = 0;
+    PAL_Uint64 end = 0;
+    MI_Result r;
+
+    r = MI_Application_NewOperationOptions(app, MI_FALSE, &options);
+
+    if (r != MI_RESULT_OK)
+        return -1;
+
+    r = MI_OperationOptions_SetString(&options,
+        MOFCODEC_SCHEMA_VALIDATION_OPTION_NAME,
+        MOFCODEC_SCHEMA_VALIDATION_IGNORE, 0);
+
+    if (r == MI_RESULT_OK)
+        r = MI_Application_NewDeserializer(app, 0, MOFCODEC_FORMAT, &de);
+
+    if (r != MI_RESULT_OK)
+    {
+        MI_OperationOptions_Delete(&options);
+        return -1;
+    }
+
+    PAL_Time(&start);
+    r = MI_Deserializer_DeserializeClassArray(&de, 0, &options, NULL,
+        (MI_Uint8*)schema->data, (MI_Uint32)schema->size, NULL, NULL, NULL,
+        &read, &classes, NULL);
+    PAL_Time(&end);
+
+    if (r != MI_RESULT_OK)
+        fprintf(stderr, "mofcompilebench: codec failed: %d\n", (int)r);
+
+    if (classes)
+        MI_Deserializer_ReleaseClassArray(classes);
+
+    MI_Deserializer_Close(&de);
+    MI_OperationOptions_Delete(&options);
+
+    return r == MI_RESULT_OK ? (double)(end - start) / 1000.0 : -1;
+}
+
+int MI_MAIN_CALL main(int argc, const char* argv[])
+{
+    size_t numClasses = 20000;
+    char path[PAL_MAX_PATH_SIZE];
+    MI_Application app = MI_APPLICATION_NULL;
+    Schema schema;
+    size_t shift;
+
+    if (argc > 1)
+        numClasses = (size_t)strtoul(argv[1], NULL, 10);
+
+    if (argc > 2 || numClasses < 8)
+    {
+        fprintf(stderr, "Usage: %s [CLASSES]\n", argv[0]);
+        return 1;
+    }
+
+    if (MI_Application_Initialize(0, MI_T("mofcompilebench"), NULL, &app)
+        != MI_RESULT_OK)
+    {
+        fprintf(stderr, "%s: failed to initialize the application\n", argv[0]);
+        return 1;
+    }
+
+    Strlcpy(path, OMI_GetPath(ID_TMPDIR), sizeof(path));
+    Strlcat(path, "/mofcompilebench.mof", sizeof(path));
+
+    memset(&schema, 0, sizeof(schema));
+
+    printf("%10s %10s %14s %14s\n", "classes", "bytes", "omigen ms",
+        "codec ms");
+
+    for (shift = 3; shift != (size_t)-1; shift--)
+    {
+        size_t n = numClasses >> shift;
+        FILE* os;
+
+        _MakeSchema(&schema, n);
+
+        os = File_Open(path, "wb");
+
+        if (!os || fwrite(schema.data, 1, schema.size, os) != schema.size)
+        {
+            fprintf(stderr, "%s: failed to write %s\n", argv[0], path);
+            return 1;
+        }
+
+        File_Close(os);
+
+        printf("%10u %10u %14.1f %14.1f\n", (unsigned int)n,
+            (unsigned int)schema.size, _TimeFrontEnd(path),
+            _TimeCodec(&app, &schema));
+    }
+
+    File_Remove(path);
+    free(schema.data);
+    MI_Application_Close(&app);
+
+    return 0;
+}
@@ -0,0 +1,254 @@
+/*
+**==============================================================================
+**
+** Copyright (c) Microsoft Corporation. All rights reserved. See file LICENSE
+** for license information.
+**
+**==============================================================================
+*/
+
+/*
+**==============================================================================
+**
+** numconvbench
+**
+**     Microbenchmark of the number and datetime conversions of the
+**     serializers and the parsers: times each conversion of base/numconv.h
+**     against the path it replaced (Stprintf(), Tcstoull(), Tcstod(), ...)
+**     over the same values and prints the nanoseconds per conversion.
+**
+**         numconvbench [ITERATIONS]
+**
+**==============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <common.h>
+#include <pal/strings.h>
+#include <pal/format.h>
+#include <pal/sleep.h>
+#include <base/numconv.h>
+
+#define NUM_VALUES 1024
+
+static MI_Sint64 _sint64s[NUM_VALUES];
+static MI_Real64 _integralReals[NUM_VALUES];
+static MI_Real64 _reals[NUM_VALUES];
+static MI_Datetime _datetimes[NUM_VALUES];
+static ZChar _uint64Strs[NUM_VALUES][NUMCONV_INT_SIZE];
+static ZChar _realStrs[NUM_VALUES][NUMCONV_REAL_SIZE];
+
+/* Keeps the compiler from dropping the conversions */
+static volatile size_t _sink;
+
+static MI_Uint64 _Next(MI_Uint64* seed)
+{
+    *seed = *seed * MI_ULL(6364136223846793005) + MI_ULL(1442695040888963407);
+    return *seed >> 11;
+}
+
+static void _InitValues()
+{
+    MI_Uint64 seed = 42;
+    size_t i;
+
+    for (i = 0; i < NUM_VALUES; i++)
+    {
+        MI_Datetime* d = &_datetimes[i];
+
+        _sint64s[i] = (MI_Sint64)(_Next(&seed) >> (i % 48)) * (i % 2 ? -1 : 1);
+        _integralReals[i] = (MI_Real64)(_Next(&seed) % 1000000);
+        _reals[i] = (MI_Real64)_Next(&seed) / 1e9;
+
+        memset(d, 0, sizeof(*d));
+        d->isTimestamp = i % 4 ? 1 : 0;
+
+        if (d->isTimestamp)
+        {
+            d->u.timestamp.year = 1970 + (MI_Uint32)(i % 100);
+            d->u.timestamp.month = 1 + (MI_Uint32)(i % 12);
+            d->u.timestamp.day = 1 + (MI_Uint32)(i % 28);
+            d->u.timestamp.hour = (MI_Uint32)(i % 24);
+            d->u.timestamp.minute = (MI_Uint32)(i % 60);
+            d->u.timestamp.second = (MI_Uint32)(i % 60);
+            d->u.timestamp.microseconds = (MI_Uint32)(_Next(&seed) % 1000000);
+            d->u.timestamp.utc = (MI_Sint32)(i % 25) * 60 - 720;
+        }
+        else
+        {
+            d->u.interval.days = (MI_Uint32)i;
+            d->u.interval.hours = (MI_Uint32)(i % 24);
+            d->u.interval.minutes = (MI_Uint32)(i % 60);
+            d->u.interval.seconds = (MI_Uint32)(i % 60);
+            d->u.interval.microseconds = (MI_Uint32)(_Next(&seed) % 1000000);
+        }
+
+        NumConv_Uint64ToZStr(_uint64Strs[i], _Next(&seed) >> (i % 40));
+        NumConv_Real64ToZStr(_realStrs[i], _reals[i], 15, 'g');
+    }
+}
+
+typedef void (*BenchFunc)(size_t i);
+
+/* Formatting: the current paths */
+
+static void _Sint64Printf(size_t i)
+{
+    ZChar buf[64];
+    _sink += (size_t)Stprintf(buf, MI_COUNT(buf), SINT64_FMT_T, _sint64s[i]);
+}
+
+static void _IntegralRealPrintf(size_t i)
+{
+    ZChar buf[64];
+    _sink += (size_t)Stprintf(buf, MI_COUNT(buf), ZT("%.15g"), _integralReals[i]);
+}
+
+static void _RealPrintf(size_t i)
+{
+    ZChar buf[64];
+    _sink += (size_t)Stprintf(buf, MI_COUNT(buf), ZT("%.15g"), _reals[i]);
+}
+
+static void _DatetimePrintf(size_t i)
+{
+    ZChar buf[64];
+    const MI_Datetime* x = &_datetimes[i];
+
+    if (x->isTimestamp)
+    {
+        MI_Sint32 utc = x->u.timestamp.utc;
+        _sink += (size_t)Stprintf(buf, 26, ZT("%04d%02d%02d%02d%02d%02d.%06d%c%03d"),
+            x->u.timestamp.year, x->u.timestamp.month, x->u.timestamp.day,
+            x->u.timestamp.hour, x->u.timestamp.minute, x->u.timestamp.second,
+            x->u.timestamp.microseconds, utc < 0 ? '-' : '+',
+            utc < 0 ? -utc : utc);
+    }
+    else
+    {
+        _sink += (size_t)Stprintf(buf, 26, ZT("%08u%02u%02u%02u.%06u:000"),
+            x->u.interval.days, x->u.interval.hours, x->u.interval.minutes,
+            x->u.interval.seconds, x->u.interval.microseconds);
+    }
+}
+
+/* Formatting: NumConv */
+
+static void _Sint64NumConv(size_t i)
+{
+    ZChar buf[NUMCONV_INT_SIZE];
+    _sink += NumConv_Sint64ToZStr(buf, _sint64s[i]);
+}
+
+static void _IntegralRealNumConv(size_t i)
+{
+    ZChar buf[NUMCONV_REAL_SIZE];
+    _sink += NumConv_Real64ToZStr(buf, _integralReals[i], 15, 'g');
+}
+
+static void _RealNumConv(size_t i)
+{
+    ZChar buf[NUMCONV_REAL_SIZE];
+    _sink += NumConv_Real64ToZStr(buf, _reals[i], 15, 'g');
+}
+
+static void _DatetimeNumConv(size_t i)
+{
+    ZChar buf[NUMCONV_DATETIME_SIZE];
+    NumConv_DatetimeToZStr(buf, &_datetimes[i]);
+    _sink += buf[0];
+}
+
+/* Parsing */
+
+static void _Uint64Strtoull(size_t i)
+{
+    _sink += (size_t)Tcstoull(_uint64Strs[i], NULL, 10);
+}
+
+static void _Uint64NumConv(size_t i)
+{
+    MI_Uint64 x;
+    NumConv_ZStrToUint64(_uint64Strs[i], &x);
+    _sink += (size_t)x;
+}
+
+static void _RealStrtod(size_t i)
+{
+    _sink += (size_t)Tcstod(_realStrs[i], NULL);
+}
+
+static void _RealNumConvParse(size_t i)
+{
+    MI_Real64 x;
+    NumConv_ZStrToReal64(_realStrs[i], &x);
+    _sink += (size_t)x;
+}
+
+typedef struct _Bench
+{
+    const char* name;
+    BenchFunc current;
+    BenchFunc numconv;
+}
+Bench;
+
+static const Bench _benches[] =
+{
+    { "sint64 to string", _Sint64Printf, _Sint64NumConv },
+    { "integral real64 to string", _IntegralRealPrintf, _IntegralRealNumConv },
+    { "real64 to string", _RealPrintf, _RealNumConv },
+    { "CIM datetime to string", _DatetimePrintf, _DatetimeNumConv },
+    { "string to uint64", _Uint64Strtoull, _Uint64NumConv },
+    { "string to real64", _RealStrtod, _RealNumConvParse },
+};
+
+/* Nanoseconds per call */
+static double _Time(BenchFunc func, size_t iterations)
+{
+    PAL_Uint64 start = 0;
+    PAL_Uint64 end = 0;
+    size_t i;
+
+    PAL_Time(&start);
+
+    for (i = 0; i < iterations; i++)
+        func(i % NUM_VALUES);
+
+    PAL_Time(&end);
+
+    return (double)(end - start) * 1000.0 / (double)iterations;
+}
+
+int MI_MAIN_CALL main(int argc, const char* argv[])
+{
+    size_t iterations = 1000000;
+    size_t i;
+
+    if (argc > 1)
+        iterations = (size_t)strtoul(argv[1], NULL, 10);
+
+    if (argc > 2 || iterations == 0)
+    {
+        fprintf(stderr, "Usage: %s [ITERATIONS]\n", argv[0]);
+        return 1;
+    }
+
+    _InitValues();
+
+    printf("%-28s %12s %12s %8s\n", "conversion", "current ns", "numconv ns",
+        "speedup");
+
+    for (i = 0; i < MI_COUNT(_benches); i++)
+    {
+        double current = _Time(_benches[i].current, iterations);
+        double numconv = _Time(_benches[i].numconv, iterations);
+
+        printf("%-28s %12.1f %12.1f %7.1fx\n", _benches[i].name, current,
+            numconv, numconv > 0 ? current / numconv : 0.0);
+    }
+
+    return 0;
+}
@@ -0,0 +1,1531 @@
+/*
+**==============================================================================
+**
+** Copyright (c) Microsoft Corporation. All rights reserved. See file LICENSE
+** for license information.
+**
+**==============================================================================
+*/
+
+/*
+**==============================================================================
+**
+** omibench
+**
+**     Load generator for the Perf_WMIv2 sample providers. Runs enumerate,
+**     get, invoke, references and subscribe operations from several
+**     concurrent client threads (each with its own session) against a
+**     running server, over the binary protocol and/or WS-Man, and reports
+**     the throughput, the latency percentiles and the resident set size of
+**     the server (and its agents) for each operation, as text or as JSON.
+**
+**     The instance operations run against Perf_NoPsSemantics and
+**     Perf_WithPsSemantics (which also posts PowerShell semantics messages);
+**     references go through PerfAssocClass. Perf_Embedded implements no
+**     operation of its own: it travels as the embedded instance of the other
+**     classes and as the parameter of Perf_WithPsSemantics.PingBackParameters
+**     (the invoke operation of that class). Subscribe uses Perf_Indication.
+**
+**     The handshake and resume operations measure the TLS handshakes per
+**     second of the WS-Man HTTPS listener (full handshakes and resumed
+**     sessions respectively) without sending any request.
+**
+**==============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netdb.h>
+#include <unistd.h>
+#include <openssl/ssl.h>
+#include <MI.h>
+#include <common.h>
+#include <pal/strings.h>
+#include <pal/format.h>
+#include <pal/sleep.h>
+#include <pal/lock.h>
+#include <pal/thread.h>
+#include <pal/dir.h>
+#include <base/paths.h>
+#include <base/pidfile.h>
+#include <base/result.h>
+
+#define NAMESPACE_DEFAULT MI_T("root/cimv2")
+#define ASSOCCLASS MI_T("PerfAssocClass")
+#define EMBEDDEDCLASS MI_T("Perf_Embedded")
+#define INDICATION_QUERY MI_T("select * from Perf_Indication")
+#define MAX_THREADS 256
+
+static const MI_Char USAGE[] = MI_T(
+"Usage: %T [OPTIONS]\n"
+"\n"
+"Runs concurrent operations against the Perf_WMIv2 providers, which must be\n"
+"registered with the server, and reports throughput, latency and server RSS.\n"
+"\n"
+"OPTIONS:\n"
+"    -h, --help              Print this help message.\n"
+"    -n NAMESPACE            Namespace of the providers (root/cimv2).\n"
+"    -t THREADS              Number of concurrent clients (4).\n"
+"    --subscribers N         Concurrent clients of the subscribe operation,\n"
+"                            at most THREADS (1). Concurrent subscribe and\n"
+"                            unsubscribe churn is known to upset the server.\n"
+"    -d SECONDS              Duration of each operation (5).\n"
+"    --classes CLASSES       Comma-separated list of the classes of the\n"
+"                            instance operations (Perf_NoPsSemantics,\n"
+"                            Perf_WithPsSemantics).\n"
+"    --ops OPS               Comma-separated list of operations\n"
+"                            (enumerate,get,invoke,references,subscribe).\n"
+"                            The TLS\n"
+"                            handshake and resume operations, which connect\n"
+"                            to the WS-Man HTTPS port, must be selected\n"
+"                            explicitly and run with --protocol wsman.\n"
+"    --instances N           Instances returned by each enumeration (10).\n"
+"    --protocol PROTOCOL     binary, wsman or both (binary).\n"
+"    --hostname HOSTNAME     WS-Man host (localhost).\n"
+"    --port PORT             WS-Man port.\n"
+"    --encryption TYPE       WS-Man encryption: http, https or none.\n"
+"    --auth TYPE             WS-Man authentication type (Basic).\n"
+"    -u USERNAME             WS-Man username.\n"
+"    -p PASSWORD             WS-Man password.\n"
+"    --format FORMAT         Output format: text or json (text).\n"
+"    -o FILE                 Write the report to FILE.\n"
+"    --pid PID               Server process (read from the PID file).\n"
+"    --destdir DIR           Destination directory of the installation.\n"
+"\n");
+
+typedef enum _BenchOp
+{
+    BENCH_ENUMERATE,
+    BENCH_GET,
+    BENCH_INVOKE,
+    BENCH_REFERENCES,
+    BENCH_SUBSCRIBE,
+    BENCH_HANDSHAKE,
+    BENCH_RESUME,
+    BENCH_NUM_OPS
+}
+BenchOp;
+
+static const MI_Char* _opNames[BENCH_NUM_OPS] =
+{
+    MI_T("enumerate"),
+    MI_T("get"),
+    MI_T("invoke"),
+    MI_T("references"),
+    MI_T("subscribe"),
+    MI_T("handshake"),
+    MI_T("resume"),
+};
+
+/* Operations before this one run against each of the selected classes */
+#define BENCH_FIRST_CLASSLESS_OP BENCH_SUBSCRIBE
+
+/* Operations from this one on are TLS handshakes (no MI operation) */
+#define BENCH_FIRST_TLS_OP BENCH_HANDSHAKE
+
+typedef enum _BenchClass
+{
+    BENCH_NOPSSEMANTICS,
+    BENCH_WITHPSSEMANTICS,
+    BENCH_NUM_CLASSES
+}
+BenchClass;
+
+static const MI_Char* _classNames[BENCH_NUM_CLASSES] =
+{
+    MI_T("Perf_NoPsSemantics"),
+    MI_T("Perf_WithPsSemantics"),
+};
+
+typedef enum _BenchProtocol
+{
+    BENCH_BINARY,
+    BENCH_WSMAN,
+    BENCH_NUM_PROTOCOLS
+}
+BenchProtocol;
+
+static const MI_Char* _protocolNames[BENCH_NUM_PROTOCOLS] =
+{
+    MI_T("binary"),
+    MI_T("wsman"),
+};
+
+struct Options
+{
+    MI_Boolean help;
+    const MI_Char* nameSpace;
+    int threads;
+    int subscribers;
+    int seconds;
+    MI_Boolean ops[BENCH_NUM_OPS];
+    MI_Boolean classes[BENCH_NUM_CLASSES];
+    MI_Uint32 instances;
+    MI_Boolean protocols[BENCH_NUM_PROTOCOLS];
+    const MI_Char* hostname;
+    int port;
+    const MI_Char* encryption;
+    const MI_Char* auth;
+    const MI_Char* user;
+    const MI_Char* password;
+    MI_Boolean json;
+    const MI_Char* output;
+    int pid;
+};
+
+static struct Options opts;
+
+static FILE* sout;
+static FILE* serr;
+static const MI_Char* arg0;
+
+static void err(const ZChar* fmt, ...)
+{
+    va_list ap;
+
+    Ftprintf(serr, PAL_T("%T: "), tcs(arg0));
+
+    va_start(ap, fmt);
+    Vftprintf(serr, fmt, ap);
+    va_end(ap);
+
+    Ftprintf(serr, PAL_T("\n"));
+}
+
+/*
+**==============================================================================
+**
+** Latencies
+**
+**==============================================================================
+*/
+
+typedef struct _Latencies
+{
+    MI_Uint64* data;
+    size_t size;
+    size_t capacity;
+}
+Latencies;
+
+static int Latencies_Add(Latencies* self, MI_Uint64 usec)
+{
+    if (self->size == self->capacity)
+    {
+        size_t capacity = self->capacity ? self->capacity * 2 : 1024;
+        MI_Uint64* data = (MI_Uint64*)realloc(self->data,
+            capacity * sizeof(MI_Uint64));
+
+        if (!data)
+            return -1;
+
+        self->data = data;
+        self->capacity = capacity;
+    }
+
+    self->data[self->size++] = usec;
+    return 0;
+}
+
+static int _CompareUint64(const void* p1, const void* p2)
+{
+    MI_Uint64 x = *(const MI_Uint64*)p1;
+    MI_Uint64 y = *(const MI_Uint64*)p2;
+    return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+/* Nearest-rank percentile of sorted latencies */
+static MI_Uint64 Latencies_Percentile(const Latencies* self, unsigned int p)
+{
+    size_t rank;
+
+    if (self->size == 0)
+        return 0;
+
+    rank = (self->size * p + 99) / 100;
+    return self->data[rank ? rank - 1 : 0];
+}
+
+/*
+**==============================================================================
+**
+** Resident set size of the server and its agents (Linux only)
+**
+**==============================================================================
+*/
+
+#if defined(linux)
+
+static MI_Uint64 _GetRSS(int pid)
+{
+    char path[64];
+    char line[256];
+    MI_Uint64 kb = 0;
+    FILE* is;
+
+    Snprintf(path, sizeof(path), "/proc/%d/status", pid);
+
+    if (!(is = fopen(path, "r")))
+        return 0;
+
+    while (fgets(line, sizeof(line), is))
+    {
+        if (strncmp(line, "VmRSS:", 6) == 0)
+        {
+            kb = strtoull(line + 6, NULL, 10);
+            break;
+        }
+    }
+
+    fclose(is);
+    return kb;
+}
+
+static int _GetParentPID(int pid)
+{
+    char path[64];
+    char buf[512];
+    const char* p;
+    FILE* is;
+    size_t n;
+    int ppid = -1;
+
+    Snprintf(path, sizeof(path), "/proc/%d/stat", pid);
+
+    if (!(is = fopen(path, "r")))
+        return -1;
+
+    n = fread(buf, 1, sizeof(buf) - 1, is);
+    buf[n] = '\0';
+    fclose(is);
+
+    /* Format: pid (comm) state ppid ...; comm may contain spaces */
+    if ((p = strrchr(buf, ')')) != NULL)
+        sscanf(p + 1, " %*c %d", &ppid);
+
+    return ppid;
+}
+
+/* RSS in kilobytes of 'pid' and (separately) of all its children */
+static void GetServerRSS(int pid, MI_Uint64* serverKB, MI_Uint64* agentsKB)
+{
+    Dir* dir;
+    DirEnt* ent;
+
+    *serverKB = _GetRSS(pid);
+    *agentsKB = 0;
+
+    if (!(dir = Dir_Open("/proc")))
+        return;
+
+    while ((ent = Dir_Read(dir)) != NULL)
+    {
+        int child = atoi(ent->name);
+
+        if (child > 0 && _GetParentPID(child) == pid)
+            *agentsKB += _GetRSS(child);
+    }
+
+    Dir_Close(dir);
+}
+
+#else
+
+static void GetServerRSS(int pid, MI_Uint64* serverKB, MI_Uint64* agentsKB)
+{
+    MI_UNREFERENCED_PARAMETER(pid);
+    *serverKB = 0;
+    *agentsKB = 0;
+}
+
+#endif
+
+/*
+**==============================================================================
+**
+** Operations
+**
+**==============================================================================
+*/
+
+static MI_Application _application = MI_APPLICATION_NULL;
+
+typedef struct _Client
+{
+    Thread thread;
+    MI_Session session;
+    BenchOp op;
+    BenchClass cls;
+    MI_Uint64 deadline;
+    MI_Uint64 key;
+    MI_Uint64 errors;
+    MI_Result lastError;
+    Latencies latencies;
+    SSL_SESSION* sslSession;
+}
+Client;
+
+/* Drain the results of an operation and return its final result */
+static MI_Result _DrainInstances(MI_Operation* operation)
+{
+    MI_Boolean moreResults = MI_TRUE;
+    MI_Result result = MI_RESULT_OK;
+
+    while (moreResults)
+    {
+        const MI_Instance* instance;
+        const MI_Char* errorMessage;
+        const MI_Instance* errorDetails;
+
+        if (MI_Operation_GetInstance(operation, &instance, &moreResults,
+            &result, &errorMessage, &errorDetails) != MI_RESULT_OK)
+        {
+            return MI_RESULT_FAILED;
+        }
+    }
+
+    return result;
+}
+
+static MI_Result _Enumerate(Client* self)
+{
+    MI_Operation operation = MI_OPERATION_NULL;
+    MI_Result result;
+
+    MI_Session_EnumerateInstances(&self->session, 0, NULL, opts.nameSpace,
+        _classNames[self->cls], MI_FALSE, NULL, &operation);
+
+    result = _DrainInstances(&operation);
+    MI_Operation_Close(&operation);
+    return result;
+}
+
+/* Name of the next instance of the class of the client */
+static MI_Result _NewInstanceName(Client* self, MI_Instance** instanceName)
+{
+    MI_Value value;
+    MI_Result result;
+
+    result = MI_Application_NewInstance(&_application,
+        _classNames[self->cls], NULL, instanceName);
+    if (result != MI_RESULT_OK)
+        return result;
+
+    value.uint64 = self->key++ % (opts.instances ? opts.instances : 1);
+    result = MI_Instance_AddElement(*instanceName, MI_T("v_uint64_key"),
+        &value, MI_UINT64, MI_FLAG_KEY);
+
+    if (result != MI_RESULT_OK)
+        MI_Instance_Delete(*instanceName);
+
+    return result;
+}
+
+static MI_Result _Get(Client* self)
+{
+    MI_Operation operation = MI_OPERATION_NULL;
+    MI_Instance* instanceName;
+    MI_Result result;
+
+    result = _NewInstanceName(self, &instanceName);
+    if (result != MI_RESULT_OK)
+        return result;
+
+    MI_Session_GetInstance(&self->session, 0, NULL, opts.nameSpace,
+        instanceName, NULL, &operation);
+
+    result = _DrainInstances(&operation);
+    MI_Operation_Close(&operation);
+
+    MI_Instance_Delete(instanceName);
+    return result;
+}
+
+/* Sends a Perf_Embedded instance to Perf_WithPsSemantics, which sends it
+ * back as an output parameter */
+static MI_Result _PingBack(Client* self)
+{
+    MI_Operation operation = MI_OPERATION_NULL;
+    MI_Instance* params = NULL;
+    MI_Instance* embedded = NULL;
+    MI_Value value;
+    MI_Result result;
+
+    result = MI_Application_NewInstance(&_application, EMBEDDEDCLASS, NULL,
+        &embedded);
+    if (result != MI_RESULT_OK)
+        return result;
+
+    value.uint16 = (MI_Uint16)self->key++;
+    result = MI_Instance_AddElement(embedded, MI_T("v_embeddedKey"), &value,
+        MI_UINT16, MI_FLAG_KEY);
+
+    value.string = MI_T("omibench");
+    if (result == MI_RESULT_OK)
+        result = MI_Instance_AddElement(embedded, MI_T("v_string"), &value,
+            MI_STRING, 0);
+
+    if (result == MI_RESULT_OK)
+        result = MI_Application_NewParameterSet(&_application, NULL, &params);
+
+    value.instance = embedded;
+    if (result == MI_RESULT_OK)
+        result = MI_Instance_AddElement(params, MI_T("inbound"), &value,
+            MI_INSTANCE, 0);
+
+    if (result == MI_RESULT_OK)
+    {
+        MI_Session_Invoke(&self->session, 0, NULL, opts.nameSpace,
+            _classNames[self->cls], MI_T("PingBackParameters"), NULL, params,
+            NULL, &operation);
+
+        result = _DrainInstances(&operation);
+        MI_Operation_Close(&operation);
+    }
+
+    if (params)
+        MI_Instance_Delete(params);
+
+    MI_Instance_Delete(embedded);
+    return result;
+}
+
+static MI_Result _Invoke(Client* self)
+{
+    MI_Operation operation = MI_OPERATION_NULL;
+    MI_Result result;
+
+    if (self->cls == BENCH_WITHPSSEMANTICS)
+        return _PingBack(self);
+
+    MI_Session_Invoke(&self->session, 0, NULL, opts.nameSpace,
+        _classNames[self->cls], MI_T("GetNumberPostedInstances"), NULL, NULL,
+        NULL, &operation);
+
+    result = _DrainInstances(&operation);
+    MI_Operation_Close(&operation);
+    return result;
+}
+
+/* PerfAssocClass associates the instances of both classes with the same key
+ * (Perf_WithPsSemantics is the antecedent, Perf_NoPsSemantics the dependent) */
+static MI_Result _References(Client* self)
+{
+    MI_Operation operation = MI_OPERATION_NULL;
+    MI_Instance* instanceName;
+    MI_Result result;
+
+    result = _NewInstanceName(self, &instanceName);
+    if (result != MI_RESULT_OK)
+        return result;
+
+    MI_Session_ReferenceInstances(&self->session, 0, NULL, opts.nameSpace,
+        instanceName, ASSOCCLASS, NULL, MI_FALSE, NULL, &operation);
+
+    result = _DrainInstances(&operation);
+    MI_Operation_Close(&operation);
+
+    MI_Instance_Delete(instanceName);
+    return result;
+}
+
+/* State of an asynchronous subscription (see _Subscribe) */
+typedef struct _Subscription
+{
+    /* Set once the first indication (or the final result) is delivered */
+    ptrdiff_t delivered;
+
+    /* Set once the final result is delivered */
+    ptrdiff_t completed;
+
+    MI_Result result;
+}
+Subscription;
+
+static void MI_CALL _IndicationResult(
+    MI_Operation* operation,
+    void* callbackContext,
+    const MI_Instance* instance,
+    const MI_Char* bookmark,
+    const MI_Char* machineID,
+    MI_Boolean moreResults,
+    MI_Result resultCode,
+    const MI_Char* errorString,
+    const MI_Instance* errorDetails,
+    MI_Result (MI_CALL * resultAcknowledgement)(MI_Operation* operation))
+{
+    Subscription* self = (Subscription*)callbackContext;
+
+    MI_UNREFERENCED_PARAMETER(operation);
+    MI_UNREFERENCED_PARAMETER(bookmark);
+    MI_UNREFERENCED_PARAMETER(machineID);
+    MI_UNREFERENCED_PARAMETER(errorString);
+    MI_UNREFERENCED_PARAMETER(errorDetails);
+    MI_UNREFERENCED_PARAMETER(resultAcknowledgement);
+
+    if (!self->delivered)
+    {
+        /* Completed without delivering anything */
+        self->result = instance ? MI_RESULT_OK :
+            (resultCode == MI_RESULT_OK ? MI_RESULT_FAILED : resultCode);
+        self->delivered = 1;
+        CondLock_Broadcast((ptrdiff_t)&self->delivered);
+    }
+
+    if (!moreResults)
+    {
+        self->completed = 1;
+        CondLock_Broadcast((ptrdiff_t)&self->completed);
+    }
+}
+
+static void _Wait(ptrdiff_t* flag)
+{
+    ptrdiff_t value = *flag;
+
+    while (!value)
+    {
+        CondLock_Wait((ptrdiff_t)flag, flag, value, CONDLOCK_DEFAULT_SPINCOUNT);
+        value = *flag;
+    }
+}
+
+/* Subscribe, wait for the first indication, then unsubscribe. The latency
+ * covers the whole round trip, including the delivery of the indication. */
+static MI_Result _Subscribe(Client* self)
+{
+    MI_Operation operation = MI_OPERATION_NULL;
+    MI_OperationCallbacks callbacks = MI_OPERATIONCALLBACKS_NULL;
+    Subscription subscription;
+
+    memset(&subscription, 0, sizeof(subscription));
+    callbacks.callbackContext = &subscription;
+    callbacks.indicationResult = _IndicationResult;
+
+    MI_Session_Subscribe(&self->session, 0, NULL, opts.nameSpace,
+        MI_T("WQL"), INDICATION_QUERY, NULL, &callbacks, &operation);
+
+    _Wait(&subscription.delivered);
+
+    if (!subscription.completed)
+        MI_Operation_Cancel(&operation, MI_REASON_NONE);
+
+    _Wait(&subscription.completed);
+    MI_Operation_Close(&operation);
+
+    return subscription.result;
+}
+
+/*
+**==============================================================================
+**
+** TLS handshakes
+**
+**==============================================================================
+*/
+
+static SSL_CTX* _sslContext;
+
+static int _Connect()
+{
+    struct addrinfo hints;
+    struct addrinfo* addrs;
+    struct addrinfo* p;
+    char port[16];
+    int fd = -1;
+
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    Snprintf(port, sizeof(port), "%d", opts.port ? opts.port : CONFIG_HTTPSPORT);
+
+    if (getaddrinfo(opts.hostname ? opts.hostname : "localhost", port,
+        &hints, &addrs) != 0)
+    {
+        return -1;
+    }
+
+    for (p = addrs; p; p = p->ai_next)
+    {
+        fd = socket(p->ai_family, p->ai_socktype, p->ai_protocol);
+
+        if (fd >= 0 && connect(fd, p->ai_addr, p->ai_addrlen) == 0)
+            break;
+
+        if (fd >= 0)
+            close(fd);
+        fd = -1;
+    }
+
+    freeaddrinfo(addrs);
+    return fd;
+}
+
+/* Connects and shakes hands with the HTTPS listener (resuming the session
+ * of the previous handshake of the client for BENCH_RESUME) */
+static MI_Result _Handshake(Client* self)
+{
+    MI_Result result = MI_RESULT_FAILED;
+    SSL* ssl;
+    int fd;
+
+    fd = _Connect();
+    if (fd < 0)
+        return MI_RESULT_NOT_FOUND;
+
+    ssl = SSL_new(_sslContext);
+    if (!ssl)
+    {
+        close(fd);
+        return MI_RESULT_SERVER_LIMITS_EXCEEDED;
+    }
+
+    SSL_set_fd(ssl, fd);
+
+    if (self->op == BENCH_RESUME && self->sslSession)
+        SSL_set_session(ssl, self->sslSession);
+
+    if (SSL_connect(ssl) == 1)
+    {
+        result = MI_RESULT_OK;
+
+        if (self->op == BENCH_RESUME)
+        {
+            /* The server does not cache sessions or issue tickets */
+            if (self->sslSession && !SSL_session_reused(ssl))
+                result = MI_RESULT_NOT_SUPPORTED;
+
+            if (self->sslSession)
+                SSL_SESSION_free(self->sslSession);
+            self->sslSession = SSL_get1_session(ssl);
+        }
+
+        SSL_shutdown(ssl);
+    }
+
+    SSL_free(ssl);
+    close(fd);
+    return result;
+}
+
+static MI_Result _NewSSLContext()
+{
+    SSL_library_init();
+
+    _sslContext = SSL_CTX_new(SSLv23_client_method());
+    if (!_sslContext)
+        return MI_RESULT_FAILED;
+
+    /* Benchmark the handshakes, not certificate validation */
+    SSL_CTX_set_verify(_sslContext, SSL_VERIFY_NONE, NULL);
+
+#if OPENSSL_VERSION_NUMBER >= 0x10100000L
+    /* TLS 1.3 tickets are only received by reading after the handshake,
+     * which the handshake operations do not do */
+    SSL_CTX_set_max_proto_version(_sslContext, TLS1_2_VERSION);
+#endif
+
+    return MI_RESULT_OK;
+}
+
+static PAL_Uint32 THREAD_API _ClientProc(void* param)
+{
+    Client* self = (Client*)param;
+
+    for (;;)
+    {
+        PAL_Uint64 start;
+        PAL_Uint64 end;
+        MI_Result result;
+
+        if (PAL_Time(&start) != PAL_TRUE || start >= self->deadline)
+            break;
+
+        switch (self->op)
+        {
+            case BENCH_ENUMERATE:
+                result = _Enumerate(self);
+                break;
+            case BENCH_GET:
+                result = _Get(self);
+                break;
+            case BENCH_INVOKE:
+                result = _Invoke(self);
+                break;
+            case BENCH_REFERENCES:
+                result = _References(self);
+                break;
+            case BENCH_HANDSHAKE:
+            case BENCH_RESUME:
+                result = _Handshake(self);
+                break;
+            default:
+                result = _Subscribe(self);
+                break;
+        }
+
+        PAL_Time(&end);
+
+        if (result != MI_RESULT_OK)
+        {
+            self->errors++;
+            self->lastError = result;
+        }
+        else if (Latencies_Add(&self->latencies, end - start) != 0)
+        {
+            break;
+        }
+    }
+
+    return 0;
+}
+
+/*
+**==============================================================================
+**
+** Sessions
+**
+**==============================================================================
+*/
+
+static MI_Result _NewSession(BenchProtocol protocol, MI_Session* session)
+{
+    MI_DestinationOptions options = MI_DESTINATIONOPTIONS_NULL;
+    MI_UserCredentials credentials;
+    MI_Result result;
+
+    if (protocol == BENCH_BINARY)
+    {
+        return MI_Application_NewSession(&_application, NULL, NULL, NULL,
+            NULL, NULL, session);
+    }
+
+    result = MI_Application_NewDestinationOptions(&_application, &options);
+    if (result != MI_RESULT_OK)
+        return result;
+
+    if (opts.user)
+    {
+        memset(&credentials, 0, sizeof(credentials));
+        credentials.authenticationType =
+            opts.auth ? opts.auth : MI_AUTH_TYPE_BASIC;
+        credentials.credentials.usernamePassword.domain =
+            opts.hostname ? opts.hostname : MI_T("localhost");
+        credentials.credentials.usernamePassword.username = opts.user;
+        credentials.credentials.usernamePassword.password = opts.password;
+
+        result = MI_DestinationOptions_AddDestinationCredentials(&options,
+            &credentials);
+        if (result != MI_RESULT_OK)
+            goto done;
+    }
+
+    if (opts.port)
+    {
+        result = MI_DestinationOptions_SetDestinationPort(&options,
+            (MI_Uint32)opts.port);
+        if (result != MI_RESULT_OK)
+            goto done;
+    }
+
+    if (opts.encryption)
+    {
+        MI_Boolean https = Tcscasecmp(opts.encryption, PAL_T("https")) == 0;
+
+        result = MI_DestinationOptions_SetTransport(&options, https ?
+            MI_DESTINATIONOPTIONS_TRANSPORT_HTTPS :
+            MI_DESTINATIONOPTIONS_TRANSPORT_HTTP);
+        if (result != MI_RESULT_OK)
+            goto done;
+
+        result = MI_DestinationOptions_SetPacketPrivacy(&options,
+            Tcscasecmp(opts.encryption, PAL_T("none")) != 0);
+        if (result != MI_RESULT_OK)
+            goto done;
+    }
+
+    result = MI_Application_NewSession(&_application, NULL,
+        opts.hostname ? opts.hostname : MI_T("localhost"), &options, NULL,
+        NULL, session);
+
+done:
+    MI_DestinationOptions_Delete(&options);
+    return result;
+}
+
+/* Make the enumeration of the class return 'opts.instances' instances */
+static MI_Result _SetBehaviour(MI_Session* session, BenchClass cls)
+{
+    MI_Operation operation = MI_OPERATION_NULL;
+    MI_Instance* params;
+    MI_Value value;
+    MI_Result result;
+
+    result = MI_Application_NewParameterSet(&_application, NULL, &params);
+    if (result != MI_RESULT_OK)
+        return result;
+
+    value.uint32 = opts.instances;
+    result = MI_Instance_AddElement(params, MI_T("maxInstances"), &value,
+        MI_UINT32, 0);
+
+    value.uint32 = 0;
+    if (result == MI_RESULT_OK)
+        result = MI_Instance_AddElement(params, MI_T("streamInstances"),
+            &value, MI_UINT32, 0);
+    if (result == MI_RESULT_OK)
+        result = MI_Instance_AddElement(params, MI_T("psSemanticsFlags"),
+            &value, MI_UINT32, 0);
+    if (result == MI_RESULT_OK)
+        result = MI_Instance_AddElement(params, MI_T("psSemanticsCount"),
+            &value, MI_UINT32, 0);
+
+    value.boolean = MI_FALSE;
+    if (result == MI_RESULT_OK && cls == BENCH_NOPSSEMANTICS)
+        result = MI_Instance_AddElement(params,
+            MI_T("enablePostNumberInstances"), &value, MI_BOOLEAN, 0);
+
+    if (result == MI_RESULT_OK)
+    {
+        MI_Session_Invoke(session, 0, NULL, opts.nameSpace, _classNames[cls],
+            MI_T("SetBehaviour"), NULL, params, NULL, &operation);
+
+        result = _DrainInstances(&operation);
+        MI_Operation_Close(&operation);
+    }
+
+    MI_Instance_Delete(params);
+    return result;
+}
+
+/*
+**==============================================================================
+**
+** Benchmark
+**
+**==============================================================================
+*/
+
+typedef struct _Report
+{
+    BenchProtocol protocol;
+    BenchOp op;
+
+    /* Class of an instance operation, BENCH_NUM_CLASSES otherwise */
+    BenchClass cls;
+    int threads;
+    MI_Uint64 count;
+    MI_Uint64 errors;
+    MI_Result lastError;
+    double seconds;
+    Latencies latencies;
+    MI_Uint64 mean;
+    MI_Uint64 serverKB;
+    MI_Uint64 agentsKB;
+}
+Report;
+
+static MI_Result _Run(Client* clients, BenchProtocol protocol, BenchOp op,
+    BenchClass cls, Report* report)
+{
+    PAL_Uint64 start;
+    PAL_Uint64 end;
+    MI_Uint64 sum = 0;
+    int threads = opts.threads;
+    int i;
+
+    if (op == BENCH_SUBSCRIBE && opts.subscribers < threads)
+        threads = opts.subscribers;
+
+    memset(report, 0, sizeof(Report));
+    report->protocol = protocol;
+    report->op = op;
+    report->cls = cls;
+    report->threads = threads;
+
+    PAL_Time(&start);
+
+    for (i = 0; i < threads; i++)
+    {
+        clients[i].op = op;
+        clients[i].cls = cls;
+        clients[i].deadline = start + (MI_Uint64)opts.seconds * 1000000;
+        clients[i].key = (MI_Uint64)i;
+        clients[i].errors = 0;
+        clients[i].lastError = MI_RESULT_OK;
+        clients[i].latencies.size = 0;
+
+        if (Thread_CreateJoinable(&clients[i].thread, _ClientProc, NULL,
+            &clients[i]) != 0)
+        {
+            err(PAL_T("failed to create thread"));
+
+            while (i--)
+            {
+                PAL_Uint32 ret;
+                Thread_Join(&clients[i].thread, &ret);
+                Thread_Destroy(&clients[i].thread);
+            }
+
+            return MI_RESULT_FAILED;
+        }
+    }
+
+    for (i = 0; i < threads; i++)
+    {
+        PAL_Uint32 ret;
+        Thread_Join(&clients[i].thread, &ret);
+        Thread_Destroy(&clients[i].thread);
+    }
+
+    PAL_Time(&end);
+    report->seconds = (double)(end - start) / 1000000.0;
+
+    /* Measured right after the load (before the server can trim) */
+    if (opts.pid > 0)
+        GetServerRSS(opts.pid, &report->serverKB, &report->agentsKB);
+
+    for (i = 0; i < threads; i++)
+    {
+        size_t j;
+
+        report->errors += clients[i].errors;
+
+        if (clients[i].lastError != MI_RESULT_OK)
+            report->lastError = clients[i].lastError;
+
+        for (j = 0; j < clients[i].latencies.size; j++)
+        {
+            if (Latencies_Add(&report->latencies,
+                clients[i].latencies.data[j]) != 0)
+            {
+                return MI_RESULT_SERVER_LIMITS_EXCEEDED;
+            }
+
+            sum += clients[i].latencies.data[j];
+        }
+    }
+
+    report->count = report->latencies.size;
+
+    if (report->latencies.size)
+    {
+        qsort(report->latencies.data, report->latencies.size,
+            sizeof(MI_Uint64), _CompareUint64);
+        report->mean = sum / report->latencies.size;
+    }
+
+    return MI_RESULT_OK;
+}
+
+/* Class the operation of a report ran against */
+static const MI_Char* _ReportClass(const Report* r)
+{
+    if (r->cls < BENCH_NUM_CLASSES)
+        return _classNames[r->cls];
+
+    return r->op == BENCH_SUBSCRIBE ? MI_T("Perf_Indication") : MI_T("-");
+}
+
+/* Print 's' left-aligned in a column of the given width */
+static void _PrintColumn(FILE* os, const MI_Char* s, size_t width)
+{
+    size_t n;
+
+    Ftprintf(os, PAL_T("%T "), tcs(s));
+
+    for (n = Tcslen(s); n < width; n++)
+        Ftprintf(os, PAL_T(" "));
+}
+
+static void _PrintText(FILE* os, const Report* reports, size_t count)
+{
+    size_t i;
+
+    Ftprintf(os, PAL_T("threads: %d, seconds: %d, instances: %u\n\n"),
+        opts.threads, opts.seconds, opts.instances);
+
+    Ftprintf(os, PAL_T("protocol operation  class                threads        ops   errors    ops/sec  p50(us)  p90(us)  p99(us)  max(us) mean(us)    rss(kB) agents(kB)\n"));
+
+    for (i = 0; i < count; i++)
+    {
+        const Report* r = &reports[i];
+
+        _PrintColumn(os, _protocolNames[r->protocol], 8);
+        _PrintColumn(os, _opNames[r->op], 10);
+        _PrintColumn(os, _ReportClass(r), 20);
+
+        Ftprintf(os, PAL_T("%7d %10llu %8llu %10.1f %8llu %8llu %8llu %8llu %8llu %10llu %10llu\n"),
+            r->threads,
+            (unsigned long long)r->count,
+            (unsigned long long)r->errors,
+            r->seconds > 0 ? r->count / r->seconds : 0.0,
+            (unsigned long long)Latencies_Percentile(&r->latencies, 50),
+            (unsigned long long)Latencies_Percentile(&r->latencies, 90),
+            (unsigned long long)Latencies_Percentile(&r->latencies, 99),
+            (unsigned long long)Latencies_Percentile(&r->latencies, 100),
+            (unsigned long long)r->mean,
+            (unsigned long long)r->serverKB,
+            (unsigned long long)r->agentsKB);
+
+        if (r->errors)
+        {
+            Ftprintf(os, PAL_T("    last error: %T\n"),
+                tcs(Result_ToString(r->lastError)));
+        }
+    }
+}
+
+static void _PrintJSON(FILE* os, const Report* reports, size_t count)
+{
+    size_t i;
+
+    Ftprintf(os, PAL_T("{\n"));
+    Ftprintf(os, PAL_T("  \"namespace\": \"%T\",\n"), tcs(opts.nameSpace));
+    Ftprintf(os, PAL_T("  \"threads\": %d,\n"), opts.threads);
+    Ftprintf(os, PAL_T("  \"seconds\": %d,\n"), opts.seconds);
+    Ftprintf(os, PAL_T("  \"instances\": %u,\n"), opts.instances);
+    Ftprintf(os, PAL_T("  \"results\": [\n"));
+
+    for (i = 0; i < count; i++)
+    {
+        const Report* r = &reports[i];
+
+        Ftprintf(os, PAL_T("    {\"protocol\": \"%T\", \"operation\": \"%T\", \"class\": \"%T\", "),
+            tcs(_protocolNames[r->protocol]), tcs(_opNames[r->op]),
+            tcs(_ReportClass(r)));
+        Ftprintf(os, PAL_T("\"threads\": %d, \"ops\": %llu, \"errors\": %llu, "),
+            r->threads, (unsigned long long)r->count, (unsigned long long)r->errors);
+        Ftprintf(os, PAL_T("\"ops_per_sec\": %.1f, "),
+            r->seconds > 0 ? r->count / r->seconds : 0.0);
+        Ftprintf(os, PAL_T("\"latency_us\": {\"p50\": %llu, \"p90\": %llu, \"p99\": %llu, \"max\": %llu, \"mean\": %llu}, "),
+            (unsigned long long)Latencies_Percentile(&r->latencies, 50),
+            (unsigned long long)Latencies_Percentile(&r->latencies, 90),
+            (unsigned long long)Latencies_Percentile(&r->latencies, 99),
+            (unsigned long long)Latencies_Percentile(&r->latencies, 100),
+            (unsigned long long)r->mean);
+        Ftprintf(os, PAL_T("\"server_rss_kb\": %llu, \"agents_rss_kb\": %llu}%T\n"),
+            (unsigned long long)r->serverKB,
+            (unsigned long long)r->agentsKB,
+            i + 1 == count ? PAL_T("") : PAL_T(","));
+    }
+
+    Ftprintf(os, PAL_T("  ]\n"));
+    Ftprintf(os, PAL_T("}\n"));
+}
+
+/*
+**==============================================================================
+**
+** Options
+**
+**==============================================================================
+*/
+
+/* Set selected[i] for each of the comma-separated names[i] in 'arg' */
+static int _ParseList(const MI_Char* arg, const MI_Char** names, int count,
+    MI_Boolean* selected)
+{
+    const MI_Char* p = arg;
+
+    memset(selected, 0, count * sizeof(MI_Boolean));
+
+    while (*p)
+    {
+        const MI_Char* end = Tcschr(p, ',');
+        size_t n = end ? (size_t)(end - p) : Tcslen(p);
+        int i;
+
+        for (i = 0; i < count; i++)
+        {
+            if (Tcslen(names[i]) == n && Tcsncmp(names[i], p, n) == 0)
+                break;
+        }
+
+        if (i == count)
+            return -1;
+
+        selected[i] = MI_TRUE;
+        p += n;
+
+        if (*p == ',')
+            p++;
+    }
+
+    return 0;
+}
+
+static MI_Result GetCommandLineOptions(int argc, const MI_Char* argv[])
+{
+    int i;
+
+    opts.nameSpace = NAMESPACE_DEFAULT;
+    opts.threads = 4;
+    opts.subscribers = 1;
+    opts.seconds = 5;
+    opts.instances = 10;
+    opts.ops[BENCH_ENUMERATE] = MI_TRUE;
+    opts.ops[BENCH_GET] = MI_TRUE;
+    opts.ops[BENCH_INVOKE] = MI_TRUE;
+    opts.ops[BENCH_REFERENCES] = MI_TRUE;
+    opts.ops[BENCH_SUBSCRIBE] = MI_TRUE;
+    opts.classes[BENCH_NOPSSEMANTICS] = MI_TRUE;
+    opts.classes[BENCH_WITHPSSEMANTICS] = MI_TRUE;
+    opts.protocols[BENCH_BINARY] = MI_TRUE;
+
+    for (i = 1; i < argc; i++)
+    {
+        const MI_Char* opt = argv[i];
+        const MI_Char* arg = NULL;
+
+        if (Tcscmp(opt, MI_T("-h")) == 0 || Tcscmp(opt, MI_T("--help")) == 0)
+        {
+            opts.help = MI_TRUE;
+            continue;
+        }
+
+        /* All other options take an argument */
+        if (i + 1 == argc)
+        {
+            err(PAL_T("missing option argument: %T"), tcs(opt));
+            return MI_RESULT_INVALID_PARAMETER;
+        }
+
+        arg = argv[++i];
+
+        if (Tcscmp(opt, MI_T("-n")) == 0)
+        {
+            opts.nameSpace = arg;
+        }
+        else if (Tcscmp(opt, MI_T("-t")) == 0)
+        {
+            opts.threads = (int)Tcstol(arg, NULL, 10);
+
+            if (opts.threads <= 0 || opts.threads > MAX_THREADS)
+            {
+                err(PAL_T("bad value for -t: %T"), tcs(arg));
+                return MI_RESULT_INVALID_PARAMETER;
+            }
+        }
+        else if (Tcscmp(opt, MI_T("--subscribers")) == 0)
+        {
+            opts.subscribers = (int)Tcstol(arg, NULL, 10);
+
+            if (opts.subscribers <= 0 || opts.subscribers > MAX_THREADS)
+            {
+                err(PAL_T("bad value for --subscribers: %T"), tcs(arg));
+                return MI_RESULT_INVALID_PARAMETER;
+            }
+        }
+        else if (Tcscmp(opt, MI_T("-d")) == 0)
+        {
+            opts.seconds = (int)Tcstol(arg, NULL, 10);
+
+            if (opts.seconds <= 0)
+            {
+                err(PAL_T("bad value for -d: %T"), tcs(arg));
+                return MI_RESULT_INVALID_PARAMETER;
+            }
+        }
+        else if (Tcscmp(opt, MI_T("--ops")) == 0)
+        {
+            if (_ParseList(arg, _opNames, BENCH_NUM_OPS, opts.ops) != 0)
+            {
+                err(PAL_T("bad value for --ops: %T"), tcs(arg));
+                return MI_RESULT_INVALID_PARAMETER;
+            }
+        }
+        else if (Tcscmp(opt, MI_T("--classes")) == 0)
+        {
+            if (_ParseList(arg, _classNames, BENCH_NUM_CLASSES,
+                opts.classes) != 0)
+            {
+                err(PAL_T("bad value for --classes: %T"), tcs(arg));
+                return MI_RESULT_INVALID_PARAMETER;
+            }
+        }
+        else if (Tcscmp(opt, MI_T("--instances")) == 0)
+        {
+            opts.instances = (MI_Uint32)Tcstol(arg, NULL, 10);
+        }
+        else if (Tcscmp(opt, MI_T("--protocol")) == 0)
+        {
+            MI_Boolean both = Tcscmp(arg, MI_T("both")) == 0;
+
+            opts.protocols[BENCH_BINARY] =
+                both || Tcscmp(arg, MI_T("binary")) == 0;
+            opts.protocols[BENCH_WSMAN] =
+                both || Tcscmp(arg, MI_T("wsman")) == 0;
+
+            if (!opts.protocols[BENCH_BINARY] && !opts.protocols[BENCH_WSMAN])
+            {
+                err(PAL_T("bad value for --protocol: %T"), tcs(arg));
+                return MI_RESULT_INVALID_PARAMETER;
+            }
+        }
+        else if (Tcscmp(opt, MI_T("--hostname")) == 0)
+        {
+            opts.hostname = arg;
+        }
+        else if (Tcscmp(opt, MI_T("--port")) == 0)
+        {
+            opts.port = (int)Tcstol(arg, NULL, 10);
+        }
+        else if (Tcscmp(opt, MI_T("--encryption")) == 0)
+        {
+            if (Tcscasecmp(arg, PAL_T("http")) != 0 &&
+                Tcscasecmp(arg, PAL_T("https")) != 0 &&
+                Tcscasecmp(arg, PAL_T("none")) != 0)
+            {
+                err(PAL_T("invalid value for encryption. allowed values are : http, https, none"));
+                return MI_RESULT_INVALID_PARAMETER;
+            }
+
+            opts.encryption = arg;
+        }
+        else if (Tcscmp(opt, MI_T("--auth")) == 0)
+        {
+            opts.auth = arg;
+        }
+        else if (Tcscmp(opt, MI_T("-u")) == 0)
+        {
+            opts.user = arg;
+        }
+        else if (Tcscmp(opt, MI_T("-p")) == 0)
+        {
+            opts.password = arg;
+        }
+        else if (Tcscmp(opt, MI_T("--format")) == 0)
+        {
+            if (Tcscmp(arg, MI_T("json")) == 0)
+                opts.json = MI_TRUE;
+            else if (Tcscmp(arg, MI_T("text")) != 0)
+            {
+                err(PAL_T("bad value for --format: %T"), tcs(arg));
+                return MI_RESULT_INVALID_PARAMETER;
+            }
+        }
+        else if (Tcscmp(opt, MI_T("-o")) == 0)
+        {
+            opts.output = arg;
+        }
+        else if (Tcscmp(opt, MI_T("--pid")) == 0)
+        {
+            opts.pid = (int)Tcstol(arg, NULL, 10);
+        }
+        else if (Tcscmp(opt, MI_T("--destdir")) == 0)
+        {
+            if (SetPath(ID_DESTDIR, arg) != 0)
+            {
+                err(PAL_T("failed to set destdir"));
+                return MI_RESULT_FAILED;
+            }
+        }
+        else
+        {
+            err(PAL_T("unknown option: %T"), tcs(opt));
+            return MI_RESULT_INVALID_PARAMETER;
+        }
+    }
+
+    return MI_RESULT_OK;
+}
+
+/*
+**==============================================================================
+**
+** main
+**
+**==============================================================================
+*/
+
+static MI_Result benchmain(int argc, const MI_Char* argv[])
+{
+    Client* clients = NULL;
+    Report reports[BENCH_NUM_PROTOCOLS * BENCH_NUM_OPS * BENCH_NUM_CLASSES];
+    size_t numReports = 0;
+    MI_Boolean instanceOps = MI_FALSE;
+    MI_Result result;
+    int protocol;
+    int cls;
+    int op;
+    int i;
+
+    sout = stdout;
+    serr = stderr;
+    arg0 = argv[0];
+
+    result = GetCommandLineOptions(argc, argv);
+    if (result != MI_RESULT_OK)
+        return result;
+
+    if (opts.help)
+    {
+        Ftprintf(sout, USAGE, tcs(arg0));
+        return MI_RESULT_OK;
+    }
+
+    /* Default to the server of this installation */
+    if (opts.pid == 0 && PIDFile_Read(&opts.pid) != 0)
+        opts.pid = 0;
+
+    if (opts.output && !(sout = fopen(opts.output, "w")))
+    {
+        err(PAL_T("failed to open: %T"), tcs(opts.output));
+        return MI_RESULT_FAILED;
+    }
+
+    result = MI_Application_Initialize(0, NULL, NULL, &_application);
+    if (result != MI_RESULT_OK)
+    {
+        err(PAL_T("failed to initialize application: %T"),
+            tcs(Result_ToString(result)));
+        goto done;
+    }
+
+    for (op = 0; op < BENCH_FIRST_CLASSLESS_OP; op++)
+        instanceOps = instanceOps || opts.ops[op];
+
+    for (op = BENCH_FIRST_TLS_OP; op < BENCH_NUM_OPS; op++)
+    {
+        if (opts.ops[op] && !_sslContext && _NewSSLContext() != MI_RESULT_OK)
+        {
+            err(PAL_T("failed to create the SSL context"));
+            result = MI_RESULT_FAILED;
+            goto done;
+        }
+    }
+
+    clients = (Client*)calloc((size_t)opts.threads, sizeof(Client));
+    if (!clients)
+    {
+        result = MI_RESULT_SERVER_LIMITS_EXCEEDED;
+        goto done;
+    }
+
+    for (protocol = 0; protocol < BENCH_NUM_PROTOCOLS; protocol++)
+    {
+        if (!opts.protocols[protocol])
+            continue;
+
+        for (i = 0; i < opts.threads; i++)
+        {
+            result = _NewSession((BenchProtocol)protocol, &clients[i].session);
+
+            if (result != MI_RESULT_OK)
+            {
+                err(PAL_T("failed to create %T session: %T"),
+                    tcs(_protocolNames[protocol]),
+                    tcs(Result_ToString(result)));
+
+                while (i--)
+                    MI_Session_Close(&clients[i].session, NULL, NULL);
+
+                goto done;
+            }
+        }
+
+        for (cls = 0; cls < BENCH_NUM_CLASSES && instanceOps &&
+            result == MI_RESULT_OK; cls++)
+        {
+            if (!opts.classes[cls])
+                continue;
+
+            result = _SetBehaviour(&clients[0].session, (BenchClass)cls);
+            if (result != MI_RESULT_OK)
+            {
+                err(PAL_T("failed to invoke %T.SetBehaviour() (are the Perf_WMIv2 providers registered?): %T"),
+                    tcs(_classNames[cls]), tcs(Result_ToString(result)));
+            }
+
+            for (op = 0; op < BENCH_FIRST_CLASSLESS_OP &&
+                result == MI_RESULT_OK; op++)
+            {
+                if (opts.ops[op])
+                {
+                    result = _Run(clients, (BenchProtocol)protocol,
+                        (BenchOp)op, (BenchClass)cls, &reports[numReports]);
+
+                    if (result == MI_RESULT_OK)
+                        numReports++;
+                }
+            }
+        }
+
+        for (op = BENCH_FIRST_CLASSLESS_OP;
+            op < BENCH_NUM_OPS && result == MI_RESULT_OK; op++)
+        {
+            /* The handshakes are with the WS-Man HTTPS listener */
+            if (op >= BENCH_FIRST_TLS_OP && protocol != BENCH_WSMAN)
+                continue;
+
+            if (opts.ops[op])
+            {
+                result = _Run(clients, (BenchProtocol)protocol, (BenchOp)op,
+                    BENCH_NUM_CLASSES, &reports[numReports]);
+
+                if (result == MI_RESULT_OK)
+                    numReports++;
+            }
+        }
+
+        for (i = 0; i < opts.threads; i++)
+            MI_Session_Close(&clients[i].session, NULL, NULL);
+
+        if (result != MI_RESULT_OK)
+            goto done;
+    }
+
+    if (opts.json)
+        _PrintJSON(sout, reports, numReports);
+    else
+        _PrintText(sout, reports, numReports);
+
+done:
+
+    for (i = 0; i < (int)numReports; i++)
+        free(reports[i].latencies.data);
+
+    if (clients)
+    {
+        for (i = 0; i < opts.threads; i++)
+        {
+            free(clients[i].latencies.data);
+
+            if (clients[i].sslSession)
+                SSL_SESSION_free(clients[i].sslSession);
+        }
+
+        free(clients);
+    }
+
+    MI_Application_Close(&_application);
+
+    if (_sslContext)
+        SSL_CTX_free(_sslContext);
+
+    if (sout != stdout)
+        fclose(sout);
+
+    return result;
+}
+
+#if defined (_MSC_VER)
+int MI_MAIN_CALL wmain(int argc, const MI_Char* argv[])
+{
+    return (int)benchmain(argc, argv);
+}
+#else
+int MI_MAIN_CALL main(int argc, const char* argv[])
+{
+#if defined (MI_USE_WCHAR)
+    /* Going to need to convert the args to MI_Char */
+    printf("Do not support %s when using wide char support yet\n", argv[0]);
+    return 0;
+#else
+    return (int)benchmain(argc, argv);
+#endif
+}
+#endif
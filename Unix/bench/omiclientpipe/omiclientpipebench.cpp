@@ -0,0 +1,151 @@
+/*
+**==============================================================================
+**
+** Copyright (c) Microsoft Corporation. All rights reserved. See file LICENSE
+** for license information.
+**
+**==============================================================================
+*/
+
+/*
+**==============================================================================
+**
+** omiclientpipebench
+**
+**     Microbenchmark of the pipelined operations of the C++ client: gets
+**     COUNT MSFT_President instances (the President sample provider, which
+**     must be registered with a running server) over the local socket, one
+**     at a time with Client::GetInstance() then pipelined with
+**     Client::SubmitGetInstance() for each WINDOW, and prints the
+**     operations per second.
+**
+**         omiclientpipebench [COUNT [WINDOW...]]
+**
+**==============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <common.h>
+#include <pal/sleep.h>
+#include <omiclient/client.h>
+
+using namespace mi;
+
+#define NAMESPACE MI_T("root/test")
+#define CLASSNAME MI_T("MSFT_President")
+
+static const Uint64 TIMEOUT = 60 * 1000 * 1000;
+
+static DInstance _InstanceName(size_t i)
+{
+    DInstance name(CLASSNAME, DInstance::CLASS);
+    name.AddUint32(MI_T("Key"), (Uint32)(1 + i % 2), false, true);
+    return name;
+}
+
+/* Operations per second, or 0 on failure */
+static double _Serial(Client& client, size_t count)
+{
+    PAL_Uint64 start = 0;
+    PAL_Uint64 end = 0;
+
+    PAL_Time(&start);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        DInstance instance;
+        Result result = MI_RESULT_FAILED;
+
+        if (!client.GetInstance(NAMESPACE, _InstanceName(i), TIMEOUT, instance,
+            result) || result != MI_RESULT_OK)
+            return 0;
+    }
+
+    PAL_Time(&end);
+
+    return end > start ? (double)count * 1000000.0 / (double)(end - start) : 0;
+}
+
+static double _Pipelined(Client& client, size_t count, Uint32 window)
+{
+    PAL_Uint64 start = 0;
+    PAL_Uint64 end = 0;
+    Array<Future> futures;
+
+    futures.Resize((Uint32)count);
+    client.SetWindow(window);
+
+    PAL_Time(&start);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (!client.SubmitGetInstance(NAMESPACE, _InstanceName(i),
+            futures[(Uint32)i]))
+            return 0;
+    }
+
+    if (!client.WaitAll(TIMEOUT))
+        return 0;
+
+    PAL_Time(&end);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (futures[(Uint32)i].GetResult() != MI_RESULT_OK)
+            return 0;
+    }
+
+    return end > start ? (double)count * 1000000.0 / (double)(end - start) : 0;
+}
+
+int MI_MAIN_CALL main(int argc, const char* argv[])
+{
+    static const Uint32 windows[] = { 1, 4, 16, 64 };
+    size_t count = 10000;
+    Client client;
+
+    if (argc > 1)
+        count = (size_t)strtoul(argv[1], NULL, 10);
+
+    if (count == 0)
+    {
+        fprintf(stderr, "Usage: %s [COUNT [WINDOW...]]\n", argv[0]);
+        return 1;
+    }
+
+    if (!client.Connect(String(), String(), String(), TIMEOUT))
+    {
+        fprintf(stderr, "%s: cannot connect to the server\n", argv[0]);
+        return 1;
+    }
+
+    printf("%-12s %12s\n", "window", "ops/sec");
+
+    double serial = _Serial(client, count);
+    if (serial == 0)
+    {
+        fprintf(stderr, "%s: GetInstance failed\n", argv[0]);
+        return 1;
+    }
+    printf("%-12s %12.0f\n", "serial", serial);
+
+    /* Windows given on the command line, the default ones otherwise */
+    size_t nwindows = argc > 2 ? (size_t)argc - 2 : MI_COUNT(windows);
+
+    for (size_t i = 0; i < nwindows; i++)
+    {
+        Uint32 window = argc > 2 ?
+            (Uint32)strtoul(argv[i + 2], NULL, 10) : windows[i];
+        double pipelined = _Pipelined(client, count, window);
+
+        if (pipelined == 0)
+        {
+            fprintf(stderr, "%s: SubmitGetInstance failed\n", argv[0]);
+            return 1;
+        }
+        printf("%-12u %12.0f\n", (unsigned)window, pipelined);
+    }
+
+    return 0;
+}
@@ -3,6 +3,7 @@
 .PHONY: install
 .PHONY: server
 .PHONY: tests
+.PHONY: bench
 
 ifndef OUTPUTDIR
 $(error OUTPUTDIR is undefined)
@@ -92,6 +93,11 @@ DIRECTORIES += configeditor
 DIRECTORIES += cli
 DIRECTORIES += omireg
 DIRECTORIES += check
+DIRECTORIES += bench
+DIRECTORIES += bench/numconv
+DIRECTORIES += bench/mofcompile
+DIRECTORIES += bench/micxxpost
+DIRECTORIES += bench/omiclientpipe
 DIRECTORIES += samples
 
 ifndef DISABLE_INDICATION
@@ -115,6 +121,7 @@ TESTDIRS += tests/mof
 TESTDIRS += tests/base
 TESTDIRS += tests/provreg
 TESTDIRS += tests/provmgr
+TESTDIRS += tests/disp
 TESTDIRS += tests/micxx
 TESTDIRS += tests/sock
 TESTDIRS += tests/protocol
@@ -336,6 +343,25 @@ check:
 	sleep 2
 	rm -rf $(CHECKDIR)
 
+##==============================================================================
+##
+## bench: run omibench against the Perf_WMIv2 providers (see bench/omibench.c)
+##
+##==============================================================================
+
+BENCHOPTS=-t 4 -d 5 --instances 100
+
+bench:
+	$(MAKE) -C samples/Providers/Perf_WMIv2
+	$(MAKE) -C samples/Providers/Perf_WMIv2 localreg
+	$(BINDIR)/omiserver -i -d --livetime 600 --httpsport 0
+	sleep 2
+	( $(BINDIR)/omibench $(BENCHOPTS) --format json -o $(TMPDIR)/omibench.json; \
+	  status=$$?; \
+	  $(BINDIR)/omiserver -s; \
+	  cat $(TMPDIR)/omibench.json; \
+	  exit $$status )
+
 ##==============================================================================
 ##
 ## size: print size of omiserver
@@ -403,10 +429,13 @@ stop:
 OIGENC_IN=./base/oi_traces.h
 OIGENC_OUT=./base/oiomi.h
 
+# FILE or BINARY (binary trace records, see base/oibinary.h)
+OIGENC_MODE=FILE
+
 oigenc:
 	chmod +w $(OIGENC_IN)
 	chmod +w $(OIGENC_OUT)
-	$(BINDIR)/oigenc FILE $(OIGENC_IN) $(OIGENC_OUT)
+	$(BINDIR)/oigenc $(OIGENC_MODE) $(OIGENC_IN) $(OIGENC_OUT)
 
 ##==============================================================================
 ##
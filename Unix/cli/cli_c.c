@@ -672,17 +672,21 @@ static MI_Result ConsumeInstanceResults(MI_Operation *miOperation)
         do
         {
             const MI_Instance *miInstanceResult = NULL;
+            const MI_Instance *miInstanceResults[64];
+            MI_Uint32 miInstanceCount = 0;
+            MI_Uint32 i;
             MI_Result _miResult;
             const MI_Char *errorString = NULL;
             const MI_Instance *errorDetails = NULL;
 
-            _miResult = MI_Operation_GetInstance(miOperation, &miInstanceResult, &moreResults, &miResult, &errorString, &errorDetails);
+            _miResult = MI_Operation_GetInstances(miOperation, MI_COUNT(miInstanceResults), miInstanceResults, &miInstanceCount, &moreResults, &miResult, &errorString, &errorDetails);
             if (_miResult != MI_RESULT_OK)
             {
                 miResult = _miResult;
             }
-            if (miInstanceResult)
+            for (i = 0; i < miInstanceCount; i++)
             {
+                miInstanceResult = miInstanceResults[i];
                 s_numInstances++;
 
                 if (!opts.quiet)
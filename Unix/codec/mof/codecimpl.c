@@ -372,7 +372,7 @@ MI_Result MI_CALL Mof_OnNewClassDecl(
             {
                 const MI_ClassDecl *cd = self->coi->classes.data[i]->classDecl;
                 r = StringHash_Add(self->resultbatch,
-                    &self->coi->classesHash, i, cd->code, cd->name);
+                    &self->coi->classesHash, i, cd->name);
                 if (r != 0)
                 {
                     mof_report_error(&self->errhandler, ID_OUT_OF_MEMORY, "");
@@ -386,7 +386,6 @@ MI_Result MI_CALL Mof_OnNewClassDecl(
             int r = StringHash_Add(self->resultbatch,
                 &self->coi->classesHash,
                 self->coi->classes.size-1,
-                newclass->classDecl->code,
                 newclass->classDecl->name);
             if (r != 0)
             {
@@ -209,6 +209,27 @@ void MI_MofCodec_onError(
     _In_opt_z_ const MI_Char * errorType,
     _In_opt_z_ const MI_Char * errorMessage);
 
+/*
+**==============================================================================
+**
+** Helpers shared with the streaming deserializer (mofstream.c)
+**
+**==============================================================================
+*/
+struct _MOF_State;
+
+MI_Result _SetOperationOptions(
+    _In_opt_ MI_OperationOptions *options,
+    _Inout_ MI_MofCodec *self);
+
+void _SetupStateCallback(
+    _In_ struct _MOF_State *state,
+    _In_opt_ MI_MofCodec * self);
+
+MI_Result _NewClassOnClassDecl(
+    _In_ MI_MofCodec * self,
+    _In_ const MI_ClassDecl* classDecl,
+    _Outptr_result_maybenull_ MI_Class** newClass);
 
 
 /*
@@ -16,6 +16,7 @@
 #endif
 #endif
 #include <base/memman.h>
+#include <base/numconv.h>
 #include "buf.h"
 #include "strset.h"
 #include <pal/strings.h>
@@ -217,31 +218,7 @@ static void _DatetimeToStr(
     _In_ const MI_Datetime* x, 
     _Pre_writable_size_(DATETIME_STR_SIZE) MI_Char buf[DATETIME_STR_SIZE])
 {
-    if (x->isTimestamp)
-    {
-        const MI_Char FMT[] =  T("%04d%02d%02d%02d%02d%02d.%06d%c%03d");
-        MI_Sint32 utc = x->u.timestamp.utc;
-        SNPRINTF(buf, DATETIME_STR_SIZE, FMT,
-            x->u.timestamp.year,
-            x->u.timestamp.month,
-            x->u.timestamp.day,
-            x->u.timestamp.hour,
-            x->u.timestamp.minute,
-            x->u.timestamp.second,
-            x->u.timestamp.microseconds,
-            utc < 0 ? '-' : '+',
-            utc < 0 ? -utc : utc);
-    }
-    else
-    {
-        const MI_Char FMT[] = T("%08u%02u%02u%02u.%06u:000");
-        SNPRINTF(buf, DATETIME_STR_SIZE, FMT,
-            x->u.interval.days,
-            x->u.interval.hours,
-            x->u.interval.minutes,
-            x->u.interval.seconds,
-            x->u.interval.microseconds);
-    }
+    NumConv_DatetimeToZStr(buf, x);
 }
 
 
@@ -431,61 +408,61 @@ static MI_Result _PutScalarValue(
         }
         case MI_UINT8:
         {
-            int n = SNPRINTF(buf, MI_COUNT(buf), T("%u"), value->uint8);
+            size_t n = NumConv_Uint64ToZStr(buf, value->uint8);
             r = Buf_Put(out, buf, n);
             break;
         }
         case MI_SINT8:
         {
-            int n = SNPRINTF(buf, MI_COUNT(buf), T("%d"), value->sint8);
+            size_t n = NumConv_Sint64ToZStr(buf, value->sint8);
             r = Buf_Put(out, buf, n);
             break;
         }
         case MI_UINT16:
         {
-            int n = SNPRINTF(buf, MI_COUNT(buf), T("%u"), value->uint16);
+            size_t n = NumConv_Uint64ToZStr(buf, value->uint16);
             r = Buf_Put(out, buf, n);
             break;
         }
         case MI_SINT16:
         {
-            int n = SNPRINTF(buf, MI_COUNT(buf), T("%d"), value->sint16);
+            size_t n = NumConv_Sint64ToZStr(buf, value->sint16);
             r = Buf_Put(out, buf, n);
             break;
         }
         case MI_UINT32:
         {
-            int n = SNPRINTF(buf, MI_COUNT(buf), T("%u"), value->uint32);
+            size_t n = NumConv_Uint64ToZStr(buf, value->uint32);
             r = Buf_Put(out, buf, n);
             break;
         }
         case MI_SINT32:
         {
-            int n = SNPRINTF(buf, MI_COUNT(buf), T("%d"), value->sint32);
+            size_t n = NumConv_Sint64ToZStr(buf, value->sint32);
             r = Buf_Put(out, buf, n);
             break;
         }
         case MI_UINT64:
         {
-            int n = SNPRINTF(buf, MI_COUNT(buf), LLU, value->uint64);
+            size_t n = NumConv_Uint64ToZStr(buf, value->uint64);
             r = Buf_Put(out, buf, n);
             break;
         }
         case MI_SINT64:
         {
-            int n = SNPRINTF(buf, MI_COUNT(buf), LLD, value->sint64);
+            size_t n = NumConv_Sint64ToZStr(buf, value->sint64);
             r = Buf_Put(out, buf, n);
             break;
         }
         case MI_REAL32:
         {
-            int n = SNPRINTF(buf, MI_COUNT(buf), T("%.23E"), value->real32);
+            size_t n = NumConv_Real64ToZStr(buf, value->real32, 23, 'E');
             r = Buf_Put(out, buf, n);
             break;
         }
         case MI_REAL64:
         {
-            int n = SNPRINTF(buf, MI_COUNT(buf), T("%.52E"), value->real64);
+            size_t n = NumConv_Real64ToZStr(buf, value->real64, 52, 'E');
             r = Buf_Put(out, buf, n);
             break;
         }
@@ -0,0 +1,1112 @@
+/*
+**==============================================================================
+**
+** Copyright (c) Microsoft Corporation. All rights reserved. See file LICENSE
+** for license information.
+**
+**==============================================================================
+*/
+
+#ifdef _PREFAST_
+# pragma prefast (push)
+# pragma prefast (disable: 28252)
+# pragma prefast (disable: 28253)
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <state.h>
+#include <base/batch.h>
+#include <pal/strings.h>
+#include "mofstream.h"
+#include "ptrarray.h"
+
+#ifdef _PREFAST_
+# pragma prefast (pop)
+#endif
+
+/* Largest declaration, same limit as the whole buffer of MI_Deserializer */
+extern const MI_Uint32 MAX_BUFFER_SIZE;
+
+/* The parser rejects buffers of 4 bytes or less */
+#define MIN_DECL_BUFFER_SIZE 5
+
+static const MI_Uint8 _utf8Bom[] = { 0xEF, 0xBB, 0xBF };
+
+/*
+**==============================================================================
+**
+** Buffer helpers
+**
+**==============================================================================
+*/
+static int _Buffer_Append(
+    _Inout_ MI_Uint8 **buffer,
+    _Inout_ MI_Uint32 *length,
+    _Inout_ MI_Uint32 *capacity,
+    _In_reads_(n) const MI_Uint8 *data,
+    MI_Uint32 n)
+{
+    if (*length + n > *capacity)
+    {
+        MI_Uint32 newCapacity = *capacity ? *capacity : 256;
+        MI_Uint8 *p;
+
+        while (newCapacity < *length + n)
+            newCapacity *= 2;
+
+        p = (MI_Uint8*)realloc(*buffer, newCapacity);
+        if (!p)
+            return -1;
+
+        *buffer = p;
+        *capacity = newCapacity;
+    }
+
+    memcpy(*buffer + *length, data, n);
+    *length += n;
+    return 0;
+}
+
+/*
+**==============================================================================
+**
+** Class cache
+**
+**==============================================================================
+*/
+static MI_Uint32 _MofStream_FindClass(
+    _In_ MI_MofStream *self,
+    _In_z_ const MI_Char *name)
+{
+    MI_Uint32 i;
+
+    if (self->classesHash.nodes)
+        return StringHash_Find(&self->classesHash, name);
+
+    for (i = 0; i < self->classes.size; i++)
+    {
+        if (Tcscasecmp(self->classes.data[i]->classDecl->name, name) == 0)
+            return i;
+    }
+    return HASH_INVALID_POS;
+}
+
+/* Add the class to the cache, which takes over its reference */
+static MI_Result _MofStream_CacheClass(
+    _Inout_ MI_MofStream *self,
+    _In_ MI_Class *classObject)
+{
+    const MI_Char *name = classObject->classDecl->name;
+    MI_Uint32 pos = _MofStream_FindClass(self, name);
+    MI_Uint32 i;
+
+    if (pos != HASH_INVALID_POS)
+    {
+        /* Declared again; the hash node and the classes derived from the */
+        /* previous declaration still point to it, keep it until the end */
+        if (Codec_PtrArray_Append_Batch(self->batch,
+            (PtrArray*)&self->replacedClasses, self->classes.data[pos]) != 0)
+        {
+            mof_report_error(&self->codec.errhandler, ID_OUT_OF_MEMORY, "");
+            return MI_RESULT_FAILED;
+        }
+        self->classes.data[pos] = classObject;
+        return MI_RESULT_OK;
+    }
+
+    if (Codec_PtrArray_Append_Batch(self->batch,
+        (PtrArray*)&self->classes, classObject) != 0)
+    {
+        mof_report_error(&self->codec.errhandler, ID_OUT_OF_MEMORY, "");
+        return MI_RESULT_FAILED;
+    }
+
+    /* Initialize hash table if needed */
+    if (self->classes.size == HASH_THRESHOLD)
+    {
+        if (StringHash_Init(self->batch, &self->classesHash) != 0)
+        {
+            mof_report_error(&self->codec.errhandler, ID_OUT_OF_MEMORY, "");
+            return MI_RESULT_FAILED;
+        }
+        for (i = 0; i < self->classes.size; i++)
+        {
+            if (StringHash_Add(self->batch, &self->classesHash, i,
+                self->classes.data[i]->classDecl->name) != 0)
+            {
+                mof_report_error(&self->codec.errhandler, ID_OUT_OF_MEMORY, "");
+                return MI_RESULT_FAILED;
+            }
+        }
+    }
+    /* Add class to hash table */
+    else if (self->classes.size > HASH_THRESHOLD)
+    {
+        if (StringHash_Add(self->batch, &self->classesHash,
+            self->classes.size - 1, name) != 0)
+        {
+            mof_report_error(&self->codec.errhandler, ID_OUT_OF_MEMORY, "");
+            return MI_RESULT_FAILED;
+        }
+    }
+    return MI_RESULT_OK;
+}
+
+/*
+**==============================================================================
+**
+** Instance aliases; the parser of a declaration looks up the aliases of the
+** previous declarations here
+**
+**==============================================================================
+*/
+static const MI_InstanceAliasDecl* MI_CALL _MofStream_OnFindAliasDecl(
+    _In_ void *data,
+    _In_z_ const MI_Char *name)
+{
+    MI_MofStream *self = (MI_MofStream*)data;
+    MI_Uint32 i;
+
+    if (self->aliasesHash.nodes)
+    {
+        MI_Uint32 pos = StringHash_Find(&self->aliasesHash, name);
+        return pos != HASH_INVALID_POS ? self->aliases.data[pos] : NULL;
+    }
+
+    for (i = 0; i < self->aliases.size; i++)
+    {
+        if (Tcscasecmp(self->aliases.data[i]->name, name) == 0)
+            return self->aliases.data[i];
+    }
+    return NULL;
+}
+
+/* Copy the key properties of an instance (all of them if there is none), */
+/* which is what a reference to it needs; the instance was handed over */
+/* already and is cleared of the other properties first, so that they are */
+/* not copied */
+static MI_Result _MofStream_CloneKeys(
+    _Inout_ MI_Instance *instance,
+    _Outptr_ MI_Instance **keys)
+{
+    MI_Uint32 count = 0;
+    MI_Uint32 i;
+    MI_Boolean hasKeys = MI_FALSE;
+    MI_Result r;
+
+    *keys = NULL;
+
+    r = MI_Instance_GetElementCount(instance, &count);
+
+    for (i = 0; r == MI_RESULT_OK && i < count && !hasKeys; i++)
+    {
+        MI_Uint32 flags = 0;
+
+        r = MI_Instance_GetElementAt(instance, i, NULL, NULL, NULL, &flags);
+        hasKeys = (flags & MI_FLAG_KEY) ? MI_TRUE : MI_FALSE;
+    }
+
+    for (i = 0; r == MI_RESULT_OK && hasKeys && i < count; i++)
+    {
+        MI_Uint32 flags = 0;
+
+        r = MI_Instance_GetElementAt(instance, i, NULL, NULL, NULL, &flags);
+        if (r == MI_RESULT_OK && !(flags & (MI_FLAG_KEY | MI_FLAG_NULL)))
+            r = MI_Instance_ClearElementAt(instance, i);
+    }
+
+    if (r != MI_RESULT_OK)
+        return r;
+
+    return MI_Instance_Clone(instance, keys);
+}
+
+/* Keep the alias and a copy of the keys of its instance for the later */
+/* declarations */
+static MI_Result _MofStream_KeepAlias(
+    _Inout_ MI_MofStream *self,
+    _In_ const MI_InstanceAliasDecl *alias)
+{
+    MI_InstanceAliasDecl *aid;
+    MI_InstanceDecl *id;
+    MI_Uint32 i;
+
+    aid = (MI_InstanceAliasDecl*)Batch_GetClear(self->batch,
+        sizeof(MI_InstanceAliasDecl));
+    id = (MI_InstanceDecl*)Batch_GetClear(self->batch, sizeof(MI_InstanceDecl));
+    if (!aid || !id)
+        goto failed;
+
+    aid->lineno = alias->lineno;
+    aid->name = Batch_Tcsdup(self->batch, alias->name);
+    if (!aid->name)
+        goto failed;
+
+    id->alias = (MI_Char*)aid->name;
+    aid->decl = id;
+
+    if (Codec_PtrArray_Append_Batch(self->batch,
+        (PtrArray*)&self->aliases, aid) != 0)
+        goto failed;
+
+    /* Initialize hash table if needed */
+    if (self->aliases.size == HASH_THRESHOLD)
+    {
+        if (StringHash_Init(self->batch, &self->aliasesHash) != 0)
+            goto failed;
+        for (i = 0; i < self->aliases.size; i++)
+        {
+            if (StringHash_Add(self->batch, &self->aliasesHash, i,
+                self->aliases.data[i]->name) != 0)
+                goto failed;
+        }
+    }
+    /* Add alias to hash table */
+    else if (self->aliases.size > HASH_THRESHOLD)
+    {
+        if (StringHash_Add(self->batch, &self->aliasesHash,
+            self->aliases.size - 1, aid->name) != 0)
+            goto failed;
+    }
+
+    /* An instance ignored by the schema check is kept as such */
+    if (alias->decl->instance &&
+        _MofStream_CloneKeys(alias->decl->instance, &id->instance) != MI_RESULT_OK)
+        goto failed;
+
+    return MI_RESULT_OK;
+
+failed:
+    mof_report_error(&self->codec.errhandler, ID_OUT_OF_MEMORY, "");
+    return MI_RESULT_FAILED;
+}
+
+/*
+**==============================================================================
+**
+** Pragmas, the last value of each holds for the later declarations
+**
+**==============================================================================
+*/
+static MI_Char* _MofStream_Tcsdup(
+    _In_z_ const MI_Char *str)
+{
+    size_t size = (Tcslen(str) + 1) * sizeof(MI_Char);
+    MI_Char *p = (MI_Char*)malloc(size);
+
+    if (p)
+        memcpy(p, str, size);
+    return p;
+}
+
+static MI_MofStream_Pragma* _MofStream_FindPragma(
+    _In_ MI_MofStream *self,
+    _In_z_ const MI_Char *name)
+{
+    MI_MofStream_Pragma *p;
+
+    for (p = self->pragmas; p; p = p->next)
+    {
+        if (Tcscasecmp(p->name, name) == 0)
+            return p;
+    }
+    return NULL;
+}
+
+static void _MofStream_OnPragma(
+    _In_z_ const MI_Char *pragma,
+    _In_z_ const MI_Char *value,
+    _In_ void *data)
+{
+    MI_MofStream *self = (MI_MofStream*)data;
+    MI_MofStream_Pragma *p = _MofStream_FindPragma(self, pragma);
+    MI_Char *copy = _MofStream_Tcsdup(value);
+
+    if (!copy)
+        goto failed;
+
+    if (!p)
+    {
+        p = (MI_MofStream_Pragma*)calloc(1, sizeof(MI_MofStream_Pragma));
+        if (!p)
+            goto failed;
+
+        p->name = _MofStream_Tcsdup(pragma);
+        if (!p->name)
+        {
+            free(p);
+            goto failed;
+        }
+        p->next = self->pragmas;
+        self->pragmas = p;
+    }
+
+    if (p->value)
+        free(p->value);
+    p->value = copy;
+
+    /* The declarations following it in the buffer are in that namespace */
+    if (Tcscasecmp(pragma, MI_T("namespace")) == 0 && self->codec.parser)
+        self->codec.parser->param.namespaceName = copy;
+    return;
+
+failed:
+    if (copy)
+        free(copy);
+    mof_report_error(&self->codec.errhandler, ID_OUT_OF_MEMORY, "");
+    self->result = MI_RESULT_FAILED;
+}
+
+/*
+**==============================================================================
+**
+** Classes created while parsing a declaration; the class cache does not
+** change during the parse, they are added to it once the declaration has
+** been parsed
+**
+**==============================================================================
+*/
+static MI_Result MI_CALL _MofStream_OnNewClassDecl(
+    _In_ void *data,
+    _In_ const MI_ClassDecl *classDecl,
+    _Outptr_result_maybenull_ MI_ClassDecl **newClassDecl)
+{
+    MI_MofStream *self = (MI_MofStream*)data;
+    MI_MofStream_NewClass *p;
+    MI_Result r;
+
+    *newClassDecl = NULL;
+
+    for (p = self->newClasses; p; p = p->next)
+    {
+        if (p->decl == classDecl)
+        {
+            *newClassDecl = p->classObject->classDecl;
+            return MI_RESULT_OK;
+        }
+    }
+
+    p = (MI_MofStream_NewClass*)malloc(sizeof(MI_MofStream_NewClass));
+    if (!p)
+    {
+        mof_report_error(&self->codec.errhandler, ID_OUT_OF_MEMORY, "");
+        return MI_RESULT_FAILED;
+    }
+
+    r = _NewClassOnClassDecl(&self->codec, classDecl, &p->classObject);
+    if (r != MI_RESULT_OK)
+    {
+        free(p);
+        return r;
+    }
+
+    p->decl = classDecl;
+    p->next = self->newClasses;
+    self->newClasses = p;
+    *newClassDecl = p->classObject->classDecl;
+    return MI_RESULT_OK;
+}
+
+/* Remove the class created for classDecl from the list, if any */
+static MI_Class* _MofStream_TakeNewClass(
+    _Inout_ MI_MofStream *self,
+    _In_ const MI_ClassDecl *classDecl)
+{
+    MI_MofStream_NewClass **p;
+
+    for (p = &self->newClasses; *p; p = &(*p)->next)
+    {
+        if ((*p)->decl == classDecl)
+        {
+            MI_MofStream_NewClass *node = *p;
+            MI_Class *classObject = node->classObject;
+            *p = node->next;
+            free(node);
+            return classObject;
+        }
+    }
+    return NULL;
+}
+
+static void _MofStream_DeleteNewClasses(
+    _Inout_ MI_MofStream *self)
+{
+    while (self->newClasses)
+    {
+        MI_MofStream_NewClass *p = self->newClasses;
+        self->newClasses = p->next;
+        MI_Class_Delete(p->classObject);
+        free(p);
+    }
+}
+
+/*
+**==============================================================================
+**
+** Scanner, finds the ';' ending the top level declaration
+**
+**==============================================================================
+*/
+MI_INLINE MI_Boolean _IsIdentChar(MI_Uint8 c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+        (c >= '0' && c <= '9') || c == '_';
+}
+
+static void _MofStream_ResetScanner(
+    _Inout_ MI_MofStream *self)
+{
+    self->mode = MofStreamScanCode;
+    self->depth = 0;
+    self->escape = MI_FALSE;
+    self->slash = MI_FALSE;
+    self->star = MI_FALSE;
+    self->content = MI_FALSE;
+    self->wordState = 0;
+    self->wordLength = 0;
+    self->wordOffset = 0;
+    self->declLength = 0;
+    self->declLines = 0;
+}
+
+/* Keep the first word of the declaration (class, instance, qualifier...) */
+static void _MofStream_ScanWord(
+    _Inout_ MI_MofStream *self,
+    MI_Uint8 c)
+{
+    if (self->wordState == 2)
+        return;
+
+    if (_IsIdentChar(c) && !(self->wordState == 0 && c >= '0' && c <= '9'))
+    {
+        if (self->wordLength < sizeof(self->word))
+            self->word[self->wordLength] = (char)c;
+        self->wordLength++;
+        self->wordState = 1;
+    }
+    else
+    {
+        self->wordState = 2;
+    }
+}
+
+/* Return the number of bytes of data up to and including the end of the */
+/* declaration or length if it goes on; sets *complete accordingly */
+static MI_Uint32 _MofStream_Scan(
+    _Inout_ MI_MofStream *self,
+    _In_reads_(length) const MI_Uint8 *data,
+    MI_Uint32 length,
+    _Out_ MI_Boolean *complete)
+{
+    MI_Uint32 n = 0;
+
+    *complete = MI_FALSE;
+
+    while (n < length)
+    {
+        MI_Uint8 c = data[n++];
+
+        /* Skip the byte order mark; its bytes stay in the buffer */
+        if (!self->started)
+        {
+            if (c == _utf8Bom[self->bomLength])
+            {
+                if (++self->bomLength == MI_COUNT(_utf8Bom))
+                {
+                    self->utf8 = MI_TRUE;
+                    self->started = MI_TRUE;
+                }
+                continue;
+            }
+            self->started = MI_TRUE;
+        }
+
+        /* UTF-16 and UTF-32 are not supported */
+        if (c == 0 || c == 0xFE || c == 0xFF)
+        {
+            mof_report_error(&self->codec.errhandler,
+                ID_PARAMETER_INVALID_BUFFER, "");
+            self->result = MI_RESULT_NOT_SUPPORTED;
+            return n;
+        }
+
+        if (c == '\n')
+            self->declLines++;
+
+        switch (self->mode)
+        {
+        case MofStreamScanString:
+        case MofStreamScanChar:
+            if (self->escape)
+                self->escape = MI_FALSE;
+            else if (c == '\\')
+                self->escape = MI_TRUE;
+            else if (c == (self->mode == MofStreamScanString ? '"' : '\''))
+                self->mode = MofStreamScanCode;
+            break;
+
+        case MofStreamScanLineComment:
+        case MofStreamScanPragma:
+            if (c == '\n')
+                self->mode = MofStreamScanCode;
+            break;
+
+        case MofStreamScanBlockComment:
+            if (self->star && c == '/')
+                self->mode = MofStreamScanCode;
+            self->star = (c == '*');
+            break;
+
+        case MofStreamScanCode:
+            if (self->slash)
+            {
+                self->slash = MI_FALSE;
+                if (c == '/')
+                {
+                    self->mode = MofStreamScanLineComment;
+                    break;
+                }
+                if (c == '*')
+                {
+                    self->mode = MofStreamScanBlockComment;
+                    self->star = MI_FALSE;
+                    break;
+                }
+                self->content = MI_TRUE;
+                if (self->wordState == 0)
+                    self->wordOffset = self->declLength + n - 2;
+                _MofStream_ScanWord(self, '/');
+            }
+
+            if (c == '/')
+            {
+                self->slash = MI_TRUE;
+                break;
+            }
+            if (c == ' ' || c == '\t' || c == '\r' || c == '\n')
+            {
+                if (self->wordState == 1)
+                    self->wordState = 2;
+                break;
+            }
+
+            self->content = MI_TRUE;
+
+            /* Pragmas go with the declaration that follows them */
+            if (c == '#' && self->wordState == 0)
+            {
+                self->mode = MofStreamScanPragma;
+                break;
+            }
+
+            /* Where the declaration starts, past the pragmas */
+            if (self->wordState == 0)
+                self->wordOffset = self->declLength + n - 1;
+            _MofStream_ScanWord(self, c);
+
+            if (c == '"')
+                self->mode = MofStreamScanString;
+            else if (c == '\'')
+                self->mode = MofStreamScanChar;
+            else if (c == '{')
+                self->depth++;
+            else if (c == '}' && self->depth > 0)
+                self->depth--;
+            else if (c == ';' && self->depth == 0)
+            {
+                *complete = MI_TRUE;
+                return n;
+            }
+            break;
+        }
+    }
+    return n;
+}
+
+/*
+**==============================================================================
+**
+** Parse one declaration and hand over its objects
+**
+**==============================================================================
+*/
+static MI_Result _MofStream_Deliver(
+    _Inout_ MI_MofStream *self,
+    _In_ MOF_State *state)
+{
+    MOF_Parser *parser = self->codec.parser;
+    MI_Uint32 i;
+    MI_Result r;
+
+    for (i = 0; i < state->classDecls.size; i++)
+    {
+        MI_ClassDecl *decl = state->classDecls.data[i];
+        MI_Class *classObject = _MofStream_TakeNewClass(self, decl);
+
+        if (!classObject)
+        {
+            r = _NewClassOnClassDecl(&self->codec, decl, &classObject);
+            if (r != MI_RESULT_OK)
+                return r;
+        }
+
+        r = _MofStream_CacheClass(self, classObject);
+        if (r != MI_RESULT_OK)
+        {
+            MI_Class_Delete(classObject);
+            return r;
+        }
+
+        r = self->onObject(self->onObjectContext, classObject, NULL);
+        if (r != MI_RESULT_OK)
+            return r;
+    }
+
+    /* Keep the classes read from classObjectNeeded for later declarations */
+    for (i = 0; i < parser->classaObjectNeeded.size; i++)
+    {
+        MI_Class *classObject = parser->classaObjectNeeded.data[i];
+
+        if (classObject)
+        {
+            r = _MofStream_CacheClass(self, classObject);
+            if (r != MI_RESULT_OK)
+                return r;
+            parser->classaObjectNeeded.data[i] = NULL;
+        }
+    }
+
+    for (i = 0; i < state->instanceDecls.size; i++)
+    {
+        MI_InstanceDecl *decl = state->instanceDecls.data[i];
+
+        if (decl->instance != NULL)
+        {
+            r = self->onObject(self->onObjectContext, NULL, decl->instance);
+            if (r != MI_RESULT_OK)
+                return r;
+        }
+    }
+
+    /* The later declarations only need the keys of the aliased instances */
+    for (i = 0; i < state->instanceAliases.size; i++)
+    {
+        r = _MofStream_KeepAlias(self, state->instanceAliases.data[i]);
+        if (r != MI_RESULT_OK)
+            return r;
+    }
+    return MI_RESULT_OK;
+}
+
+static MI_Result _MofStream_ParseDecl(
+    _Inout_ MI_MofStream *self,
+    _In_reads_(length) MI_Uint8 *data,
+    MI_Uint32 length)
+{
+    /* The first declaration starts with the byte order mark, if any */
+    MI_Uint32 bom = (self->utf8 && self->firstDecl) ? MI_COUNT(_utf8Bom) : 0;
+    MI_Boolean isQualifierDecl = self->wordLength == 9 &&
+        Strncasecmp(self->word, "qualifier", 9) == 0;
+    MI_Uint8 *buffer = data;
+    MI_Uint32 bufferLength = length;
+    MI_Uint8 *composed = NULL;
+    MOF_Parser *parser;
+    MI_Result r;
+
+    /* Put the qualifier declarations and the byte order mark in front */
+    if ((self->utf8 && !self->firstDecl) || self->prologueLength > 0 ||
+        length < MIN_DECL_BUFFER_SIZE)
+    {
+        MI_Uint32 capacity = MI_COUNT(_utf8Bom) + self->prologueLength +
+            length + MIN_DECL_BUFFER_SIZE;
+
+        composed = (MI_Uint8*)malloc(capacity);
+        if (!composed)
+        {
+            mof_report_error(&self->codec.errhandler, ID_OUT_OF_MEMORY, "");
+            r = MI_RESULT_FAILED;
+            goto Done;
+        }
+
+        bufferLength = 0;
+        if (self->utf8)
+        {
+            memcpy(composed, _utf8Bom, MI_COUNT(_utf8Bom));
+            bufferLength += MI_COUNT(_utf8Bom);
+        }
+        if (self->prologueLength > 0)
+        {
+            memcpy(composed + bufferLength, self->prologue, self->prologueLength);
+            bufferLength += self->prologueLength;
+        }
+        memcpy(composed + bufferLength, data + bom, length - bom);
+        bufferLength += length - bom;
+        while (bufferLength < MIN_DECL_BUFFER_SIZE)
+            composed[bufferLength++] = ' ';
+        buffer = composed;
+    }
+
+    parser = MOF_Parser_Init(buffer, bufferLength, NULL, &r);
+    if (NULL == parser)
+    {
+        if (r == MI_RESULT_SERVER_LIMITS_EXCEEDED)
+            mof_report_error(&self->codec.errhandler, ID_OUT_OF_MEMORY, "");
+        else
+            mof_report_error(&self->codec.errhandler, ID_PARAMETER_INVALID_BUFFER, "");
+        r = MI_RESULT_FAILED;
+        goto Done;
+    }
+
+    self->codec.parser = parser;
+    r = _SetOperationOptions(self->options, &self->codec);
+    if (r == MI_RESULT_OK)
+    {
+        MOF_State *state = (MOF_State*)parser->state;
+        MI_MofStream_Pragma *pragma = _MofStream_FindPragma(self, MI_T("namespace"));
+        MI_Uint32 i;
+
+        parser->param.buffer = buffer;
+        parser->param.bufferlength = bufferLength;
+        parser->param.schemas = &self->classes;
+        parser->param.schemasHash = self->classesHash;
+        parser->param.namespaceName = pragma ? pragma->value : NULL;
+        memcpy(&parser->param.callbacks, &self->callbacks, sizeof(MI_DeserializerCallbacks));
+
+        _SetupStateCallback(state, &self->codec);
+        state->onNewClassDecl = _MofStream_OnNewClassDecl;
+        state->onNewClassDeclData = (void*)self;
+        state->onFindAliasDecl = _MofStream_OnFindAliasDecl;
+        state->onFindAliasDeclData = (void*)self;
+        state->pragmaCallback = _MofStream_OnPragma;
+        state->pragmaCallbackData = (void*)self;
+
+        /* Report the lines of the whole buffer */
+        state->buf.lineNo = self->lineNo - self->prologueLines;
+
+        if (MOF_Parser_Parse(parser) != 0)
+            r = MI_RESULT_FAILED;
+        else if (self->result != MI_RESULT_OK)
+            r = self->result;
+        else
+            r = _MofStream_Deliver(self, state);
+
+        /* Before the parser deletes the classes they refer to */
+        for (i = 0; i < state->instanceDecls.size; i++)
+        {
+            if (state->instanceDecls.data[i]->instance)
+            {
+                MI_Instance_Delete(state->instanceDecls.data[i]->instance);
+                state->instanceDecls.data[i]->instance = NULL;
+            }
+        }
+    }
+
+    MOF_Parser_Delete(parser);
+    self->codec.parser = NULL;
+    self->codec.errhandler.state = NULL;
+    _MofStream_DeleteNewClasses(self);
+
+    if (r == MI_RESULT_OK && isQualifierDecl)
+    {
+        /* Without the pragmas before it, which must not be replayed (only */
+        /* their lines are kept) */
+        MI_Uint32 start = self->wordOffset > bom ? self->wordOffset : bom;
+        MI_Uint32 i;
+
+        for (i = bom; i < start && r == MI_RESULT_OK; i++)
+        {
+            if (data[i] == '\n' && _Buffer_Append(&self->prologue,
+                &self->prologueLength, &self->prologueCapacity, data + i, 1) != 0)
+                r = MI_RESULT_FAILED;
+        }
+
+        if (r != MI_RESULT_OK || _Buffer_Append(&self->prologue,
+            &self->prologueLength, &self->prologueCapacity, data + start,
+            length - start) != 0)
+        {
+            mof_report_error(&self->codec.errhandler, ID_OUT_OF_MEMORY, "");
+            r = MI_RESULT_FAILED;
+        }
+        self->prologueLines += self->declLines;
+    }
+
+Done:
+    if (composed)
+        free(composed);
+    self->lineNo += self->declLines;
+    self->firstDecl = MI_FALSE;
+    return r;
+}
+
+/* Record the failure, all later calls return it */
+static MI_Result _MofStream_Fail(
+    _Inout_ MI_MofStream *self,
+    MI_Result r,
+    _Outptr_opt_result_maybenull_ MI_Instance **cimErrorDetails)
+{
+    self->result = r;
+    if (cimErrorDetails && self->codec.errorInstance)
+    {
+        *cimErrorDetails = self->codec.errorInstance;
+        self->codec.errorInstance = NULL;
+    }
+    return r;
+}
+
+/*
+**==============================================================================
+**
+** Public functions
+**
+**==============================================================================
+*/
+_Use_decl_annotations_
+MI_Result MI_MofStream_Init(
+    MI_MofStream *self,
+    MI_Uint32 flags,
+    MI_OperationOptions *options,
+    MI_DeserializerCallbacks *callbacks,
+    const MI_ClassA *classes,
+    MI_MofStream_OnObject onObject,
+    void *onObjectContext,
+    MI_Instance **cimErrorDetails)
+{
+    MI_Uint32 i;
+    MI_Result r;
+
+    memset(self, 0, sizeof(MI_MofStream));
+    if (cimErrorDetails)
+    {
+        *cimErrorDetails = NULL;
+    }
+
+    /* setup error handler on codec */
+    MI_MofCodec_SetupErrorHandler(&self->codec);
+    self->codec.type = DeserializeInstanceArray;
+    self->lineNo = 1;
+    self->firstDecl = MI_TRUE;
+
+    if (flags != 0)
+    {
+        MI_MofCodec_ParameterIsNonZero(&self->codec, MI_T("flags"));
+        return _MofStream_Fail(self, MI_RESULT_INVALID_PARAMETER, cimErrorDetails);
+    }
+    if (onObject == NULL)
+    {
+        MI_MofCodec_ParameterIsNull(&self->codec, MI_T("onObject"));
+        return _MofStream_Fail(self, MI_RESULT_INVALID_PARAMETER, cimErrorDetails);
+    }
+
+    self->options = options;
+    self->onObject = onObject;
+    self->onObjectContext = onObjectContext;
+    if (callbacks)
+    {
+        memcpy(&self->callbacks, callbacks, sizeof(MI_DeserializerCallbacks));
+    }
+
+    self->batch = Batch_New(BATCH_MAX_PAGES);
+    if (NULL == self->batch)
+    {
+        mof_report_error(&self->codec.errhandler, ID_OUT_OF_MEMORY, "");
+        return _MofStream_Fail(self, MI_RESULT_FAILED, cimErrorDetails);
+    }
+
+    /* Pre-resolved classes */
+    if (classes)
+    {
+        for (i = 0; i < classes->size; i++)
+        {
+            MI_Class *classObject;
+
+            if (!classes->data[i])
+                continue;
+
+            r = MI_Class_Clone(classes->data[i], &classObject);
+            if (r != MI_RESULT_OK)
+            {
+                mof_report_error(&self->codec.errhandler, ID_OUT_OF_MEMORY, "");
+                return _MofStream_Fail(self, r, cimErrorDetails);
+            }
+
+            r = _MofStream_CacheClass(self, classObject);
+            if (r != MI_RESULT_OK)
+            {
+                MI_Class_Delete(classObject);
+                return _MofStream_Fail(self, r, cimErrorDetails);
+            }
+        }
+    }
+
+    _MofStream_ResetScanner(self);
+    return MI_RESULT_OK;
+}
+
+_Use_decl_annotations_
+MI_Result MI_MofStream_Feed(
+    MI_MofStream *self,
+    const MI_Uint8 *chunk,
+    MI_Uint32 length,
+    MI_Instance **cimErrorDetails)
+{
+    MI_Result r;
+
+    if (cimErrorDetails)
+    {
+        *cimErrorDetails = NULL;
+    }
+    if (self->result != MI_RESULT_OK)
+    {
+        return self->result;
+    }
+    if (chunk == NULL && length > 0)
+    {
+        MI_MofCodec_ParameterIsNull(&self->codec, MI_T("chunk"));
+        return _MofStream_Fail(self, MI_RESULT_INVALID_PARAMETER, cimErrorDetails);
+    }
+
+    while (length > 0)
+    {
+        MI_Boolean complete;
+        MI_Uint32 n = _MofStream_Scan(self, chunk, length, &complete);
+
+        if (self->result != MI_RESULT_OK)
+        {
+            return _MofStream_Fail(self, self->result, cimErrorDetails);
+        }
+
+        self->declLength += n;
+        if (self->declLength > MAX_BUFFER_SIZE)
+        {
+            MI_MofCodec_ParameterOutOfRange(&self->codec, MI_T("declaration length"),
+                0, MAX_BUFFER_SIZE, self->declLength);
+            return _MofStream_Fail(self, MI_RESULT_SERVER_LIMITS_EXCEEDED, cimErrorDetails);
+        }
+
+        if (complete && self->pendingLength == 0)
+        {
+            /* The whole declaration is in this chunk, parse it in place */
+            r = _MofStream_ParseDecl(self, (MI_Uint8*)chunk, n);
+        }
+        else
+        {
+            if (_Buffer_Append(&self->pending, &self->pendingLength,
+                &self->pendingCapacity, chunk, n) != 0)
+            {
+                mof_report_error(&self->codec.errhandler, ID_OUT_OF_MEMORY, "");
+                return _MofStream_Fail(self, MI_RESULT_FAILED, cimErrorDetails);
+            }
+
+            r = MI_RESULT_OK;
+            if (complete)
+            {
+                r = _MofStream_ParseDecl(self, self->pending, self->pendingLength);
+                self->pendingLength = 0;
+            }
+        }
+
+        if (r != MI_RESULT_OK)
+        {
+            return _MofStream_Fail(self, r, cimErrorDetails);
+        }
+        if (complete)
+        {
+            _MofStream_ResetScanner(self);
+        }
+
+        chunk += n;
+        length -= n;
+    }
+    return MI_RESULT_OK;
+}
+
+_Use_decl_annotations_
+MI_Result MI_MofStream_Finish(
+    MI_MofStream *self,
+    MI_Instance **cimErrorDetails)
+{
+    MI_Result r = MI_RESULT_OK;
+
+    if (cimErrorDetails)
+    {
+        *cimErrorDetails = NULL;
+    }
+    if (self->result != MI_RESULT_OK)
+    {
+        return self->result;
+    }
+
+    /* Let the parser report whatever is left but blanks and comments */
+    if (self->content || self->slash || self->mode == MofStreamScanBlockComment)
+    {
+        r = _MofStream_ParseDecl(self, self->pending, self->pendingLength);
+        if (r != MI_RESULT_OK)
+        {
+            return _MofStream_Fail(self, r, cimErrorDetails);
+        }
+    }
+
+    self->pendingLength = 0;
+    _MofStream_ResetScanner(self);
+    return MI_RESULT_OK;
+}
+
+_Use_decl_annotations_
+const MI_Char* MI_MofStream_GetPragma(
+    MI_MofStream *self,
+    const MI_Char *name)
+{
+    MI_MofStream_Pragma *pragma = _MofStream_FindPragma(self, name);
+
+    return pragma ? pragma->value : NULL;
+}
+
+_Use_decl_annotations_
+void MI_MofStream_Delete(
+    MI_MofStream *self)
+{
+    MI_Uint32 i;
+
+    _MofStream_DeleteNewClasses(self);
+
+    for (i = 0; i < self->classes.size; i++)
+    {
+        MI_Class_Delete(self->classes.data[i]);
+    }
+    for (i = 0; i < self->replacedClasses.size; i++)
+    {
+        MI_Class_Delete(self->replacedClasses.data[i]);
+    }
+    for (i = 0; i < self->aliases.size; i++)
+    {
+        MI_InstanceDecl *decl = (MI_InstanceDecl*)self->aliases.data[i]->decl;
+
+        if (decl->instance)
+        {
+            MI_Instance_Delete(decl->instance);
+        }
+    }
+    while (self->pragmas)
+    {
+        MI_MofStream_Pragma *pragma = self->pragmas;
+        self->pragmas = pragma->next;
+        free(pragma->name);
+        free(pragma->value);
+        free(pragma);
+    }
+    if (self->batch)
+    {
+        Batch_Delete(self->batch);
+    }
+    if (self->pending)
+    {
+        free(self->pending);
+    }
+    if (self->prologue)
+    {
+        free(self->prologue);
+    }
+    MI_MofCodec_Delete(&self->codec);
+    memset(self, 0, sizeof(MI_MofStream));
+}
@@ -0,0 +1,222 @@
+/*
+**==============================================================================
+**
+** Copyright (c) Microsoft Corporation. All rights reserved. See file LICENSE
+** for license information.
+**
+**==============================================================================
+*/
+
+#ifndef _mof_mofstream_h
+#define _mof_mofstream_h
+
+#include "codecimpl.h"
+
+/*
+**==============================================================================
+**
+** MI_MofStream
+**      Deserializes a MOF document handed over in chunks of any size.
+**
+**      The chunks are cut into top level declarations (class, instance,
+**      qualifier declarations and the pragmas before them), each parsed on
+**      its own as soon as its terminating ';' arrives, so the memory held
+**      is bounded by the largest declaration rather than the document:
+**      only the pending declaration is buffered and the parser of a
+**      declaration is released once its objects have been delivered.
+**
+**      Every class and every top level instance is handed to the callback
+**      in document order; they are owned by the stream and only valid
+**      during the callback (MI_Class_Clone or MI_Instance_Clone them to
+**      keep them). An instance declared with an alias is handed over like
+**      the others; since any later declaration may refer to it, the stream
+**      keeps a copy of its keys (of all of it for a class without keys)
+**      which the references resolve to. Unlike MI_Deserializer, the
+**      instances referred to are also handed over as top level ones.
+**
+**      The classes given to MI_MofStream_Init, the classes declared so far
+**      and the classes returned by the classObjectNeeded callback make up
+**      the class cache the later declarations are resolved against, a
+**      class being declared again replacing the cached one. Qualifier
+**      declarations are kept and replayed before each later declaration.
+**
+**      A pragma holds until the same pragma is given again: the classes
+**      are created in (and classObjectNeeded is asked for) the namespace
+**      of the last '#pragma namespace', and MI_MofStream_GetPragma returns
+**      the value of any pragma in effect.
+**
+**      Limitations: the buffer must be ANSI or UTF-8 (with or without
+**      BOM).
+**
+**==============================================================================
+*/
+
+BEGIN_EXTERNC
+
+/* Called for each deserialized class (instance is NULL) or instance */
+/* (classObject is NULL); any result but MI_RESULT_OK stops the stream */
+typedef MI_Result (MI_CALL *MI_MofStream_OnObject)(
+    _In_opt_ void *context,
+    _In_opt_ MI_Class *classObject,
+    _In_opt_ MI_Instance *instance);
+
+/* Classes created for the declaration being parsed */
+typedef struct _MI_MofStream_NewClass
+{
+    const MI_ClassDecl *decl;
+    MI_Class *classObject;
+    struct _MI_MofStream_NewClass *next;
+}MI_MofStream_NewClass;
+
+/* Last value of a pragma */
+typedef struct _MI_MofStream_Pragma
+{
+    MI_Char *name;
+    MI_Char *value;
+    struct _MI_MofStream_Pragma *next;
+}MI_MofStream_Pragma;
+
+/* Lexical state of the declaration being buffered */
+typedef enum _MI_MofStream_ScanMode
+{
+    MofStreamScanCode,
+    MofStreamScanString,
+    MofStreamScanChar,
+    MofStreamScanLineComment,
+    MofStreamScanBlockComment,
+    MofStreamScanPragma
+}MI_MofStream_ScanMode;
+
+typedef struct _MI_MofStream
+{
+    /* Error handler and parser of the current declaration */
+    MI_MofCodec codec;
+
+    /* Input parameters */
+    MI_OperationOptions *options;
+    MI_DeserializerCallbacks callbacks;
+    MI_MofStream_OnObject onObject;
+    void *onObjectContext;
+
+    /* Result of the first failure, all later calls return it */
+    MI_Result result;
+
+    /* Class cache, holds one reference to each class */
+    Batch *batch;
+    MI_ClassA classes;
+    StringHash classesHash;
+    MI_ClassA replacedClasses;
+    MI_MofStream_NewClass *newClasses;
+
+    /* Instance aliases declared so far, with a copy of the keys of their */
+    /* instance */
+    struct
+    {
+        struct _MI_InstanceAliasDecl **data;
+        MI_Uint32 size;
+    }aliases;
+    StringHash aliasesHash;
+
+    /* Pragmas in effect */
+    MI_MofStream_Pragma *pragmas;
+
+    /* Pending (incomplete) declaration */
+    MI_Uint8 *pending;
+    MI_Uint32 pendingLength;
+    MI_Uint32 pendingCapacity;
+
+    /* Qualifier declarations replayed before each declaration */
+    MI_Uint8 *prologue;
+    MI_Uint32 prologueLength;
+    MI_Uint32 prologueCapacity;
+    MI_Uint32 prologueLines;
+
+    /* Byte order mark at the start of the buffer */
+    MI_Boolean started;
+    MI_Uint32 bomLength;
+    MI_Boolean utf8;
+    MI_Boolean firstDecl;
+
+    /* Scanner state of the pending declaration */
+    MI_MofStream_ScanMode mode;
+    MI_Uint32 depth;
+    MI_Boolean escape;
+    MI_Boolean slash;
+    MI_Boolean star;
+    MI_Boolean content;
+    int wordState;
+    char word[16];
+    MI_Uint32 wordLength;
+    MI_Uint32 wordOffset;
+    MI_Uint32 declLength;
+    MI_Uint32 declLines;
+    MI_Uint32 lineNo;
+}MI_MofStream;
+
+/*
+**==============================================================================
+**
+** Initialize the stream; classes (may be NULL) is the pre-resolved class
+** cache, the stream takes its own reference to each class
+**
+**==============================================================================
+*/
+MI_Result MI_MofStream_Init(
+    _Out_ MI_MofStream *self,
+    _In_ MI_Uint32 flags,
+    _In_opt_ MI_OperationOptions *options,
+    _In_opt_ MI_DeserializerCallbacks *callbacks,
+    _In_opt_ const MI_ClassA *classes,
+    _In_ MI_MofStream_OnObject onObject,
+    _In_opt_ void *onObjectContext,
+    _Outptr_opt_result_maybenull_ MI_Instance **cimErrorDetails);
+
+/*
+**==============================================================================
+**
+** Deserialize the declarations completed by the next chunk of the buffer
+**
+**==============================================================================
+*/
+MI_Result MI_MofStream_Feed(
+    _Inout_ MI_MofStream *self,
+    _In_reads_(length) const MI_Uint8 *chunk,
+    _In_ MI_Uint32 length,
+    _Outptr_opt_result_maybenull_ MI_Instance **cimErrorDetails);
+
+/*
+**==============================================================================
+**
+** End of the buffer, deserialize the last declaration (fails if it is
+** incomplete)
+**
+**==============================================================================
+*/
+MI_Result MI_MofStream_Finish(
+    _Inout_ MI_MofStream *self,
+    _Outptr_opt_result_maybenull_ MI_Instance **cimErrorDetails);
+
+/*
+**==============================================================================
+**
+** Value of the pragma in effect (e.g. MI_T("namespace")), NULL if it was
+** not given so far; valid until the pragma is given again
+**
+**==============================================================================
+*/
+const MI_Char* MI_MofStream_GetPragma(
+    _In_ MI_MofStream *self,
+    _In_z_ const MI_Char *name);
+
+/*
+**==============================================================================
+**
+** Clean up the stream and its class cache
+**
+**==============================================================================
+*/
+void MI_MofStream_Delete(_Inout_ MI_MofStream *self);
+
+END_EXTERNC
+
+#endif /* _mof_mofstream_h */
@@ -14,7 +14,7 @@
 /*
 **==============================================================================
 **
-** string hash function
+** string hash function (case insensitive)
 **
 **==============================================================================
 */
@@ -27,7 +27,48 @@ MI_Uint32 HashName(_In_z_ const MI_Char* str)
         hash ^= ((hash << 5) + PAL_tolower(*p) + (hash >> 2));
         p++;
     }
-    return hash % HASH_TABLE_SIZE;
+    return hash;
+}
+
+/*
+**==============================================================================
+**
+** Allocate the buckets of the hash table
+**
+**==============================================================================
+*/
+static int _StringHash_Resize(
+    _In_ Batch* batch,
+    _Inout_ StringHash *hash,
+    _In_ MI_Uint32 size)
+{
+    HashNodePtr* nodes = (HashNodePtr*)Batch_GetClear(batch, sizeof(HashNodePtr) * size);
+    MI_Uint32 i;
+    if (NULL == nodes)
+    {
+        return -1;
+    }
+
+    /* Move the nodes to the new buckets */
+    for (i = 0; i < hash->size; i++)
+    {
+        HashNodePtr node = hash->nodes[i];
+        while (node)
+        {
+            HashNodePtr next = node->next;
+            MI_Uint32 h = node->code & (size - 1);
+            node->next = nodes[h];
+            nodes[h] = node;
+            node = next;
+        }
+    }
+    if (hash->nodes)
+    {
+        Batch_Put(batch, hash->nodes);
+    }
+    hash->nodes = nodes;
+    hash->size = size;
+    return 0;
 }
 
 /*
@@ -44,11 +85,9 @@ int StringHash_Init(
     Batch* batch = (Batch*)mofbatch;
     if (hash->nodes == NULL)
     {
-        hash->nodes = (HashNodePtr*)Batch_GetClear(batch, sizeof(HashNodePtr) * (HASH_TABLE_SIZE));
-        if (NULL == hash->nodes)
-        {
-            return -1;
-        }
+        hash->size = 0;
+        hash->count = 0;
+        return _StringHash_Resize(batch, hash, HASH_INITIAL_SIZE);
     }
     return 0;
 }
@@ -64,21 +103,34 @@ int StringHash_Add(
     _In_ void* mofbatch,
     _Inout_ StringHash *hash,
     _In_ MI_Uint32 pos,
-    _In_ MI_Uint32 code,
     _In_z_ const MI_Char* str)
 {
     Batch * batch = (Batch*)mofbatch;
-    MI_Uint32 h = HashName(str);
-    HashNodePtr node = (HashNodePtr)Batch_GetClear(batch, sizeof(HashNode));
+    MI_Uint32 code = HashName(str);
+    MI_Uint32 h;
+    HashNodePtr node;
+
+    /* Keep the chains short */
+    if (hash->count >= hash->size)
+    {
+        if (_StringHash_Resize(batch, hash, hash->size * 2) != 0)
+        {
+            return -1;
+        }
+    }
+
+    node = (HashNodePtr)Batch_Get(batch, sizeof(HashNode));
     if (NULL == node)
     {
         return -1;
     }
+    h = code & (hash->size - 1);
     node->source = str;
     node->code = code;
     node->pos = pos;
     node->next = hash->nodes[h];
     hash->nodes[h] = node;
+    hash->count++;
     return 0;
 }
 
@@ -95,10 +147,9 @@ MI_Uint32 StringHash_Find(
 {
     if(hash->nodes)
     {
-        MI_Uint32 h = HashName(name);
-        MI_Uint32 code = Hash(name);
+        MI_Uint32 code = HashName(name);
         HashNodePtr node;
-        node = hash->nodes[h];
+        node = hash->nodes[code & (hash->size - 1)];
         while (node)
         {
             if ((node->code == code) && (Tcscasecmp(node->source, name) == 0))
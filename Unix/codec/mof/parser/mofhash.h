@@ -28,12 +28,16 @@ extern "C" {
 **  hashtable. Whenever the search target size is bigger than HASH_THRESHOLD,
 **  parse will start to use hashtable.
 **
+**  The table starts with HASH_INITIAL_SIZE buckets and doubles whenever it
+**  holds more strings than buckets, so a parser that only goes a little
+**  beyond the threshold does not pay for a table sized for 1M strings.
+**
 **==============================================================================
 */
 /* Invalid position means not found the string in hash table */
 #define HASH_INVALID_POS 0xFFFFFFFF
-/* Defines Hash table size, a big prime number */
-#define HASH_TABLE_SIZE 1000003
+/* Initial number of buckets, a power of 2 */
+#define HASH_INITIAL_SIZE 256
 /* Fallback to hash search beyond this threshold */
 #define HASH_THRESHOLD 128
 /* A number used to caculate hash value */
@@ -46,17 +50,18 @@ typedef struct _HashNode
                    /* Assume the string(s) are stored in */
                    /* another separate array, such as MOF_ClassDeclList */
     const MI_Char* source; /* source string of the node */
-    MI_Uint32 code; /* Another hash code of the string to */
-                    /* fastern search on collision entry*/
-    HashNodePtr next; /* Next node with same hash value */
+    MI_Uint32 code; /* Full hash code of the string, to fasten */
+                    /* search on collision entry and to rehash */
+    HashNodePtr next; /* Next node with same bucket */
 }
 HashNode;
 /* Defines structure of string hash table */
-/* TODO: Extend and reuse hashtable structure defined in base/hashtable.h */
 /* Need hashtable take a batch to allocate memory */
 typedef struct _StringHash
 {
     HashNodePtr* nodes;
+    MI_Uint32 size; /* Number of buckets (power of 2) */
+    MI_Uint32 count; /* Number of strings */
 }StringHash;
 
 
@@ -82,7 +87,6 @@ int StringHash_Add(
     _In_ void* mofbatch,
     _Inout_ StringHash *hash,
     _In_ MI_Uint32 pos,
-    _In_ MI_Uint32 code,
     _In_z_ const MI_Char* str);
 
 /*
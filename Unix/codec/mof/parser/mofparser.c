@@ -16,6 +16,28 @@
 
 MOF_GlobalData g_d = {0};
 
+/*=============================================================================
+**
+** Index the standard qualifiers (looked up for each qualifier of the mof);
+** FindQualifierDeclaration() searches the list if this fails
+**
+=============================================================================*/
+static void _InitQualifierDeclsHash()
+{
+    MI_Uint32 i;
+    if (StringHash_Init(g_d.b, &g_d.qualifierDeclsHash) != 0)
+        return;
+    for (i = 0; i < g_d.qualifierDecls.size; i++)
+    {
+        if (StringHash_Add(g_d.b, &g_d.qualifierDeclsHash, i,
+            g_d.qualifierDecls.data[i]->name) != 0)
+        {
+            memset(&g_d.qualifierDeclsHash, 0, sizeof(g_d.qualifierDeclsHash));
+            return;
+        }
+    }
+}
+
 #if defined(_MSC_VER)
 /*=============================================================================
 **
@@ -50,6 +72,7 @@ void GlobalInitialize()
             g_d.qualifierDecls.data[i++] = d++;
         }
     }
+    _InitQualifierDeclsHash();
     g_d.inited = MI_TRUE;
 }
 
@@ -61,6 +84,7 @@ void GlobalInitialize()
 void GlobalFinalize()
 {
     g_d.inited = MI_FALSE;
+    memset(&g_d.qualifierDeclsHash, 0, sizeof(g_d.qualifierDeclsHash));
     Batch_Delete(g_d.b);
 }
 
@@ -94,6 +118,7 @@ void GlobalInitialize()
             g_d.qualifierDecls.data[i++] = d++;
         }
     }
+    _InitQualifierDeclsHash();
     g_d.inited = MI_TRUE;
 }
 
@@ -108,6 +133,7 @@ __attribute__((destructor))
 void GlobalFinalize()
 {
     g_d.inited = MI_FALSE;
+    memset(&g_d.qualifierDeclsHash, 0, sizeof(g_d.qualifierDeclsHash));
     Batch_Delete(g_d.b);
 }
 #endif
@@ -200,6 +200,9 @@ typedef struct _MOF_State
     /* Maintains a list of qualifier declarations processed during parsing */
     MOF_QualifierDeclList qualifierDecls;
 
+    /* Maintains a hash structure for quick search of qualifier declaration */
+    StringHash qualifierDeclsHash;
+
     /* Track of EmbeddedInstances qualifiers for post processing */
     MOF_EmbeddedInstanceList embeddedInstanceList;
 
@@ -216,6 +219,12 @@ typedef struct _MOF_State
         _In_ const MI_ClassDecl* classDecl,
         _Outptr_result_maybenull_ MI_ClassDecl** newClassDecl);
 
+    /* Finds the instance aliases declared outside of the buffer */
+    void* onFindAliasDeclData;
+    const MI_InstanceAliasDecl* (MI_CALL *onFindAliasDecl)(
+        _In_ void * data,
+        _In_z_ const MI_Char* name);
+
     /* Create dynamic instance */
     void (MI_CALL *onAliasDeclared)(_In_ void *state);
 
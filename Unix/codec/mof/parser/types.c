@@ -1960,9 +1960,20 @@ void PrintValue(const void* value, MI_Type type, FILE* file)
 
 const MI_QualifierDecl* _FindQualifierDeclarationIntl(
     _In_ MOF_QualifierDeclList * list,
+    _In_ StringHash * hash,
     _In_z_ const MI_Char* name)
 {
     size_t i;
+    if (hash->nodes)
+    {
+        MI_Uint32 pos = StringHash_Find(hash, name);
+        if (pos != HASH_INVALID_POS)
+        {
+            _Analysis_assume_(pos < list->size);
+            return list->data[pos];
+        }
+        return NULL;
+    }
     for (i = 0; i < list->size; i++)
     {
         if (Tcscasecmp(list->data[i]->name, name) == 0)
@@ -1971,20 +1982,63 @@ const MI_QualifierDecl* _FindQualifierDeclarationIntl(
     return NULL;
 }
 
+/* Add the declaration to the list (and to the hash table beyond
+ * HASH_THRESHOLD declarations) */
+int _AppendQualifierDecl(
+    _In_ void * mofstate,
+    _In_ MI_QualifierDecl* qd)
+{
+    MOF_State * state = (MOF_State *)mofstate;
+    if (Codec_PtrArray_Append(state, (PtrArray*)&state->qualifierDecls, qd) != 0)
+        return -1;
+
+    if (state->qualifierDecls.size == HASH_THRESHOLD)
+    {
+        /* Initialize hash */
+        MI_Uint32 i = 0;
+        if (StringHash_Init(state->batch, &state->qualifierDeclsHash) != 0)
+        {
+            yyerrorf(state->errhandler, ID_OUT_OF_MEMORY, "out of memory");
+            return -1;
+        }
+        for(; i < state->qualifierDecls.size; i++)
+        {
+            if (StringHash_Add(state->batch, &state->qualifierDeclsHash, i,
+                state->qualifierDecls.data[i]->name) != 0)
+            {
+                yyerrorf(state->errhandler, ID_OUT_OF_MEMORY, "out of memory");
+                return -1;
+            }
+        }
+    }
+    else if (state->qualifierDecls.size > HASH_THRESHOLD)
+    {
+        if (StringHash_Add(state->batch, &state->qualifierDeclsHash,
+            state->qualifierDecls.size - 1, qd->name) != 0)
+        {
+            yyerrorf(state->errhandler, ID_OUT_OF_MEMORY, "out of memory");
+            return -1;
+        }
+    }
+    return 0;
+}
+
 _Use_decl_annotations_
 const MI_QualifierDecl* FindQualifierDeclaration(
     void * mofstate,
     const MI_Char* name)
 {
     MOF_State * state = (MOF_State *)mofstate;
-    const MI_QualifierDecl* decl = _FindQualifierDeclarationIntl(&state->qualifierDecls, name);
+    const MI_QualifierDecl* decl = _FindQualifierDeclarationIntl(
+        &state->qualifierDecls, &state->qualifierDeclsHash, name);
 
     if (decl == NULL)
     {
         /* Not found, fall back to global qualifiers */
         if (g_d.inited)
         {
-            decl = _FindQualifierDeclarationIntl(&g_d.qualifierDecls, name);
+            decl = _FindQualifierDeclarationIntl(
+                &g_d.qualifierDecls, &g_d.qualifierDeclsHash, name);
         }
     }
 
@@ -2005,7 +2059,7 @@ const MI_QualifierDecl* FindQualifierDeclaration(
         if (r == MI_RESULT_OK)
         {
             /* Add the declaration for future use */
-            if (Codec_PtrArray_Append(state, (PtrArray*)&state->qualifierDecls, qdecl) != 0)
+            if (_AppendQualifierDecl(state, qdecl) != 0)
                 return NULL;
             decl = qdecl;
         }
@@ -2018,7 +2072,8 @@ int AddQualifierDeclaration(
     MI_QualifierDecl* qd)
 {
     MOF_State * state = (MOF_State *)mofstate;
-    if (_FindQualifierDeclarationIntl(&state->qualifierDecls, qd->name))
+    if (_FindQualifierDeclarationIntl(&state->qualifierDecls,
+        &state->qualifierDeclsHash, qd->name))
     {
         yyerrorf(state->errhandler, ID_QUALIFIER_ALREADY_DECLARED, 
             "qualifier already declared: '%T'", 
@@ -2053,7 +2108,7 @@ int AddQualifierDeclaration(
     }
 
     /* Add the declaration */
-    return Codec_PtrArray_Append(state, (PtrArray*)&state->qualifierDecls, qd);
+    return _AppendQualifierDecl(state, qd);
 }
 
 /* Add string to hash table */
@@ -2081,7 +2136,7 @@ int _AddClasDeclToHash(
     _In_ MI_Uint32 pos)
 {
     MOF_State * state = (MOF_State *)mofstate;
-    int c = StringHash_Add(state->batch, &state->classDeclsHash, pos, cd->code, cd->name);
+    int c = StringHash_Add(state->batch, &state->classDeclsHash, pos, cd->name);
     if (c != 0)
     {
         yyerrorf(state->errhandler, ID_OUT_OF_MEMORY, "out of memory");
@@ -2105,7 +2160,7 @@ int _InitializeSchemaHash(_In_ void * mofstate,
         if (p->schemas->data[i])
         {
             const MI_Char* name = p->schemas->data[i]->classDecl->name;
-            c = StringHash_Add(state->batch, &p->schemasHash, i, Hash(name), name);
+            c = StringHash_Add(state->batch, &p->schemasHash, i, name);
             if (c != 0)
             {
                 yyerrorf(state->errhandler, ID_OUT_OF_MEMORY, "out of memory");
@@ -4885,8 +4940,7 @@ int _AddInstanceAliasDeclToHash(
     _In_ MI_Uint32 pos)
 {
     MOF_State * state = (MOF_State *)mofstate;
-    MI_Uint32 code = Hash(aid->name);
-    int c = StringHash_Add(state->batch, &state->instanceAliasesHash, pos, code, aid->name);
+    int c = StringHash_Add(state->batch, &state->instanceAliasesHash, pos, aid->name);
     if (c != 0)
     {
         yyerrorf(state->errhandler, ID_OUT_OF_MEMORY, "out of memory");
@@ -4934,7 +4988,9 @@ const MI_InstanceAliasDecl* FindInstanceAliasDecl(
     MOF_State * state = (MOF_State *)mofstate;
     if (state->instanceAliases.size > HASH_THRESHOLD)
     {
-        return _FindInstanceAliasFromHash(state, name);
+        const MI_InstanceAliasDecl* decl = _FindInstanceAliasFromHash(state, name);
+        if (decl)
+            return decl;
     }
     else
     {
@@ -4944,6 +5000,9 @@ const MI_InstanceAliasDecl* FindInstanceAliasDecl(
                 return state->instanceAliases.data[i];
         }
     }
+    /* Fall back to callback */
+    if (state->onFindAliasDecl)
+        return (*state->onFindAliasDecl)(state->onFindAliasDeclData, name);
     /* Not found */
     return NULL;
 }
@@ -26,6 +26,7 @@
 #include <pal/dir.h>
 #include "stringids.h"
 #include "instancedecl.h"
+#include "mofhash.h"
 
 /*
 **==============================================================================
@@ -446,6 +447,7 @@ typedef struct _MOF_GlobalData
     MI_Boolean inited;
     Batch* b;
     MOF_QualifierDeclList qualifierDecls;
+    StringHash qualifierDeclsHash;
 }MOF_GlobalData;
 
 /*=============================================================================
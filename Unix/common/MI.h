@@ -206,6 +206,10 @@
 # define _Out_writes_to_opt_(length, lengthwritten)
 #endif
 
+#if !defined(_Out_writes_to_)
+# define _Out_writes_to_(length, lengthwritten)
+#endif
+
 #if !defined(_Inout_)
 # define _Inout_
 #endif
@@ -7724,6 +7728,40 @@ MI_INLINE MI_Result MI_Operation_GetInstance(
     return MI_RESULT_INVALID_PARAMETER;
 }
 
+/*
+**=============================================================================
+**
+** MI_Operation_GetInstancesV1()
+**
+** NOTE: Do not call this method directly, instead call through
+**       MI_Operation_GetInstances.
+**
+** Batch version of MI_Operation_GetInstance.  This method will block until
+** a result is available and then returns up to maxInstances results that
+** have already been received, without waiting for more.  The instances are
+** valid until the next call to MI_Operation_GetInstance(s) or
+** MI_Operation_Close.  When moreResults is MI_FALSE the last instance (if
+** any) came with the final result, and result, errorMessage and
+** completionDetails describe it.  Operations that do not support batches
+** return at most one instance per call.
+**
+** This is exported by the client library rather than added to
+** MI_OperationFT so that the function table layout does not change.
+**
+**=============================================================================
+*/
+MI_EXPORT MI_Result MI_MAIN_CALL MI_Operation_GetInstancesV1(
+    _In_        MI_Operation *operation,
+                MI_Uint32 maxInstances,
+    _Out_writes_to_(maxInstances, *instanceCount) const MI_Instance **instances,
+    _Out_       MI_Uint32 *instanceCount,
+    _Out_opt_   MI_Boolean *moreResults,
+    _Out_opt_   MI_Result *result,
+    _Outptr_opt_result_maybenull_z_ const MI_Char **errorMessage,
+    _Outptr_opt_result_maybenull_   const MI_Instance **completionDetails);
+
+#define MI_Operation_GetInstances MI_Operation_GetInstancesV1
+
 /*
 **=============================================================================
 **
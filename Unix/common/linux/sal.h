@@ -94,6 +94,10 @@
 # define _Out_writes_to_opt_(length, lengthwritten)
 #endif
 
+#if !defined(_Out_writes_to_)
+# define _Out_writes_to_(length, lengthwritten)
+#endif
+
 #if !defined(_Acquires_lock_)
 # define _Acquires_lock_(lock)
 #endif
@@ -14,6 +14,7 @@
 #include <base/paths.h>
 #include <pal/format.h>
 #include <base/Strand.h>
+#include <base/serverstats.h>
 #include <protocol/protocol.h>
 #include "agentmgr.h"
 #include <omi_error/errorutil.h>
@@ -106,6 +107,9 @@ struct _AgentElem
 
     MI_Instance*            shellInstance;
     const MI_Char*          shellId;
+
+    /* agent counted in ServerStats (started successfully) */
+    MI_Boolean              counted;
 };
 
 /*
@@ -243,6 +247,9 @@ void _AgentElem_Finish( _In_ Strand* self_)
     // It is ok now for the protocol object to go away
     ProtocolSocketAndBase_ReadyToFinish(self->protocol);
 
+    if (self->counted)
+        ServerStats_UpdateAgents((MI_Uint32)self->uid, -1);
+
     if (self->shellInstance)
     {
         MI_Instance_Delete(self->shellInstance);
@@ -662,6 +669,14 @@ void _RequestItem_ParentPost( _In_ StrandEntry* self, _In_ Message* msg)
         requestItem->request->operationId = requestItem->originalOperationId;
         msg->operationId = requestItem->originalOperationId;
 
+        /* take the stages reached in the agent */
+        if( PostResultMsgTag == msg->tag && Message_IsRequest(requestItem->request) )
+        {
+            ServerStats_MergeTrace(
+                &((RequestMsg*)requestItem->request)->trace,
+                &((PostResultMsg*)msg)->trace );
+        }
+
         Strand_Post( &requestItem->strand.strand, msg );
 
         /* remove item if result received */
@@ -1063,6 +1078,9 @@ static AgentElem* _CreateAgent(
         &self->tailAgents,
         (ListElem*)&(agent->next));
 
+    agent->counted = MI_TRUE;
+    ServerStats_UpdateAgents((MI_Uint32)uid, 1);
+
     return agent;
 
 failed:
@@ -1133,6 +1151,9 @@ static MI_Result _SendRequestToAgent_Common(
     operationId = _NextOperationId();
     requestItem->key = operationId;
 
+    if( Message_IsRequest(msg) )
+        ServerStats_Stamp( &((RequestMsg*)msg)->trace, SERVERSTATS_STAGE_AGENTSEND );
+
     result = _PrepareMessageForAgent( operationId, msg, &req );
     if( MI_RESULT_OK != result )
     {
@@ -1256,6 +1277,203 @@ static MI_Result _SendRequestToAgent(
 
 #endif
 
+/* Sends the request to the agent of the given user (creating it if needed) */
+static MI_Result _HandleRequestWithAgent(
+    _In_ AgentMgr* self,
+    _Inout_ InteractionOpenParams* params,
+    _In_ const ProvRegEntry* proventry,
+    uid_t uid,
+    gid_t gid)
+{
+    MI_Result result = MI_RESULT_OK;
+    AgentElem* agent;
+    RequestMsg* msg = (RequestMsg*)params->msg;
+
+#if defined(CONFIG_POSIX)
+
+    // We cannot use ReadWriteLock_AcquireRead(&self->lock);
+    // as we may need to create the object here
+    // (and there is no option to upgrade from read to write acquisition)
+    ReadWriteLock_AcquireWrite(&self->lock);
+
+#ifndef DISABLE_SHELL
+    if (msg->base.flags & WSMAN_IsShellRequest)
+    {
+        if (msg->base.tag == ShellCreateReqTag)
+        {
+            CreateInstanceReq *createReq = (CreateInstanceReq*) msg;
+            agent = _CreateShellAgent(self, uid, gid, createReq);
+            if (!agent)
+            {
+                trace_FailedLoadProviderAgent();
+                result = MI_RESULT_FAILED;
+            }
+            else
+            {
+                result = _SendIdleRequestToAgent( agent );
+            }
+        }
+        else
+        {
+            agent = _FindShellAgent(self, uid, gid, msg);
+            if (agent == NULL)
+            {
+                result = MI_RESULT_NOT_FOUND;
+            }
+        }
+    }
+    else
+#endif
+    {
+        agent = _FindAgent(self, uid, gid);
+
+        if (!agent)
+        {
+            agent = _CreateAgent(self, uid, gid);
+            if (!agent)
+            {
+                trace_FailedLoadProviderAgent();
+                result = MI_RESULT_FAILED;
+            }
+            else
+            {
+                result = _SendIdleRequestToAgent( agent );
+            }
+        }
+    }
+
+#ifndef DISABLE_SHELL
+   if ((MI_RESULT_OK == result) &&
+        (msg->base.flags & WSMAN_IsShellRequest))
+    {
+        if ((msg->base.tag == ShellConnectReqTag) ||
+            (msg->base.tag == ShellReconnectReqTag))
+        {
+            MI_Value value;
+            value.string = MI_T("Connected");
+            result = MI_Instance_SetElement(agent->shellInstance, MI_T("State"), &value, MI_STRING, 0);
+        }
+        else if (msg->base.tag == ShellDisconnectReqTag)
+        {
+            MI_Value value;
+            value.string = MI_T("Disconnected");
+            result = MI_Instance_SetElement(agent->shellInstance, MI_T("State"), &value, MI_STRING, 0);
+        }
+        else if (msg->base.tag == ShellDeleteReqTag)
+        {
+            /* Mark it with no shellId that way it will not be recognised as a shell any more */
+            agent->shellId = NULL;
+        }
+    }
+#endif
+
+    if( MI_RESULT_OK == result )
+    {
+        result = _SendRequestToAgent(agent, params, &msg->base, proventry);
+    }
+
+    ReadWriteLock_ReleaseWrite(&self->lock);
+
+    return result;
+
+#else
+    MI_UNUSED(agent);
+    MI_UNUSED(result);
+    MI_UNUSED(msg);
+    MI_UNUSED(uid);
+    MI_UNUSED(gid);
+    /* windows version hosts all providers as 'in-proc' */
+    return ProvMgr_NewRequest(
+            &self->provmgr,
+            proventry,
+            params );
+#endif
+}
+
+#if defined(CONFIG_ENABLE_PREEXEC)
+
+/* A request waiting for its pre-exec program (allocated from its batch) */
+typedef struct _AgentMgr_PreExecRequest
+{
+    Batch* batch;
+    AgentMgr* self;
+    InteractionOpenParams params;
+    /* (its strings are copies, as the registry may be reloaded meanwhile) */
+    ProvRegEntry proventry;
+    uid_t uid;
+    gid_t gid;
+}
+AgentMgr_PreExecRequest;
+
+static AgentMgr_PreExecRequest* _PreExecRequest_New(
+    const ProvRegEntry* proventry)
+{
+    Batch* batch = Batch_New(BATCH_MAX_PAGES);
+    AgentMgr_PreExecRequest* request;
+    ProvRegEntry* entry;
+
+    if (!batch)
+        return NULL;
+
+    request = (AgentMgr_PreExecRequest*)Batch_GetClear(
+        batch, sizeof(AgentMgr_PreExecRequest));
+
+    if (!request)
+        goto failed;
+
+    request->batch = batch;
+    entry = &request->proventry;
+    *entry = *proventry;
+    entry->next = NULL;
+
+    if (proventry->user &&
+        !(entry->user = Batch_Strdup(batch, proventry->user)))
+        goto failed;
+
+    if (proventry->nameSpace &&
+        !(entry->nameSpace = Batch_Tcsdup(batch, proventry->nameSpace)))
+        goto failed;
+
+    if (proventry->className &&
+        !(entry->className = Batch_Tcsdup(batch, proventry->className)))
+        goto failed;
+
+    if (proventry->libraryName &&
+        !(entry->libraryName = Batch_Strdup(batch, proventry->libraryName)))
+        goto failed;
+
+    if (!(entry->preexec = Batch_Strdup(batch, proventry->preexec)))
+        goto failed;
+
+    return request;
+
+failed:
+    Batch_Delete(batch);
+    return NULL;
+}
+
+static void _PreExecCallback(
+    void* callbackData,
+    MI_Result result)
+{
+    AgentMgr_PreExecRequest* request = (AgentMgr_PreExecRequest*)callbackData;
+    Message* msg = request->params.msg;
+
+    if (result == MI_RESULT_OK)
+    {
+        result = _HandleRequestWithAgent(request->self, &request->params,
+            &request->proventry, request->uid, request->gid);
+    }
+
+    if (result != MI_RESULT_OK)
+        Strand_FailOpenWithResult(&request->params, result, PostResultMsg_NewAndSerialize);
+
+    Message_Release(msg);
+    Batch_Delete(request->batch);
+}
+
+#endif /* defined(CONFIG_ENABLE_PREEXEC) */
+
 /*
 **==============================================================================
 **
@@ -1284,7 +1502,7 @@ MI_Result AgentMgr_Init(
     ReadWriteLock_Init(&self->lock);
 
 #if defined(CONFIG_ENABLE_PREEXEC)
-    PreExec_Construct(&self->preexec);
+    PreExec_Construct(&self->preexec, selector);
 #endif /* defined(CONFIG_ENABLE_PREEXEC) */
 
     return MI_RESULT_OK;
@@ -1344,8 +1562,6 @@ MI_Result AgentMgr_HandleRequest(
     _Inout_ InteractionOpenParams* params,
     _In_ const ProvRegEntry* proventry)
 {
-    MI_Result result = MI_RESULT_OK;
-    AgentElem* agent;
     uid_t uid;
     gid_t gid;
     RequestMsg* msg = (RequestMsg*)params->msg;
@@ -1427,105 +1643,37 @@ MI_Result AgentMgr_HandleRequest(
     }
 
 #if defined(CONFIG_ENABLE_PREEXEC)
-    if (PreExec_Exec(&self->preexec, proventry->preexec, uid, gid) != 0)
-        return MI_RESULT_FAILED;
-#endif /* defined(CONFIG_ENABLE_PREEXEC) */
+    if (proventry->preexec)
+    {
+        /* Wait for the pre-exec program if it has to run (or still runs) */
+        AgentMgr_PreExecRequest* request = _PreExecRequest_New(proventry);
+        int r;
 
-#if defined(CONFIG_POSIX)
+        if (!request)
+            return MI_RESULT_SERVER_LIMITS_EXCEEDED;
 
-    // We cannot use ReadWriteLock_AcquireRead(&self->lock);
-    // as we may need to create the object here
-    // (and there is no option to upgrade from read to write acquisition)
-    ReadWriteLock_AcquireWrite(&self->lock);
+        request->self = self;
+        request->params = *params;
+        request->uid = uid;
+        request->gid = gid;
+        Message_AddRef(params->msg);
 
-#ifndef DISABLE_SHELL
-    if (msg->base.flags & WSMAN_IsShellRequest)
-    {
-        if (msg->base.tag == ShellCreateReqTag)
-        {
-            CreateInstanceReq *createReq = (CreateInstanceReq*) msg;
-            agent = _CreateShellAgent(self, uid, gid, createReq);
-            if (!agent)
-            {
-                trace_FailedLoadProviderAgent();
-                result = MI_RESULT_FAILED;
-            }
-            else
-            {
-                result = _SendIdleRequestToAgent( agent );
-            }
-        }
-        else
-        {
-            agent = _FindShellAgent(self, uid, gid, msg);
-            if (agent == NULL)
-            {
-                result = MI_RESULT_NOT_FOUND;
-            }
-        }
-    }
-    else
-#endif
-    {
-        agent = _FindAgent(self, uid, gid);
+        r = PreExec_Exec(&self->preexec, request->proventry.preexec, uid, gid,
+            _PreExecCallback, request);
 
-        if (!agent)
-        {
-            agent = _CreateAgent(self, uid, gid);
-            if (!agent)
-            {
-                trace_FailedLoadProviderAgent();
-                result = MI_RESULT_FAILED;
-            }
-            else
-            {
-                result = _SendIdleRequestToAgent( agent );
-            }
-        }
-    }
+        /* The interaction is opened (or failed) by _PreExecCallback() */
+        if (r == PREEXEC_PENDING)
+            return MI_RESULT_OK;
 
-#ifndef DISABLE_SHELL
-   if ((MI_RESULT_OK == result) &&
-        (msg->base.flags & WSMAN_IsShellRequest))
-    {
-        if ((msg->base.tag == ShellConnectReqTag) ||
-            (msg->base.tag == ShellReconnectReqTag))
-        {
-            MI_Value value;
-            value.string = MI_T("Connected");
-            result = MI_Instance_SetElement(agent->shellInstance, MI_T("State"), &value, MI_STRING, 0);
-        }
-        else if (msg->base.tag == ShellDisconnectReqTag)
-        {
-            MI_Value value;
-            value.string = MI_T("Disconnected");
-            result = MI_Instance_SetElement(agent->shellInstance, MI_T("State"), &value, MI_STRING, 0);
-        }
-        else if (msg->base.tag == ShellDeleteReqTag)
-        {
-            /* Mark it with no shellId that way it will not be recognised as a shell any more */
-            agent->shellId = NULL;
-        }
-    }
-#endif
+        Message_Release(params->msg);
+        Batch_Delete(request->batch);
 
-    if( MI_RESULT_OK == result )
-    {
-        result = _SendRequestToAgent(agent, params, &msg->base, proventry);
+        if (r != 0)
+            return MI_RESULT_FAILED;
     }
+#endif /* defined(CONFIG_ENABLE_PREEXEC) */
 
-    ReadWriteLock_ReleaseWrite(&self->lock);
-
-    return result;
-
-#else
-    MI_UNUSED(agent);
-    /* windows version hosts all providers as 'in-proc' */
-    return ProvMgr_NewRequest(
-            &self->provmgr,
-            proventry,
-            params );
-#endif
+    return _HandleRequestWithAgent(self, params, proventry, uid, gid);
 }
 
 #ifndef DISABLE_SHELL
@@ -25,8 +25,12 @@
 
 #define DISPENUMPARENT_STRANDAUX_ENUMDONE      0
 
+#define DISPCACHEDSCHEMA_STRANDAUX_POSTRESULT  0
+
 STRAND_DEBUGNAME1( DispEnumParent, EnumDone )
 STRAND_DEBUGNAME( DispEnumEntry )
+STRAND_DEBUGNAME( DispGetClass )
+STRAND_DEBUGNAME1( DispCachedSchema, PostResult )
 
 /*
 **==============================================================================
@@ -315,6 +319,9 @@ static void _DispEnumParent_Entry_Post( _In_ StrandMany* self_, _In_ Message* ms
             self->result = rsp->result;
         }
 
+        // take the stages reached by the provider (the first one to reach them)
+        ServerStats_MergeTrace( &self->baseRequest->trace, &rsp->trace );
+
         // This is not posted here
     }
     else
@@ -372,6 +379,7 @@ static MI_Result _DispatchEnumerateInstancesReq(
     msg->nameSpace = Batch_Tcsdup(msg->base.base.batch, request->nameSpace);
     msg->className = Batch_Tcsdup(msg->base.base.batch, className);
     msg->base.userAgent = request->base.userAgent;
+    msg->base.trace = request->base.trace;
 
     if (!msg->nameSpace || !msg->className)
     {
@@ -496,6 +504,7 @@ static MI_Boolean _DispatchAssocReq(
     msg->packedInstancePtr = req->packedInstancePtr;
     msg->packedInstanceSize = req->packedInstanceSize;
     msg->base.userAgent = req->base.userAgent;
+    msg->base.trace = req->base.trace;
 
     msg->className = Batch_Tcsdup(msg->base.base.batch, className);
 
@@ -589,6 +598,247 @@ sendErrorBack:
     return r;
 }
 
+/*
+**==============================================================================
+**
+** GetClass (see schemacache.h)
+**
+**==============================================================================
+*/
+
+typedef struct _DispGetClass
+{
+    StrandBoth              strand;
+    Disp*                   disp;
+    GetClassReq*            request;
+    MI_Uint32               generation;     // of the schema cache when the request was received
+}
+DispGetClass;
+
+static void _DispGetClass_Finished( _In_ Strand* self_)
+{
+    DispGetClass* self = (DispGetClass*)self_;
+
+    GetClassReq_Release( self->request );
+    Strand_Delete( self_ );
+}
+
+static void _DispGetClass_Right_Post( _In_ Strand* self_, _In_ Message* msg)
+{
+    DispGetClass* self = (DispGetClass*)self_;
+
+    if( PostSchemaMsgTag == msg->tag )
+    {
+        SchemaCache_Put(
+            &self->disp->schemaCache,
+            self->generation,
+            self->request->nameSpace,
+            self->request->className,
+            self->request->base.base.flags,
+            (PostSchemaMsg*)msg );
+    }
+
+    StrandBoth_PostPassthruLeft( &self->strand, msg );
+}
+
+/*
+    This object sits between the transport (left) and the provider manager
+    (right) for a GetClass request whose response is not cached yet.
+
+    Behavior:
+    - The response (PostSchemaMsg) is cached on its way to the transport
+    - Everything else (acks, cancel and close) just passes thru
+    - Shutdown: once both sides are closed
+*/
+static StrandFT _DispGetClass_LeftFT = {
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    _DispGetClass_Finished,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL };
+
+static StrandFT _DispGetClass_RightFT = {
+    _DispGetClass_Right_Post,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL };
+
+typedef struct _DispCachedSchema
+{
+    Strand                  strand;
+    PostResultMsg*          result;         // posted once the schema is acked
+}
+DispCachedSchema;
+
+static void _DispCachedSchema_Ack( _In_ Strand* self_)
+{
+    DispCachedSchema* self = (DispCachedSchema*)self_;
+
+    // The transport may ack the next post right away, so post it
+    // once this method is done
+    if( self->result )
+    {
+        Strand_ScheduleAux( self_, DISPCACHEDSCHEMA_STRANDAUX_POSTRESULT );
+    }
+}
+
+//DISPCACHEDSCHEMA_STRANDAUX_POSTRESULT
+static void _DispCachedSchema_PostResult( _In_ Strand* self_)
+{
+    DispCachedSchema* self = (DispCachedSchema*)self_;
+
+    if( self->result && !self_->info.thisClosedOther )
+    {
+        Strand_Post( self_, &self->result->base );
+        PostResultMsg_Release( self->result );
+        self->result = NULL;
+        Strand_Close( self_ );
+    }
+}
+
+static void _DispCachedSchema_Close( _In_ Strand* self_)
+{
+    if( !self_->info.thisClosedOther )
+    {
+        // Just close back
+        Strand_Close( self_ );
+    }
+}
+
+static void _DispCachedSchema_Finished( _In_ Strand* self_)
+{
+    DispCachedSchema* self = (DispCachedSchema*)self_;
+
+    if( self->result )
+    {
+        PostResultMsg_Release( self->result );
+    }
+
+    Strand_Delete( self_ );
+}
+
+/*
+    This object responds to a GetClass request from the schema cache,
+    without involving the provider manager.
+
+    Behavior:
+    - Posts the cached schema and, once acked, the final result
+    - Shutdown: closes after posting the final result (or if the
+       transport closes first)
+*/
+static StrandFT _DispCachedSchema_FT = {
+    NULL,
+    NULL,
+    _DispCachedSchema_Ack,
+    NULL,
+    _DispCachedSchema_Close,
+    _DispCachedSchema_Finished,
+    NULL,
+    _DispCachedSchema_PostResult,
+    NULL,
+    NULL,
+    NULL,
+    NULL };
+
+/* Responds from the schema cache, returns MI_FALSE if not cached */
+static MI_Boolean _SendCachedSchema(
+    _In_ Disp* self,
+    _Inout_ InteractionOpenParams* interactionParams,
+    _In_ GetClassReq* req)
+{
+    DispCachedSchema* interaction;
+    PostSchemaMsg* schema;
+    PostResultMsg* result;
+
+    schema = SchemaCache_Get(&self->schemaCache, req->nameSpace,
+        req->className, req->base.base.flags, req->base.base.operationId);
+
+    if (!schema)
+        return MI_FALSE;
+
+    result = PostResultMsg_NewAndSerialize(&req->base.base, NULL, NULL,
+        MI_RESULT_TYPE_MI, MI_RESULT_OK);
+
+    if (!result)
+    {
+        PostSchemaMsg_Release(schema);
+        return MI_FALSE;
+    }
+
+    interaction = (DispCachedSchema*)Strand_New(
+        STRAND_DEBUG( DispCachedSchema )
+        &_DispCachedSchema_FT,
+        sizeof(DispCachedSchema),
+        STRAND_FLAG_ENTERSTRAND,
+        interactionParams );
+
+    if (!interaction)
+    {
+        PostResultMsg_Release(result);
+        PostSchemaMsg_Release(schema);
+        return MI_FALSE;
+    }
+
+    interaction->result = result;
+
+    Strand_Ack( &interaction->strand );   // Ack open msg
+    Strand_Post( &interaction->strand, &schema->base );
+    Strand_Leave( &interaction->strand );
+
+    PostSchemaMsg_Release(schema);
+    return MI_TRUE;
+}
+
+/* Sends the request to the provider manager thru a DispGetClass,
+ * returns MI_FALSE if it cannot be created */
+static MI_Boolean _DispatchGetClassReq(
+    _In_ Disp* self,
+    _Inout_ InteractionOpenParams* interactionParams,
+    _In_ GetClassReq* req,
+    _In_ const ProvRegEntry* proventry)
+{
+    DispGetClass* interaction;
+    AgentMgr_OpenCallbackData openCallbackData;
+
+    interaction = (DispGetClass*)StrandBoth_New(
+        STRAND_DEBUG( DispGetClass )
+        &_DispGetClass_LeftFT,
+        &_DispGetClass_RightFT,
+        sizeof(DispGetClass),
+        STRAND_FLAG_ENTERSTRAND,
+        interactionParams );
+
+    if (!interaction)
+        return MI_FALSE;
+
+    Message_AddRef( &req->base.base );
+    interaction->disp = self;
+    interaction->request = req;
+    interaction->generation = SchemaCache_GetGeneration(&self->schemaCache);
+
+    /* Send the request to provider manager */
+    openCallbackData.self = &self->agentmgr;
+    openCallbackData.proventry = proventry;
+    StrandBoth_Open( &interaction->strand, AgentMgr_OpenCallback, &openCallbackData, &req->base.base, MI_TRUE, MI_TRUE );
+
+    return MI_TRUE;
+}
+
 static MI_Result _HandleGetClassReq(
     _In_ Disp* self,
     _Inout_ InteractionOpenParams* interactionParams,
@@ -657,7 +907,15 @@ static MI_Result _HandleGetClassReq(
         freg = *reg;
     }
 
-    // Send the request to provider manager.
+    /* Only the class declaration comes from the cache: the namespace and the
+     * class must still be registered (resolved above) */
+    if (_SendCachedSchema(self, interactionParams, req))
+        return MI_RESULT_OK;
+
+    if (_DispatchGetClassReq(self, interactionParams, req, &freg))
+        return MI_RESULT_OK;
+
+    // Send the request to provider manager (uncached).
     r = AgentMgr_HandleRequest(&self->agentmgr, interactionParams, &freg);
 
     if (r != MI_RESULT_OK)
@@ -850,6 +1108,40 @@ sendErrorBack:
     return r;
 }
 
+static void _ReleaseQuery(
+    Message* msg,
+    void* callbackData)
+{
+    MI_UNUSED(msg);
+    WQLCache_Release((WQLCacheEntry*)callbackData);
+}
+
+/* Parses the query of the request, sharing it through the query cache
+ * (released with the request) when possible */
+static WQL* _ParseQuery(
+    _In_ Disp* self,
+    _Inout_ EnumerateInstancesReq* req,
+    WQL_Dialect dialect)
+{
+    WQLCacheEntry* cached;
+
+    if (!self->wqlCache || req->base.base.dtor)
+    {
+        return WQL_Parse(req->queryExpression, req->base.base.batch,
+            dialect);
+    }
+
+    cached = WQLCache_Acquire(self->wqlCache, req->nameSpace,
+        req->queryExpression, dialect);
+
+    if (!cached)
+        return NULL;
+
+    req->base.base.dtor = _ReleaseQuery;
+    req->base.base.dtorData = cached;
+    return cached->wql;
+}
+
 static MI_Result _HandleEnumerateInstancesReq(
     _In_ Disp* self,
     _Inout_ InteractionOpenParams* interactionParams,
@@ -913,8 +1205,7 @@ static MI_Result _HandleEnumerateInstancesReq(
         /* Compile the query */
         if (req->queryExpression)
         {
-            req->wql = WQL_Parse(req->queryExpression, req->base.base.batch,
-                dialect);
+            req->wql = _ParseQuery(self, req, dialect);
 
             if (!req->wql)
             {
@@ -1541,6 +1832,11 @@ MI_Result Disp_Init(Disp* self, Selector* selector)
     /* Initialize the provider manager */
     MI_RETURN_ERR(AgentMgr_Init(&self->agentmgr, selector));
 
+    MI_RETURN_ERR(SchemaCache_Init(&self->schemaCache));
+
+    /* Queries are parsed for each request if this fails */
+    self->wqlCache = WQLCache_New(WQLCACHE_MAX_ENTRIES);
+
 #ifndef DISABLE_INDICATION
     /* Initialize indication manager */
     self->indmgr = IndiMgr_NewFromDisp(self);
@@ -1558,6 +1854,9 @@ MI_Result Disp_Reload(Disp* self)
 
     ProvReg_Destroy(&self->provreg);
     ProvReg_Init2(&self->provreg);
+
+    /* Classes may have changed with the providers */
+    SchemaCache_Clear(&self->schemaCache);
     return MI_RESULT_OK;
 }
 
@@ -1565,6 +1864,10 @@ MI_Result Disp_Destroy(Disp* self)
 {
     MI_RETURN_ERR(AgentMgr_Destroy(&self->agentmgr));
     ProvReg_Destroy(&self->provreg);
+    SchemaCache_Destroy(&self->schemaCache);
+
+    if (self->wqlCache)
+        WQLCache_Delete(self->wqlCache);
 
 #ifndef DISABLE_INDICATION
     /* Shutdown indication manager */
@@ -1575,6 +1878,36 @@ MI_Result Disp_Destroy(Disp* self)
     return MI_RESULT_OK;
 }
 
+MI_Boolean Disp_FindInProcLibrary(
+    _In_ Disp* self,
+    _In_z_ const ZChar* nameSpace,
+    _In_z_ const ZChar* className,
+    _Out_writes_z_(PAL_MAX_PATH_SIZE) char libraryName[PAL_MAX_PATH_SIZE])
+{
+    const ProvRegEntry* entry;
+    MI_Result r;
+
+    entry = ProvReg_FindProviderForClass(&self->provreg, nameSpace,
+        className, &r);
+
+    if (!entry || entry->hosting != PROV_HOSTING_INPROC)
+        return MI_FALSE;
+
+    Strlcpy(libraryName, entry->libraryName, PAL_MAX_PATH_SIZE);
+    return MI_TRUE;
+}
+
+void Disp_WithClassDecl(
+    _In_ Disp* self,
+    _In_z_ const char* libraryName,
+    _In_z_ const ZChar* className,
+    _In_ ClassDeclProc proc,
+    _In_opt_ void* procData)
+{
+    ProvMgr_WithClassDecl(&self->agentmgr.provmgr, libraryName, className,
+        proc, procData);
+}
+
 MI_Result Disp_HandleInteractionRequest(
     _In_ Disp* self,
     _Inout_ InteractionOpenParams* params )
@@ -1593,6 +1926,9 @@ MI_Result Disp_HandleInteractionRequest(
     DEBUG_ASSERT( NULL != params->interaction );
     DEBUG_ASSERT( NULL != params->msg );
 
+    if (Message_IsRequest(msg))
+        ServerStats_Stamp(&((RequestMsg*)msg)->trace, SERVERSTATS_STAGE_DISPATCH);
+
     switch (msg->tag)
     {
         case GetInstanceReqTag:
@@ -19,6 +19,7 @@
 #include <pal/atomic.h>
 #include <indication/indimgr/mgr.h>
 #include "agentmgr.h"
+#include "schemacache.h"
 
 /*
 **==============================================================================
@@ -37,6 +38,8 @@
 **
 **         (4) Accepts response messages and routes them back to the requestor.
 **
+**         (5) Caches GetClass responses (see schemacache.h).
+**
 **==============================================================================
 */
 
@@ -44,6 +47,10 @@ typedef struct _Disp
 {
     ProvReg     provreg;
     AgentMgr    agentmgr;
+    SchemaCache schemaCache;
+
+    /* Parsed queries of enumerations (may be NULL) */
+    WQLCache*   wqlCache;
 
 #ifndef DISABLE_INDICATION
     IndicationManager *indmgr;
@@ -61,6 +68,26 @@ MI_Result Disp_Reload(
 MI_Result Disp_Destroy(
     Disp* self);
 
+/* Copies the name of the library of the provider of a class to
+ * 'libraryName' if the provider is hosted in-proc (returns MI_FALSE
+ * otherwise). The registry may be reloaded once this returns: the caller
+ * serializes it with Disp_Reload(). */
+MI_Boolean Disp_FindInProcLibrary(
+    _In_ Disp* self,
+    _In_z_ const ZChar* nameSpace,
+    _In_z_ const ZChar* className,
+    _Out_writes_z_(PAL_MAX_PATH_SIZE) char libraryName[PAL_MAX_PATH_SIZE]);
+
+/* Calls 'proc' with the declaration of a class of an in-proc provider
+ * library if it is loaded already (see ProvMgr_WithClassDecl()),
+ * otherwise with NULL */
+void Disp_WithClassDecl(
+    _In_ Disp* self,
+    _In_z_ const char* libraryName,
+    _In_z_ const ZChar* className,
+    _In_ ClassDeclProc proc,
+    _In_opt_ void* procData);
+
 
 MI_Result Disp_HandleInteractionRequest(
     _In_ Disp* self,
@@ -13,6 +13,7 @@
 #include <pal/strings.h>
 #include <base/paths.h>
 #include <base/strarr.h>
+#include <pal/sleep.h>
 
 #if defined(CONFIG_POSIX)
 # include <pthread.h>
@@ -21,6 +22,7 @@
 # include <sys/types.h>
 # include <sys/wait.h>
 # include <signal.h>
+# include <fcntl.h>
 #endif
 
 /*
@@ -31,71 +33,149 @@
 **==============================================================================
 */
 
+/* A request waiting for a running program */
+typedef struct _PreExecWaiter
+{
+    struct _PreExecWaiter* next;
+    PreExecCallback callback;
+    void* callbackData;
+}
+PreExecWaiter;
+
+typedef struct _Bucket /* derives from HashBucket */
+{
+    struct _Bucket* next;
+    char* key;
+
+    /* The running program (NULL once it succeeded) */
+    struct _PreExecRun* run;
+}
+Bucket;
+
+/* A program that has not exited yet; its handler watches the pipe the
+ * intermediate child writes the exit status of the program to */
+typedef struct _PreExecRun
+{
+    Handler handler;
+    struct _PreExecRun* next;
+    PreExec* self;
+
+    /* Cache entry of the program (NULL once it exited) */
+    Bucket* bucket;
+
+    /* Intermediate child (leader of the process group) */
+    pid_t pid;
+
+    /* Exit status of the program as read from the pipe */
+    int status;
+    size_t received;
+
+    MI_Boolean finished;
+    PreExecWaiter* waiters;
+    char path[PAL_MAX_PATH_SIZE];
+}
+PreExecRun;
+
+/* Starts the program through an intermediate child which waits for it and
+ * writes its exit status to the pipe whose read end is returned in 'fd' */
 static pid_t _Exec(
     const char* path,
     const char* uidStr,
-    const char* gidStr)
+    const char* gidStr,
+    int* fd)
 {
-    pid_t pid = fork();
+    int fds[2];
+    pid_t pid;
+
+    if (pipe(fds) != 0)
+        return -1;
+
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+
+    pid = fork();
 
     /* Return if failure */
     if (pid < 0)
+    {
+        close(fds[0]);
+        close(fds[1]);
         return -1;
+    }
 
     /* Return if parent */
     if (pid > 0)
-        return pid;
+    {
+        /* Also done by the child: whichever runs first */
+        setpgid(pid, pid);
 
-    /* In child process here... */
+        close(fds[1]);
+        fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+        *fd = fds[0];
+        return pid;
+    }
 
-    /* Close any open file descriptors */
+    /* In intermediate child process here... */
     {
-        int fd;
-        int n = getdtablesize();
+        sigset_t set;
+        pid_t child;
+        int status = 0;
 
-        if (n > 2500 || n < 0)
-            n = 2500;
+        /* Wait for the program here rather than in the inherited handler */
+        signal(SIGCHLD, SIG_DFL);
+        sigemptyset(&set);
+        sigprocmask(SIG_SETMASK, &set, NULL);
 
-        /* Leave stdin(0), stdout(1), stderr(2) open (for debugging) */
-        for (fd = 3; fd < n; ++fd)
-            close(fd);
-    }
+        setpgid(0, 0);
 
-    /* Execute the program */
-    execl(
-        path,   /* path of program */
-        path,   /* argv[0] */
-        uidStr, /* argv[1] */
-        gidStr, /* argv[2] */
-        NULL);
+        /* Close any open file descriptors but the pipe */
+        {
+            int fd;
+            int n = getdtablesize();
 
-    _exit(1); 
-    /* Unreachable */
-    return -1;
-}
+            if (n > 2500 || n < 0)
+                n = 2500;
 
-static void _BlockSIGCHLD()
-{
-    sigset_t set;
-    sigemptyset(&set);
-    sigaddset(&set, SIGCHLD);
-    sigprocmask(SIG_BLOCK, &set, NULL);
-}
+            /* Leave stdin(0), stdout(1), stderr(2) open (for debugging) */
+            for (fd = 3; fd < n; ++fd)
+            {
+                if (fd != fds[1])
+                    close(fd);
+            }
+        }
 
-static void _UnblockSIGCHLD()
-{
-    sigset_t set;
-    sigemptyset(&set);
-    sigaddset(&set, SIGCHLD);
-    sigprocmask(SIG_UNBLOCK, &set, NULL);
-}
+        child = fork();
 
-typedef struct _Bucket /* derives from HashBucket */
-{
-    struct _Bucket* next;
-    char* key;
+        if (child < 0)
+            _exit(1);
+
+        if (child == 0)
+        {
+            close(fds[1]);
+
+            /* Execute the program */
+            execl(
+                path,   /* path of program */
+                path,   /* argv[0] */
+                uidStr, /* argv[1] */
+                gidStr, /* argv[2] */
+                NULL);
+
+            _exit(1);
+        }
+
+        while (waitpid(child, &status, 0) == -1 && errno == EINTR)
+            ;
+
+        if (write(fds[1], &status, sizeof(status)) != sizeof(status))
+            _exit(1);
+
+        _exit(0);
+    }
+
+    /* Unreachable */
+    return -1;
 }
-Bucket;
 
 static size_t _Hash(
     const HashBucket* bucket_)
@@ -127,42 +207,178 @@ static void _Release(
     PAL_Free(bucket);
 }
 
-static MI_Boolean _Contains(
+static Bucket* _Find(
     HashMap* self,
     const char* key)
 {
     Bucket bucket;
     bucket.key = (char*)key;
-    return HashMap_Find(self, (const HashBucket*)&bucket) ? MI_TRUE : MI_FALSE;
+    return (Bucket*)HashMap_Find(self, (const HashBucket*)&bucket);
 }
 
-static int _Insert(
+static Bucket* _Insert(
     HashMap* self,
     const char* key)
 {
     Bucket* bucket = (Bucket*)PAL_Calloc(1, sizeof(Bucket));
 
     if (!bucket)
-        return -1;
+        return NULL;
 
     bucket->key = PAL_Strdup(key);
 
     if (!bucket->key)
     {
         PAL_Free(bucket);
-        return -1;
+        return NULL;
     }
 
     if (HashMap_Insert(self, (HashBucket*)bucket) != 0)
     {
-        PAL_Free(bucket);
         PAL_Free(bucket->key);
-        return -1;
+        PAL_Free(bucket);
+        return NULL;
     }
 
+    return bucket;
+}
+
+static int _AddWaiter(
+    PreExecRun* run,
+    PreExecCallback callback,
+    void* callbackData)
+{
+    PreExecWaiter* waiter = (PreExecWaiter*)PAL_Calloc(1, sizeof(PreExecWaiter));
+
+    if (!waiter)
+        return -1;
+
+    waiter->callback = callback;
+    waiter->callbackData = callbackData;
+    waiter->next = run->waiters;
+    run->waiters = waiter;
     return 0;
 }
 
+/* Updates the cache with the outcome of the program and resumes the requests
+ * waiting for it */
+static void _Finish(
+    PreExecRun* run,
+    MI_Result result)
+{
+    PreExec* self = run->self;
+    PreExecWaiter* waiter;
+    PreExecRun** p;
+
+    Lock_Acquire(&self->lock);
+
+    run->finished = MI_TRUE;
+    waiter = run->waiters;
+    run->waiters = NULL;
+
+    if (run->bucket)
+    {
+        /* Keep the key on success, forget it so the next request retries
+         * otherwise */
+        if (result == MI_RESULT_OK)
+            run->bucket->run = NULL;
+        else
+            HashMap_Remove(&self->cache, (const HashBucket*)run->bucket);
+
+        run->bucket = NULL;
+    }
+
+    for (p = &self->runs; *p; p = &(*p)->next)
+    {
+        if (*p == run)
+        {
+            *p = run->next;
+            break;
+        }
+    }
+
+    Lock_Release(&self->lock);
+
+    if (result == MI_RESULT_OK)
+        trace_PreExecOk(run->path);
+    else
+        trace_PreExecFailed(run->path);
+
+    while (waiter)
+    {
+        PreExecWaiter* next = waiter->next;
+        (*waiter->callback)(waiter->callbackData, result);
+        PAL_Free(waiter);
+        waiter = next;
+    }
+}
+
+static MI_Boolean _RunCallback(
+    Selector* selector,
+    Handler* handler,
+    MI_Uint32 mask,
+    MI_Uint64 currentTimeUsec)
+{
+    PreExecRun* run = (PreExecRun*)handler->data;
+
+    MI_UNUSED(selector);
+    MI_UNUSED(currentTimeUsec);
+
+    if (mask & SELECTOR_READ)
+    {
+        ssize_t n = read(
+            handler->sock,
+            (char*)&run->status + run->received,
+            sizeof(run->status) - run->received);
+
+        if (n > 0)
+        {
+            run->received += (size_t)n;
+
+            if (run->received < sizeof(run->status))
+                return MI_TRUE;
+
+            _Finish(run,
+                WIFEXITED(run->status) && WEXITSTATUS(run->status) == 0 ?
+                MI_RESULT_OK : MI_RESULT_FAILED);
+            return MI_FALSE;
+        }
+
+        if (n < 0 && (errno == EINTR || errno == EAGAIN))
+            return MI_TRUE;
+
+        /* The intermediate child exited without writing the status */
+        _Finish(run, MI_RESULT_FAILED);
+        return MI_FALSE;
+    }
+
+    if (mask & SELECTOR_TIMEOUT)
+    {
+        kill(-run->pid, SIGKILL);
+        _Finish(run, MI_RESULT_FAILED);
+        return MI_FALSE;
+    }
+
+    if (mask & (SELECTOR_REMOVE | SELECTOR_DESTROY))
+    {
+        /* Removed before the program exited (shutdown) */
+        if (!run->finished)
+        {
+            kill(-run->pid, SIGKILL);
+            _Finish(run, MI_RESULT_FAILED);
+        }
+
+        close(handler->sock);
+
+        /* Usually already reaped by the global SIGCHLD handler */
+        waitpid(run->pid, NULL, WNOHANG);
+
+        PAL_Free(run);
+    }
+
+    return MI_TRUE;
+}
+
 /*
 **==============================================================================
 **
@@ -172,7 +388,8 @@ static int _Insert(
 */
 
 int PreExec_Construct(
-    PreExec* self)
+    PreExec* self,
+    Selector* selector)
 {
     const size_t NUMLISTS = 32;
     memset(self, 0, sizeof(*self));
@@ -180,12 +397,25 @@ int PreExec_Construct(
     if (HashMap_Init(&self->cache, NUMLISTS, _Hash, _Equal, _Release) != 0)
         return -1;
 
+    Lock_Init(&self->lock);
+    self->selector = selector;
+    self->timeoutUsec = PREEXEC_TIMEOUT_USEC;
+
     return 0;
 }
 
 void PreExec_Destruct(
     PreExec* self)
 {
+    PreExecRun* run;
+
+    /* Removing the handler finishes the run (and unlinks it) */
+    while ((run = self->runs) != NULL)
+    {
+        if (Selector_RemoveHandler(self->selector, &run->handler) != MI_RESULT_OK)
+            _Finish(run, MI_RESULT_FAILED);
+    }
+
     HashMap_Destroy(&self->cache);
 }
 
@@ -193,7 +423,9 @@ int PreExec_Exec(
     PreExec* self,
     const char* programPath,
     uid_t uid,
-    uid_t gid)
+    uid_t gid,
+    PreExecCallback callback,
+    void* callbackData)
 {
     char path[PAL_MAX_PATH_SIZE];
     char key[PAL_MAX_PATH_SIZE];
@@ -201,6 +433,10 @@ int PreExec_Exec(
     const char* uidStr;
     char gidBuf[11];
     const char* gidStr;
+    Bucket* bucket;
+    PreExecRun* run;
+    MI_Uint64 currentTimeUsec = 0;
+    int fd;
 
     /* If no pre-exec program, nothing to do */
     if (programPath == NULL)
@@ -228,23 +464,6 @@ int PreExec_Exec(
         Strlcat(key, gidStr, PAL_MAX_PATH_SIZE);
     }
 
-    /* If key already in cache, then return without doing anything */
-    {
-        static pthread_mutex_t s_mutex = PTHREAD_MUTEX_INITIALIZER;
-
-        pthread_mutex_lock(&s_mutex);
-
-        if (_Contains(&self->cache, key))
-        {
-            pthread_mutex_unlock(&s_mutex);
-            return 0;
-        }
-
-        /* Add key to cache */
-        _Insert(&self->cache, key);
-        pthread_mutex_unlock(&s_mutex);
-    }
-
     /* If programPath is relative, form the full path of the pre-exec program */
     {
         path[0] = '\0';
@@ -262,34 +481,76 @@ int PreExec_Exec(
         Strlcat(path, programPath, PAL_MAX_PATH_SIZE);
     }
 
-    /* Execute and wait on the pre-exec program to exit */
-    _BlockSIGCHLD();
+    PAL_Time(&currentTimeUsec);
+
+    Lock_Acquire(&self->lock);
+
+    /* If key already in cache, either done or wait for the running program */
+    bucket = _Find(&self->cache, key);
+
+    if (bucket)
     {
-        pid_t pid = _Exec(path, uidStr, gidStr);
+        int r = 0;
 
-        if (pid == -1)
-        {
-            _UnblockSIGCHLD();
-            trace_PreExecFailed(path);
-            return -1;
-        }
+        if (bucket->run)
+            r = _AddWaiter(bucket->run, callback, callbackData) == 0 ?
+                PREEXEC_PENDING : -1;
 
-        {
-            pid_t r;
-            int status;
+        Lock_Release(&self->lock);
+        return r;
+    }
 
-            r = waitpid(pid, &status, 0);
+    /* Add key to cache and start the program */
+    run = (PreExecRun*)PAL_Calloc(1, sizeof(PreExecRun));
+    bucket = run ? _Insert(&self->cache, key) : NULL;
 
-            if (r != pid || WEXITSTATUS(status) != 0)
-            {
-                _UnblockSIGCHLD();
-                trace_PreExecFailed(path);
-                return -1;
-            }
-        }
+    if (!bucket || _AddWaiter(run, callback, callbackData) != 0)
+        goto failed;
+
+    run->pid = _Exec(path, uidStr, gidStr, &fd);
+
+    if (run->pid == -1)
+        goto failed;
+
+    Strlcpy(run->path, path, PAL_MAX_PATH_SIZE);
+    run->self = self;
+    run->bucket = bucket;
+    run->handler.sock = fd;
+    run->handler.mask = SELECTOR_READ;
+    run->handler.callback = _RunCallback;
+    run->handler.data = run;
+    run->handler.handlerName = MI_T("PREEXEC");
+
+    if (self->timeoutUsec)
+        run->handler.fireTimeoutAt = currentTimeUsec + self->timeoutUsec;
+
+    if (Selector_AddHandler(self->selector, &run->handler) != MI_RESULT_OK)
+    {
+        kill(-run->pid, SIGKILL);
+        close(fd);
+        goto failed;
     }
-    _UnblockSIGCHLD();
 
-    trace_PreExecOk(path);
-    return 0;
+    bucket->run = run;
+    run->next = self->runs;
+    self->runs = run;
+
+    Lock_Release(&self->lock);
+
+    /* Let the selector watch the pipe (and its timeout) */
+    Selector_Wakeup(self->selector, MI_FALSE);
+
+    return PREEXEC_PENDING;
+
+failed:
+    if (bucket)
+        HashMap_Remove(&self->cache, (const HashBucket*)bucket);
+
+    if (run)
+        PAL_Free(run->waiters);
+
+    PAL_Free(run);
+    Lock_Release(&self->lock);
+    trace_PreExecFailed(path);
+    return -1;
 }
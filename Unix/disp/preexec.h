@@ -59,8 +59,16 @@
 **         (2) Checks whether the registration defines a PREEXEC line.
 **         (3) If so it invokes PreExec_Exec().
 **         (4) Checks whether PROGRAMNAME-UID-GID is in the cache.
-**         (6) Adds PROGRAMNAME-UID-GUID to the cache.
-**         (5) If not initially in the cache, invokes the program.
+**         (5) If not, adds PROGRAMNAME-UID-GID to the cache and starts the
+**             program; the request waits (its interaction is not opened
+**             yet) until the program exits.
+**         (6) If the program is still running (started for an earlier
+**             request with the same key), the request waits for the same
+**             run instead of starting the program again.
+**         (7) Once the program exits, the waiting requests proceed to the
+**             agent (exit status 0) or fail. A failure (or a program that
+**             runs longer than PreExec.timeoutUsec and is killed) removes
+**             the key from the cache so the next request tries again.
 **
 **     The pre-exec program is executed with the following parameters:
 **
@@ -69,8 +77,9 @@
 **         argv[1]=<UID>
 **         argv[2]=<GID>
 **
-**     This feature is not built by default. To include this feature, OMI
-**     must be configured with the --enable-preexec option.
+**     This feature is not enabled by default. To enable this feature, OMI
+**     must be configured with the --enable-preexec option (the module is
+**     always built, the dispatcher only uses it then).
 **
 **     Notes:
 **
@@ -89,19 +98,19 @@
 **
 **         (4) If two provider registration files define the same PREEXEC
 **             line, the same program will still only be executed at most
-**
 **             once for each UID-GID pair.
+**
 **         (5) This feature is not available on Windows since it goes against
 **             the Windows authentication policies. On Windows, one should use
 **             root providers in conjunction with impersonation.
 **
-**         (6) During program execution, this module blocks SIGCHLD signals
-**             which are usually handled by a global signal handler (see
-**             server/server.c). It does this so that waidpid() will work
-**             correctly (as it waits on the completion code of the pre-exec
-**             program). Otherwise obth the global SIGCHLD handler and this
-**             module would both call waitpid() and one or the other would
-**             not respond.
+**         (6) The dispatcher never blocks on the program: it is started
+**             through an intermediate child that waits for it and writes
+**             its exit status to a pipe watched by the selector. The
+**             server's global SIGCHLD handler (see server/server.c) may
+**             reap the intermediate child at any time without losing the
+**             status, and the program runs in the process group of the
+**             intermediate child so that a timeout kills both.
 **
 **==============================================================================
 */
@@ -111,24 +120,63 @@
 
 #include <common.h>
 #include <pal/hashmap.h>
+#include <pal/lock.h>
+#include <sock/selector.h>
+
+BEGIN_EXTERNC
+
+/* Default time a pre-exec program may run before it is killed */
+#define PREEXEC_TIMEOUT_USEC (MI_ULL(60) * 1000000)
+
+/* Returned by PreExec_Exec() when the callback will be invoked later */
+#define PREEXEC_PENDING 1
+
+/* Invoked on the selector thread once the pre-exec program exited with
+ * MI_RESULT_OK if it succeeded */
+typedef void (*PreExecCallback)(
+    void* callbackData,
+    MI_Result result);
+
+struct _PreExecRun;
 
 typedef struct _PreExec
 {
     /* Key=PREEXECPATH+UID+GID */
     HashMap cache;
+
+    /* Protects the cache and the running programs */
+    Lock lock;
+
+    /* Watches the running programs */
+    Selector* selector;
+
+    /* Programs that have not exited yet */
+    struct _PreExecRun* runs;
+
+    /* Time a program may run before it is killed (and its requests fail) */
+    MI_Uint64 timeoutUsec;
 }
 PreExec;
 
 int PreExec_Construct(
-    PreExec* self);
+    PreExec* self,
+    Selector* selector);
 
+/* Kills the programs still running and fails their requests */
 void PreExec_Destruct(
     PreExec* self);
 
+/* Returns 0 if there is no program or it already ran for this UID-GID
+ * pair, PREEXEC_PENDING if the callback is invoked once it exits or -1
+ * if it cannot be started */
 int PreExec_Exec(
     PreExec* self,
     const char* programPath,
     uid_t uid,
-    uid_t gid);
+    uid_t gid,
+    PreExecCallback callback,
+    void* callbackData);
+
+END_EXTERNC
 
 #endif /* _disp_preexec_h */
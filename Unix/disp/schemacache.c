@@ -0,0 +1,273 @@
+/*
+**==============================================================================
+**
+** Copyright (c) Microsoft Corporation. All rights reserved. See file LICENSE
+** for license information.
+**
+**==============================================================================
+*/
+
+#include "schemacache.h"
+#include <pal/strings.h>
+#include <base/batch.h>
+
+/* Number of lists of the hash map */
+#define _NUM_LISTS 256
+
+typedef struct _SchemaCacheEntry /* derives from HashBucket */
+{
+    struct _SchemaCacheEntry* next;
+
+    /* Key */
+    const ZChar* nameSpace;
+    const ZChar* className;
+    MI_Uint32 flags;
+
+    /* Cached response (allocated with the entry) */
+    MI_Uint32 msgFlags;
+    void* packedSchemaInstancePtr;
+    MI_Uint32 packedSchemaInstanceSize;
+    void* packedSchemaWsmanPtr;
+    MI_Uint32 packedSchemaWsmanSize;
+}
+SchemaCacheEntry;
+
+static size_t _Hash(
+    const HashBucket* bucket_)
+{
+    const SchemaCacheEntry* bucket = (const SchemaCacheEntry*)bucket_;
+    size_t h;
+
+    h = HashMap_HashProc_PalStringCaseInsensitive(bucket->className);
+    h = h * 31 + HashMap_HashProc_PalStringCaseInsensitive(bucket->nameSpace);
+    return h * 31 + bucket->flags;
+}
+
+static int _Equal(
+    const HashBucket* bucket1_,
+    const HashBucket* bucket2_)
+{
+    const SchemaCacheEntry* bucket1 = (const SchemaCacheEntry*)bucket1_;
+    const SchemaCacheEntry* bucket2 = (const SchemaCacheEntry*)bucket2_;
+
+    return bucket1->flags == bucket2->flags &&
+        Tcscasecmp(bucket1->className, bucket2->className) == 0 &&
+        Tcscasecmp(bucket1->nameSpace, bucket2->nameSpace) == 0;
+}
+
+static void _Release(
+    HashBucket* bucket)
+{
+    PAL_Free(bucket);
+}
+
+/* Copy 'size' bytes to 'ptr' (advanced past the copy) */
+static void* _Copy(
+    char** ptr,
+    const void* data,
+    size_t size)
+{
+    void* result = *ptr;
+
+    memcpy(*ptr, data, size);
+    *ptr += (size + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
+    return result;
+}
+
+static SchemaCacheEntry* _NewEntry(
+    const ZChar* nameSpace,
+    const ZChar* className,
+    MI_Uint32 flags,
+    const PostSchemaMsg* msg)
+{
+    SchemaCacheEntry* entry;
+    size_t nameSpaceSize = (Tcslen(nameSpace) + 1) * sizeof(ZChar);
+    size_t classNameSize = (Tcslen(className) + 1) * sizeof(ZChar);
+    size_t wsmanSize = 0;
+    size_t size;
+    char* ptr;
+
+    /* The WS-Man buffer is terminated as well, since it is also handled as
+     * a string when sent over the binary protocol (see messages.c) */
+    if (msg->packedSchemaWsmanPtr)
+        wsmanSize = msg->packedSchemaWsmanSize + sizeof(ZChar);
+
+    size = sizeof(SchemaCacheEntry) + sizeof(void*) * 4 +
+        nameSpaceSize + classNameSize +
+        msg->packedSchemaInstanceSize + wsmanSize;
+
+    entry = (SchemaCacheEntry*)PAL_Calloc(1, size);
+    if (!entry)
+        return NULL;
+
+    ptr = (char*)(entry + 1);
+
+    entry->nameSpace = (const ZChar*)_Copy(&ptr, nameSpace, nameSpaceSize);
+    entry->className = (const ZChar*)_Copy(&ptr, className, classNameSize);
+    entry->flags = flags;
+    entry->msgFlags = msg->base.flags;
+
+    if (msg->packedSchemaInstancePtr)
+    {
+        entry->packedSchemaInstancePtr = _Copy(&ptr,
+            msg->packedSchemaInstancePtr, msg->packedSchemaInstanceSize);
+        entry->packedSchemaInstanceSize = msg->packedSchemaInstanceSize;
+    }
+
+    if (msg->packedSchemaWsmanPtr)
+    {
+        /* The terminator is already zero (PAL_Calloc) */
+        entry->packedSchemaWsmanPtr = _Copy(&ptr,
+            msg->packedSchemaWsmanPtr, msg->packedSchemaWsmanSize);
+        entry->packedSchemaWsmanSize = msg->packedSchemaWsmanSize;
+    }
+
+    return entry;
+}
+
+MI_Result SchemaCache_Init(
+    SchemaCache* self)
+{
+    memset(self, 0, sizeof(SchemaCache));
+
+    if (HashMap_Init(&self->map, _NUM_LISTS, _Hash, _Equal, _Release) != 0)
+        return MI_RESULT_SERVER_LIMITS_EXCEEDED;
+
+    ReadWriteLock_Init(&self->lock);
+    return MI_RESULT_OK;
+}
+
+void SchemaCache_Destroy(
+    SchemaCache* self)
+{
+    HashMap_Destroy(&self->map);
+    self->count = 0;
+}
+
+void SchemaCache_Clear(
+    SchemaCache* self)
+{
+    HashBucket* bucket;
+    size_t iter = 0;
+
+    ReadWriteLock_AcquireWrite(&self->lock);
+
+    while ((bucket = (HashBucket*)HashMap_Top(&self->map, &iter)) != NULL)
+        HashMap_Remove(&self->map, bucket);
+
+    self->count = 0;
+    self->generation++;
+
+    ReadWriteLock_ReleaseWrite(&self->lock);
+}
+
+MI_Uint32 SchemaCache_GetGeneration(
+    SchemaCache* self)
+{
+    MI_Uint32 generation;
+
+    ReadWriteLock_AcquireRead(&self->lock);
+    generation = self->generation;
+    ReadWriteLock_ReleaseRead(&self->lock);
+
+    return generation;
+}
+
+PostSchemaMsg* SchemaCache_Get(
+    SchemaCache* self,
+    const ZChar* nameSpace,
+    const ZChar* className,
+    MI_Uint32 flags,
+    MI_Uint64 operationId)
+{
+    SchemaCacheEntry key;
+    const SchemaCacheEntry* entry;
+    PostSchemaMsg* msg = NULL;
+
+    memset(&key, 0, sizeof(key));
+    key.nameSpace = nameSpace;
+    key.className = className;
+    key.flags = flags;
+
+    ReadWriteLock_AcquireRead(&self->lock);
+
+    entry = (const SchemaCacheEntry*)HashMap_Find(&self->map,
+        (const HashBucket*)&key);
+
+    if (entry && (msg = PostSchemaMsg_New(operationId)) != NULL)
+    {
+        msg->base.flags = entry->msgFlags;
+
+        if (entry->packedSchemaInstancePtr)
+        {
+            msg->packedSchemaInstancePtr = Batch_Get(msg->base.batch,
+                entry->packedSchemaInstanceSize);
+
+            if (!msg->packedSchemaInstancePtr)
+                goto failed;
+
+            memcpy(msg->packedSchemaInstancePtr,
+                entry->packedSchemaInstancePtr,
+                entry->packedSchemaInstanceSize);
+            msg->packedSchemaInstanceSize = entry->packedSchemaInstanceSize;
+        }
+
+        if (entry->packedSchemaWsmanPtr)
+        {
+            msg->packedSchemaWsmanPtr = Batch_Get(msg->base.batch,
+                entry->packedSchemaWsmanSize + sizeof(ZChar));
+
+            if (!msg->packedSchemaWsmanPtr)
+                goto failed;
+
+            /* Including the terminator (see _NewEntry()) */
+            memcpy(msg->packedSchemaWsmanPtr, entry->packedSchemaWsmanPtr,
+                entry->packedSchemaWsmanSize + sizeof(ZChar));
+            msg->packedSchemaWsmanSize = entry->packedSchemaWsmanSize;
+        }
+    }
+
+    ReadWriteLock_ReleaseRead(&self->lock);
+    return msg;
+
+failed:
+    ReadWriteLock_ReleaseRead(&self->lock);
+    PostSchemaMsg_Release(msg);
+    return NULL;
+}
+
+void SchemaCache_Put(
+    SchemaCache* self,
+    MI_Uint32 generation,
+    const ZChar* nameSpace,
+    const ZChar* className,
+    MI_Uint32 flags,
+    const PostSchemaMsg* msg)
+{
+    SchemaCacheEntry* entry;
+
+    /* Only the packed forms are cached (responses of in-process providers
+     * carry both the instance and its packed form) */
+    if (!msg->packedSchemaInstancePtr && !msg->packedSchemaWsmanPtr)
+        return;
+
+    entry = _NewEntry(nameSpace, className, flags, msg);
+    if (!entry)
+        return;
+
+    ReadWriteLock_AcquireWrite(&self->lock);
+
+    if (generation == self->generation &&
+        self->count < SCHEMACACHE_MAX_ENTRIES &&
+        HashMap_Insert(&self->map, (HashBucket*)entry) == 0)
+    {
+        self->count++;
+        entry = NULL;
+    }
+
+    ReadWriteLock_ReleaseWrite(&self->lock);
+
+    /* Not inserted */
+    if (entry)
+        PAL_Free(entry);
+}
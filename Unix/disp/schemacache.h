@@ -0,0 +1,88 @@
+/*
+**==============================================================================
+**
+** Copyright (c) Microsoft Corporation. All rights reserved. See file LICENSE
+** for license information.
+**
+**==============================================================================
+*/
+
+#ifndef _omi_schemacache_h
+#define _omi_schemacache_h
+
+#include <common.h>
+#include <base/messages.h>
+#include <pal/hashmap.h>
+#include <pal/lock.h>
+
+BEGIN_EXTERNC
+
+/*
+**==============================================================================
+**
+** SchemaCache
+**
+**     Caches the GetClass responses (PostSchemaMsg) posted by the providers,
+**     keyed by namespace, class name and request flags (the flags select the
+**     encoding: binary or WS-Man and the WS-Man schema options). Classes are
+**     immutable while the provider registry is loaded, so the dispatcher
+**     serves cached responses without going to the provider (or its agent).
+**
+**     The cache is cleared when the provider registry is reloaded. Responses
+**     of requests issued before the reload are not cached (see generation).
+**
+**==============================================================================
+*/
+
+/* Maximum number of cached responses (further responses are not cached) */
+#define SCHEMACACHE_MAX_ENTRIES 1024
+
+typedef struct _SchemaCache
+{
+    HashMap         map;
+    size_t          count;
+
+    /* Incremented by SchemaCache_Clear() */
+    MI_Uint32       generation;
+
+    ReadWriteLock   lock;
+}
+SchemaCache;
+
+MI_Result SchemaCache_Init(
+    _Out_ SchemaCache* self);
+
+void SchemaCache_Destroy(
+    _Inout_ SchemaCache* self);
+
+/* Removes all the entries (called when the provider registry is reloaded) */
+void SchemaCache_Clear(
+    _Inout_ SchemaCache* self);
+
+/* To be passed to SchemaCache_Put() for the response of a request */
+MI_Uint32 SchemaCache_GetGeneration(
+    _In_ SchemaCache* self);
+
+/* Returns a new copy of the cached response with the given operationId
+ * (to be released by the caller), or NULL if it is not cached */
+PostSchemaMsg* SchemaCache_Get(
+    _In_ SchemaCache* self,
+    _In_z_ const ZChar* nameSpace,
+    _In_z_ const ZChar* className,
+    MI_Uint32 flags,
+    MI_Uint64 operationId);
+
+/* Caches a copy of the response to a GetClass request issued while the
+ * cache had the given generation. Does nothing if the cache has been
+ * cleared since, is full or already has the response. */
+void SchemaCache_Put(
+    _In_ SchemaCache* self,
+    MI_Uint32 generation,
+    _In_z_ const ZChar* nameSpace,
+    _In_z_ const ZChar* className,
+    MI_Uint32 flags,
+    _In_ const PostSchemaMsg* msg);
+
+END_EXTERNC
+
+#endif /* _omi_schemacache_h */
@@ -31,6 +31,7 @@
 #include <pal/dir.h>
 #include <base/env.h>
 #include <base/paths.h>
+#include <base/propertyindex.h>
 
 #if defined(_MSC_VER)
 # include <time.h>
@@ -91,6 +92,7 @@ GeneratorOptions::GeneratorOptions()
     entryPoint.clear();
     no_warnings = false;
     modelCorrespondence = false;
+    noExtensions = false;
 }
 
 //==============================================================================
@@ -139,6 +141,16 @@ static ProviderClassSet providerClasses;
 static set<string> generated_headers;
 static set<string> generated_classes;
 
+//==============================================================================
+//
+// extended_classes
+//
+//     Classes that have an OMI_ClassDeclExtension.
+//
+//==============================================================================
+
+static set<string> extended_classes;
+
 //==============================================================================
 //
 // Fprintf()
@@ -2021,6 +2033,7 @@ void PutCppPropertyAccessor(
         "        GetField<=TYPE=>(n).Set(x);\n"
         "    }\n"
         "    \n"
+        "=MOVE_ACCESSOR="
         "    bool =NAME=_exists() const\n"
         "    {\n"
         "        const size_t n = offsetof(Self, =NAME=);\n"
@@ -2033,8 +2046,24 @@ void PutCppPropertyAccessor(
         "        GetField<=TYPE=>(n).Clear();\n"
         "    }\n";
 
+    // Strings and arrays are moved into the instance rather than copied
+    const char MOVE[] =
+        "#if MICXX_HAVE_MOVE\n"
+        "    void =NAME=_value(=TYPE=&& x)\n"
+        "    {\n"
+        "        const size_t n = offsetof(Self, =NAME=);\n"
+        "        GetField<=TYPE=>(n).Set(std::move(x));\n"
+        "    }\n"
+        "    \n"
+        "#endif\n";
+
     string r = sub(T, "=ALIAS=", alias);
 
+    if ((pd->type & MI_ARRAY_BIT) || pd->type == MI_STRING)
+        r = sub(r, "=MOVE_ACCESSOR=", MOVE);
+    else
+        r = sub(r, "=MOVE_ACCESSOR=", "");
+
     if (IsPropertyRefOrInstance<PropertyDeclType>(pd) && 
         !GetPropertyClassname<PropertyDeclType>(pd).empty())
     {
@@ -3978,6 +4007,71 @@ static void GenPropertyDecl(
 //
 //==============================================================================
 
+//==============================================================================
+//
+// GenClassDeclExtension()
+//
+//     This function generates the OMI_ClassDeclExtension for the given class,
+//     which holds a perfect hash of its property names. Returns false if no
+//     perfect hash could be found (the server then searches the properties
+//     of the class as usual).
+//
+//==============================================================================
+
+static bool GenClassDeclExtension(
+    FILE* os,
+    const MI_ClassDecl* cd)
+{
+    const string alias = AliasOf(cd->name);
+    vector<MI_Uint16> slots;
+    MI_Uint32 numSlots;
+    MI_Uint32 seed = 0;
+    bool found = false;
+
+    // Start with a load factor of 1/2 and grow the table until a seed is
+    // found, giving up once the table becomes much larger than the class.
+    for (numSlots = 4; numSlots < 2 * cd->numProperties; numSlots <<= 1)
+        ;
+
+    for (; !found && numSlots <= 64 * cd->numProperties; numSlots <<= 1)
+    {
+        slots.resize(numSlots);
+        found = PropertyIndex_MakePerfectHash(cd, numSlots, &seed, &slots[0])
+            ? true : false;
+    }
+
+    if (!found)
+        return false;
+
+    putl(os, "static MI_CONST MI_Uint16 %s_slots[] =", alias.c_str());
+    putl(os, "{");
+
+    for (size_t i = 0; i < slots.size(); i += 16)
+    {
+        put(os, "   ");
+
+        for (size_t j = i; j < i + 16 && j < slots.size(); j++)
+            put(os, " %u,", slots[j]);
+
+        nl(os);
+    }
+
+    putl(os, "};");
+    nl(os);
+
+    putl(os, "static MI_CONST OMI_ClassDeclExtension %s_ext =", alias.c_str());
+    putl(os, "{");
+    putl(os, "    &%s_rtti, /* classDecl */", alias.c_str());
+    putl(os, "    %uU, /* seed */", seed);
+    putl(os, "    %u, /* mask */", (MI_Uint32)slots.size() - 1);
+    putl(os, "    %s_slots, /* slots */", alias.c_str());
+    putl(os, "};");
+    nl(os);
+
+    extended_classes.insert(cd->name);
+    return true;
+}
+
 static void GenPropertyDecls(
     Parser& parser,
     FILE* os, 
@@ -3997,6 +4091,11 @@ static void GenPropertyDecls(
         }
     }
 
+    // Generate the perfect hash of property names (if any)
+
+    if (cd->numProperties && !s_options.noExtensions)
+        GenClassDeclExtension(os, cd);
+
     // Generate the array of property declarations (if any)
 
     if (cd->numProperties)
@@ -4943,6 +5042,31 @@ static void GenSchemaSourceFile(
         nl(os);
     }
 
+    // Generate the layout of the property hash tables, which is shared with
+    // the server (base/propertyindex.h) rather than published in MI.h.
+    if (!s_options.noExtensions)
+    {
+        const char T[] =
+            "#ifndef OMI_CLASSDECLEXTENSION_DEFINED\n"
+            "#define OMI_CLASSDECLEXTENSION_DEFINED\n"
+            "\n"
+            "typedef struct _OMI_ClassDeclExtension\n"
+            "{\n"
+            "    MI_ClassDecl MI_CONST* classDecl;\n"
+            "    MI_Uint32 seed;\n"
+            "    MI_Uint32 mask;\n"
+            "    MI_Uint16 MI_CONST* slots;\n"
+            "}\n"
+            "OMI_ClassDeclExtension;\n"
+            "\n"
+            "#endif /* OMI_CLASSDECLEXTENSION_DEFINED */\n"
+            "\n";
+
+        PutCommentBox(os, "Property hash table layout");
+        nl(os);
+        puts(os, T);
+    }
+
     // Generate match function (if necessary)
     if (generateMatch)
     {
@@ -5044,6 +5168,32 @@ static void GenSchemaSourceFile(
         puts(os, r);
     }
 
+    // Generate the array of OMI_ClassDeclExtension structures, which the
+    // provider manager looks up next to MI_Main() (not for other entry
+    // points, which would clash when linked into one library).
+    if (!extended_classes.empty() && s_options.entryPoint.empty())
+    {
+        PutCommentBox(os, "Property hash tables");
+        nl(os);
+
+        putl(os, "MI_EXTERN_C MI_EXPORT OMI_ClassDeclExtension MI_CONST* "
+            "MI_CONST OMI_ClassDeclExtensions[];");
+        nl(os);
+        putl(os, "OMI_ClassDeclExtension MI_CONST* MI_CONST "
+            "OMI_ClassDeclExtensions[] =");
+        putl(os, "{");
+
+        for (p = generated_classes.begin(); p != end; p++)
+        {
+            if (extended_classes.find(*p) != extended_classes.end())
+                putl(os, "    &%s_ext,", AliasOf((*p).c_str()).c_str());
+        }
+
+        putl(os, "    NULL,");
+        putl(os, "};");
+        nl(os);
+    }
+
     // Generate MI_Server methods.
     if (!s_options.noProviders)
     {
@@ -127,6 +127,10 @@ struct GeneratorOptions
     // Generate ModelCorrespondence qualifier if true.
     bool modelCorrespondence;
 
+    // Do not generate OMI_ClassDeclExtension structures (perfect hash tables
+    // of property names) in schema.c if true.
+    bool noExtensions;
+
     // Default constructor (sets options to default values).
     GeneratorOptions();
 
@@ -56,6 +56,7 @@ OPTIONS:\n\
     -e CLASS                    Generate extra class with this name.\n\
     -y NAME                     Use NAME as entry point (default MI_Main).\n\
     --no-warnings         	Print no warnings.\n\
+    --no-extensions             Do not generate property hash tables.\n\
     -C, --schemafile PATH       Alternative path of main CIM schema file.\n\
     -m PROVIDERNAME             Generate provider makefile.\n\
     --nogi CLASSNAME            Set MI_ProviderFT.GetInstance to NULL for\n\
@@ -199,6 +200,7 @@ static void _GetCommandLineOptions(
         "-f",
         "-q",
         "--no-warnings",
+        "--no-extensions",
         "-a",
         "-n",
         "--cpp",
@@ -290,6 +292,10 @@ static void _GetCommandLineOptions(
         {
             options.no_warnings = true;
         }
+        else if (strcmp(state.opt, "--no-extensions") == 0)
+        {
+            options.noExtensions = true;
+        }
         else if (strcmp(state.opt, "-a") == 0)
         {
             options.all = true;
@@ -22,9 +22,21 @@
 #include <pal/format.h>
 #include <base/paths.h>
 #include <base/Strand.h>
+#include <base/serverstats.h>
+#include <pal/thread.h>
+#include <pal/lock.h>
+#include <pal/sem.h>
 
 #ifdef CONFIG_POSIX
 #include <pthread.h>
+#include <poll.h>
+#include <openssl/rand.h>
+#include <openssl/evp.h>
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+#include <openssl/core_names.h>
+#else
+#include <openssl/hmac.h>
+#endif
 #else
 /* ssl not supported in this configuration; just make compiler happy */
 typedef void SSL;
@@ -32,6 +44,8 @@ typedef void SSL_CTX;
 #define SSL_CTX_free(c)
 #define SSL_new(c) 0
 #define SSL_free(c)
+#define SSL_set_quiet_shutdown(c,m)
+#define SSL_shutdown(c) 0
 #define SSL_set_fd(c,a) (a==a)
 #define SSL_read(c,a,b) 0
 #define SSL_write(c,a,b) 0
@@ -203,6 +217,25 @@ static MI_Boolean _getHeaderField(
             }
             break;
         }
+        case (_HashCode('a','g',15)): /*Accept-Encoding*/
+        {
+            if (Strcasecmp(name,"Accept-Encoding") == 0)
+                handler->acceptEncoding = Http_ParseAcceptEncoding(value);
+
+            break;
+        }
+        case (_HashCode('t','g',17)): /*Transfer-Encoding*/
+        {
+            if (Strcasecmp(name,"Transfer-Encoding") == 0)
+            {
+                /* chunked is the only transfer coding understood */
+                if (Strcasecmp(value, "chunked") != 0)
+                    return MI_FALSE;
+
+                handler->recvChunked = MI_TRUE;
+            }
+            break;
+        }
         case (_HashCode('a','n',13)): /*Authorization*/
         {
             if (Strcasecmp(name,"Authorization") == 0)
@@ -231,7 +264,10 @@ static MI_Boolean _getHeaderField(
                 /* Remove the HTTP version from the uri string*/
                 char *tmp = Strchr(value, ' ');
                 if (tmp)
+                {
                     *tmp = '\0';
+                    handler->recvHttp10 = Strcmp(tmp + 1, "HTTP/1.0") == 0;
+                }
 
                 handler->recvHeaders.httpUrl = value;
             }
@@ -253,6 +289,20 @@ static MI_Boolean _getHeaderField(
     return MI_TRUE;
 }
 
+static void _TraceSSLErrors(void)
+{
+    unsigned long err = ERR_get_error();
+
+    while (err)
+    {
+        char err_txt[200];
+        ERR_error_string_n(err, err_txt, sizeof(err_txt));
+
+        trace_SSLRead_Error((int)err, scs(err_txt));
+        err = ERR_get_error();
+    }
+}
+
 static MI_Result _Sock_ReadAux(
     Http_SR_SocketData* handler,
     void* buf,
@@ -323,18 +373,7 @@ static MI_Result _Sock_ReadAux(
         break;
 
     default:
-        {
-            /* print error */
-            unsigned long err = ERR_get_error();
-            while (err)
-            {
-                char err_txt[200];
-                ERR_error_string_n(err, err_txt, sizeof(err_txt));
-
-                trace_SSLRead_Error((int)err, scs(err_txt));
-                err = ERR_get_error();
-            }
-        }
+        _TraceSSLErrors();
         break;
     }
     return MI_RESULT_FAILED;
@@ -467,6 +506,255 @@ INLINE MI_Result _Sock_Write(
     return r;
 }
 
+/* Make room in recvPage for 'want' more bytes after the decoded body */
+static MI_Boolean _ReserveRecvPage(
+    Http_SR_SocketData* handler,
+    size_t want)
+{
+    size_t decoded = handler->recvHeaders.contentLength;
+    size_t capacity = handler->recvPageCapacity;
+    size_t limit = HTTP_MAX_CONTENT + MAX_HEADER_SIZE;
+    Page* page;
+
+    if (handler->recvPage && capacity - decoded >= want)
+        return MI_TRUE;
+
+    if (capacity < INITIAL_BUFFER_SIZE)
+        capacity = INITIAL_BUFFER_SIZE;
+
+    while (capacity - decoded < want && capacity < limit)
+        capacity *= 2;
+
+    if (capacity > limit)
+        capacity = limit;
+
+    /* keep room for the zero terminator */
+    page = (Page*)PAL_Realloc(handler->recvPage, sizeof(Page) + capacity + 1);
+
+    if (!page)
+        return MI_FALSE;
+
+    if (!handler->recvPage)
+        page->u.s.next = 0;
+
+    handler->recvPage = page;
+    handler->recvPageCapacity = capacity;
+    return MI_TRUE;
+}
+
+/* Decode 'size' raw bytes stored right after the decoded body; the chunk
+   data is moved down over the chunk framing */
+static MI_Boolean _DecodeChunks(
+    Http_SR_SocketData* handler,
+    size_t size)
+{
+    char* out = ((char*)(handler->recvPage + 1)) + handler->recvHeaders.contentLength;
+    const char* in = out;
+    const char* end = in + size;
+
+    while (in < end)
+    {
+        char c = *in;
+        int digit = -1;
+
+        switch (handler->chunkState)
+        {
+        case CHUNK_STATE_DATA:
+        {
+            size_t n = (size_t)(end - in);
+
+            if (n > handler->chunkRemaining)
+                n = handler->chunkRemaining;
+
+            if (out != in)
+                memmove(out, in, n);
+
+            out += n;
+            in += n;
+            handler->recvHeaders.contentLength += n;
+            handler->chunkRemaining -= n;
+
+            if (0 == handler->chunkRemaining)
+                handler->chunkState = CHUNK_STATE_DATA_CR;
+            continue;
+        }
+        case CHUNK_STATE_SIZE:
+        {
+            if (c >= '0' && c <= '9')
+                digit = c - '0';
+            else if (c >= 'a' && c <= 'f')
+                digit = c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F')
+                digit = c - 'A' + 10;
+
+            if (digit >= 0)
+            {
+                handler->chunkRemaining = handler->chunkRemaining * 16 + digit;
+
+                if (handler->chunkRemaining >
+                    HTTP_MAX_CONTENT - handler->recvHeaders.contentLength)
+                {
+                    trace_ContentLength_MaxCheck_Failed();
+                    return MI_FALSE;
+                }
+            }
+            else if (0 == handler->chunkLineLength)
+                return MI_FALSE;
+            else if (c == ';' || c == ' ' || c == '\t')
+                handler->chunkState = CHUNK_STATE_EXTENSION;
+            else if (c == '\r')
+                handler->chunkState = CHUNK_STATE_SIZE_LF;
+            else
+                return MI_FALSE;
+            break;
+        }
+        case CHUNK_STATE_EXTENSION:
+        {
+            if (c == '\r')
+                handler->chunkState = CHUNK_STATE_SIZE_LF;
+            break;
+        }
+        case CHUNK_STATE_SIZE_LF:
+        {
+            if (c != '\n')
+                return MI_FALSE;
+
+            handler->chunkState = handler->chunkRemaining ?
+                CHUNK_STATE_DATA : CHUNK_STATE_TRAILER;
+            break;
+        }
+        case CHUNK_STATE_DATA_CR:
+        {
+            if (c != '\r')
+                return MI_FALSE;
+
+            handler->chunkState = CHUNK_STATE_DATA_LF;
+            break;
+        }
+        case CHUNK_STATE_DATA_LF:
+        {
+            if (c != '\n')
+                return MI_FALSE;
+
+            handler->chunkState = CHUNK_STATE_SIZE;
+            handler->chunkLineLength = 0;
+            in++;
+            continue;
+        }
+        case CHUNK_STATE_TRAILER:
+        {
+            handler->chunkState = (c == '\r') ?
+                CHUNK_STATE_END_LF : CHUNK_STATE_TRAILER_LINE;
+            break;
+        }
+        case CHUNK_STATE_TRAILER_LINE:
+        {
+            if (c == '\r')
+                handler->chunkState = CHUNK_STATE_TRAILER_LF;
+            break;
+        }
+        case CHUNK_STATE_TRAILER_LF:
+        case CHUNK_STATE_END_LF:
+        {
+            if (c != '\n')
+                return MI_FALSE;
+
+            handler->chunkState = (handler->chunkState == CHUNK_STATE_END_LF) ?
+                CHUNK_STATE_DONE : CHUNK_STATE_TRAILER;
+            break;
+        }
+        case CHUNK_STATE_DONE:
+        {
+            trace_HttpPayloadIsBiggerThanContentLength();
+            return MI_FALSE;
+        }
+        }
+
+        /* chunk size lines and trailers are bounded like the header */
+        if (++handler->chunkLineLength > MAX_HEADER_SIZE)
+        {
+            trace_HttpChunkHeaderIsTooBig();
+            return MI_FALSE;
+        }
+
+        in++;
+    }
+
+    return MI_TRUE;
+}
+
+/* Header of a chunked request received; decode the part of the body
+   that came along with it */
+static Http_CallbackResult _StartChunkedBody(
+    Http_SR_SocketData* handler,
+    const char* data)
+{
+    /* Transfer-Encoding overrides Content-Length; the size of the body is
+       only known once the last chunk arrived */
+    handler->recvHeaders.contentLength = 0;
+    handler->recvPageCapacity = 0;
+    handler->chunkState = CHUNK_STATE_SIZE;
+    handler->chunkRemaining = 0;
+    handler->chunkLineLength = 0;
+
+    if (!_ReserveRecvPage(handler, handler->receivedSize))
+        return PRT_RETURN_FALSE;
+
+    memcpy(handler->recvPage + 1, data, handler->receivedSize);
+
+    if (!_DecodeChunks(handler, handler->receivedSize))
+        return PRT_RETURN_FALSE;
+
+    handler->receivedSize = 0;
+    handler->recvingState = RECV_STATE_CHUNKED;
+    return PRT_CONTINUE;
+}
+
+/* Read the next part of a chunked body straight into recvPage; continues
+   once the last chunk and the trailers were received */
+static Http_CallbackResult _ReadChunks(
+    Http_SR_SocketData* handler)
+{
+    char* buf;
+    size_t buf_size, received;
+    MI_Result r;
+
+    if (handler->chunkState != CHUNK_STATE_DONE)
+    {
+        /* read a large chunk in one go */
+        size_t want = INITIAL_BUFFER_SIZE;
+
+        if (handler->chunkState == CHUNK_STATE_DATA && handler->chunkRemaining > want)
+            want = handler->chunkRemaining;
+
+        if (!_ReserveRecvPage(handler, want))
+            return PRT_RETURN_FALSE;
+
+        buf = ((char*)(handler->recvPage + 1)) + handler->recvHeaders.contentLength;
+        buf_size = handler->recvPageCapacity - handler->recvHeaders.contentLength;
+        received = 0;
+
+        r = _Sock_Read(handler, buf, buf_size, &received);
+
+        if ( r == MI_RESULT_OK && 0 == received )
+            return PRT_RETURN_FALSE; /* conection closed */
+
+        if ( r != MI_RESULT_OK && r != MI_RESULT_WOULD_BLOCK )
+            return PRT_RETURN_FALSE;
+
+        if (!_DecodeChunks(handler, received))
+            return PRT_RETURN_FALSE;
+
+        if (handler->chunkState != CHUNK_STATE_DONE)
+            return PRT_RETURN_TRUE;
+    }
+
+    ((char*)(handler->recvPage + 1))[handler->recvHeaders.contentLength] = 0;
+    handler->recvPage->u.s.size = (unsigned int)handler->recvHeaders.contentLength;
+
+    return PRT_CONTINUE;
+}
+
 static Http_CallbackResult _ReadHeader(
     Http_SR_SocketData* handler)
 {
@@ -478,7 +766,7 @@ static Http_CallbackResult _ReadHeader(
     MI_Boolean fullHeaderReceived = MI_FALSE;
 
     /* are we done with header? */
-    if (handler->recvingState == RECV_STATE_CONTENT)
+    if (handler->recvingState != RECV_STATE_HEADER)
         return PRT_CONTINUE;
 
     buf = handler->recvBuffer + handler->receivedSize;
@@ -498,9 +786,10 @@ static Http_CallbackResult _ReadHeader(
 
     handler->receivedSize += received;
 
-    /* did we get full header? */
+    /* did we get full header? (resume where the previous read stopped) */
     buf = handler->recvBuffer;
-    for ( index = 3; index < handler->receivedSize; index++ )
+    index = handler->headerScanned > 3 ? handler->headerScanned : 3;
+    for ( ; index < handler->receivedSize; index++ )
     {
         if (buf[index-3] == '\r' && buf[index-1] == '\r' &&
             buf[index-2] == '\n' && buf[index] == '\n' )
@@ -512,6 +801,8 @@ static Http_CallbackResult _ReadHeader(
 
     if (!fullHeaderReceived )
     {
+        handler->headerScanned = handler->receivedSize;
+
         if ( handler->receivedSize <  handler->recvBufferSize )
             return PRT_RETURN_TRUE; /* continue reading */
 
@@ -537,6 +828,8 @@ static Http_CallbackResult _ReadHeader(
     /* consume data */
     currentLine = buf;
     data = buf + index + 1; /* pointer to data in case we got some */
+    handler->acceptEncoding = 0;
+    handler->recvHttp10 = MI_FALSE;
 
     if (!_getHeaderField(handler, &currentLine, ' '))
         return PRT_RETURN_FALSE;
@@ -549,6 +842,12 @@ static Http_CallbackResult _ReadHeader(
 
     }
 
+    handler->headerScanned = 0;
+    handler->receivedSize -= index + 1;
+
+    if (handler->recvChunked)
+        return _StartChunkedBody(handler, data);
+
     size_t allocSize = 0;
     if (SizeTAdd(sizeof(Page), handler->recvHeaders.contentLength, &allocSize) == S_OK &&
         SizeTAdd(allocSize, 1, &allocSize) == S_OK)
@@ -570,8 +869,6 @@ static Http_CallbackResult _ReadHeader(
     handler->recvPage->u.s.size = (unsigned int)handler->recvHeaders.contentLength;
     handler->recvPage->u.s.next = 0;
 
-    handler->receivedSize -= index + 1;
-
     /* Verify that we have not more than 'content-length' bytes in buffer left
         If we hvae more, assuming http client is invalid and drop connection */
     if (handler->receivedSize > handler->recvHeaders.contentLength)
@@ -594,31 +891,41 @@ static Http_CallbackResult _ReadData(
     MI_Result r;
     HttpRequestMsg* msg;
 
-    /* are we in the right state? */
-    if (handler->recvingState != RECV_STATE_CONTENT)
-        return PRT_RETURN_FALSE;
-
-    buf = ((char*)(handler->recvPage + 1)) + handler->receivedSize;
-    buf_size = handler->recvHeaders.contentLength - handler->receivedSize;
-    received = 0;
+    if (handler->recvingState == RECV_STATE_CHUNKED)
+    {
+        Http_CallbackResult result = _ReadChunks(handler);
 
-    if (buf_size)
+        if (result != PRT_CONTINUE)
+            return result;
+    }
+    else
     {
-        r = _Sock_Read(handler, buf, buf_size, &received);
+        /* are we in the right state? */
+        if (handler->recvingState != RECV_STATE_CONTENT)
+            return PRT_RETURN_FALSE;
 
-        if ( r == MI_RESULT_OK && 0 == received )
-            return PRT_RETURN_FALSE; /* conection closed */
+        buf = ((char*)(handler->recvPage + 1)) + handler->receivedSize;
+        buf_size = handler->recvHeaders.contentLength - handler->receivedSize;
+        received = 0;
 
-        if ( r != MI_RESULT_OK && r != MI_RESULT_WOULD_BLOCK )
-            return PRT_RETURN_FALSE;
+        if (buf_size)
+        {
+            r = _Sock_Read(handler, buf, buf_size, &received);
 
-        handler->receivedSize += received;
-    }
+            if ( r == MI_RESULT_OK && 0 == received )
+                return PRT_RETURN_FALSE; /* conection closed */
 
-    /* did we get all data? */
+            if ( r != MI_RESULT_OK && r != MI_RESULT_WOULD_BLOCK )
+                return PRT_RETURN_FALSE;
 
-    if ( handler->receivedSize != handler->recvHeaders.contentLength )
-        return PRT_RETURN_TRUE;
+            handler->receivedSize += received;
+        }
+
+        /* did we get all data? */
+
+        if ( handler->receivedSize != handler->recvHeaders.contentLength )
+            return PRT_RETURN_TRUE;
+    }
 
 
     /* If we are authorised, but the client is sending an auth header, then 
@@ -708,6 +1015,8 @@ static Http_CallbackResult _ReadData(
 
 Done:
     handler->recvPage = 0;
+    handler->recvPageCapacity = 0;
+    handler->recvChunked = MI_FALSE;
     handler->receivedSize = 0;
     memset(&handler->recvHeaders, 0, sizeof(handler->recvHeaders));
     handler->recvingState = RECV_STATE_HEADER;
@@ -800,6 +1109,16 @@ static void _ResetWriteState(
         socketData->sendHeader = 0;
     }
 
+#if defined(CONFIG_ENABLE_COMPRESSION)
+    if (socketData->deflater)
+    {
+        Http_Deflater_Delete(socketData->deflater);
+        socketData->deflater = NULL;
+    }
+#endif
+    socketData->sendChunk = NULL;
+    socketData->sendChunkSize = 0;
+
     socketData->httpErrorCode = 0;
     socketData->authFailed     = FALSE;
     socketData->sentSize = 0;
@@ -828,10 +1147,24 @@ static const char CONNECTION_HEADER[] = "Connection: ";
 static const char CONTENT_TYPE_HEADER[] = "Content-Type: ";
 #define CONTENT_TYPE_HEADER_LEN  (MI_COUNT(CONTENT_TYPE_HEADER)-1)
 
+static const char CONTENT_ENCODING_HEADER[] = "Content-Encoding: ";
+#define CONTENT_ENCODING_HEADER_LEN  (MI_COUNT(CONTENT_ENCODING_HEADER)-1)
+
+static const char TRANSFER_ENCODING_CHUNKED[] = "Transfer-Encoding: chunked\r\n";
+#define TRANSFER_ENCODING_CHUNKED_LEN  (MI_COUNT(TRANSFER_ENCODING_CHUNKED)-1)
+
+static const char VARY_ACCEPT_ENCODING[] = "Vary: Accept-Encoding\r\n";
+#define VARY_ACCEPT_ENCODING_LEN  (MI_COUNT(VARY_ACCEPT_ENCODING)-1)
+
+/* A compressed body (contentEncoding set) is sent in chunks, its length
+   being unknown until the last one. With compression enabled, every
+   response depends on Accept-Encoding (compressed or not), which caches
+   are told with Vary */
 static Page *
 _BuildHeader( Http_SR_SocketData* handler, int contentLen, 
                                           int connectionActionLen, const char *connectionAction,
-                                          int contentTypeLen,      const char *contentType)
+                                          int contentTypeLen,      const char *contentType,
+                                          const char *contentEncoding)
 
 {
 
@@ -846,8 +1179,29 @@ _BuildHeader( Http_SR_SocketData* handler, int contentLen,
     char content_len_buff[16] ;
     char *pcontent_len = int64_to_a(content_len_buff, sizeof(content_len_buff), contentLen, &content_len_strlen);
 
-    int needed_size = HTTP_PROTOCOL_HEADER_LEN  + errorcode_strlen + 1 + errcode_desc_len + 2 + // HTTP/1.1 0 200 Success\r\n
-                      CONTENT_LENGTH_HEADER_LEN + content_len_strlen + 2;                       // Content-Length: 214
+    int content_encoding_len = contentEncoding ? (int)strlen(contentEncoding) : 0;
+    MI_Boolean vary = MI_FALSE;
+
+#if defined(CONFIG_ENABLE_COMPRESSION)
+    vary = handler->http->options.compression.level != 0;
+#endif
+
+    int needed_size = HTTP_PROTOCOL_HEADER_LEN  + errorcode_strlen + 1 + errcode_desc_len + 2; // HTTP/1.1 0 200 Success\r\n
+
+    if (contentEncoding)
+    {
+        needed_size += CONTENT_ENCODING_HEADER_LEN + content_encoding_len + 2 +
+                       TRANSFER_ENCODING_CHUNKED_LEN;
+    }
+    else
+    {
+        needed_size += CONTENT_LENGTH_HEADER_LEN + content_len_strlen + 2;                    // Content-Length: 214
+    }
+
+    if (vary)
+    {
+        needed_size += VARY_ACCEPT_ENCODING_LEN;
+    }
 
     if (connectionAction)
     {
@@ -884,16 +1238,42 @@ _BuildHeader( Http_SR_SocketData* handler, int contentLen,
     memcpy(bufp, "\r\n", 2);
     bufp += 2;
  
-    // Content-Length: 2035\r\n
+    if (contentEncoding)
+    {
+        // Content-Encoding: gzip\r\n
+        memcpy(bufp, CONTENT_ENCODING_HEADER, CONTENT_ENCODING_HEADER_LEN);
+        bufp += CONTENT_ENCODING_HEADER_LEN;
+
+        memcpy(bufp, contentEncoding, content_encoding_len);
+        bufp += content_encoding_len;
 
-    memcpy(bufp, CONTENT_LENGTH_HEADER, CONTENT_LENGTH_HEADER_LEN);
-    bufp += CONTENT_LENGTH_HEADER_LEN;
+        memcpy(bufp, "\r\n", 2);
+        bufp += 2;
+
+        // Transfer-Encoding: chunked\r\n
+        memcpy(bufp, TRANSFER_ENCODING_CHUNKED, TRANSFER_ENCODING_CHUNKED_LEN);
+        bufp += TRANSFER_ENCODING_CHUNKED_LEN;
+    }
+    else
+    {
+        // Content-Length: 2035\r\n
 
-    memcpy(bufp, pcontent_len, content_len_strlen);
-    bufp += content_len_strlen;
+        memcpy(bufp, CONTENT_LENGTH_HEADER, CONTENT_LENGTH_HEADER_LEN);
+        bufp += CONTENT_LENGTH_HEADER_LEN;
 
-    memcpy(bufp, "\r\n", 2);
-    bufp += 2;
+        memcpy(bufp, pcontent_len, content_len_strlen);
+        bufp += content_len_strlen;
+
+        memcpy(bufp, "\r\n", 2);
+        bufp += 2;
+    }
+
+    if (vary)
+    {
+        // Vary: Accept-Encoding\r\n
+        memcpy(bufp, VARY_ACCEPT_ENCODING, VARY_ACCEPT_ENCODING_LEN);
+        bufp += VARY_ACCEPT_ENCODING_LEN;
+    }
 
     if (connectionAction)
     {
@@ -977,6 +1357,7 @@ static Http_CallbackResult _WriteHeader( Http_SR_SocketData* handler)
         char *content_type    = (char*)CONTENT_TYPE_APPLICATION_SOAP;
         int  content_type_len = CONTENT_TYPE_APPLICATION_SOAP_LEN;
         int  content_len      = 0;
+        const char *content_encoding = NULL;
     
         if (handler->sendPage)
         {
@@ -1044,9 +1425,27 @@ static Http_CallbackResult _WriteHeader( Http_SR_SocketData* handler)
     #endif
         }
 
+#if defined(CONFIG_ENABLE_COMPRESSION)
+        /* Encrypted (Kerberos/SPNEGO) bodies do not compress; send them
+           as they are */
+        if (handler->sendPage && !handler->encryptedTransaction &&
+            handler->acceptEncoding && !handler->recvHttp10 &&
+            handler->http->options.compression.level &&
+            (MI_Uint32)content_len >= handler->http->options.compression.minSize)
+        {
+            handler->deflater = Http_Deflater_New(handler->acceptEncoding,
+                handler->http->options.compression.level,
+                (const char*)(handler->sendPage + 1), content_len);
+
+            if (handler->deflater)
+                content_encoding = Http_Deflater_Encoding(handler->deflater);
+        }
+#endif
+
         handler->sendHeader = _BuildHeader(handler, content_len, 
                                           CONNECTION_KEEPALIVE_LEN, CONNECTION_KEEPALIVE,
-                                          content_type_len, content_type);
+                                          content_type_len, content_type,
+                                          content_encoding);
     }
 
     sent = 0;
@@ -1089,6 +1488,53 @@ static Http_CallbackResult _WriteHeader( Http_SR_SocketData* handler)
 }
 
 
+#if defined(CONFIG_ENABLE_COMPRESSION)
+
+/* Send the compressed body one chunk at a time; only the chunk being sent
+   is held besides the response page */
+static Http_CallbackResult _WriteCompressedData(
+    Http_SR_SocketData* handler)
+{
+    size_t sent;
+    MI_Result r;
+
+    for (;;)
+    {
+        if (handler->sentSize == handler->sendChunkSize)
+        {
+            if (!Http_Deflater_Next(handler->deflater, &handler->sendChunk,
+                &handler->sendChunkSize))
+                return PRT_RETURN_FALSE;
+
+            handler->sentSize = 0;
+
+            if (0 == handler->sendChunkSize)
+            {
+                _ResetWriteState( handler );
+                return PRT_CONTINUE;
+            }
+        }
+
+        sent = 0;
+
+        r = _Sock_Write(handler, (char*)handler->sendChunk + handler->sentSize,
+            handler->sendChunkSize - handler->sentSize, &sent);
+
+        if ( r == MI_RESULT_OK && 0 == sent )
+            return PRT_RETURN_FALSE; /* conection closed */
+
+        if ( r != MI_RESULT_OK && r != MI_RESULT_WOULD_BLOCK )
+            return PRT_RETURN_FALSE;
+
+        if (!sent)
+            return PRT_RETURN_TRUE;
+
+        handler->sentSize += sent;
+    }
+}
+
+#endif /* defined(CONFIG_ENABLE_COMPRESSION) */
+
 static Http_CallbackResult _WriteData(
     Http_SR_SocketData* handler)
 {
@@ -1106,6 +1552,11 @@ static Http_CallbackResult _WriteData(
         return PRT_CONTINUE;
     }
 
+#if defined(CONFIG_ENABLE_COMPRESSION)
+    if (handler->deflater)
+        return _WriteCompressedData(handler);
+#endif
+
     buf = ((char*)(handler->sendPage + 1)) + handler->sentSize;
     buf_size = handler->sendPage->u.s.size - handler->sentSize;
     sent = 0;
@@ -1211,11 +1662,23 @@ static MI_Boolean _RequestCallback(
         (mask & SELECTOR_DESTROY) != 0)
     {
         if (handler->ssl)
+        {
+            /* Quiet shutdown (no close_notify is written to a socket that
+             * may be broken already); otherwise SSL_free() drops the
+             * session from the session cache */
+            if (handler->acceptDone)
+            {
+                SSL_set_quiet_shutdown(handler->ssl, 1);
+                SSL_shutdown(handler->ssl);
+            }
+
             SSL_free(handler->ssl);
+        }
 
         trace_SocketClose_REMOVEDESTROY();
 
         Sock_Close(handler->handler.sock);
+        ServerStats_AddGauge(SERVERSTATS_GAUGE_HTTPCONNECTIONS, -1);
 
         // Free the savedSendMsg and ACK it to prevent leaks when a non-io thread
         // writes to the socket, but it cannot be read because of an error or a
@@ -1234,6 +1697,10 @@ static MI_Boolean _RequestCallback(
         if (handler->sendPage)
             PAL_Free(handler->sendPage);
 
+#if defined(CONFIG_ENABLE_COMPRESSION)
+        Http_Deflater_Delete(handler->deflater);
+#endif
+
         PAL_Free(handler->recvBuffer);
         // handler deleted on its own strand
 
@@ -1425,15 +1892,417 @@ static StrandFT _HttpSocket_FT = {
 **==============================================================================
 */
 
-static MI_Boolean _ListenerCallback(
-    Selector* sel,
-    Handler* handler_,
-    MI_Uint32 mask,
-    MI_Uint64 currentTimeUsec)
+/* Closes a connection that was not handed to the selector yet */
+static void _CloseConnection(
+    Http_SR_SocketData* h)
 {
-    Http_Listener_SocketData* handler = (Http_Listener_SocketData*)handler_;
-    Http* self = (Http*)handler->base.data;
-    MI_Result r;
+    if (h->ssl)
+        SSL_free(h->ssl);
+
+    Sock_Close(h->handler.sock);
+    PAL_Free(h->recvBuffer);
+    Strand_Delete(&h->strand);
+}
+
+/* Hands a new connection to the selector and opens its interaction */
+static void _StartConnection(
+    Http* self,
+    Http_SR_SocketData* h,
+    MI_Uint64 currentTimeUsec)
+{
+    MI_Result r;
+
+    h->handler.fireTimeoutAt = currentTimeUsec + self->options.timeoutUsec;
+
+    /* Watch for read events on the incoming connection */
+    r = Selector_AddHandler(self->selector, &h->handler);
+
+    if (r != MI_RESULT_OK)
+    {
+        trace_SelectorAddHandler_Failed();
+        _CloseConnection(h);
+        return;
+    }
+
+    ServerStats_AddGauge(SERVERSTATS_GAUGE_HTTPCONNECTIONS, 1);
+
+    // notify next stack layer about new connection
+    // (open the interaction)
+    Strand_Open(
+        &h->strand,
+        self->callbackOnNewConnection,
+        self->callbackData,
+        NULL,
+        MI_TRUE );
+}
+
+/*
+**==============================================================================
+**
+** Handshake pool
+**
+**     Performs the TLS handshakes of new HTTPS connections on worker threads
+**     (options.sslSession.handshakeThreads), so that the asymmetric crypto of
+**     the full handshakes does not serialize on the selector thread. Once a
+**     handshake completes the connection is handed back to the selector
+**     thread (through a handler without socket that is 'timed out' on
+**     purpose), which starts it as any other connection. Connections failing
+**     the handshake are closed by the worker.
+**
+**==============================================================================
+*/
+
+#ifdef CONFIG_POSIX
+
+/* Maximum number of handshake threads */
+#define HTTP_HANDSHAKE_MAX_THREADS 64
+
+/* Granularity of the checks for shutdown/timeout while waiting for the
+ * client during a handshake */
+#define HTTP_HANDSHAKE_POLL_MSEC 100
+
+struct _Http_HandshakePool
+{
+    /* Selector handler (no socket) fired when handshakes complete */
+    Handler handler;
+
+    Http* http;
+
+    Lock lock;
+
+    /* Connections waiting for their handshake (FIFO) */
+    Http_SR_SocketData* queueHead;
+    Http_SR_SocketData* queueTail;
+
+    /* Connections whose handshake completed, to be started */
+    Http_SR_SocketData* done;
+
+    /* Set when the pool is being deleted */
+    MI_Boolean stop;
+
+    /* Set once the handler is removed from the selector */
+    MI_Boolean removed;
+
+    /* Wakes up the workers */
+    Sem queued;
+
+    MI_Uint32 threadCount;
+    Thread threads[HTTP_HANDSHAKE_MAX_THREADS];
+};
+
+static MI_Boolean _Handshake(
+    Http_HandshakePool* pool,
+    Http_SR_SocketData* h)
+{
+    MI_Uint64 now;
+    MI_Uint64 deadline;
+
+    if (PAL_TRUE != PAL_Time(&now))
+        return MI_FALSE;
+
+    deadline = now + pool->http->options.timeoutUsec;
+
+    for (;;)
+    {
+        struct pollfd fd;
+        int res;
+        int n;
+
+        ERR_clear_error();
+        res = SSL_accept(h->ssl);
+
+        if (res > 0)
+            return MI_TRUE;
+
+        if (res == 0)
+            return MI_FALSE;    /* connection closed */
+
+        switch (SSL_get_error(h->ssl, res))
+        {
+        case SSL_ERROR_WANT_READ:
+            fd.events = POLLIN;
+            break;
+
+        case SSL_ERROR_WANT_WRITE:
+            fd.events = POLLOUT;
+            break;
+
+        case SSL_ERROR_SYSCALL:
+            if (EAGAIN == errno ||
+                EWOULDBLOCK == errno ||
+                EINPROGRESS == errno)
+            {
+                fd.events = POLLIN;
+                break;
+            }
+
+            trace_SSLRead_UnexpectedSysError(errno);
+            return MI_FALSE;
+
+        default:
+            _TraceSSLErrors();
+            return MI_FALSE;
+        }
+
+        fd.fd = h->handler.sock;
+        fd.revents = 0;
+
+        do
+        {
+            if (pool->stop || PAL_TRUE != PAL_Time(&now))
+                return MI_FALSE;
+
+            if (now >= deadline)
+            {
+                trace_ConnectionClosed_Timeout();
+                return MI_FALSE;
+            }
+
+            n = poll(&fd, 1, HTTP_HANDSHAKE_POLL_MSEC);
+        }
+        while (n == 0 || (n < 0 && errno == EINTR));
+
+        if (n < 0)
+            return MI_FALSE;
+    }
+}
+
+static PAL_Uint32 THREAD_API _HandshakeProc(void* param)
+{
+    Http_HandshakePool* pool = (Http_HandshakePool*)param;
+
+    for (;;)
+    {
+        Http_SR_SocketData* h;
+        MI_Boolean stop;
+
+        /* Posted for each queued connection, and for each thread to stop */
+        Sem_Wait(&pool->queued);
+
+        Lock_Acquire(&pool->lock);
+        h = pool->queueHead;
+        if (h)
+        {
+            pool->queueHead = h->next;
+            if (!pool->queueHead)
+                pool->queueTail = NULL;
+            h->next = NULL;
+        }
+        stop = pool->stop;
+        Lock_Release(&pool->lock);
+
+        if (!h)
+        {
+            if (stop)
+                break;
+
+            continue;
+        }
+
+        if (!_Handshake(pool, h))
+        {
+            _CloseConnection(h);
+            continue;
+        }
+
+        h->acceptDone = MI_TRUE;
+
+        /* Hand the connection to the selector thread */
+        Lock_Acquire(&pool->lock);
+        if (!pool->removed)
+        {
+            h->next = pool->done;
+            pool->done = h;
+            /* fire now (TIME_NEVER is 0) */
+            pool->handler.fireTimeoutAt = 1;
+            h = NULL;
+        }
+        Lock_Release(&pool->lock);
+
+        if (h)
+            _CloseConnection(h);
+        else
+            Selector_Wakeup(pool->http->selector, MI_TRUE);
+    }
+
+    return 0;
+}
+
+static MI_Boolean _HandshakePoolCallback(
+    Selector* sel,
+    Handler* handler,
+    MI_Uint32 mask,
+    MI_Uint64 currentTimeUsec)
+{
+    Http_HandshakePool* pool = FromOffset(Http_HandshakePool, handler, handler);
+    Http_SR_SocketData* done;
+
+    MI_UNUSED(sel);
+
+    if (mask & SELECTOR_TIMEOUT)
+    {
+        Lock_Acquire(&pool->lock);
+        done = pool->done;
+        pool->done = NULL;
+        pool->handler.fireTimeoutAt = TIME_NEVER;
+        Lock_Release(&pool->lock);
+
+        while (done)
+        {
+            Http_SR_SocketData* h = done;
+            done = h->next;
+            h->next = NULL;
+            _StartConnection(pool->http, h, currentTimeUsec);
+        }
+    }
+
+    if ((mask & SELECTOR_REMOVE) != 0 ||
+        (mask & SELECTOR_DESTROY) != 0)
+    {
+        Lock_Acquire(&pool->lock);
+        done = pool->done;
+        pool->done = NULL;
+        pool->removed = MI_TRUE;
+        Lock_Release(&pool->lock);
+
+        while (done)
+        {
+            Http_SR_SocketData* h = done;
+            done = h->next;
+            _CloseConnection(h);
+        }
+    }
+
+    return MI_TRUE;
+}
+
+static void _HandshakePool_Delete(
+    Http_HandshakePool* pool);
+
+static MI_Result _HandshakePool_New(
+    Http* self)
+{
+    Http_HandshakePool* pool;
+    MI_Uint32 threadCount = self->options.sslSession.handshakeThreads;
+    MI_Result r;
+
+    if (threadCount > HTTP_HANDSHAKE_MAX_THREADS)
+        threadCount = HTTP_HANDSHAKE_MAX_THREADS;
+
+    pool = (Http_HandshakePool*)PAL_Calloc(1, sizeof(Http_HandshakePool));
+    if (!pool)
+        return MI_RESULT_SERVER_LIMITS_EXCEEDED;
+
+    pool->http = self;
+    Lock_Init(&pool->lock);
+
+    if (Sem_Init(&pool->queued, SEM_USER_ACCESS_DEFAULT, 0) != 0)
+    {
+        PAL_Free(pool);
+        return MI_RESULT_FAILED;
+    }
+
+    pool->handler.sock = INVALID_SOCK;
+    pool->handler.fireTimeoutAt = TIME_NEVER;
+    pool->handler.callback = _HandshakePoolCallback;
+    pool->handler.data = self;
+    pool->handler.handlerName = MI_T("HTTPS_HANDSHAKE");
+
+    r = Selector_AddHandler(self->selector, &pool->handler);
+    if (r != MI_RESULT_OK)
+    {
+        Sem_Destroy(&pool->queued);
+        PAL_Free(pool);
+        return r;
+    }
+
+    self->handshakePool = pool;
+
+    for (; pool->threadCount < threadCount; pool->threadCount++)
+    {
+        if (Thread_CreateJoinable(&pool->threads[pool->threadCount],
+            _HandshakeProc, NULL, pool) != 0)
+        {
+            _HandshakePool_Delete(pool);
+            self->handshakePool = NULL;
+            return MI_RESULT_FAILED;
+        }
+    }
+
+    return MI_RESULT_OK;
+}
+
+static void _HandshakePool_Delete(
+    Http_HandshakePool* pool)
+{
+    MI_Uint32 i;
+    MI_Boolean removed;
+
+    Lock_Acquire(&pool->lock);
+    pool->stop = MI_TRUE;
+    Lock_Release(&pool->lock);
+
+    if (pool->threadCount)
+        Sem_Post(&pool->queued, pool->threadCount);
+
+    for (i = 0; i < pool->threadCount; i++)
+    {
+        PAL_Uint32 ret;
+
+        Thread_Join(&pool->threads[i], &ret);
+        Thread_Destroy(&pool->threads[i]);
+    }
+
+    Lock_Acquire(&pool->lock);
+    removed = pool->removed;
+    Lock_Release(&pool->lock);
+
+    /* Closes the connections not started yet */
+    if (!removed)
+        Selector_RemoveHandler(pool->http->selector, &pool->handler);
+
+    while (pool->queueHead)
+    {
+        Http_SR_SocketData* h = pool->queueHead;
+        pool->queueHead = h->next;
+        _CloseConnection(h);
+    }
+
+    Sem_Destroy(&pool->queued);
+    PAL_Free(pool);
+}
+
+/* Queues a new connection for its handshake */
+static void _HandshakePool_Add(
+    Http_HandshakePool* pool,
+    Http_SR_SocketData* h)
+{
+    Lock_Acquire(&pool->lock);
+    if (pool->queueTail)
+        pool->queueTail->next = h;
+    else
+        pool->queueHead = h;
+    pool->queueTail = h;
+    Lock_Release(&pool->lock);
+
+    Sem_Post(&pool->queued, 1);
+}
+
+#endif /* CONFIG_POSIX */
+
+/*
+**==============================================================================
+*/
+
+static MI_Boolean _ListenerCallback(
+    Selector* sel,
+    Handler* handler_,
+    MI_Uint32 mask,
+    MI_Uint64 currentTimeUsec)
+{
+    Http_Listener_SocketData* handler = (Http_Listener_SocketData*)handler_;
+    Http* self = (Http*)handler->base.data;
+    MI_Result r;
     Sock s;
     Addr addr;
     Http_SR_SocketData* h;
@@ -1500,7 +2369,6 @@ static MI_Boolean _ListenerCallback(
         h->handler.mask = SELECTOR_READ | SELECTOR_EXCEPTION;
         h->handler.callback = _RequestCallback;
         h->handler.data = self;
-        h->handler.fireTimeoutAt = currentTimeUsec + self->options.timeoutUsec;
         h->enableTracing = self->options.enableTracing;
 
         /* ssl support */
@@ -1511,42 +2379,28 @@ static MI_Boolean _ListenerCallback(
             if (!h->ssl)
             {
                 trace_SSLNew_Failed();
-                Strand_Delete(&h->strand);
-                Sock_Close(s);
+                _CloseConnection(h);
                 return MI_TRUE;
             }
 
             if (!(SSL_set_fd(h->ssl, s) ))
             {
                 trace_SSL_setfd_Failed();
-                SSL_free(h->ssl);
-                Strand_Delete(&h->strand);
-                Sock_Close(s);
+                _CloseConnection(h);
                 return MI_TRUE;
             }
-        }
 
-        /* Watch for read events on the incoming connection */
-        r = Selector_AddHandler(self->selector, &h->handler);
-
-        if (r != MI_RESULT_OK)
-        {
-            trace_SelectorAddHandler_Failed();
-            if (handler->secure)
-                SSL_free(h->ssl);
-            Strand_Delete(&h->strand);
-            Sock_Close(s);
-            return MI_TRUE;
+#ifdef CONFIG_POSIX
+            /* perform the handshake on the pool, if any */
+            if (self->handshakePool)
+            {
+                _HandshakePool_Add(self->handshakePool, h);
+                return MI_TRUE;
+            }
+#endif
         }
 
-        // notify next stack layer about new connection
-        // (open the interaction)
-        Strand_Open(
-            &h->strand,
-            self->callbackOnNewConnection,
-            self->callbackData,
-            NULL,
-            MI_TRUE );
+        _StartConnection(self, h, currentTimeUsec);
     }
 
     if ((mask & SELECTOR_REMOVE) != 0 ||
@@ -1667,6 +2521,180 @@ static MI_Boolean _verifyPrivateKey(
     return MI_TRUE;
 }
 
+/* Returns the key to protect a new session ticket with (rotating the keys
+ * if the current one is older than sslSession.ticketKeyLifetimeSec), or the
+ * key a received ticket is protected with: 1 if it is the current key, 2
+ * if the ticket must be renewed (previous or expired key), 0 if unknown */
+static int _GetTicketKey(
+    Http* self,
+    const unsigned char* name,
+    Http_TicketKey* key)
+{
+    Http_TicketKey* current = &self->ticketKeys[0];
+    Http_TicketKey* previous = &self->ticketKeys[1];
+    MI_Uint64 lifetimeUsec =
+        (MI_Uint64)self->options.sslSession.ticketKeyLifetimeSec * 1000000;
+    MI_Uint64 now;
+    int result = 0;
+
+    if (PAL_TRUE != PAL_Time(&now))
+        return 0;
+
+    Lock_Acquire(&self->ticketKeysLock);
+
+    if (!name)
+    {
+        if (!current->valid || now - current->createdAt >= lifetimeUsec)
+        {
+            Http_TicketKey newKey;
+
+            if (RAND_bytes(newKey.name, sizeof(newKey.name)) > 0 &&
+                RAND_bytes(newKey.aesKey, sizeof(newKey.aesKey)) > 0 &&
+                RAND_bytes(newKey.hmacKey, sizeof(newKey.hmacKey)) > 0)
+            {
+                newKey.createdAt = now;
+                newKey.valid = MI_TRUE;
+
+                *previous = *current;
+                *current = newKey;
+            }
+
+            OPENSSL_cleanse(&newKey, sizeof(newKey));
+        }
+
+        if (current->valid)
+        {
+            *key = *current;
+            result = 1;
+        }
+    }
+    else if (current->valid &&
+        memcmp(name, current->name, sizeof(current->name)) == 0)
+    {
+        *key = *current;
+        result = now - current->createdAt >= lifetimeUsec ? 2 : 1;
+    }
+    else if (previous->valid &&
+        memcmp(name, previous->name, sizeof(previous->name)) == 0)
+    {
+        *key = *previous;
+        result = 2;
+    }
+
+    Lock_Release(&self->ticketKeysLock);
+
+    return result;
+}
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+typedef EVP_MAC_CTX Http_TicketMacCtx;
+
+static int _InitTicketMac(
+    EVP_MAC_CTX* ctx,
+    const unsigned char* key)
+{
+    OSSL_PARAM params[2];
+
+    params[0] = OSSL_PARAM_construct_utf8_string(
+        OSSL_MAC_PARAM_DIGEST, (char*)"SHA256", 0);
+    params[1] = OSSL_PARAM_construct_end();
+
+    return EVP_MAC_init(ctx, key, 32, params);
+}
+#else
+typedef HMAC_CTX Http_TicketMacCtx;
+
+static int _InitTicketMac(
+    HMAC_CTX* ctx,
+    const unsigned char* key)
+{
+    return HMAC_Init_ex(ctx, key, 32, EVP_sha256(), NULL);
+}
+#endif
+
+/* Encrypts/decrypts the session tickets with the keys of the listener
+ * (AES-256-CBC and HMAC-SHA256), see SSL_CTX_set_tlsext_ticket_key_cb() */
+static int _TicketKeyCallback(
+    SSL* ssl,
+    unsigned char* keyName,
+    unsigned char* iv,
+    EVP_CIPHER_CTX* cipherCtx,
+    Http_TicketMacCtx* macCtx,
+    int enc)
+{
+    Http* self = (Http*)SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl));
+    Http_TicketKey key;
+    int result;
+
+    if (enc)
+    {
+        if (RAND_bytes(iv, EVP_CIPHER_iv_length(EVP_aes_256_cbc())) <= 0 ||
+            _GetTicketKey(self, NULL, &key) == 0)
+        {
+            return -1;
+        }
+
+        memcpy(keyName, key.name, sizeof(key.name));
+        result = 1;
+    }
+    else
+    {
+        result = _GetTicketKey(self, keyName, &key);
+
+        /* Unknown key: full handshake */
+        if (result == 0)
+            return 0;
+    }
+
+    if (!EVP_CipherInit_ex(cipherCtx, EVP_aes_256_cbc(), NULL, key.aesKey,
+            iv, enc) ||
+        !_InitTicketMac(macCtx, key.hmacKey))
+    {
+        result = -1;
+    }
+
+    OPENSSL_cleanse(&key, sizeof(key));
+    return result;
+}
+
+/* Configures the session cache and the session tickets */
+static void _SetSessionOptions(
+    Http* self,
+    SSL_CTX* sslContext)
+{
+    const SSL_SessionOptions* options = &self->options.sslSession;
+    static const unsigned char sessionIdContext[] = "omi";
+
+    SSL_CTX_set_session_id_context(sslContext, sessionIdContext,
+        sizeof(sessionIdContext) - 1);
+
+    if (options->timeoutSec)
+        SSL_CTX_set_timeout(sslContext, options->timeoutSec);
+
+    if (options->cacheSize)
+    {
+        SSL_CTX_set_session_cache_mode(sslContext, SSL_SESS_CACHE_SERVER);
+        SSL_CTX_sess_set_cache_size(sslContext, options->cacheSize);
+    }
+
+    if (!options->tickets)
+    {
+        SSL_CTX_set_options(sslContext, SSL_OP_NO_TICKET);
+        return;
+    }
+
+    if (options->ticketKeyLifetimeSec)
+    {
+        Lock_Init(&self->ticketKeysLock);
+        SSL_CTX_set_app_data(sslContext, self);
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+        SSL_CTX_set_tlsext_ticket_key_evp_cb(sslContext, _TicketKeyCallback);
+#else
+        SSL_CTX_set_tlsext_ticket_key_cb(sslContext, _TicketKeyCallback);
+#endif
+    }
+}
+
 static MI_Result _CreateSSLContext(Http* self, const char* sslCipherSuite, SSL_Options sslOptions)
 {
     SSL_CTX *sslContext;
@@ -1724,6 +2752,8 @@ static MI_Result _CreateSSLContext(Http* self, const char* sslCipherSuite, SSL_O
         }
     }
 
+    _SetSessionOptions(self, sslContext);
+
     self->sslContext = sslContext;
     return MI_RESULT_OK;
 }
@@ -1820,6 +2850,17 @@ MI_Result Http_New_Server(
 
     self = *selfOut;
 
+    // options
+    if( NULL == options )
+    {
+        HttpOptions tmpOptions = DEFAULT_HTTP_OPTIONS;
+        self->options = tmpOptions;
+    }
+    else
+    {
+        self->options = *options;
+    }
+
     /* Create http listener socket */
     if (http_port)
     {
@@ -1856,22 +2897,23 @@ MI_Result Http_New_Server(
             Http_Delete(self);
             return r;
         }
+
+        /* handshakes on worker threads */
+        if (self->options.sslSession.handshakeThreads)
+        {
+            r = _HandshakePool_New(self);
+
+            if (r != MI_RESULT_OK)
+            {
+                Http_Delete(self);
+                return r;
+            }
+        }
     }
 #else
     MI_UNUSED(https_port);
 #endif
 
-    // options
-    if( NULL == options )
-    {
-        HttpOptions tmpOptions = DEFAULT_HTTP_OPTIONS;
-        self->options = tmpOptions;
-    }
-    else
-    {
-        self->options = *options;
-    }
-
     return MI_RESULT_OK;
 }
 
@@ -1886,6 +2928,15 @@ MI_Result Http_Delete(
     if (self->magic != _MAGIC)
         return MI_RESULT_INVALID_PARAMETER;
 
+#ifdef CONFIG_POSIX
+    /* Stop the handshakes before the selector goes away */
+    if (self->handshakePool)
+    {
+        _HandshakePool_Delete(self->handshakePool);
+        self->handshakePool = NULL;
+    }
+#endif
+
     if (self->internalSelectorUsed)
     {
         /* Release selector;
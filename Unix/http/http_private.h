@@ -21,6 +21,7 @@
 #include <openssl/ssl.h>
 #include <openssl/err.h>
 #include <pthread.h>
+#include <pal/lock.h>
 #else
 /* ssl not supported in this configuration; just make compiler happy */
 typedef void SSL;
@@ -57,6 +58,27 @@ static const MI_Uint32 MAX_HEADER_SIZE     = 4 * 1024;
 static const MI_Uint32 INITIAL_BUFFER_SIZE = 4 * 1024;
 static const size_t HTTP_MAX_CONTENT = 1024 * 1024;
 
+#ifdef CONFIG_POSIX
+
+/* Key protecting the session tickets (see _TicketKeyCallback) */
+typedef struct _Http_TicketKey {
+    unsigned char name[16];
+    unsigned char aesKey[32];
+    unsigned char hmacKey[32];
+    MI_Uint64 createdAt;
+    MI_Boolean valid;
+} Http_TicketKey;
+
+#endif
+
+typedef struct _Http_HandshakePool Http_HandshakePool;
+
+/* Content codings of Accept-Encoding the server compresses responses with */
+#define HTTP_ENCODING_GZIP      0x01
+#define HTTP_ENCODING_DEFLATE   0x02
+
+typedef struct _Http_Deflater Http_Deflater;
+
 struct _Http {
     MI_Uint32 magic;
     Selector internalSelector;
@@ -67,6 +89,13 @@ struct _Http {
     /* options: timeouts etc */
     HttpOptions options;
     MI_Boolean internalSelectorUsed;
+#ifdef CONFIG_POSIX
+    /* current and previous session ticket keys */
+    Lock ticketKeysLock;
+    Http_TicketKey ticketKeys[2];
+#endif
+    /* performs TLS handshakes off the selector thread (optional) */
+    Http_HandshakePool *handshakePool;
 };
 
 typedef struct _Http_Listener_SocketData {
@@ -78,9 +107,25 @@ typedef struct _Http_Listener_SocketData {
 
 typedef enum _Http_RecvState {
     RECV_STATE_HEADER,
-    RECV_STATE_CONTENT
+    RECV_STATE_CONTENT,
+    RECV_STATE_CHUNKED
 } Http_RecvState;
 
+/* Position of the chunked request body decoder */
+typedef enum _Http_ChunkState {
+    CHUNK_STATE_SIZE,           /* hex digits of the chunk size */
+    CHUNK_STATE_EXTENSION,      /* chunk extension up to the CR */
+    CHUNK_STATE_SIZE_LF,
+    CHUNK_STATE_DATA,
+    CHUNK_STATE_DATA_CR,
+    CHUNK_STATE_DATA_LF,
+    CHUNK_STATE_TRAILER,        /* start of a trailer line */
+    CHUNK_STATE_TRAILER_LINE,
+    CHUNK_STATE_TRAILER_LF,
+    CHUNK_STATE_END_LF,         /* CR of the empty line ending the body */
+    CHUNK_STATE_DONE
+} Http_ChunkState;
+
 typedef struct _Http_SR_SocketData {
     Strand strand;
 
@@ -106,12 +151,32 @@ typedef struct _Http_SR_SocketData {
     Page *recvPage;
     HttpRequestMsg *request;    // request msg with the request page
 
+    /* where the search for the end of the header resumes */
+    size_t headerScanned;
+
+    /* chunked request body, decoded in place into recvPage */
+    MI_Boolean recvChunked;
+    Http_ChunkState chunkState;
+    size_t chunkRemaining;
+    size_t chunkLineLength;
+    size_t recvPageCapacity;
+
+    /* content codings the client accepts for the response; chunked
+       (compressed) responses are not sent to HTTP/1.0 clients */
+    MI_Uint32 acceptEncoding;
+    MI_Boolean recvHttp10;
+
     /* sending part */
     Page *sendPage;
     Page *sendHeader;
     size_t sentSize;
     Http_RecvState sendingState;
 
+    /* compressed response, sent as chunks produced one at a time */
+    Http_Deflater *deflater;
+    const char *sendChunk;
+    size_t sendChunkSize;
+
     int httpErrorCode;
 
     /* Enumeration saying what type (HTTP_AUTH_TYPE). */
@@ -148,6 +213,9 @@ typedef struct _Http_SR_SocketData {
     MI_Boolean enableTracing;
 
     volatile ptrdiff_t refcount;
+
+    /* link in the handshake pool queues */
+    struct _Http_SR_SocketData *next;
 } Http_SR_SocketData;
 
 /* helper functions result */
@@ -165,6 +233,33 @@ MI_Boolean Http_DecryptData(_In_ Http_SR_SocketData * handler, _Out_ HttpHeaders
 MI_Boolean 
 Http_EncryptData(_In_ Http_SR_SocketData *handler, int contentLen, int contentTypeLen, char *contentType, _Out_ Page ** pData);
 
+/* Response compression (httpcompress.c) */
+MI_Uint32 Http_ParseAcceptEncoding(_In_z_ const char* value);
+
+#if defined(CONFIG_ENABLE_COMPRESSION)
+
+/* Compress the 'size' bytes of 'data' (kept alive by the caller) with the
+   preferred coding of 'encodings'; NULL to send them uncompressed */
+Http_Deflater* Http_Deflater_New(
+    MI_Uint32 encodings,
+    MI_Uint32 level,
+    _In_reads_(size) const char* data,
+    size_t size);
+
+/* Value of the Content-Encoding header */
+const char* Http_Deflater_Encoding(_In_ Http_Deflater* self);
+
+/* Next chunk of the chunked body, the last one included; *size is 0 once
+   the whole body was returned */
+MI_Boolean Http_Deflater_Next(
+    _Inout_ Http_Deflater* self,
+    _Outptr_result_bytebuffer_(*size) const char** data,
+    _Out_ size_t* size);
+
+void Http_Deflater_Delete(_In_opt_ Http_Deflater* self);
+
+#endif /* defined(CONFIG_ENABLE_COMPRESSION) */
+
 //struct gss_buffer_desc_struct;
 //char *DecodeToken(struct gss_buffer_desc_struct *token);
 #endif
@@ -118,6 +118,47 @@ typedef enum _AuthMechanism {
 /* ************************************************ */
 typedef struct _Http Http;
 
+/* TLS session resumption and handshake options of the HTTPS listener,
+    set from omiserver.conf (sslsessioncachesize, sslsessiontimeout,
+    sslsessiontickets, sslticketkeylifetime and sslhandshakethreads) */
+typedef struct _SSL_SessionOptions
+{
+    /* Number of sessions kept in the server-side session cache (for
+    session-ID resumption); 0 disables the cache */
+    MI_Uint32 cacheSize;
+
+    /* Lifetime of cached sessions and of session tickets */
+    MI_Uint32 timeoutSec;
+
+    /* Issue stateless session tickets (RFC 5077) */
+    MI_Boolean tickets;
+
+    /* Period after which the ticket keys are rotated; tickets issued
+    with the previous key are still accepted (and renewed) */
+    MI_Uint32 ticketKeyLifetimeSec;
+
+    /* Number of threads performing TLS handshakes before the connections
+    are handed to the selector; 0 performs them on the selector thread */
+    MI_Uint32 handshakeThreads;
+}
+SSL_SessionOptions;
+
+#define DEFAULT_SSL_SESSION_OPTIONS { 20480, 300, MI_TRUE, 3600, 0 }
+
+/* HTTP response compression, negotiated with Accept-Encoding; set from
+    omiserver.conf (httpcompressionlevel and httpcompressionminsize) */
+typedef struct _Http_CompressionOptions
+{
+    /* zlib compression level (1 to 9); 0 disables the compression */
+    MI_Uint32 level;
+
+    /* Responses smaller than this are sent uncompressed */
+    MI_Uint32 minSize;
+}
+Http_CompressionOptions;
+
+#define DEFAULT_HTTP_COMPRESSION_OPTIONS { 0, 1024 }
+
 /* HTTP options.
     mostly used for unit-testing; default values
     are hard-coded but can be overwritten by 
@@ -130,6 +171,12 @@ typedef struct _HttpOptions
 
     /* Enable tracing of HTTP input and output */
     MI_Boolean enableTracing;
+
+    /* TLS session resumption and handshakes (HTTPS listener only) */
+    SSL_SessionOptions sslSession;
+
+    /* Response compression */
+    Http_CompressionOptions compression;
 }
 HttpOptions;
 
@@ -151,7 +198,8 @@ SSL_Options;
 //------------------------------------------------------------------------------------------------------------------
 
 /* 60 sec timeout */
-#define DEFAULT_HTTP_OPTIONS  { (60 * 1000000), MI_FALSE }
+#define DEFAULT_HTTP_OPTIONS  { (60 * 1000000), MI_FALSE, DEFAULT_SSL_SESSION_OPTIONS, \
+    DEFAULT_HTTP_COMPRESSION_OPTIONS }
 
 MI_Result Http_New_Server(
     _Out_       Http**              selfOut,
@@ -0,0 +1,289 @@
+/*
+**==============================================================================
+**
+** Copyright (c) Microsoft Corporation. All rights reserved. See file LICENSE
+** for license information.
+**
+**==============================================================================
+*/
+
+#include <config.h>
+#include <string.h>
+#include <pal/strings.h>
+#include <base/Strand.h>
+#include "httpcommon.h"
+#include "http_private.h"
+
+#if defined(CONFIG_ENABLE_COMPRESSION)
+#include <zlib.h>
+#endif
+
+/* Is the value of a 'q' parameter a weight of 0 (0, 0.0, 0.000...)? */
+static MI_Boolean _IsZeroWeight(
+    const char* p)
+{
+    if (*p != '0')
+        return MI_FALSE;
+
+    p++;
+
+    if (*p == '.')
+    {
+        p++;
+
+        while (*p == '0')
+            p++;
+    }
+
+    return (*p >= '1' && *p <= '9') ? MI_FALSE : MI_TRUE;
+}
+
+MI_Uint32 Http_ParseAcceptEncoding(
+    _In_z_ const char* value)
+{
+    MI_Uint32 encodings = 0;
+    MI_Uint32 named = 0;
+    MI_Uint32 refusedEncodings = 0;
+    MI_Boolean any = MI_FALSE;
+    const char* p = value;
+
+    /* comma separated codings, each with optional parameters; a weight
+       (q) of 0 refuses the coding, "*" stands for the codings not named */
+    while (*p)
+    {
+        const char* name;
+        size_t len;
+        MI_Uint32 encoding = 0;
+        MI_Boolean refused = MI_FALSE;
+
+        while (*p == ' ' || *p == '\t' || *p == ',')
+            p++;
+
+        name = p;
+
+        while (*p && *p != ',' && *p != ';' && *p != ' ' && *p != '\t')
+            p++;
+
+        len = (size_t)(p - name);
+
+        while (*p && *p != ',')
+        {
+            if (*p == ';')
+            {
+                p++;
+
+                while (*p == ' ' || *p == '\t')
+                    p++;
+
+                if ((p[0] == 'q' || p[0] == 'Q') && p[1] == '=')
+                {
+                    p += 2;
+                    refused = _IsZeroWeight(p);
+                }
+                continue;
+            }
+            p++;
+        }
+
+        if ((len == 4 && Strncasecmp(name, "gzip", 4) == 0) ||
+            (len == 6 && Strncasecmp(name, "x-gzip", 6) == 0))
+            encoding = HTTP_ENCODING_GZIP;
+        else if (len == 7 && Strncasecmp(name, "deflate", 7) == 0)
+            encoding = HTTP_ENCODING_DEFLATE;
+        else if (len == 1 && name[0] == '*')
+        {
+            if (!refused)
+                any = MI_TRUE;
+            continue;
+        }
+
+        named |= encoding;
+
+        if (refused)
+            refusedEncodings |= encoding;
+        else
+            encodings |= encoding;
+    }
+
+    if (any)
+        encodings |= (HTTP_ENCODING_GZIP | HTTP_ENCODING_DEFLATE) & ~named;
+
+    /* a coding refused explicitly stays refused, whatever else is listed */
+    return encodings & ~refusedEncodings;
+}
+
+#if defined(CONFIG_ENABLE_COMPRESSION)
+
+/* Compressed bytes per chunk; the chunk size line and the CRLF ending the
+   chunk (and the last chunk) are built around them in the same buffer */
+#define HTTP_DEFLATE_CHUNK_SIZE     (16 * 1024)
+#define HTTP_DEFLATE_CHUNK_HEADER   10
+#define HTTP_DEFLATE_CHUNK_TRAILER  7
+
+struct _Http_Deflater
+{
+    z_stream stream;
+    MI_Uint32 encoding;
+
+    /* all the input was compressed, the last chunk was returned */
+    MI_Boolean finished;
+
+    char buffer[HTTP_DEFLATE_CHUNK_HEADER + HTTP_DEFLATE_CHUNK_SIZE +
+        HTTP_DEFLATE_CHUNK_TRAILER];
+};
+
+static voidpf _Alloc(
+    voidpf opaque,
+    uInt items,
+    uInt size)
+{
+    MI_UNUSED(opaque);
+    return PAL_Calloc(items, size);
+}
+
+static void _Free(
+    voidpf opaque,
+    voidpf address)
+{
+    MI_UNUSED(opaque);
+    PAL_Free(address);
+}
+
+Http_Deflater* Http_Deflater_New(
+    MI_Uint32 encodings,
+    MI_Uint32 level,
+    _In_reads_(size) const char* data,
+    size_t size)
+{
+    Http_Deflater* self;
+    MI_Uint32 encoding;
+    int windowBits;
+
+    /* gzip is preferred: it is the coding all the clients understand */
+    if (encodings & HTTP_ENCODING_GZIP)
+    {
+        encoding = HTTP_ENCODING_GZIP;
+        windowBits = MAX_WBITS + 16;
+    }
+    else if (encodings & HTTP_ENCODING_DEFLATE)
+    {
+        encoding = HTTP_ENCODING_DEFLATE;
+        windowBits = MAX_WBITS;
+    }
+    else
+        return NULL;
+
+    if (level < 1 || level > 9 || size > (size_t)(uInt)-1)
+        return NULL;
+
+    self = (Http_Deflater*)PAL_Malloc(sizeof(Http_Deflater));
+
+    if (!self)
+        return NULL;
+
+    memset(&self->stream, 0, sizeof(self->stream));
+    self->stream.zalloc = _Alloc;
+    self->stream.zfree = _Free;
+
+    if (deflateInit2(&self->stream, (int)level, Z_DEFLATED, windowBits, 8,
+        Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+        PAL_Free(self);
+        return NULL;
+    }
+
+    self->stream.next_in = (Bytef*)data;
+    self->stream.avail_in = (uInt)size;
+    self->encoding = encoding;
+    self->finished = MI_FALSE;
+
+    return self;
+}
+
+const char* Http_Deflater_Encoding(
+    _In_ Http_Deflater* self)
+{
+    return self->encoding == HTTP_ENCODING_GZIP ? "gzip" : "deflate";
+}
+
+MI_Boolean Http_Deflater_Next(
+    _Inout_ Http_Deflater* self,
+    _Outptr_result_bytebuffer_(*size) const char** data,
+    _Out_ size_t* size)
+{
+    static const char _hex[] = "0123456789ABCDEF";
+    char* out = self->buffer + HTTP_DEFLATE_CHUNK_HEADER;
+    char* start = out;
+    char* end;
+    size_t length = 0;
+
+    *data = NULL;
+    *size = 0;
+
+    if (self->finished)
+        return MI_TRUE;
+
+    /* all the input is there, deflate until the chunk is full or the
+       stream ends */
+    while (length == 0)
+    {
+        int r;
+
+        self->stream.next_out = (Bytef*)out;
+        self->stream.avail_out = HTTP_DEFLATE_CHUNK_SIZE;
+
+        r = deflate(&self->stream, Z_FINISH);
+
+        if (r == Z_STREAM_END)
+            self->finished = MI_TRUE;
+        else if (r != Z_OK)
+            return MI_FALSE;
+
+        length = HTTP_DEFLATE_CHUNK_SIZE - self->stream.avail_out;
+
+        if (self->finished)
+            break;
+    }
+
+    end = out + length;
+
+    if (length)
+    {
+        /* <hex size>CRLF<data>CRLF */
+        *--start = '\n';
+        *--start = '\r';
+
+        do
+        {
+            *--start = _hex[length & 0xF];
+            length >>= 4;
+        }
+        while (length);
+
+        memcpy(end, "\r\n", 2);
+        end += 2;
+    }
+
+    if (self->finished)
+    {
+        /* last chunk, no trailer */
+        memcpy(end, "0\r\n\r\n", 5);
+        end += 5;
+    }
+
+    *data = start;
+    *size = (size_t)(end - start);
+    return MI_TRUE;
+}
+
+void Http_Deflater_Delete(
+    _In_opt_ Http_Deflater* self)
+{
+    if (self)
+    {
+        deflateEnd(&self->stream);
+        PAL_Free(self);
+    }
+}
+
+#endif /* defined(CONFIG_ENABLE_COMPRESSION) */
@@ -81,6 +81,23 @@ else
   OPENSSL_LIBOPT:=-L$(OPENSSLLIBDIR)
 endif
 
+##==============================================================================
+##
+## zlib (HTTP response compression)
+##
+##==============================================================================
+
+ifeq ($(ENABLE_COMPRESSION),1)
+    ZLIB_LIBS=-lz
+else
+    ZLIB_LIBS=
+endif
+
+## Only the http library uses zlib, so only it and what links it need -lz
+## (expanded at link time: some makefiles set LIBRARIES after this file)
+
+__ZLIB_LIBS=$(if $(filter http,$(LIBRARY) $(LIBRARIES)),$(ZLIB_LIBS))
+
 ##==============================================================================
 ##
 ## OBJDIRPATH -- resolve directory where objects will go.
@@ -161,23 +178,27 @@ endif
 CSHLIBFLAGS=$(shell $(BUILDTOOL) cshlibflags $(__CSHLIBOPTS))
 CSHLIBFLAGS+=$(shell $(BUILDTOOL) syslibs)
 CSHLIBFLAGS+=$(OPENSSL_LIBS)
+CSHLIBFLAGS+=$(__ZLIB_LIBS)
 CSHLIBFLAGS+=$(EXPORTFLAGS)
 CSHLIBFLAGS+=$(LIBPATHFLAGS)
 
 CXXSHLIBFLAGS=$(shell $(BUILDTOOL) cxxshlibflags)
 CXXSHLIBFLAGS+=$(shell $(BUILDTOOL) syslibs)
 CXXSHLIBFLAGS+=$(OPENSSL_LIBS)
+CXXSHLIBFLAGS+=$(__ZLIB_LIBS)
 CXXSHLIBFLAGS+=$(EXPORTFLAGS)
 CXXSHLIBFLAGS+=$(LIBPATHFLAGS)
 
 CPROGFLAGS=$(shell $(BUILDTOOL) cprogflags)
 CPROGFLAGS+=$(shell $(BUILDTOOL) syslibs)
 CPROGFLAGS+=$(OPENSSL_LIBS)
+CPROGFLAGS+=$(__ZLIB_LIBS)
 CPROGFLAGS+=$(LIBPATHFLAGS)
 
 CXXPROGFLAGS=$(shell $(BUILDTOOL) cxxprogflags)
 CXXPROGFLAGS+=$(shell $(BUILDTOOL) syslibs)
 CXXPROGFLAGS+=$(OPENSSL_LIBS)
+CXXPROGFLAGS+=$(__ZLIB_LIBS)
 CXXPROGFLAGS+=$(LIBPATHFLAGS)
 
 __DEPS=$(wildcard $(addprefix $(LIBDIR)/lib,$(addsuffix .*,$(LIBRARIES))))
@@ -0,0 +1,862 @@
+/*
+**==============================================================================
+**
+** Copyright (c) Microsoft Corporation. All rights reserved. See file LICENSE
+** for license information.
+**
+**==============================================================================
+*/
+
+#include "ConnectionPool.h"
+#include <pal/atomic.h>
+#include <pal/strings.h>
+#include <pal/sleep.h>
+#include <base/messages.h>
+#include <base/credcache.h>
+#include <protocol/protocol.h>
+
+/*
+**==============================================================================
+**
+** Data structures
+**
+**==============================================================================
+*/
+
+/*
+    PooledConnection - a binary protocol connection to the server shared by
+    the operations (PooledOperation entries) with the same locator and
+    credentials.
+*/
+typedef struct _PooledConnection
+{
+    StrandMany              strand;
+
+    /* Linked-list support (protected by the pool lock) */
+    ListElem*               next;
+    ListElem*               prev;
+
+    ConnectionPool*         pool;
+    ProtocolSocketAndBase*  protocol;
+
+    /* Key (see CredCache_HashUser) */
+    char*                   locator;
+    MI_Boolean              hasCredentials;
+    unsigned char           credentials[CREDCACHE_HASH_SIZE];
+
+    /* Protected by the pool lock */
+    MI_Boolean              listed;
+    MI_Boolean              closeScheduled; /* _PooledConnection_CloseAux */
+    MI_Boolean              lost;           /* _PooledConnection_Close ran */
+    MI_Uint32               operations;     /* entries not deleted yet */
+    MI_Uint64               idleSince;      /* when operations dropped to 0 */
+
+    /* Only used on the strand */
+    MI_Boolean              connected;
+    MI_Boolean              closing;
+}
+PooledConnection;
+
+/*
+    PooledOperation - the interaction opened by one miapi operation, using
+    the operationId of its request as key on the connection.
+*/
+typedef struct _PooledOperation
+{
+    StrandEntry             strand;
+
+    MI_Uint64               operationId;
+    MI_Boolean              pendingCancel;
+    MI_Boolean              cancelSent;
+}
+PooledOperation;
+
+#define POOLEDCONNECTION_STRANDAUX_CLOSE    0
+#define POOLEDCONNECTION_STRANDAUX_ENTRYACK 1
+
+STRAND_DEBUGNAME2( PooledConnection, Close, EntryAck )
+STRAND_DEBUGNAME( PooledOperation )
+
+/*
+**==============================================================================
+**
+** Local functions
+**
+**==============================================================================
+*/
+
+/* Returns whether the connection was opened to 'locator' with the same
+ * credentials (hashes compared in constant time) */
+static MI_Boolean _PooledConnection_Matches(
+    _In_ const PooledConnection* self,
+    _In_z_ const char* locator,
+    MI_Boolean hasCredentials,
+    _In_reads_(CREDCACHE_HASH_SIZE) const unsigned char* credentials)
+{
+    if (strcmp(self->locator, locator) != 0 ||
+        self->hasCredentials != hasCredentials)
+    {
+        return MI_FALSE;
+    }
+
+    return !hasCredentials ||
+        CredCache_CompareHash(self->credentials, credentials) == 0;
+}
+
+static void _FreeKey(
+    _Inout_ PooledConnection* self)
+{
+    PAL_Free(self->locator);
+    self->locator = NULL;
+
+    memset(self->credentials, 0, sizeof(self->credentials));
+}
+
+/* Returns whether the pool is going to schedule _PooledConnection_CloseAux */
+static MI_Boolean _PooledConnection_RemoveFromPool(
+    _Inout_ PooledConnection* self)
+{
+    ConnectionPool* pool = self->pool;
+    MI_Boolean closeScheduled;
+
+    Lock_Acquire(&pool->lock);
+
+    if (self->listed)
+    {
+        List_Remove(&pool->head, &pool->tail, (ListElem*)&self->next);
+        self->listed = MI_FALSE;
+    }
+
+    closeScheduled = self->closeScheduled;
+    self->lost = MI_TRUE;
+
+    Lock_Release(&pool->lock);
+
+    return closeScheduled;
+}
+
+/* Schedules the close of connections already removed from the pool (with
+ * closeScheduled set) and chained thru 'next'; must be called without holding
+ * the pool lock as the connection may run on this thread. The connections
+ * cannot finish before, as _PooledConnection_Close leaves the close to
+ * _PooledConnection_CloseAux in that case. */
+static void _ScheduleClose(
+    _In_opt_ ListElem* first)
+{
+    while (first)
+    {
+        PooledConnection* connection = FromOffset(PooledConnection, next, first);
+
+        first = first->next;
+        StrandMany_ScheduleAux(&connection->strand, POOLEDCONNECTION_STRANDAUX_CLOSE);
+    }
+}
+
+/* Removes the connections idle since before 'now' minus the timeout and
+ * chains them thru 'next' for _ScheduleClose; sets 'nextSweep' to the time
+ * the oldest of the remaining idle connections expires (TIME_NEVER if none).
+ * Called with the pool lock acquired */
+static ListElem* _ConnectionPool_RemoveIdle(
+    _Inout_ ConnectionPool* self,
+    MI_Uint64 now,
+    _Out_ MI_Uint64* nextSweep)
+{
+    ListElem* idle = NULL;
+    ListElem* elem = self->head;
+
+    *nextSweep = TIME_NEVER;
+
+    while (elem)
+    {
+        PooledConnection* current = FromOffset(PooledConnection, next, elem);
+        MI_Uint64 expires = current->idleSince + CONNECTIONPOOL_IDLE_TIMEOUT_USEC;
+        elem = elem->next;
+
+        if (current->operations != 0)
+            continue;
+
+        if (now >= expires)
+        {
+            List_Remove(&self->head, &self->tail, (ListElem*)&current->next);
+            current->listed = MI_FALSE;
+            current->closeScheduled = MI_TRUE;
+            current->next = idle;
+            idle = (ListElem*)&current->next;
+        }
+        else if (*nextSweep == TIME_NEVER || expires < *nextSweep)
+        {
+            *nextSweep = expires;
+        }
+    }
+
+    return idle;
+}
+
+/* Arms the sweeper for a connection that has just become idle; returns
+ * whether the selector has to be woken up to notice the new timeout.
+ * Called with the pool lock acquired */
+static MI_Boolean _ConnectionPool_ArmSweeper(
+    _Inout_ ConnectionPool* self,
+    MI_Uint64 idleSince)
+{
+    if (self->closing || self->sweeper.fireTimeoutAt != TIME_NEVER)
+        return MI_FALSE;
+
+    self->sweeper.fireTimeoutAt = idleSince + CONNECTIONPOOL_IDLE_TIMEOUT_USEC;
+    return MI_TRUE;
+}
+
+/*
+    Sweeper handler: closes the connections idle for too long and
+    re-calculates the timeout (for the next idle connection). Removes
+    itself from the selector once the pool is being destroyed.
+*/
+static MI_Boolean _ConnectionPool_SweeperCallback(
+    Selector* sel,
+    Handler* handler,
+    MI_Uint32 mask,
+    MI_Uint64 currentTimeUsec)
+{
+    ConnectionPool* self = (ConnectionPool*)handler->data;
+
+    MI_UNUSED(sel);
+
+    if (mask & SELECTOR_TIMEOUT)
+    {
+        ListElem* idle;
+        MI_Boolean closing;
+
+        Lock_Acquire(&self->lock);
+        closing = self->closing;
+        idle = _ConnectionPool_RemoveIdle(self, currentTimeUsec, &handler->fireTimeoutAt);
+        Lock_Release(&self->lock);
+
+        _ScheduleClose(idle);
+
+        return !closing;
+    }
+
+    if (mask & (SELECTOR_REMOVE | SELECTOR_DESTROY))
+    {
+        /* ConnectionPool_Destroy waits for this */
+        if (Atomic_Dec(&self->connections) == 0)
+            CondLock_Broadcast((ptrdiff_t)self);
+    }
+
+    return MI_TRUE;
+}
+
+/*
+**==============================================================================
+**
+** PooledConnection
+**
+**==============================================================================
+*/
+
+static void _PooledConnection_Post( _In_ Strand* self_, _In_ Message* msg)
+{
+    PooledConnection* self = (PooledConnection*)StrandMany_FromStrand(self_);
+
+    if( !StrandMany_PostFindEntry( &self->strand, msg ) )
+    {
+        /* Remaining results of an operation already closed (canceled);
+         * acked once out of this method as the ack may post the next one */
+        StrandMany_ScheduleAux( &self->strand, POOLEDCONNECTION_STRANDAUX_ENTRYACK );
+    }
+}
+
+static void _PooledConnection_PostControl( _In_ Strand* self_, _In_ Message* msg)
+{
+    PooledConnection* self = (PooledConnection*)StrandMany_FromStrand(self_);
+    ProtocolEventConnect* event = (ProtocolEventConnect*)msg;
+
+    DEBUG_ASSERT( ProtocolEventConnectTag == msg->tag );
+
+    /* On failure the connection is closed next (see _PooledConnection_Close) */
+    self->connected = event->success;
+
+    StrandMany_PostControlAll( &self->strand, msg );
+}
+
+static void _PooledConnection_Ack( _In_ Strand* self_)
+{
+    /* Acks of the entries' messages are routed by StrandMany */
+}
+
+static void _PooledConnection_Cancel( _In_ Strand* self_)
+{
+    DEBUG_ASSERT( MI_FALSE );  // not used
+}
+
+static void _PooledConnection_Close( _In_ Strand* self_)
+{
+    PooledConnection* self = (PooledConnection*)StrandMany_FromStrand(self_);
+
+    /* Lost the connection (or finished closing it): no new operations are
+     * added and the outstanding ones are closed, what fails them */
+    MI_Boolean closeScheduled = _PooledConnection_RemoveFromPool( self );
+    self->closing = MI_TRUE;
+
+    StrandMany_CloseAllEntries( &self->strand );
+
+    if( !closeScheduled && !self_->info.thisClosedOther )
+        Strand_Close( self_ );
+}
+
+static void _PooledConnection_Finish( _In_ Strand* self_)
+{
+    PooledConnection* self = (PooledConnection*)StrandMany_FromStrand(self_);
+    ConnectionPool* pool = self->pool;
+
+    // It is ok now for the protocol object to go away
+    ProtocolSocketAndBase_ReadyToFinish( self->protocol );
+
+    _FreeKey( self );
+    StrandMany_Delete( &self->strand );
+
+    if( Atomic_Dec( &pool->connections ) == 0 )
+        CondLock_Broadcast( (ptrdiff_t)pool );
+}
+
+// POOLEDCONNECTION_STRANDAUX_CLOSE
+static void _PooledConnection_CloseAux( _In_ Strand* self_)
+{
+    if( !self_->info.thisClosedOther )
+        Strand_Close( self_ );
+}
+
+// POOLEDCONNECTION_STRANDAUX_ENTRYACK
+static void _PooledConnection_EntryAck( _In_ Strand* self_)
+{
+    /* No on-the-wire flow control per operation yet (see disp/agentmgr.c) */
+    if( self_->info.otherAckPending )
+        Strand_Ack( self_ );
+}
+
+/*
+    Object that implements a pooled binary protocol connection to the server.
+    Uses the one-to-many interface to multiplex the operations from all the
+    sessions with the same locator and credentials.
+
+    Behavior:
+    - Post delivers the message to the operation with the same operationId,
+       or drops it (acking it thru _PooledConnection_EntryAck) if the
+       operation has been closed already.
+    - PostControl remembers whether the connection succeeded and passes the
+       connect event to all the operations (later operations receive it in
+       _PooledConnection_NewEntry).
+    - Ack does nothing as there is no on-the-wire flow control.
+    - Close removes the connection from the pool and closes all operations,
+       so that each of them reports a failure if it had not finished yet.
+    - Shutdown:
+       The objects are deleted thru the normal Strand logic. That is,
+       once the interaction is closed on both sides and there are no
+       entries the object is auto-deleted.
+
+    Unique features and special Behavour:
+    - _PooledConnection_CloseAux is scheduled when the connection has been
+       idle for too long or the application is closed.
+    - _PooledConnection_EntryAck is scheduled by each entry when it receives
+       an Ack (or drops a message) so the Ack is passed thru to the connection.
+*/
+static StrandFT _PooledConnection_FT = {
+    _PooledConnection_Post,
+    _PooledConnection_PostControl,
+    _PooledConnection_Ack,
+    _PooledConnection_Cancel,
+    _PooledConnection_Close,
+    _PooledConnection_Finish,
+    NULL,
+    _PooledConnection_CloseAux,
+    _PooledConnection_EntryAck,
+    NULL,
+    NULL,
+    NULL };
+
+/*
+**==============================================================================
+**
+** PooledOperation
+**
+**==============================================================================
+*/
+
+static void _PooledOperation_SendCancel( _In_ PooledOperation* self )
+{
+    CancelMsg* msg = CancelMsg_New( self->operationId );
+
+    if( NULL != msg )
+    {
+        StrandEntry_PostParent( &self->strand, &msg->base );
+        CancelMsg_Release( msg );
+        self->cancelSent = MI_TRUE;
+    }
+
+    /* Completes the operation right away (as dropping its own connection
+     * did before); the server results still on the way are dropped */
+    if( !self->strand.strand.info.thisClosedOther )
+        Strand_Close( &self->strand.strand );
+}
+
+static void _PooledOperation_Post( _In_ Strand* self_, _In_ Message* msg)
+{
+    PooledOperation* self = (PooledOperation*)StrandEntry_FromStrand(self_);
+
+    if( self->cancelSent )
+    {
+        /* Nothing else goes to the server after the cancel */
+        Strand_Ack( self_ );
+        return;
+    }
+
+    StrandEntry_PostParentPassthru( &self->strand, msg );
+}
+
+static void _PooledOperation_PostControl( _In_ Strand* self_, _In_ Message* msg)
+{
+    DEBUG_ASSERT( MI_FALSE );  // not used
+}
+
+static void _PooledOperation_Ack( _In_ Strand* self_)
+{
+    PooledOperation* self = (PooledOperation*)StrandEntry_FromStrand(self_);
+
+    StrandEntry_ScheduleAuxParent( &self->strand, POOLEDCONNECTION_STRANDAUX_ENTRYACK );
+}
+
+static void _PooledOperation_Cancel( _In_ Strand* self_)
+{
+    PooledOperation* self = (PooledOperation*)StrandEntry_FromStrand(self_);
+
+    if( self->cancelSent )
+        return;
+
+    if( self_->info.otherAckPending )
+    {
+        // Sent once the message being posted is acked (see _PooledOperation_ParentAck)
+        self->pendingCancel = MI_TRUE;
+    }
+    else
+    {
+        _PooledOperation_SendCancel( self );
+    }
+}
+
+static void _PooledOperation_Close( _In_ Strand* self_)
+{
+    if( !self_->info.thisClosedOther )
+        Strand_Close( self_ );
+}
+
+static void _PooledOperation_Finish( _In_ Strand* self_)
+{
+    PooledOperation* self = (PooledOperation*)StrandEntry_FromStrand(self_);
+
+    StrandEntry_Delete( &self->strand );
+}
+
+/*
+    Object that implements a single operation multiplexed on a pooled
+    connection (PooledConnection).
+
+    Behavior:
+    - Post passes the request thru to the connection; the Ack comes back
+       passthru once it is sent.
+    - PostControl is not used in this direction.
+    - Ack is passed thru to the connection by _PooledConnection_EntryAck.
+    - Cancel sends a CancelMsg with the operationId to the server (once the
+       message being posted is acked, if any) and closes the interaction so
+       the operation fails right away.
+    - Close closes back the interaction; the operation closes it once the
+       final result has been delivered, what keeps the connection open.
+    - Shutdown:
+       The objects are deleted thru the normal Strand logic. That is,
+       once the interaction is closed on both sides the object is auto-deleted.
+*/
+static StrandFT _PooledOperation_FT = {
+    _PooledOperation_Post,
+    _PooledOperation_PostControl,
+    _PooledOperation_Ack,
+    _PooledOperation_Cancel,
+    _PooledOperation_Close,
+    _PooledOperation_Finish,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL };
+
+/*
+**==============================================================================
+*/
+
+static void _PooledConnection_NewEntry( _In_ StrandMany* self_, _In_ StrandEntry* newEntry, _In_opt_ Message* msg, _Inout_ MI_Boolean* failed )
+{
+    PooledConnection* self = (PooledConnection*)self_;
+
+    if( self->closing )
+    {
+        /* Raced with the loss of the connection */
+        StrandMany_CloseEntry( newEntry );
+    }
+    else if( self->connected )
+    {
+        ProtocolEventConnect* event = ProtocolEventConnect_New( MI_TRUE );
+
+        if( NULL == event )
+        {
+            StrandMany_CloseEntry( newEntry );
+            return;
+        }
+
+        StrandMany_PostControlEntry( newEntry, &event->base );
+        ProtocolEventConnect_Release( event );
+    }
+    // Otherwise the entry receives the connect event from _PooledConnection_PostControl
+}
+
+static void _PooledConnection_EntryDeleted( _In_ StrandMany* self_ )
+{
+    PooledConnection* self = (PooledConnection*)self_;
+    ConnectionPool* pool = self->pool;
+    MI_Boolean wakeup = MI_FALSE;
+
+    Lock_Acquire( &pool->lock );
+
+    DEBUG_ASSERT( self->operations > 0 );
+    if( --self->operations == 0 && PAL_TRUE == PAL_Time( &self->idleSince ) )
+        wakeup = _ConnectionPool_ArmSweeper( pool, self->idleSince );
+
+    Lock_Release( &pool->lock );
+
+    if( wakeup )
+        Selector_Wakeup( pool->selector, MI_FALSE );
+}
+
+static void _PooledOperation_ParentPost( _In_ StrandEntry* self, _In_ Message* msg)
+{
+    if( self->strand.info.thisClosedOther )
+    {
+        /* Canceled or failed already, drop it */
+        StrandEntry_ScheduleAuxParent( self, POOLEDCONNECTION_STRANDAUX_ENTRYACK );
+        return;
+    }
+
+    Strand_Post( &self->strand, msg );
+}
+
+static void _PooledOperation_ParentAck( _In_ StrandEntry* self_)
+{
+    PooledOperation* self = (PooledOperation*)self_;
+
+    if( self->strand.ackPassthru )
+    {
+        Strand_Ack( &self->strand.strand );
+
+        if( self->pendingCancel )
+        {
+            self->pendingCancel = MI_FALSE;
+            _PooledOperation_SendCancel( self );
+        }
+    }
+    // Otherwise it is the ack of the CancelMsg, nothing to do
+}
+
+static StrandManyInternalFT _PooledConnection_InternalFT = {
+    _PooledConnection_NewEntry,
+    _PooledConnection_EntryDeleted,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    _PooledOperation_ParentPost,
+    NULL,
+    _PooledOperation_ParentAck,
+    NULL };
+
+static size_t _PooledConnection_HashMapHashProc( _In_ const HashBucket* bucket )
+{
+    const PooledOperation* self = (const PooledOperation*)StrandEntry_FromBucketConst(bucket);
+    return (size_t)self->operationId;
+}
+
+static int _PooledConnection_HashMapEqualProc( _In_ const HashBucket* bucket1, _In_ const HashBucket* bucket2 )
+{
+    const PooledOperation* entry1 = (const PooledOperation*)StrandEntry_FromBucketConst(bucket1);
+    const PooledOperation* entry2 = (const PooledOperation*)StrandEntry_FromBucketConst(bucket2);
+    return entry1->operationId == entry2->operationId;
+}
+
+static StrandEntry* _PooledConnection_FindOperation( _In_ const StrandMany* parent, _In_ const Message* msg )
+{
+    PooledOperation forSearch;
+    HashBucket* bucket;
+
+    forSearch.operationId = msg->operationId;
+
+    bucket = HashMap_Find( &((StrandMany*)parent)->many, &forSearch.strand.bucket );
+    if( NULL == bucket )
+        return NULL;
+
+    return StrandEntry_FromBucket( bucket );
+}
+
+/* Connects synchronously, so it is called without holding the pool lock;
+ * the caller adds the connection to the pool */
+static PooledConnection* _PooledConnection_New(
+    _Inout_     ConnectionPool*         pool,
+    _In_z_      const char*             locator,
+    _In_opt_z_  const char*             user,
+    _In_opt_z_  const char*             password,
+                MI_Boolean              hasCredentials,
+    _In_reads_(CREDCACHE_HASH_SIZE) const unsigned char* credentials)
+{
+    PooledConnection* self;
+    InteractionOpenParams interactionParams;
+
+    self = (PooledConnection*)StrandMany_New(
+                            STRAND_DEBUG( PooledConnection )
+                            &_PooledConnection_FT,
+                            &_PooledConnection_InternalFT,
+                            sizeof(PooledConnection),
+                            STRAND_FLAG_ENTERSTRAND,
+                            NULL,
+                            CONNECTIONPOOL_MAX_OPERATIONS,
+                            _PooledConnection_HashMapHashProc,
+                            _PooledConnection_HashMapEqualProc,
+                            _PooledConnection_FindOperation );
+    if( NULL == self )
+        return NULL;
+
+    self->pool = pool;
+    self->locator = PAL_Strdup( locator );
+
+    /* Keeps a lost connection from closing itself (and finishing) before
+     * ConnectionPool_Open adds it to the pool or schedules its close */
+    self->closeScheduled = MI_TRUE;
+    self->hasCredentials = hasCredentials;
+    memcpy( self->credentials, credentials, sizeof(self->credentials) );
+
+    if( NULL == self->locator )
+        goto failed;
+
+    Strand_OpenPrepare( &self->strand.strand, &interactionParams, NULL, NULL, MI_TRUE );
+
+    if( MI_RESULT_OK != ProtocolSocketAndBase_New_Connector(
+        &self->protocol,
+        pool->selector,
+        locator,
+        &interactionParams,
+        user,
+        password ) )
+    {
+        // The connector deleted itself (the interaction was never opened)
+        goto failed;
+    }
+
+    // The strand has been left once the connector accepted the interaction
+    Atomic_Inc( &pool->connections );
+
+    return self;
+
+failed:
+    _FreeKey( self );
+    StrandMany_Delete( &self->strand );
+    return NULL;
+}
+
+/* Returns a connection of the pool to 'locator' with the same credentials and
+ * room for another operation, or NULL. Called with the pool lock acquired */
+static PooledConnection* _ConnectionPool_Find(
+    _In_ ConnectionPool* self,
+    _In_z_ const char* locator,
+    MI_Boolean hasCredentials,
+    _In_reads_(CREDCACHE_HASH_SIZE) const unsigned char* credentials)
+{
+    ListElem* elem;
+
+    for (elem = self->head; elem; elem = elem->next)
+    {
+        PooledConnection* current = FromOffset(PooledConnection, next, elem);
+
+        if (current->operations < CONNECTIONPOOL_MAX_OPERATIONS &&
+            _PooledConnection_Matches(current, locator, hasCredentials, credentials))
+        {
+            return current;
+        }
+    }
+
+    return NULL;
+}
+
+/*
+**==============================================================================
+**
+** Public API
+**
+**==============================================================================
+*/
+
+MI_Result ConnectionPool_Init(
+    ConnectionPool* self,
+    Selector* selector)
+{
+    MI_Result r;
+
+    memset(self, 0, sizeof(*self));
+    Lock_Init(&self->lock);
+
+    self->selector = selector;
+    self->sweeper.sock = INVALID_SOCK;
+    self->sweeper.fireTimeoutAt = TIME_NEVER;
+    self->sweeper.callback = _ConnectionPool_SweeperCallback;
+    self->sweeper.data = self;
+    self->sweeper.handlerName = MI_T("CONNECTIONPOOL_SWEEPER");
+
+    self->connections = 1;
+
+    r = Selector_AddHandler(selector, &self->sweeper);
+    if (r != MI_RESULT_OK)
+        self->connections = 0;
+
+    return r;
+}
+
+void ConnectionPool_Destroy(
+    ConnectionPool* self)
+{
+    ListElem* first;
+    ListElem* elem;
+    ptrdiff_t count;
+
+    Lock_Acquire(&self->lock);
+
+    /* The sweeper removes itself from the selector thread (handlers cannot
+     * be removed safely from other threads while the selector runs) */
+    self->closing = MI_TRUE;
+    self->sweeper.fireTimeoutAt = 1;
+
+    first = self->head;
+    for (elem = self->head; elem; elem = elem->next)
+    {
+        PooledConnection* connection = FromOffset(PooledConnection, next, elem);
+        connection->listed = MI_FALSE;
+        connection->closeScheduled = MI_TRUE;
+    }
+
+    self->head = self->tail = NULL;
+
+    Lock_Release(&self->lock);
+
+    Selector_Wakeup(self->selector, MI_TRUE);
+    _ScheduleClose(first);
+
+    /* Wait for all the connections (and the sweeper) to finish */
+    count = self->connections;
+    while (count)
+    {
+        CondLock_Wait((ptrdiff_t)self, &self->connections, count, CONDLOCK_DEFAULT_SPINCOUNT);
+        count = self->connections;
+    }
+}
+
+MI_Result ConnectionPool_Open(
+    ConnectionPool* self,
+    const char* locator,
+    const char* user,
+    const char* password,
+    MI_Uint64 operationId,
+    InteractionOpenParams* params)
+{
+    PooledConnection* connection = NULL;
+    PooledConnection* created = NULL;
+    PooledOperation* operation;
+    MI_Boolean hasCredentials = (user || password) ? MI_TRUE : MI_FALSE;
+    unsigned char credentials[CREDCACHE_HASH_SIZE];
+    MI_Boolean wakeup = MI_FALSE;
+
+    memset(credentials, 0, sizeof(credentials));
+
+    if (hasCredentials &&
+        CredCache_HashUser(user ? user : "", password ? password : "", credentials) != 0)
+    {
+        return MI_RESULT_FAILED;
+    }
+
+    Lock_Acquire(&self->lock);
+
+    connection = _ConnectionPool_Find(self, locator, hasCredentials, credentials);
+
+    if (!connection)
+    {
+        /* Connect without holding the lock (other operations of the pool go
+         * on meanwhile), then look again since another thread may have added
+         * a matching connection in the meantime */
+        Lock_Release(&self->lock);
+
+        created = _PooledConnection_New(self, locator, user, password, hasCredentials, credentials);
+
+        Lock_Acquire(&self->lock);
+
+        if (created)
+        {
+            connection = _ConnectionPool_Find(self, locator, hasCredentials, credentials);
+
+            if (!connection && !self->closing && !created->lost)
+            {
+                List_Append(&self->head, &self->tail, (ListElem*)&created->next);
+                created->listed = MI_TRUE;
+                created->closeScheduled = MI_FALSE;
+                connection = created;
+                created = NULL;
+            }
+            else
+            {
+                /* Not used (or already lost): _PooledConnection_CloseAux
+                 * closes it */
+                created->next = NULL;
+            }
+        }
+    }
+
+    /* Keeps the connection in the pool until the entry is deleted */
+    if (connection)
+        connection->operations++;
+
+    Lock_Release(&self->lock);
+
+    memset(credentials, 0, sizeof(credentials));
+
+    if (created)
+        _ScheduleClose((ListElem*)&created->next);
+
+    if (!connection)
+        return MI_RESULT_FAILED;
+
+    operation = (PooledOperation*)StrandEntry_New(
+                                    STRAND_DEBUG( PooledOperation )
+                                    &connection->strand,
+                                    &_PooledOperation_FT,
+                                    sizeof(PooledOperation),
+                                    0,
+                                    params );
+    if (!operation)
+    {
+        Lock_Acquire(&self->lock);
+        if (--connection->operations == 0 && PAL_TRUE == PAL_Time(&connection->idleSince))
+            wakeup = _ConnectionPool_ArmSweeper(self, connection->idleSince);
+        Lock_Release(&self->lock);
+
+        if (wakeup)
+            Selector_Wakeup(self->selector, MI_FALSE);
+
+        return MI_RESULT_SERVER_LIMITS_EXCEEDED;
+    }
+
+    operation->operationId = operationId;
+    StrandEntry_ScheduleAdd(&operation->strand, NULL);
+
+    return MI_RESULT_OK;
+}
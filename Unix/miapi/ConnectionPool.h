@@ -0,0 +1,88 @@
+/*
+**==============================================================================
+**
+** Copyright (c) Microsoft Corporation. All rights reserved. See file LICENSE
+** for license information.
+**
+**==============================================================================
+*/
+
+#ifndef _miapi_ConnectionPool_h_
+#define _miapi_ConnectionPool_h_
+
+#include <MI.h>
+#include <pal/lock.h>
+#include <base/list.h>
+#include <base/Strand.h>
+#include <sock/selector.h>
+
+/*
+**==============================================================================
+**
+** ConnectionPool
+**
+**     Binary protocol connections of an application, keyed by locator and
+**     credentials. Operations from any session with the same key are
+**     multiplexed over one connection (the server demultiplexes them by
+**     operationId, see base/multiplex.c), so that short-lived sessions do
+**     not pay a connect and authentication round trip per operation.
+**
+**     A connection is removed from the pool as soon as it is lost (its
+**     outstanding operations fail) and it is closed once it has been idle
+**     for CONNECTIONPOOL_IDLE_TIMEOUT_USEC (swept by a selector timeout
+**     handler) or when the application is closed.
+**
+**     The pool does not keep the passwords: connections are matched on a
+**     salted hash of the credentials (see CredCache_HashUser).
+**
+**==============================================================================
+*/
+
+/* Idle connections older than this are closed */
+#define CONNECTIONPOOL_IDLE_TIMEOUT_USEC (30 * 1000000)
+
+/* Operations multiplexed over a connection before another one is opened */
+#define CONNECTIONPOOL_MAX_OPERATIONS 64
+
+typedef struct _ConnectionPool
+{
+    Lock                lock;
+
+    /* Pooled connections (PooledConnection) */
+    ListElem*           head;
+    ListElem*           tail;
+
+    /* Connections not finished yet, including the ones already closing,
+     * plus one while the sweeper is on the selector */
+    volatile ptrdiff_t  connections;
+
+    /* Closes idle connections; fires when the oldest one expires */
+    Selector*           selector;
+    Handler             sweeper;
+    MI_Boolean          closing;
+}
+ConnectionPool;
+
+MI_Result ConnectionPool_Init(
+    _Out_ ConnectionPool* self,
+    _In_  Selector* selector);
+
+/* Closes all the connections and waits for them to finish; all the
+ * operations must have been closed already */
+void ConnectionPool_Destroy(
+    _Inout_ ConnectionPool* self);
+
+/* Accepts the interaction opened by an operation (see Strand_OpenPrepare)
+ * on a pooled connection to 'locator', connecting a new one if needed.
+ * Like ProtocolSocketAndBase_New_Connector, the operation receives a
+ * ProtocolEventConnect control message once the connection is established
+ * and its messages must carry 'operationId'. */
+MI_Result ConnectionPool_Open(
+    _Inout_     ConnectionPool*         self,
+    _In_z_      const char*             locator,
+    _In_opt_z_  const char*             user,
+    _In_opt_z_  const char*             password,
+                MI_Uint64               operationId,
+    _In_        InteractionOpenParams*  params);
+
+#endif /* _miapi_ConnectionPool_h_ */
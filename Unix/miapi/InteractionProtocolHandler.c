@@ -10,6 +10,7 @@
 #include <MI.h>
 #include "InteractionProtocolHandler.h"
 #include "Options.h"
+#include "ConnectionPool.h"
 #include <pal/atomic.h>
 #include <pal/intsafe.h>
 #include <pal/thread.h>
@@ -46,6 +47,7 @@ typedef struct _InteractionProtocolHandler_Application
 {
     MI_Char *applicationID;
     MI_Application myMiApplication;
+    ConnectionPool connectionPool;
 } InteractionProtocolHandler_Application;
 
 typedef void *  SessionCloseCompletionContext;
@@ -337,6 +339,7 @@ static void InteractionProtocolHandler_Operation_Strand_Post( _In_ Strand* self_
             }
 
             operation->currentObjectMessage = operation->cachedResultRequest; /* Needs releasing in Ack() */
+            operation->cachedResultRequest = NULL;
 
             operation->asyncOperationCallbacks.classResult(&operation->myMiOperation, operation->asyncOperationCallbacks.callbackContext, classItem, MI_FALSE, resp->result, resp->errorMessage, resp->cimError, InteractionProtocolHandler_Client_Ack_PostToInteraction);
         }
@@ -349,6 +352,7 @@ static void InteractionProtocolHandler_Operation_Strand_Post( _In_ Strand* self_
                 previousInstance = previousResp->instance;
 
             operation->currentObjectMessage = operation->cachedResultRequest; /* Needs releasing in Ack() */
+            operation->cachedResultRequest = NULL;
 
             operation->asyncOperationCallbacks.instanceResult(&operation->myMiOperation, operation->asyncOperationCallbacks.callbackContext, previousInstance, MI_FALSE, resp->result, resp->errorMessage, resp->cimError, InteractionProtocolHandler_Client_Ack_PostToInteraction);
         }
@@ -556,6 +560,11 @@ static void InteractionProtocolHandler_Operation_Strand_Finish( _In_ Strand* sel
     {
         Message_Release(&operation->req->base);
     }
+    if (operation->cachedResultRequest)
+    {
+        /* Not delivered as the operation was closed first */
+        Message_Release(operation->cachedResultRequest);
+    }
     SessionCloseCompletion_Release(operation->sessionCloseCompletion);
     PAL_Free(operation->protocolConnection);
     PAL_Free(operation);
@@ -1003,10 +1012,14 @@ MI_Result MI_CALL InteractionProtocolHandler_Session_GetApplication(
     }
 }
 
+/* Opens the interaction on a connection of the pool, or on a connection of
+ * its own (stored in 'socket') if 'pool' is NULL */
 static MI_Result _CreateSocketConnector(
+    ConnectionPool *pool,
     ProtocolSocketAndBase **socket,
     Selector *selector,
     InteractionOpenParams *interactionParam,
+    MI_Uint64 operationId,
     const MI_Char *locator,
     MI_DestinationOptions *options)
 {
@@ -1095,13 +1108,26 @@ static MI_Result _CreateSocketConnector(
         }
     }
 
-    r = ProtocolSocketAndBase_New_Connector(
-        socket,
-        selector,
-        locator_,
-        interactionParam,
-        user_,
-        password_);
+    if (pool)
+    {
+        r = ConnectionPool_Open(
+            pool,
+            locator_,
+            user_,
+            password_,
+            operationId,
+            interactionParam);
+    }
+    else
+    {
+        r = ProtocolSocketAndBase_New_Connector(
+            socket,
+            selector,
+            locator_,
+            interactionParam,
+            user_,
+            password_);
+    }
 done:
     PAL_Free(locator_mem);
     PAL_Free(user_);
@@ -1176,10 +1202,23 @@ MI_Result InteractionProtocolHandler_Session_Connect(
 
         if (session->protocolType == PROTOCOL_SOCKET)
         {
+            ConnectionPool* pool = &session->parentApplication->connectionPool;
+
+            // The server does not stamp the subscription results (and
+            // indications) with the operationId of the request, so they
+            // cannot be multiplexed
+            if (operation->req->base.tag == SubscribeReqTag)
+                pool = NULL;
+
+            // Pooled connections are owned by the application
+            operation->protocolConnection->protocol.socket = NULL;
+
             r = _CreateSocketConnector(
+                    pool,
                     &operation->protocolConnection->protocol.socket,
                     &g_globalSelector,
                     &interactionParams,
+                    operation->req->base.operationId,
                     destination,
                     options);
             if (r != MI_RESULT_OK)
@@ -1886,7 +1925,7 @@ void MI_CALL InteractionProtocolHandler_Session_EnumerateInstances(
     {
         MI_Uint32 flag = WSMANFlag;
         if (session->protocolType == PROTOCOL_SOCKET)
-            flag = BinaryProtocolFlag;
+            flag = BinaryProtocolFlag | BinaryCompactInstancesFlag;
 
          req = EnumerateInstancesReq_New(_NextOperationId(), flag);
     }
@@ -1947,7 +1986,7 @@ void MI_CALL InteractionProtocolHandler_Session_QueryInstances(
     {
         MI_Uint32 flag = WSMANFlag;
         if (session->protocolType == PROTOCOL_SOCKET)
-            flag = BinaryProtocolFlag;
+            flag = BinaryProtocolFlag | BinaryCompactInstancesFlag;
 
          req = EnumerateInstancesReq_New(_NextOperationId(), flag);
     }
@@ -2017,7 +2056,7 @@ void MI_CALL InteractionProtocolHandler_Session_AssociatorInstances(
     {
         MI_Uint32 flag = WSMANFlag;
         if (session->protocolType == PROTOCOL_SOCKET)
-            flag = BinaryProtocolFlag;
+            flag = BinaryProtocolFlag | BinaryCompactInstancesFlag;
 
          req = AssociationsOfReq_New(_NextOperationId(), flag, AssociatorsOfReqTag);
     }
@@ -2138,7 +2177,7 @@ void MI_CALL InteractionProtocolHandler_Session_ReferenceInstances(
     {
         MI_Uint32 flag = WSMANFlag;
         if (session->protocolType == PROTOCOL_SOCKET)
-            flag = BinaryProtocolFlag;
+            flag = BinaryProtocolFlag | BinaryCompactInstancesFlag;
 
          req = AssociationsOfReq_New(_NextOperationId(), flag, ReferencesOfReqTag);
     }
@@ -2514,11 +2553,20 @@ MI_Result MI_MAIN_CALL InteractionProtocolHandler_Application_Initialize(MI_Uint
         return MI_RESULT_SERVER_LIMITS_EXCEEDED;
     }
 
+    miResult = ConnectionPool_Init(&application->connectionPool, &g_globalSelector);
+    if (miResult != MI_RESULT_OK)
+    {
+        PAL_Free(application);
+        InteractionProtocolHandler_DeInitializeSelector();
+        return miResult;
+    }
+
     if (applicationID)
     {
         application->applicationID = PAL_Tcsdup(applicationID);
         if (application->applicationID == NULL)
         {
+            ConnectionPool_Destroy(&application->connectionPool);
             PAL_Free(application);
             InteractionProtocolHandler_DeInitializeSelector();
             return MI_RESULT_SERVER_LIMITS_EXCEEDED;
@@ -2541,6 +2589,9 @@ MI_Result MI_CALL InteractionProtocolHandler_Application_Close(
         InteractionProtocolHandler_Application *application = (InteractionProtocolHandler_Application *)miApplication->reserved2;
         if (application)
         {
+            /* All the operations are closed already */
+            ConnectionPool_Destroy(&application->connectionPool);
+
             InteractionProtocolHandler_DeInitializeSelector();
 
             if (application->applicationID)
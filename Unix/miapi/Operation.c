@@ -34,6 +34,29 @@ typedef enum
     OPERATION_INDICATION
 } OPERATATION_TYPE;
 
+/* Maximum number of synchronous instance results received ahead of the client */
+#define OPERATION_PREFETCH_MAX 32
+
+/* The protocol handler may deliver its final result when the operation is
+ * closed or canceled even though the queue is full (see
+ * InteractionProtocolHandler_Operation_Strand_Close), so there is room for it */
+#define OPERATION_PREFETCH_SLOTS (OPERATION_PREFETCH_MAX + 1)
+
+typedef struct _PrefetchedResult
+{
+    const MI_Instance *instance;
+    MI_Boolean moreResults;
+    MI_Result resultCode;
+    const MI_Char *errorString;
+    const MI_Instance *errorDetails;
+
+    /* Instance is a copy, otherwise it belongs to the protocol handler and the
+     * result is acknowledged (resultAcknowledgement) once the client is done
+     * with it */
+    MI_Boolean owned;
+    MI_Result (MI_CALL * resultAcknowledgement)(_In_ MI_Operation *operation);
+} PrefetchedResult;
+
 typedef struct _OperationObject OperationObject;
 struct _OperationObject
 {
@@ -76,6 +99,14 @@ struct _OperationObject
     const MI_Char *errorString;
     const MI_Instance *errorDetails;
 
+    /* Synchronous instance results not yet released by the client (ring buffer,
+     * the first prefetchReturned ones have been returned to the client) */
+    Lock prefetchLock;
+    PrefetchedResult prefetch[OPERATION_PREFETCH_SLOTS];
+    MI_Uint32 prefetchFirst;
+    MI_Uint32 prefetchCount;
+    MI_Uint32 prefetchReturned;
+
     /* State variable to make operation synchronous */
     volatile ptrdiff_t instanceCallbackReceived;
 
@@ -991,18 +1022,62 @@ void MI_CALL Operation_OperationCallback_Instance(
         }
         else
         {
-            /* SYNC behaviour, store and notify potential waiter for results */
-            operationObject->instanceResult = instance;
-            operationObject->moreResults = moreResults;
-            operationObject->resultCode = resultCode;
-            operationObject->errorString = errorString;
-            operationObject->errorDetails = errorDetails;
-            operationObject->ph_instance_resultAcknowledgement = resultAcknowledgement;
-            operationObject->consumedResult = MI_FALSE;
+            /* SYNC behaviour, queue and notify potential waiter for results.
+             * Instances are copied and acknowledged straight away so the protocol
+             * handler can deliver the next ones while the client is busy.  The final
+             * result, results that could not be copied and the result that fills the
+             * queue are acknowledged from result retrieval instead.
+             */
+            MI_Instance *instanceCopy = NULL;
+            MI_Boolean acknowledge = MI_FALSE;
+            PrefetchedResult *prefetched;
+
+            if (moreResults && instance && (resultCode == MI_RESULT_OK))
+            {
+                if (MI_Instance_Clone(instance, &instanceCopy) != MI_RESULT_OK)
+                {
+                    /* Not fatal: the result is delivered without prefetching */
+                    NitsIgnoringError();
+                    instanceCopy = NULL;
+                }
+            }
+
+            Lock_Acquire(&operationObject->prefetchLock);
+
+            prefetched = &operationObject->prefetch[(operationObject->prefetchFirst + operationObject->prefetchCount) % OPERATION_PREFETCH_SLOTS];
+            prefetched->instance = instanceCopy ? instanceCopy : instance;
+            prefetched->moreResults = moreResults;
+            prefetched->resultCode = resultCode;
+            prefetched->errorString = errorString;
+            prefetched->errorDetails = errorDetails;
+            prefetched->owned = (instanceCopy != NULL);
+            prefetched->resultAcknowledgement = NULL;
+            operationObject->prefetchCount++;
+
+            if (!instanceCopy)
+            {
+                prefetched->resultAcknowledgement = resultAcknowledgement;
+            }
+            else if (operationObject->prefetchCount < OPERATION_PREFETCH_MAX)
+            {
+                acknowledge = MI_TRUE;
+            }
+            else
+            {
+                operationObject->ph_instance_resultAcknowledgement = resultAcknowledgement;
+            }
 
             trace_MIClient_OperationInstanceResult_WaitingForClient(operationObject->clientSessionPtr, operationObject->clientOperationPtr, operationObject, resultCode, moreResults?MI_T("TRUE"):MI_T("FALSE"));
             operationObject->instanceCallbackReceived = 1;
+
+            Lock_Release(&operationObject->prefetchLock);
+
             CondLock_Broadcast((ptrdiff_t) operationObject);
+
+            if (acknowledge)
+            {
+                resultAcknowledgement(operation);
+            }
             /* Do rest of work from result retrieval */
         }
     }
@@ -1199,6 +1274,19 @@ void Operation_Destructor(
     /* Unregister self from session */
     OperationObject *operationObject = (OperationObject*) thunkHandle->u.object;
 
+    /* Delete the copies of synchronous results the client did not release */
+    while (operationObject->prefetchCount)
+    {
+        PrefetchedResult *prefetched = &operationObject->prefetch[operationObject->prefetchFirst];
+
+        if (prefetched->owned)
+        {
+            MI_Instance_Delete((MI_Instance *) prefetched->instance);
+        }
+        operationObject->prefetchFirst = (operationObject->prefetchFirst + 1) % OPERATION_PREFETCH_SLOTS;
+        operationObject->prefetchCount--;
+    }
+
     /* Close the protocol handler operation */
     if (operationObject->protocolHandlerOperation.ft)
     {
@@ -1213,6 +1301,47 @@ void Operation_Destructor(
     PAL_Free(operationObject);
 
 }
+/* Acknowledges the synchronous results the protocol handler is still waiting
+ * for: the last one delivered and the ones still queued (the protocol handler
+ * may have queued its final result while an earlier one was not acknowledged
+ * yet, see OPERATION_PREFETCH_SLOTS) */
+static void Operation_AcknowledgeRemaining(
+    _Inout_ OperationObject *operationObject,
+    _In_ MI_Operation *phOperation)
+{
+    MI_Result (MI_CALL * acknowledgements[OPERATION_PREFETCH_SLOTS + 1])(_In_ MI_Operation *operation);
+    MI_Uint32 count = 0;
+    MI_Uint32 index;
+
+    Lock_Acquire(&operationObject->prefetchLock);
+
+    if (operationObject->ph_instance_resultAcknowledgement)
+    {
+        acknowledgements[count++] = operationObject->ph_instance_resultAcknowledgement;
+        operationObject->ph_instance_resultAcknowledgement = NULL;
+    }
+    for (index = 0; index < operationObject->prefetchCount; index++)
+    {
+        PrefetchedResult *prefetched = &operationObject->prefetch[(operationObject->prefetchFirst + index) % OPERATION_PREFETCH_SLOTS];
+
+        if (prefetched->resultAcknowledgement)
+        {
+            acknowledgements[count++] = prefetched->resultAcknowledgement;
+            prefetched->resultAcknowledgement = NULL;
+        }
+    }
+    operationObject->instanceResult = NULL;
+
+    Lock_Release(&operationObject->prefetchLock);
+
+    /* In order, outside of the lock as the protocol handler may deliver more
+     * results on this thread */
+    for (index = 0; index < count; index++)
+    {
+        acknowledgements[index](phOperation);
+    }
+}
+
 /* Close the operation down.  If it is still running it will need to be cancelled.
  * Close is potentially async if the operation has not already completed as it
  * will ensure the callback is called for async or GetInstance/etc is called
@@ -1235,7 +1364,6 @@ MI_Result MI_CALL Operation_Close(
     {
         OperationObject *operationObject = (OperationObject *) thunkHandle->u.object;
         MI_Operation phOperation = operationObject->protocolHandlerOperation;
-        MI_Result (MI_CALL * tmpResultAcknowledgement)(_In_ MI_Operation *operation) = operationObject->ph_instance_resultAcknowledgement;
         MI_CLIENT_IMPERSONATION_TOKEN originalImpersonation = INVALID_HANDLE_VALUE;
 
         //Do access check
@@ -1277,12 +1405,7 @@ MI_Result MI_CALL Operation_Close(
             }
 
             /* ack last data if present in case of syncrhonous */
-            if (tmpResultAcknowledgement)
-            {
-                operationObject->instanceResult = NULL;
-                operationObject->ph_instance_resultAcknowledgement = NULL;
-                tmpResultAcknowledgement(&phOperation);
-            }
+            Operation_AcknowledgeRemaining(operationObject, &phOperation);
         }
 
         //Once we call Shutdown on the thunk handle no operations that try to thunk will fail.  The operation
@@ -1586,6 +1709,7 @@ MI_Result Operation_Execute_SetupOperation(
     memset(*operationObject, 0, sizeof(OperationObject));
 
     (*operationObject)->currentState = RetrievingResults;
+    Lock_Init(&(*operationObject)->prefetchLock);
 
     //Set default Mode for WriteError and PromptUser
     (*operationObject)->writeErrorMode = MI_CALLBACKMODE_REPORT;
@@ -2816,24 +2940,164 @@ void MI_CALL Operation_Execute_TestConnection(
         TerminateProcess(GetCurrentProcess(), -1);
     }
 }
-/* Do synchronous retrieval of results */
-MI_Result MI_CALL Operation_GetInstance_Result(
-    _In_      MI_Operation *operation,
-    _Outptr_result_maybenull_     const MI_Instance **instance,
+/* Hand the queued synchronous instance results over to the client (up to
+ * maxInstances of them, waiting for the first one if needed).  Called with the
+ * final result not consumed yet.  The results returned by the previous call
+ * are released first, acknowledging the protocol handler result if it is
+ * waiting on them (or on the queue to drain).
+ */
+static void Operation_GetInstances_Sync(
+    _In_      OperationObject *operationObject,
+    _In_      ThunkHandle *thunkHandle,
+              MI_Uint32 maxInstances,
+    _Out_writes_to_(maxInstances, *instanceCount) const MI_Instance **instances,
+    _Out_     MI_Uint32 *instanceCount,
     _Out_opt_ MI_Boolean *moreResults,
     _Out_opt_ MI_Result *result,
     _Outptr_opt_result_maybenull_z_ const MI_Char **errorMessage,
     _Outptr_opt_result_maybenull_ const MI_Instance **completionDetails)
 {
-    if ((operation == NULL) || (instance == NULL))
+    MI_Result (MI_CALL * tmpResultAcknowledgement)(_In_ MI_Operation *operation) = NULL;
+    MI_Instance *released[OPERATION_PREFETCH_SLOTS];
+    MI_Uint32 releasedCount = 0;
+    const PrefetchedResult *last = NULL;
+    ptrdiff_t curInstanceCallbackReceived;
+    MI_Uint32 index;
+
+    Lock_Acquire(&operationObject->prefetchLock);
+
+    /* Release the results returned by the previous call */
+    while (operationObject->prefetchReturned)
     {
-        if (result)
-            *result = MI_RESULT_INVALID_PARAMETER;
-        return MI_RESULT_INVALID_PARAMETER;
+        PrefetchedResult *prefetched = &operationObject->prefetch[operationObject->prefetchFirst];
+
+        if (prefetched->owned)
+        {
+            released[releasedCount++] = (MI_Instance *) prefetched->instance;
+        }
+        else
+        {
+            /* Protocol handler is waiting for this one to be acknowledged */
+            tmpResultAcknowledgement = prefetched->resultAcknowledgement;
+            prefetched->resultAcknowledgement = NULL;
+        }
+        operationObject->prefetchFirst = (operationObject->prefetchFirst + 1) % OPERATION_PREFETCH_SLOTS;
+        operationObject->prefetchCount--;
+        operationObject->prefetchReturned--;
+    }
+
+    /* Protocol handler is waiting for the queue to drain (its last result was queued as a copy) */
+    if ((tmpResultAcknowledgement == NULL) && operationObject->ph_instance_resultAcknowledgement &&
+        (operationObject->prefetchCount <= OPERATION_PREFETCH_MAX / 2))
+    {
+        tmpResultAcknowledgement = operationObject->ph_instance_resultAcknowledgement;
+        operationObject->ph_instance_resultAcknowledgement = NULL;
+    }
+
+    Lock_Release(&operationObject->prefetchLock);
+
+    if (tmpResultAcknowledgement)
+    {
+        /* Ack, we can get callback imediately on this thread */
+        tmpResultAcknowledgement(&operationObject->protocolHandlerOperation);
+    }
+    for (index = 0; index < releasedCount; index++)
+    {
+        MI_Instance_Delete(released[index]);
+    }
+
+    /* Wait for new items */
+    Lock_Acquire(&operationObject->prefetchLock);
+    while (operationObject->prefetchCount == 0)
+    {
+        operationObject->instanceCallbackReceived = 0;
+        Lock_Release(&operationObject->prefetchLock);
+
+        curInstanceCallbackReceived = operationObject->instanceCallbackReceived;
+        while (!curInstanceCallbackReceived)
+        {
+            /* 0 is the current value of state, the value we don't want to see. */
+            CondLock_Wait((ptrdiff_t) operationObject, &operationObject->instanceCallbackReceived, curInstanceCallbackReceived, CONDLOCK_DEFAULT_SPINCOUNT);
+            curInstanceCallbackReceived = operationObject->instanceCallbackReceived;
+        }
+
+        Lock_Acquire(&operationObject->prefetchLock);
+    }
+
+    /* We have results, so hand them to the user up to the first one that completes
+     * the operation or carries an error */
+    *instanceCount = 0;
+    while ((operationObject->prefetchReturned < operationObject->prefetchCount) && (*instanceCount < maxInstances))
+    {
+        last = &operationObject->prefetch[(operationObject->prefetchFirst + operationObject->prefetchReturned) % OPERATION_PREFETCH_SLOTS];
+        operationObject->prefetchReturned++;
+
+        if (last->instance)
+        {
+            instances[(*instanceCount)++] = last->instance;
+        }
+        if (!last->moreResults || (last->resultCode != MI_RESULT_OK))
+        {
+            break;
+        }
+    }
+
+    if (moreResults)
+    {
+        *moreResults = last->moreResults;
+    }
+    if (result)
+    {
+        *result = last->resultCode;
+    }
+    if (errorMessage)
+    {
+        *errorMessage = last->errorString;
+    }
+    if (completionDetails)
+    {
+        *completionDetails = last->errorDetails;
+    }
+
+    trace_MIClient_OperationInstancResultSync(operationObject->clientSessionPtr, operationObject->clientOperationPtr, operationObject, last->resultCode, last->moreResults?MI_T("TRUE"):MI_T("FALSE"));
+
+    if (!last->moreResults)
+    {
+        /* Final result stays queued until the operation is closed, which acknowledges it */
+        operationObject->instanceResult = last->instance;
+        operationObject->resultCode = last->resultCode;
+
+        Lock_Release(&operationObject->prefetchLock);
+
+        operationObject->consumedFinalResult = MI_TRUE;
+        operationObject->currentState = Completed;
+
+        //Some threads may be waiting on this notification so wake them up
+        CondLock_Broadcast((ptrdiff_t)&operationObject->consumedFinalResult);
+
+        //No more results, so release the refcount we have for final result
+        ThunkHandle_Release(thunkHandle);
+    }
+    else
+    {
+        Lock_Release(&operationObject->prefetchLock);
     }
+}
 
+/* Do synchronous retrieval of results */
+static MI_Result Operation_GetInstances_Common(
+    _In_      MI_Operation *operation,
+              MI_Uint32 maxInstances,
+    _Out_writes_to_(maxInstances, *instanceCount) const MI_Instance **instances,
+    _Out_     MI_Uint32 *instanceCount,
+    _Out_opt_ MI_Boolean *moreResults,
+    _Out_opt_ MI_Result *result,
+    _Outptr_opt_result_maybenull_z_ const MI_Char **errorMessage,
+    _Outptr_opt_result_maybenull_ const MI_Instance **completionDetails)
+{
     /* Zero out parameters */
-    *instance = NULL;
+    *instances = NULL;
+    *instanceCount = 0;
 
     if (moreResults)
     {
@@ -2862,7 +3126,6 @@ MI_Result MI_CALL Operation_GetInstance_Result(
         if (thunkHandle != NULL)
         {
             OperationObject *operationObject = (OperationObject *) thunkHandle->u.object;
-            ptrdiff_t curInstanceCallbackReceived;
             MI_CLIENT_IMPERSONATION_TOKEN originalImpersonation = INVALID_HANDLE_VALUE;
 
             returnValue = Session_AccessCheck(&operationObject->clientSession, MI_T("get operation's instance result"));
@@ -2887,65 +3150,7 @@ MI_Result MI_CALL Operation_GetInstance_Result(
             {
                 if(operationObject->consumedFinalResult == MI_FALSE)
                 {
-                    if (operationObject->consumedResult)
-                    {
-                        /* We need to acknowledge the current item, reset the state and wait for the next item
-                         * to be retrieved
-                         */
-                        MI_Result (MI_CALL * tmpResultAcknowledgement)(_In_ MI_Operation *operation) = operationObject->ph_instance_resultAcknowledgement;
-                        operationObject->ph_instance_resultAcknowledgement = NULL; /* Calling ack so clear it out */
-                        operationObject->instanceResult = NULL; /* Ack-ing result so wipe it out */
-                        operationObject->consumedResult = MI_FALSE; /* Reset consumped result as we have not consumed the one we have not got yet */
-                        operationObject->instanceCallbackReceived = 0; /* Reset the callback receieved as we need to get the next one */
-                        tmpResultAcknowledgement(&operationObject->protocolHandlerOperation); /* Ack, we can get callback imediately on this thread, unwind and process next imediately */
-
-                        /* Now we are ready to get more results */
-                    }
-
-                    /* Wait for new item */
-                    curInstanceCallbackReceived = operationObject->instanceCallbackReceived;
-                    while (!curInstanceCallbackReceived)
-                    {
-                        /* 0 is the current value of state, the value we don't want to see. */
-                        CondLock_Wait((ptrdiff_t) operationObject, &operationObject->instanceCallbackReceived, curInstanceCallbackReceived, CONDLOCK_DEFAULT_SPINCOUNT);
-                        curInstanceCallbackReceived = operationObject->instanceCallbackReceived;
-                    }
-
-                    /* We have result, so fill in out parameters and return them to the user */
-                    *instance = operationObject->instanceResult;
-                    if (moreResults)
-                    {
-                        *moreResults = operationObject->moreResults;
-                    }
-                    if (result)
-                    {
-                        *result = operationObject->resultCode;
-                    }
-                    if (errorMessage)
-                    {
-                        *errorMessage = operationObject->errorString;
-                    }
-                    if (completionDetails)
-                    {
-                        *completionDetails = operationObject->errorDetails;
-                    }
-
-                    /* These results got consumed by this call */
-                    operationObject->consumedResult = MI_TRUE;
-
-                    if (!operationObject->moreResults)
-                    {
-                        operationObject->consumedFinalResult = MI_TRUE;
-                        operationObject->currentState = Completed;
-
-                        //Some threads may be waiting on this notification so wake them up
-                        CondLock_Broadcast((ptrdiff_t)&operationObject->consumedFinalResult);
-
-                        //No more results, so release the refcount we have for final result
-                        ThunkHandle_Release(thunkHandle);
-                    }
-
-                    trace_MIClient_OperationInstancResultSync(operationObject->clientSessionPtr, operationObject->clientOperationPtr, operationObject, operationObject->resultCode, operationObject->moreResults?MI_T("TRUE"):MI_T("FALSE"));
+                    Operation_GetInstances_Sync(operationObject, thunkHandle, maxInstances, instances, instanceCount, moreResults, result, errorMessage, completionDetails);
                 }
                 else
                 {
@@ -2985,6 +3190,87 @@ MI_Result MI_CALL Operation_GetInstance_Result(
     }
 }
 
+MI_Result MI_CALL Operation_GetInstance_Result(
+    _In_      MI_Operation *operation,
+    _Outptr_result_maybenull_     const MI_Instance **instance,
+    _Out_opt_ MI_Boolean *moreResults,
+    _Out_opt_ MI_Result *result,
+    _Outptr_opt_result_maybenull_z_ const MI_Char **errorMessage,
+    _Outptr_opt_result_maybenull_ const MI_Instance **completionDetails)
+{
+    MI_Uint32 instanceCount;
+
+    if ((operation == NULL) || (instance == NULL))
+    {
+        if (result)
+            *result = MI_RESULT_INVALID_PARAMETER;
+        return MI_RESULT_INVALID_PARAMETER;
+    }
+
+    return Operation_GetInstances_Common(operation, 1, instance, &instanceCount, moreResults, result, errorMessage, completionDetails);
+}
+
+MI_Result MI_CALL Operation_GetInstances_Result(
+    _In_      MI_Operation *operation,
+              MI_Uint32 maxInstances,
+    _Out_writes_to_(maxInstances, *instanceCount) const MI_Instance **instances,
+    _Out_     MI_Uint32 *instanceCount,
+    _Out_opt_ MI_Boolean *moreResults,
+    _Out_opt_ MI_Result *result,
+    _Outptr_opt_result_maybenull_z_ const MI_Char **errorMessage,
+    _Outptr_opt_result_maybenull_ const MI_Instance **completionDetails)
+{
+    if (instanceCount)
+    {
+        *instanceCount = 0;
+    }
+    if ((operation == NULL) || (instances == NULL) || (instanceCount == NULL) || (maxInstances == 0))
+    {
+        if (result)
+            *result = MI_RESULT_INVALID_PARAMETER;
+        return MI_RESULT_INVALID_PARAMETER;
+    }
+
+    return Operation_GetInstances_Common(operation, maxInstances, instances, instanceCount, moreResults, result, errorMessage, completionDetails);
+}
+
+/*=============================================================================================
+ * PUBLIC: MI_Operation_GetInstances. Operations created by this library hand over their
+ * queued results in batches; any other operation returns one instance per call through
+ * its GetInstance function.
+ *=============================================================================================
+ */
+MI_LINKAGE MI_Result MI_MAIN_CALL MI_Operation_GetInstancesV1(
+    _In_      MI_Operation *operation,
+              MI_Uint32 maxInstances,
+    _Out_writes_to_(maxInstances, *instanceCount) const MI_Instance **instances,
+    _Out_     MI_Uint32 *instanceCount,
+    _Out_opt_ MI_Boolean *moreResults,
+    _Out_opt_ MI_Result *result,
+    _Outptr_opt_result_maybenull_z_ const MI_Char **errorMessage,
+    _Outptr_opt_result_maybenull_ const MI_Instance **completionDetails)
+{
+    if (operation && (operation->ft == &g_operationFT))
+    {
+        return Operation_GetInstances_Result(operation, maxInstances, instances, instanceCount, moreResults, result, errorMessage, completionDetails);
+    }
+    if (operation && operation->ft && instances && instanceCount && maxInstances)
+    {
+        MI_Result returnValue;
+
+        returnValue = operation->ft->GetInstance(operation, instances, moreResults, result, errorMessage, completionDetails);
+        *instanceCount = (instances[0] != NULL) ? 1 : 0;
+        return returnValue;
+    }
+    if (instanceCount)
+        *instanceCount = 0;
+    if (result)
+        *result = MI_RESULT_INVALID_PARAMETER;
+    if (moreResults)
+        *moreResults = MI_FALSE;
+    return MI_RESULT_INVALID_PARAMETER;
+}
+
 MI_Result MI_CALL Operation_GetIndication_Result(
     _In_      MI_Operation *operation,
     _Outptr_result_maybenull_       const MI_Instance **instance,
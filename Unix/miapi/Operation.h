@@ -27,6 +27,15 @@ MI_Result MI_CALL Operation_GetInstance_Result(
     _Out_opt_ MI_Result *result,
     _Outptr_opt_result_maybenull_z_ const MI_Char **errorMessage,
     _Outptr_opt_result_maybenull_ const MI_Instance **completionDetails);
+MI_Result MI_CALL Operation_GetInstances_Result(
+    _In_      MI_Operation *operation,
+              MI_Uint32 maxInstances,
+    _Out_writes_to_(maxInstances, *instanceCount) const MI_Instance **instances,
+    _Out_     MI_Uint32 *instanceCount,
+    _Out_opt_ MI_Boolean *moreResults,
+    _Out_opt_ MI_Result *result,
+    _Outptr_opt_result_maybenull_z_ const MI_Char **errorMessage,
+    _Outptr_opt_result_maybenull_ const MI_Instance **completionDetails);
 MI_Result MI_CALL Operation_GetIndication_Result(
     _In_      MI_Operation *operation,
     _Outptr_result_maybenull_       const MI_Instance **instance,
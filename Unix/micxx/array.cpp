@@ -175,6 +175,46 @@ static void Release(void* v_this, const ArrayTraits* v_traits)
     }
 }
 
+// Makes the buffer unshared with room for 'capacity' elements; when 'grow' is
+// set, an outgrown buffer at least doubles so that adding the elements one at
+// a time relocates them a logarithmic number of times
+static void _Reserve(void* v_this, const ArrayTraits* v_traits, MI_Uint32 capacity, MI_Boolean grow)
+{
+    Array_data* v = (Array_data*)v_this;
+    MI_Boolean shared = v->p && Atomic_Read(&GetHeader(v->p)->m_refCounter) != 1;
+
+    if (!shared && (v->p ? GetHeader(v->p)->m_capacity : 0) >= capacity)
+        return;
+
+    if (capacity < v->size)
+        capacity = v->size;
+
+    if (grow && v->p && !shared && capacity < 2 * GetHeader(v->p)->m_capacity)
+        capacity = 2 * GetHeader(v->p)->m_capacity;
+
+    void* new_data = Allocate(capacity,v_traits);
+
+    if (shared)
+    {
+        if (v_traits->copy_ctor)
+            v_traits->copy_ctor(new_data,v->p,v->size);
+        else
+            memcpy(new_data,v->p,v->size*v_traits->size);
+
+        Release(v_this,v_traits);
+    }
+    else if (v->p)
+    {
+        if (v->size)
+            memcpy(new_data,v->p,v->size * v_traits->size);
+
+        operator delete(GetHeader(v->p));
+    }
+
+    v->p = new_data;
+    AddRef(v->p);
+}
+
 // Array class implementation - taken out to reduce code size
 void __ArrayCopyCtor(void* v_this, const ArrayTraits* v_traits, const void* v_obj, MI_Uint32 count)
 {
@@ -242,23 +282,8 @@ void __ArrayResize(void* v_this, const ArrayTraits* v_traits, const void* v_obj,
     //      cow()
     //      re-alloc
 
-    // make own copy
-    __ArrayCOW(v_this,v_traits);
-
-
-    // see if we need to re-alloc
-    if ( !v->p || GetHeader(v->p)->m_capacity < new_size)
-    {
-        void* new_data = Allocate(new_size,v_traits);
-        if (v->size)
-            memcpy(new_data,v->p,v->size * v_traits->size);
-
-        if (v->p)
-            operator delete(GetHeader(v->p));
-
-        v->p = new_data;
-        AddRef(v->p);
-    }
+    // make own copy, re-alloc if needed
+    _Reserve(v_this,v_traits,new_size,MI_TRUE);
 
     // delete extra
     if ( v->size > new_size && v_traits->dtor )
@@ -305,5 +330,37 @@ void __ArrayDelete(void* v_this, const ArrayTraits* v_traits, MI_Uint32 index)
     v->size --;
 }
 
+void __ArrayReserve(void* v_this, const ArrayTraits* v_traits, MI_Uint32 capacity, MI_Boolean grow)
+{
+    _Reserve(v_this,v_traits,capacity,grow);
+}
+
+void __ArrayAppend(void* v_this, const ArrayTraits* v_traits, const void* v_obj, MI_Uint32 count)
+{
+    Array_data* v = (Array_data*)v_this;
+    const char* src = (const char*)v_obj;
+
+    if (!count)
+        return;
+
+    // the elements may come from this very array
+    if (v->p && src >= (char*)v->p && src < (char*)v->p + v->size*v_traits->size)
+    {
+        size_t offset = src - (char*)v->p;
+        _Reserve(v_this,v_traits,v->size + count,MI_TRUE);
+        src = (char*)v->p + offset;
+    }
+    else
+    {
+        _Reserve(v_this,v_traits,v->size + count,MI_TRUE);
+    }
+
+    if (v_traits->copy_ctor)
+        v_traits->copy_ctor(((char*)v->p) + v->size*v_traits->size,src,count);
+    else
+        memcpy(((char*)v->p) + v->size*v_traits->size,src,count*v_traits->size);
+
+    v->size += count;
+}
 
 MI_END_NAMESPACE
@@ -11,6 +11,10 @@
 #define _micxx_array_h
 
 #include <new>
+#include "linkage.h"
+#if MICXX_HAVE_MOVE
+# include <utility>
+#endif
 #include "atomic.h"
 #include "memory.h"
 #include "arraytraits.h"
@@ -32,6 +36,12 @@ public:
 
     Array& operator=(const Array<TYPE>& x);
 
+#if MICXX_HAVE_MOVE
+    Array(Array<TYPE>&& x);
+
+    Array& operator=(Array<TYPE>&& x);
+#endif
+
     MI_Uint32 GetSize() const;
 
     const TYPE* GetData() const;
@@ -52,6 +62,24 @@ public:
     /* ATTN: Can we rename of "PushBack" */
     void PushBack(const TYPE& item);
 
+#if MICXX_HAVE_MOVE
+    void PushBack(TYPE&& item);
+
+    /* Constructs the new last element in place from 'args' */
+    template<class... ARGS>
+    void EmplaceBack(ARGS&&... args);
+#endif
+
+    /* Makes room for 'capacity' elements so that growing up to it does
+       not reallocate */
+    void Reserve(MI_Uint32 capacity);
+
+    /* Replaces the elements with (Assign) or appends (Append) the 'size'
+       elements at 'data' */
+    void Assign(const TYPE* data, MI_Uint32 size);
+
+    void Append(const TYPE* data, MI_Uint32 size);
+
 private:
 
     void cow();
@@ -94,6 +122,12 @@ MI_EXTERN_C MICXX_LINKAGE void __ArrayResize(void* v_this,
 MI_EXTERN_C MICXX_LINKAGE void __ArrayDelete(void* v_this, 
     const ArrayTraits* v_traits, MI_Uint32 index);
 
+MI_EXTERN_C MICXX_LINKAGE void __ArrayReserve(void* v_this, 
+    const ArrayTraits* v_traits, MI_Uint32 capacity, MI_Boolean grow);
+
+MI_EXTERN_C MICXX_LINKAGE void __ArrayAppend(void* v_this, 
+    const ArrayTraits* v_traits, const void* v_obj, MI_Uint32 count);
+
 template<class TYPE>
 inline Array<TYPE>::Array() : m_data(0), m_size(0) 
 {
@@ -175,6 +209,29 @@ inline Array<TYPE>& Array<TYPE>::operator=(const Array<TYPE>& x)
     return *this;
 }
 
+#if MICXX_HAVE_MOVE
+template<class TYPE>
+inline Array<TYPE>::Array(Array<TYPE>&& x) : m_data(x.m_data), m_size(x.m_size)
+{
+    x.m_data = 0;
+    x.m_size = 0;
+}
+
+template<class TYPE>
+inline Array<TYPE>& Array<TYPE>::operator=(Array<TYPE>&& x)
+{
+    if (this != &x)
+    {
+        __ArrayAssign(this,traits(),0);
+        m_data = x.m_data;
+        m_size = x.m_size;
+        x.m_data = 0;
+        x.m_size = 0;
+    }
+    return *this;
+}
+#endif
+
 template<class TYPE>
 inline void Array<TYPE>::cow()
 {
@@ -188,6 +245,53 @@ inline void Array<TYPE>::PushBack(const TYPE& item)
     Resize(GetSize() + 1, item);
 }
 
+#if MICXX_HAVE_MOVE
+template<class TYPE>
+inline void Array<TYPE>::PushBack(TYPE&& item)
+{
+    EmplaceBack(std::move(item));
+}
+
+template<class TYPE>
+template<class... ARGS>
+inline void Array<TYPE>::EmplaceBack(ARGS&&... args)
+{
+    if (m_data && AtomicGet(GetHeader(m_data)->m_refCounter) == 1 &&
+        GetHeader(m_data)->m_capacity > m_size)
+    {
+        new(m_data + m_size) TYPE(std::forward<ARGS>(args)...);
+    }
+    else
+    {
+        /* 'args' may refer to the elements of the buffer being replaced */
+        TYPE item(std::forward<ARGS>(args)...);
+
+        __ArrayReserve(this, traits(), m_size + 1, MI_TRUE);
+        new(m_data + m_size) TYPE(std::move(item));
+    }
+    m_size++;
+}
+#endif
+
+template<class TYPE>
+inline void Array<TYPE>::Reserve(MI_Uint32 capacity)
+{
+    __ArrayReserve(this, traits(), capacity, MI_FALSE);
+}
+
+template<class TYPE>
+inline void Array<TYPE>::Assign(const TYPE* data, MI_Uint32 size)
+{
+    Array<TYPE> x(data, size);
+    __ArrayAssign(this, traits(), &x);
+}
+
+template<class TYPE>
+inline void Array<TYPE>::Append(const TYPE* data, MI_Uint32 size)
+{
+    __ArrayAppend(this, traits(), data, size);
+}
+
 template<class TYPE>
 inline void Array<TYPE>::Resize(MI_Uint32 size, const TYPE& item)
 {
@@ -11,6 +11,10 @@
 #define _micxx_field_h
 
 #include <MI.h>
+#include "linkage.h"
+#if MICXX_HAVE_MOVE
+# include <utility>
+#endif
 
 MI_BEGIN_NAMESPACE
 
@@ -31,6 +35,12 @@ public:
 
     void Set(const TYPE& x);
 
+#if MICXX_HAVE_MOVE
+    explicit Field(TYPE&& x);
+
+    void Set(TYPE&& x);
+#endif
+
     void Clear();
 
     bool Equal(const Field<TYPE>& x) const;
@@ -59,6 +69,21 @@ inline void Field<TYPE>::Set(const TYPE& x)
     exists = MI_TRUE;
 }
 
+#if MICXX_HAVE_MOVE
+template<class TYPE>
+inline Field<TYPE>::Field(TYPE&& x) : 
+    value(std::move(x)), exists(MI_TRUE), flags(0)
+{
+}
+
+template<class TYPE>
+inline void Field<TYPE>::Set(TYPE&& x)
+{
+    value = std::move(x);
+    exists = MI_TRUE;
+}
+#endif
+
 template<class TYPE>
 inline void Field<TYPE>::Clear()
 {
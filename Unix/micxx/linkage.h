@@ -21,4 +21,14 @@
 #define MI_BEGIN_NAMESPACE namespace mi {
 #define MI_END_NAMESPACE }
 
+/* Move constructors and assignments (C++11); they are all inline so the */
+/* exported symbols and the layouts shared with "C" do not depend on it */
+#ifndef MICXX_HAVE_MOVE
+# if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1800)
+#  define MICXX_HAVE_MOVE 1
+# else
+#  define MICXX_HAVE_MOVE 0
+# endif
+#endif
+
 #endif /* _micxx_linkage_h */
@@ -28,12 +28,24 @@ public:
 
     String(const String& x);
 
+#if MICXX_HAVE_MOVE
+    String(String&& x);
+#endif
+
     ~String();
 
     void Clear();
 
     String& operator=(const String& x);
 
+#if MICXX_HAVE_MOVE
+    String& operator=(String&& x);
+#endif
+
+    // Makes room for 'capacity' characters (not counting the terminating
+    // zero) so that appending up to it does not reallocate
+    void Reserve(MI_Uint32 capacity);
+
     String& operator+=(const String& x);
 
     String& operator+=(const MI_Char* str);
@@ -103,6 +115,24 @@ inline String::String(const String& x)
     AddRef();
 }
 
+#if MICXX_HAVE_MOVE
+inline String::String(String&& x) : m_data(x.m_data)
+{
+    x.m_data = 0;
+}
+
+inline String& String::operator=(String&& x)
+{
+    if ( this != &x )
+    {
+        Release();
+        m_data = x.m_data;
+        x.m_data = 0;
+    }
+    return *this;
+}
+#endif
+
 inline String::~String()
 {
     Release();
@@ -174,21 +174,56 @@ String& String::operator+=(const MI_Char ch)
     return operator+=(buf);
 }
 
+void String::Reserve(MI_Uint32 capacity)
+{
+    MI_Uint32 size = GetSize();
+
+    if ( m_data &&
+        AtomicGet(GetHeader(m_data)->m_refCounter) == 1 &&
+        GetHeader(m_data)->m_capacity > capacity )
+        return;
+
+    if ( capacity < size )
+        capacity = size;
+
+    MI_Char* new_buf = Allocate( capacity + 1 );
+
+    if ( m_data )
+        memcpy(new_buf,m_data,size * sizeof(MI_Char) );
+    new_buf[size] = 0;
+    GetHeader(new_buf)->m_size = size;
+
+    Release();
+    m_data = new_buf;
+    AddRef();
+}
+
 String& String::StrCat(const MI_Char* str, MI_Uint32 size)
 {
     // nothing to change
     if ( !size )
         return *this;
 
+    MI_Uint32 old_size = GetHeader(m_data)->m_size;
+
     if ( AtomicGet(GetHeader(m_data)->m_refCounter) != 1 ||
-        GetHeader(m_data)->m_capacity <= (size + GetHeader(m_data)->m_size)
+        GetHeader(m_data)->m_capacity <= (size + old_size)
         )
-    {   // have to allocate a new buffer
-        MI_Char* new_buf = Allocate( GetHeader(m_data)->m_size + size + 1 );
+    {   // have to allocate a new buffer; grow an unshared one geometrically
+        // so that repeated appends copy the string a logarithmic number of
+        // times
+        MI_Uint32 capacity = old_size + size + 1;
+
+        if ( AtomicGet(GetHeader(m_data)->m_refCounter) == 1 &&
+            capacity < 2 * GetHeader(m_data)->m_capacity )
+            capacity = 2 * GetHeader(m_data)->m_capacity;
+
+        MI_Char* new_buf = Allocate( capacity );
 
-        memcpy(new_buf,m_data,GetHeader(m_data)->m_size * sizeof(MI_Char) );
-        memcpy(new_buf+GetHeader(m_data)->m_size,str,(size+1) * sizeof(MI_Char) );
-        GetHeader(new_buf)->m_size = GetHeader(m_data)->m_size + size;
+        memcpy(new_buf,m_data,old_size * sizeof(MI_Char) );
+        memcpy(new_buf+old_size,str,size * sizeof(MI_Char) );
+        new_buf[old_size + size] = 0;
+        GetHeader(new_buf)->m_size = old_size + size;
 
         Release();
         m_data = new_buf;
@@ -196,7 +231,8 @@ String& String::StrCat(const MI_Char* str, MI_Uint32 size)
     } 
     else 
     {
-        memcpy(m_data+GetHeader(m_data)->m_size,str,(size+1) * sizeof(MI_Char) );
+        memcpy(m_data+old_size,str,size * sizeof(MI_Char) );
+        m_data[old_size + size] = 0;
         GetHeader(m_data)->m_size += size;
     }
 
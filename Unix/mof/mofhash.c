@@ -0,0 +1,127 @@
+/*
+**==============================================================================
+**
+** Copyright (c) Microsoft Corporation. All rights reserved. See file LICENSE
+** for license information.
+**
+**==============================================================================
+*/
+
+#include <string.h>
+#include <pal/strings.h>
+#include "mofhash.h"
+#include "types.h"
+#include "state.h"
+
+#define MOF_STRINGHASH_INITIAL_SIZE 64
+
+/* FNV-1a of the lower-case name */
+static MI_Uint32 _Hash(const char* name)
+{
+    MI_Uint32 h = 2166136261u;
+
+    for (; *name; name++)
+    {
+        unsigned char c = (unsigned char)*name;
+
+        if (c >= 'A' && c <= 'Z')
+            c += 'a' - 'A';
+
+        h = (h ^ c) * 16777619u;
+    }
+
+    return h;
+}
+
+static int _Resize(MOF_StringHash* self, MI_Uint32 size)
+{
+    MOF_StringHashNode** buckets;
+    MI_Uint32 i;
+
+    buckets = (MOF_StringHashNode**)MOF_Calloc(&state.heap, size,
+        sizeof(MOF_StringHashNode*));
+
+    if (!buckets)
+    {
+        yyerrorf(ID_OUT_OF_MEMORY, "out of memory");
+        return -1;
+    }
+
+    for (i = 0; i < self->size; i++)
+    {
+        MOF_StringHashNode* p = self->buckets[i];
+
+        while (p)
+        {
+            MOF_StringHashNode* next = p->next;
+            MI_Uint32 h = p->code & (size - 1);
+            p->next = buckets[h];
+            buckets[h] = p;
+            p = next;
+        }
+    }
+
+    MOF_Free(&state.heap, self->buckets);
+    self->buckets = buckets;
+    self->size = size;
+    return 0;
+}
+
+int MOF_StringHash_Add(
+    MOF_StringHash* self,
+    const char* name,
+    MI_Uint32 pos)
+{
+    MOF_StringHashNode* node;
+    MI_Uint32 h;
+
+    if (self->count >= self->size)
+    {
+        if (_Resize(self, self->size ?
+            self->size * 2 : MOF_STRINGHASH_INITIAL_SIZE) != 0)
+        {
+            return -1;
+        }
+    }
+
+    node = (MOF_StringHashNode*)MOF_Malloc(&state.heap,
+        sizeof(MOF_StringHashNode));
+
+    if (!node)
+    {
+        yyerrorf(ID_OUT_OF_MEMORY, "out of memory");
+        return -1;
+    }
+
+    node->name = name;
+    node->code = _Hash(name);
+    node->pos = pos;
+
+    h = node->code & (self->size - 1);
+    node->next = self->buckets[h];
+    self->buckets[h] = node;
+    self->count++;
+
+    return 0;
+}
+
+MI_Uint32 MOF_StringHash_Find(
+    const MOF_StringHash* self,
+    const char* name)
+{
+    MOF_StringHashNode* p;
+    MI_Uint32 code;
+
+    if (!self->size)
+        return MOF_STRINGHASH_NOT_FOUND;
+
+    code = _Hash(name);
+
+    for (p = self->buckets[code & (self->size - 1)]; p; p = p->next)
+    {
+        if (p->code == code && Strcasecmp(p->name, name) == 0)
+            return p->pos;
+    }
+
+    return MOF_STRINGHASH_NOT_FOUND;
+}
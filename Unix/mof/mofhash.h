@@ -0,0 +1,66 @@
+/*
+**==============================================================================
+**
+** Copyright (c) Microsoft Corporation. All rights reserved. See file LICENSE
+** for license information.
+**
+**==============================================================================
+*/
+
+#ifndef _mof_mofhash_h
+#define _mof_mofhash_h
+
+#ifndef MI_CHAR_TYPE
+# define MI_CHAR_TYPE 1
+#endif
+
+#include <MI.h>
+#include <stddef.h>
+
+/*
+**==============================================================================
+**
+** MOF_StringHash
+**
+**     Case-insensitive index of the names of a declaration list (such as
+**     MOF_ClassDeclList): maps each name to its position in the list so that
+**     the parser finds class and qualifier declarations in constant time
+**     rather than by scanning the list (which made compiling a schema with
+**     thousands of classes quadratic). The buckets are allocated on the
+**     parser heap and double whenever the table holds more names than
+**     buckets.
+**
+**==============================================================================
+*/
+
+#define MOF_STRINGHASH_NOT_FOUND 0xFFFFFFFF
+
+typedef struct _MOF_StringHashNode
+{
+    struct _MOF_StringHashNode* next;
+    const char* name;
+    MI_Uint32 code;
+    MI_Uint32 pos;
+}
+MOF_StringHashNode;
+
+typedef struct _MOF_StringHash
+{
+    MOF_StringHashNode** buckets;
+    MI_Uint32 size;
+    MI_Uint32 count;
+}
+MOF_StringHash;
+
+/* Add 'name' (which must outlive the table) at position 'pos' */
+extern int MOF_StringHash_Add(
+    MOF_StringHash* self,
+    const char* name,
+    MI_Uint32 pos);
+
+/* Return the position of 'name' or MOF_STRINGHASH_NOT_FOUND */
+extern MI_Uint32 MOF_StringHash_Find(
+    const MOF_StringHash* self,
+    const char* name);
+
+#endif /* _mof_mofhash_h */
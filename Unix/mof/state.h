@@ -12,6 +12,7 @@
 
 #include "heap.h"
 #include "ptrarray.h"
+#include "mofhash.h"
 #include "types.h"
 
 #define MOF_MAX_PATHS 16
@@ -48,12 +49,18 @@ typedef struct _MOF_State
     /* Maintains a list of class declarations processed during parsing */
     MOF_ClassDeclList classDecls;
 
+    /* Index of classDecls by class name */
+    MOF_StringHash classDeclsHash;
+
     /* Maintains a list of instance declarations processed during parsing */
     MOF_InstanceDeclList instanceDecls;
 
     /* Maintains a list of qualifier declarations processed during parsing */
     MOF_QualifierDeclList qualifierDecls;
 
+    /* Index of qualifierDecls by qualifier name */
+    MOF_StringHash qualifierDeclsHash;
+
     /* Track of EmbeddedInstances qualifiers for post processing */
     MOF_EmbeddedInstanceList embeddedInstanceList;
 
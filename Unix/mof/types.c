@@ -1873,13 +1873,10 @@ void PrintValue(const void* value, MI_Type type, FILE* file)
 
 const MI_QualifierDecl* FindQualifierDeclaration(const char* name)
 {
-    size_t i;
+    MI_Uint32 pos = MOF_StringHash_Find(&state.qualifierDeclsHash, name);
 
-    for (i = 0; i < state.qualifierDecls.size; i++)
-    {
-        if (Strcasecmp(state.qualifierDecls.data[i]->name, name) == 0)
-            return state.qualifierDecls.data[i];
-    }
+    if (pos != MOF_STRINGHASH_NOT_FOUND)
+        return state.qualifierDecls.data[pos];
 
     /* Not found */
     return NULL;
@@ -1922,19 +1919,19 @@ int AddQualifierDeclaration(MI_QualifierDecl* qd)
     }
 
     /* Add the declaration */
-    PtrArray_Append((PtrArray*)&state.qualifierDecls, qd);
-    return 0;
+    if (PtrArray_Append((PtrArray*)&state.qualifierDecls, qd) != 0)
+        return -1;
+
+    return MOF_StringHash_Add(&state.qualifierDeclsHash, qd->name,
+        state.qualifierDecls.size - 1);
 }
 
 const MI_ClassDecl* FindClassDecl(const char* name)
 {
-    size_t i;
+    MI_Uint32 pos = MOF_StringHash_Find(&state.classDeclsHash, name);
 
-    for (i = 0; i < state.classDecls.size; i++)
-    {
-        if (Strcasecmp(state.classDecls.data[i]->name, name) == 0)
-            return state.classDecls.data[i];
-    }
+    if (pos != MOF_STRINGHASH_NOT_FOUND)
+        return state.classDecls.data[pos];
 
     /* Not found */
     return NULL;
@@ -1950,8 +1947,11 @@ int AddClassDecl(MI_ClassDecl* qd)
     }
 
     /* Add the declaration */
-    PtrArray_Append((PtrArray*)&state.classDecls, qd);
-    return 0;
+    if (PtrArray_Append((PtrArray*)&state.classDecls, qd) != 0)
+        return -1;
+
+    return MOF_StringHash_Add(&state.classDeclsHash, qd->name,
+        state.classDecls.size - 1);
 }
 
 void PrintQualifier(const MI_Qualifier* self, size_t level, FILE* file)
@@ -13,6 +13,7 @@
 #include "OIParser.h"
 #include "FileGen.h"
 #include "EmptyGen.h"
+#include "BinaryGen.h"
 #if !defined(CONFIG_POSIX)
 # include "EtwGen.h"
 # include "ManifestGen.h"
@@ -41,6 +42,8 @@ int main(int argc, char** argv)
 #define SYSLOG_MODE "SYSLOG"
 #define ETW_MODE "ETW"
 #define NOOP_MODE "NOOP"
+#define BINARY_MODE "BINARY"
+#define DECODE_MODE "DECODE"
 
 static const char HELP[] = "\
 Open Instrumentation Generator \n\
@@ -56,7 +59,7 @@ This generator reads annotated header file, and outputs:\n\
 Usage:\n\
 \n\
     oigenc.exe <mode> <more options>\n\
-        where <mode> = ETW, SYSLOG, FILE, NOOP\n\
+        where <mode> = ETW, SYSLOG, FILE, NOOP, BINARY, DECODE\n\
 \n\
 For ETW (Windows):\n\
     oigenc.exe " ETW_MODE " <headerFile> <provider name> <{guid}> <outputCFile> <outputManifestFile>\n\
@@ -66,6 +69,10 @@ For Syslog (Linux):\n\
     see http://pubs.opengroup.org/onlinepubs/007908799/xsh/syslog.h.html for syslog flags\n\
 For File logging:\n\
     oigenc.exe " FILE_MODE " <headerFile> <outputCFile>\n\
+For binary tracing (file logging plus binary records, see base/oibinary.h):\n\
+    oigenc.exe " BINARY_MODE " <headerFile> <outputCFile>\n\
+To render a binary trace file as text (timestamps in UTC) on standard output:\n\
+    oigenc.exe " DECODE_MODE " <headerFile> <traceFile>\n\
 For No tracing at all:\n\
     oigenc.exe " NOOP_MODE " <headerFile> <outputCFile>\n\
 \n\
@@ -240,6 +247,75 @@ int genmain(int argc, _In_reads_z_(argc) _Deref_pre_z_ char** argv)
 
         Parser_Destroy(&parser);
     }
+    else if (Strcmp(argv[1], BINARY_MODE) == 0 && argc == 4)
+    {
+        /* binary tracing */
+
+        char * header = argv[2];
+        char * target = argv[3];
+
+        int count = 0;
+        OIEvent * events = 0;
+        OIParser parser;
+
+        memset(&parser, 0, sizeof(OIParser));
+
+        if (!Parser_Init(&parser, header))
+        {
+            printf("OIGEN: out of memory while parsing the input file '%s'", header);
+            return 1;
+        }
+
+        if (!Parser_Parse(&parser, &events, &count))
+        {
+            printf("OIGEN: error parsing the input file '%s'", header);
+            return 1;
+        }
+
+        if (!GenerateBinary(events, target))
+        {
+            printf("OIGEN: error while writing Binary code, the input file '%s'", header);
+            return 1;
+        }
+
+        Parser_Destroy(&parser);
+    }
+    else if (Strcmp(argv[1], DECODE_MODE) == 0 && argc == 4)
+    {
+        /* binary trace file to text */
+
+        char * header = argv[2];
+        char * source = argv[3];
+
+        int count = 0;
+        OIEvent * events = 0;
+        OIParser parser;
+
+        memset(&parser, 0, sizeof(OIParser));
+
+        if (!Parser_Init(&parser, header))
+        {
+            printf("OIGEN: out of memory while parsing the input file '%s'", header);
+            return 1;
+        }
+
+        if (!Parser_Parse(&parser, &events, &count))
+        {
+            printf("OIGEN: error parsing the input file '%s'", header);
+            return 1;
+        }
+
+        if (!DecodeBinary(events, source, stdout))
+        {
+            printf("OIGEN: error while decoding the trace file '%s'", source);
+            return 1;
+        }
+
+        Parser_Destroy(&parser);
+
+        /* the output is the decoded trace only */
+        return 0;
+    }
     else
     {
         printf("Unknown mode or incorrect number of parameters! mode=[%s], parameters=[%d]\n", argv[1], argc);
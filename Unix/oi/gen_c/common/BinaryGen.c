@@ -0,0 +1,528 @@
+/*
+**==============================================================================
+**
+** Copyright (c) Microsoft Corporation. All rights reserved. See file LICENSE
+** for license information.
+**
+**==============================================================================
+*/
+
+#include "oicommon.h"
+#include "BinaryGen.h"
+#include "FileGen.h"
+#include <base/oibinary.h>
+#include <pal/strings.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define BINARY_CGEN_START NL \
+    "/*" NL \
+    "**==============================================================================" NL \
+    "**" NL \
+    "** Copyright (c) Microsoft Corporation. All rights reserved. See file LICENSE" NL \
+    "** for license information." NL \
+    "**" NL \
+    "**==============================================================================" NL \
+    "*/" NL \
+    "#include <oi/oi_binary.h>" NL \
+     NL
+
+#define BINARYEVENT  "BINARY_EVENT%d("
+#define BINARYEVENTD "BINARY_EVENTD%d("
+
+_Use_decl_annotations_
+char GetArgumentKind(const char * type)
+{
+    if (_isTStringType(type))
+        return 'T';
+
+    if (__isStringType(type))
+        return 'S';
+
+    if (strchr(type, '*'))
+        return 'P';
+
+    return 'V';
+}
+
+static PAL_Boolean _AddEvents(
+    _In_ FILE * out,
+    _In_ OIEvent * events)
+{
+    char buf[BUFFER_SIZE];
+    OIEvent * current = events;
+
+    while(current)
+    {
+        OIEvent * next = current->next;
+        OIArgument * arg;
+        int ArgCount = CountArguments(current->Argument);
+        int wrote;
+
+        if (!AddCallMacro(out, current))
+            return PAL_FALSE;
+
+        buf[0] = 0;
+#if defined(CONFIG_OS_WINDOWS)
+        wrote = sprintf_s(buf, BUFFER_SIZE, UseDebugMacro(current->Priority) ? BINARYEVENTD : BINARYEVENT, ArgCount);
+#else
+        wrote = sprintf(buf, UseDebugMacro(current->Priority) ? BINARYEVENTD : BINARYEVENT, ArgCount);
+#endif
+        if (wrote >= BUFFER_SIZE)
+            goto error;
+
+        if (Strcat(buf, BUFFER_SIZE, current->EventId) == 0)
+            goto error;
+        if (Strcat(buf, BUFFER_SIZE, ", ") == 0)
+            goto error;
+        if (Strcat(buf, BUFFER_SIZE, current->Name) == 0)
+            goto error;
+        if (Strcat(buf, BUFFER_SIZE, "_Impl") == 0)
+            goto error;
+        if (Strcat(buf, BUFFER_SIZE, ", ") == 0)
+            goto error;
+        if (Strcat(buf, BUFFER_SIZE, current->Priority) == 0)
+            goto error;
+        if (Strcat(buf, BUFFER_SIZE, ", PAL_T(") == 0)
+            goto error;
+        if (Strcat(buf, BUFFER_SIZE, current->Format) == 0)
+            goto error;
+        if (Strcat(buf, BUFFER_SIZE, ")") == 0)
+            goto error;
+
+        /* Each type is followed by its kind */
+        arg = current->Argument;
+        while(arg)
+        {
+            char kind[4] = { ',', ' ', 0, 0 };
+
+            kind[2] = GetArgumentKind(arg->Type);
+
+            if (Strcat(buf, BUFFER_SIZE, ", ") == 0)
+                goto error;
+            if (Strcat(buf, BUFFER_SIZE, arg->Type) == 0)
+                goto error;
+            if (Strcat(buf, BUFFER_SIZE, kind) == 0)
+                goto error;
+
+            arg = arg->next;
+        }
+
+        if (Strcat(buf, BUFFER_SIZE, ")") == 0)
+            goto error;
+
+        /* buf may contain %d which we need to preserve */
+        fprintf(out, "%s", buf);
+        fprintf(out, NL);
+
+        current = next;
+    }
+
+    return PAL_TRUE;
+
+error:
+    OIERROR1("Out of buffer space while generating! Buffer so far was [%s]", buf);
+    return PAL_FALSE;
+}
+
+/************* Decoding ******************/
+
+typedef struct _DecodedEvent
+{
+    unsigned long id;
+    OIEvent * event;
+}
+DecodedEvent;
+
+static int _CompareEvents(const void * p1, const void * p2)
+{
+    const DecodedEvent * e1 = (const DecodedEvent *)p1;
+    const DecodedEvent * e2 = (const DecodedEvent *)p2;
+
+    if (e1->id != e2->id)
+        return e1->id < e2->id ? -1 : 1;
+
+    return 0;
+}
+
+static int _CompareRecords(const void * p1, const void * p2)
+{
+    const OIBinaryRecord * r1 = (const OIBinaryRecord *)p1;
+    const OIBinaryRecord * r2 = (const OIBinaryRecord *)p2;
+
+    if (r1->timestamp != r2->timestamp)
+        return r1->timestamp < r2->timestamp ? -1 : 1;
+
+    if (r1->tid != r2->tid)
+        return r1->tid < r2->tid ? -1 : 1;
+
+    if (r1->seq != r2->seq)
+        return r1->seq < r2->seq ? -1 : 1;
+
+    return 0;
+}
+
+static const char * _PriorityName(_In_z_ const char * priority)
+{
+    if (Strcmp(priority, "LOG_EMERG") == 0 ||
+        Strcmp(priority, "LOG_ALERT") == 0 ||
+        Strcmp(priority, "LOG_CRIT") == 0)
+        return "FATAL";
+    if (Strcmp(priority, "LOG_ERR") == 0)
+        return "ERROR";
+    if (Strcmp(priority, "LOG_WARNING") == 0)
+        return "WARNING";
+    if (Strcmp(priority, "LOG_NOTICE") == 0 ||
+        Strcmp(priority, "LOG_INFO") == 0)
+        return "INFO";
+    if (Strcmp(priority, "LOG_DEBUG") == 0)
+        return "DEBUG";
+
+    return "VERBOSE";
+}
+
+/* Writes one argument of a record for the conversion 'spec' (the
+ * conversion specification without its length modifiers) */
+static void _PutArgument(
+    _In_ FILE * out,
+    _In_ const OIBinaryRecord * record,
+    int index,
+    char kind,
+    _In_z_ const char * spec,
+    char conversion,
+    PAL_Boolean is64)
+{
+    char fmt[32];
+    MI_Uint64 value = record->args[index];
+
+    if (kind == 'S' || kind == 'T')
+    {
+        MI_Uint32 offset = OIBINARY_STRING_OFFSET(value);
+        MI_Uint32 length = OIBINARY_STRING_LENGTH(value);
+
+        if (offset + length >= sizeof(record->strings))
+        {
+            fprintf(out, "<?>");
+            return;
+        }
+
+        Strlcpy(fmt, spec, sizeof(fmt));
+        Strlcat(fmt, "s", sizeof(fmt));
+        fprintf(out, fmt, record->strings + offset);
+        return;
+    }
+
+    switch (conversion)
+    {
+        case 'p':
+            Strlcpy(fmt, spec, sizeof(fmt));
+            Strlcat(fmt, "p", sizeof(fmt));
+            fprintf(out, fmt, (void *)(ptrdiff_t)value);
+            break;
+        case 'c':
+            Strlcpy(fmt, spec, sizeof(fmt));
+            Strlcat(fmt, "c", sizeof(fmt));
+            fprintf(out, fmt, (int)(char)value);
+            break;
+        case 'd':
+        case 'i':
+            Strlcpy(fmt, spec, sizeof(fmt));
+            if (is64)
+            {
+                Strlcat(fmt, "lld", sizeof(fmt));
+                fprintf(out, fmt, (long long)value);
+            }
+            else
+            {
+                Strlcat(fmt, "d", sizeof(fmt));
+                fprintf(out, fmt, (int)value);
+            }
+            break;
+        case 'u':
+        case 'x':
+        case 'X':
+        case 'o':
+        {
+            char conv[4] = { 0, 0, 0, 0 };
+
+            Strlcpy(fmt, spec, sizeof(fmt));
+            if (is64)
+            {
+                conv[0] = 'l';
+                conv[1] = 'l';
+                conv[2] = conversion;
+                Strlcat(fmt, conv, sizeof(fmt));
+                fprintf(out, fmt, (unsigned long long)value);
+            }
+            else
+            {
+                conv[0] = conversion;
+                Strlcat(fmt, conv, sizeof(fmt));
+                fprintf(out, fmt, (unsigned int)value);
+            }
+            break;
+        }
+        default:
+            fprintf(out, "<?>");
+            break;
+    }
+}
+
+/* Renders the format of the event (a C string literal, possibly split)
+ * with the arguments of the record */
+static void _PutMessage(
+    _In_ FILE * out,
+    _In_ OIEvent * event,
+    _In_ const OIBinaryRecord * record)
+{
+    const char * p = event->Format;
+    OIArgument * arg = event->Argument;
+    int index = 0;
+    PAL_Boolean quoted = PAL_FALSE;
+
+    while (*p)
+    {
+        char c = *p++;
+
+        if (c == '"')
+        {
+            quoted = !quoted;
+            continue;
+        }
+
+        if (!quoted)
+            continue;
+
+        if (c == '\\' && *p)
+        {
+            c = *p++;
+
+            if (c == 'n')
+                c = '\n';
+            else if (c == 't')
+                c = '\t';
+
+            fputc(c, out);
+            continue;
+        }
+
+        if (c != '%')
+        {
+            fputc(c, out);
+            continue;
+        }
+
+        if (*p == '%')
+        {
+            fputc('%', out);
+            p++;
+            continue;
+        }
+
+        /* Conversion specification */
+        {
+            char spec[16];
+            size_t n = 0;
+            PAL_Boolean is64 = PAL_FALSE;
+            char conversion;
+
+            spec[n++] = '%';
+
+            while (*p && strchr("-+ #0123456789.", *p) && n < sizeof(spec) - 1)
+                spec[n++] = *p++;
+
+            spec[n] = 0;
+
+            /* Length modifiers */
+            for (;;)
+            {
+                if (p[0] == 'I' && p[1] == '6' && p[2] == '4')
+                {
+                    is64 = PAL_TRUE;
+                    p += 3;
+                }
+                else if (p[0] == 'l' && p[1] == 'l')
+                {
+                    is64 = PAL_TRUE;
+                    p += 2;
+                }
+                else if (*p == 'l' || *p == 'h' || *p == 'z')
+                {
+                    if (*p != 'h' && sizeof(long) == 8)
+                        is64 = PAL_TRUE;
+                    p++;
+                }
+                else
+                    break;
+            }
+
+            if (!*p)
+                break;
+
+            conversion = *p++;
+
+            if (!arg || index >= record->argc)
+            {
+                fprintf(out, "<missing>");
+                continue;
+            }
+
+            _PutArgument(out, record, index, GetArgumentKind(arg->Type),
+                spec, conversion, is64);
+
+            arg = arg->next;
+            index++;
+        }
+    }
+}
+
+static PAL_Boolean _PutRecord(
+    _In_ FILE * out,
+    _In_reads_(numEvents) DecodedEvent * events,
+    size_t numEvents,
+    _In_ const OIBinaryRecord * record)
+{
+    DecodedEvent key;
+    DecodedEvent * found;
+    time_t t = (time_t)(record->timestamp / 1000000);
+    struct tm tm;
+
+    memset(&tm, 0, sizeof(tm));
+#if defined(CONFIG_OS_WINDOWS)
+    gmtime_s(&tm, &t);
+#else
+    gmtime_r(&t, &tm);
+#endif
+
+    fprintf(out, "%04d/%02d/%02d %02d:%02d:%02d.%06u [%llu] ",
+        tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday,
+        tm.tm_hour, tm.tm_min, tm.tm_sec,
+        (unsigned int)(record->timestamp % 1000000),
+        (unsigned long long)record->tid);
+
+    key.id = record->eventId;
+    key.event = NULL;
+    found = (DecodedEvent *)bsearch(&key, events, numEvents,
+        sizeof(DecodedEvent), _CompareEvents);
+
+    if (!found)
+    {
+        fprintf(out, "EventId=%u (unknown event)" NL, record->eventId);
+        return PAL_TRUE;
+    }
+
+    fprintf(out, "EventId=%u Priority=%s ", record->eventId,
+        _PriorityName(found->event->Priority));
+    _PutMessage(out, found->event, record);
+    fprintf(out, NL);
+
+    return PAL_TRUE;
+}
+
+/************* Public Definitions ******************/
+
+_Use_decl_annotations_
+PAL_Boolean GenerateBinary(
+    OIEvent * events,
+    const char * target)
+{
+    /* overwrite existing file */
+    FILE* out = fopen(target, "w");
+    if (!out)
+    {
+        OIERROR1("Failed to open file [%s] for writing!", target);
+        return PAL_FALSE;
+    }
+
+    fprintf(out, BINARY_CGEN_START);
+    fprintf(out, NL);
+
+    if (!_AddEvents(out, events))
+    {
+        fclose(out);
+        OIERROR1("Failed to generate binary tracing implementation for file [%s]!", target);
+        return PAL_FALSE;
+    }
+
+    fclose(out);
+
+    OITRACE("Success!");
+    return PAL_TRUE;
+}
+
+_Use_decl_annotations_
+PAL_Boolean DecodeBinary(
+    OIEvent * events,
+    const char * source,
+    FILE * out)
+{
+    OIBinaryFileHeader header;
+    OIBinaryRecord * records = NULL;
+    DecodedEvent * table = NULL;
+    size_t numEvents = 0;
+    size_t i;
+    OIEvent * current;
+    PAL_Boolean result = PAL_FALSE;
+    FILE* in = fopen(source, "rb");
+
+    if (!in)
+    {
+        OIERROR1("Failed to open file [%s] for reading!", source);
+        return PAL_FALSE;
+    }
+
+    if (fread(&header, sizeof(header), 1, in) != 1 ||
+        header.magic != OIBINARY_MAGIC ||
+        header.version != OIBINARY_VERSION ||
+        header.recordSize != sizeof(OIBinaryRecord))
+    {
+        OIERROR1("File [%s] is not a binary trace file!", source);
+        goto done;
+    }
+
+    /* Events sorted by id */
+    for (current = events; current; current = current->next)
+        numEvents++;
+
+    table = (DecodedEvent *)PAL_Calloc(numEvents + 1, sizeof(DecodedEvent));
+    records = (OIBinaryRecord *)PAL_Malloc(
+        (header.numRecords + 1) * sizeof(OIBinaryRecord));
+
+    if (!table || !records)
+    {
+        OIERROR("Out of memory!");
+        goto done;
+    }
+
+    for (current = events, i = 0; current; current = current->next, i++)
+    {
+        table[i].id = strtoul(current->EventId, NULL, 10);
+        table[i].event = current;
+    }
+
+    qsort(table, numEvents, sizeof(DecodedEvent), _CompareEvents);
+
+    if (header.numRecords &&
+        fread(records, sizeof(OIBinaryRecord), header.numRecords, in) != header.numRecords)
+    {
+        OIERROR1("File [%s] is truncated!", source);
+        goto done;
+    }
+
+    qsort(records, header.numRecords, sizeof(OIBinaryRecord), _CompareRecords);
+
+    for (i = 0; i < header.numRecords; i++)
+    {
+        if (!_PutRecord(out, table, numEvents, &records[i]))
+            goto done;
+    }
+
+    result = PAL_TRUE;
+
+done:
+    PAL_Free(records);
+    PAL_Free(table);
+    fclose(in);
+    return result;
+}
@@ -0,0 +1,55 @@
+/*
+**==============================================================================
+**
+** Copyright (c) Microsoft Corporation. All rights reserved. See file LICENSE
+** for license information.
+**
+**==============================================================================
+*/
+
+#ifndef _OI_BinaryGen_h_
+#define _OI_BinaryGen_h_
+
+#include "common.h"
+#include "OIParser.h"
+#include <stdio.h>
+
+PAL_BEGIN_EXTERNC
+
+/*
+    GenerateBinary
+
+    events - linked list of OI event description
+    target - output file for the generated code
+*/
+PAL_Boolean GenerateBinary(
+    _In_   OIEvent * events,
+    _In_z_ const char * target);
+
+/*
+    DecodeBinary
+
+    Renders the records of a binary trace file (see base/oibinary.h) as
+    text, in timestamp order, with the formats of the events
+
+    events - linked list of OI event description (same header as the one
+        the binary tracing code was generated from)
+    source - binary trace file
+    out - where the text is written
+*/
+PAL_Boolean DecodeBinary(
+    _In_   OIEvent * events,
+    _In_z_ const char * source,
+    _In_   FILE * out);
+
+/*
+    GetArgumentKind
+
+    Returns the kind of the argument of the binary trace records for the
+    type of an event argument ('V', 'P', 'S' or 'T', see OIBinaryArg)
+*/
+char GetArgumentKind(_In_z_ const char * type);
+
+PAL_END_EXTERNC
+
+#endif /* _OI_BinaryGen_h_ */
@@ -75,6 +75,85 @@ PAL_Boolean __isStringType(_In_z_ const char * type)
 }
          
 
+_Use_decl_annotations_
+PAL_Boolean AddCallMacro(
+    FILE * out,
+    OIEvent * event)
+{
+    char buf[BUFFER_SIZE];
+    OIArgument * arg;
+    int ArgCount = CountArguments(event->Argument);
+    int wrote;
+    int i = 0;
+    char plist1[BUFFER_SIZE];
+    char plist2[BUFFER_SIZE];
+
+    plist1[0] = 0;
+    plist2[0] = 0;
+    buf[0] = 0;
+    arg = event->Argument;
+    while(arg)
+    {
+        char param1[BUFFER_SIZE];
+        char param2[BUFFER_SIZE];
+        const char * argType = arg->Type;
+        char * formatString1 = "a%d";
+        char * formatString2 = formatString1;
+
+        param1[0] = 0;
+        param2[0] = 0;
+        if (_isTStringType(argType))
+        {
+            formatString2 = "tcs(a%d)";
+        }
+        else if (__isStringType(argType))
+        {
+            formatString2 = "scs(a%d)";
+        }
+
+#if defined(CONFIG_OS_WINDOWS)
+        wrote = sprintf_s(param1, BUFFER_SIZE, formatString1, i);
+        wrote = sprintf_s(param2, BUFFER_SIZE, formatString2, i);
+#else
+        wrote = sprintf(param1, formatString1, i);
+        wrote = sprintf(param2, formatString2, i);
+#endif
+        if (wrote >= BUFFER_SIZE)
+            goto error;
+
+        if (Strcat(plist1, BUFFER_SIZE, param1) == 0)
+            goto error;
+        
+        if (Strcat(plist2, BUFFER_SIZE, param2) == 0)
+            goto error;
+
+        // add a comma if this is NOT the last argument
+        arg = arg->next;
+        i++;
+        if (arg)
+        {
+            if (Strcat(plist1, BUFFER_SIZE, ", ") == 0)
+                goto error;
+            if (Strcat(plist2, BUFFER_SIZE, ", ") == 0)
+                goto error;
+        }
+    }
+
+#if defined(CONFIG_OS_WINDOWS)
+    wrote = sprintf_s(buf, BUFFER_SIZE, (ArgCount == 0)? FILECALLIMPL0 : FILECALLIMPLN, 
+#else
+    wrote = sprintf(buf, (ArgCount == 0)? FILECALLIMPL0 : FILECALLIMPLN, 
+#endif
+        event->Name, plist1, event->Name, plist2, event->Name, plist1, event->Name, plist2);
+
+    fprintf(out, "%s", buf);
+    return PAL_TRUE;
+
+error:
+    OIERROR1("Out of buffer space while generating! Buffer so far was [%s]", buf);
+    return PAL_FALSE;
+}
+
 static PAL_Boolean _AddEvents(
     _In_ FILE * out,
     _In_ OIEvent * events)
@@ -89,71 +168,8 @@ static PAL_Boolean _AddEvents(
         int ArgCount = CountArguments(current->Argument);
         int wrote;
 
-        {
-            int i = 0;
-            char plist1[BUFFER_SIZE];
-            char plist2[BUFFER_SIZE];
-            plist1[0] = 0;
-            plist2[0] = 0;
-            arg = current->Argument;
-            while(arg)
-            {
-                char param1[BUFFER_SIZE];
-                char param2[BUFFER_SIZE];
-                const char * argType = arg->Type;
-                char * formatString1 = "a%d";
-                char * formatString2 = formatString1;
-
-                param1[0] = 0;
-                param2[0] = 0;
-                if (_isTStringType(argType))
-                {
-                    formatString2 = "tcs(a%d)";
-                }
-                else if (__isStringType(argType))
-                {
-                    formatString2 = "scs(a%d)";
-                }
-
-                  
-#if defined(CONFIG_OS_WINDOWS)
-                wrote = sprintf_s(param1, BUFFER_SIZE, formatString1, i);
-                wrote = sprintf_s(param2, BUFFER_SIZE, formatString2, i);
-#else
-                wrote = sprintf(param1, formatString1, i);
-                wrote = sprintf(param2, formatString2, i);
-#endif
-                if (wrote >= BUFFER_SIZE)
-                    goto error;
-
-                if (Strcat(plist1, BUFFER_SIZE, param1) == 0)
-                    goto error;
-                
-                if (Strcat(plist2, BUFFER_SIZE, param2) == 0)
-                    goto error;
-
-                // add a comma if this is NOT the last argument
-                arg = arg->next;
-                i++;
-                if (arg)
-                {
-                    if (Strcat(plist1, BUFFER_SIZE, ", ") == 0)
-                        goto error;
-                    if (Strcat(plist2, BUFFER_SIZE, ", ") == 0)
-                        goto error;
-                }
-            }
-
-            buf[0] = 0;
-#if defined(CONFIG_OS_WINDOWS)
-            wrote = sprintf_s(buf, BUFFER_SIZE, (ArgCount == 0)? FILECALLIMPL0 : FILECALLIMPLN, 
-#else
-            wrote = sprintf(buf, (ArgCount == 0)? FILECALLIMPL0 : FILECALLIMPLN, 
-#endif
-                current->Name, plist1, current->Name, plist2, current->Name, plist1, current->Name, plist2);
-
-            fprintf(out, "%s", buf);
-        }
+        if (!AddCallMacro(out, current))
+            return PAL_FALSE;
 
         buf[0] = 0;
 #if defined(CONFIG_OS_WINDOWS)
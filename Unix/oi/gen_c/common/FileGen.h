@@ -12,6 +12,7 @@
 
 #include "common.h"
 #include "OIParser.h"
+#include <stdio.h>
 
 PAL_BEGIN_EXTERNC
 
@@ -26,6 +27,20 @@ PAL_Boolean GenerateFile(
     _In_   OIEvent * events,
     _In_z_ const char * target);
 
+/*
+    AddCallMacro
+
+    Writes the macro calling the event implementation (adding the file and
+    the line in debug builds); shared with the other generators
+*/
+PAL_Boolean AddCallMacro(
+    _In_ FILE * out,
+    _In_ OIEvent * event);
+
+PAL_Boolean _isTStringType(_In_z_ const char * type);
+
+PAL_Boolean __isStringType(_In_z_ const char * type);
+
 PAL_END_EXTERNC
 
 #endif /* _OI_FileGen_h_ */
@@ -0,0 +1,384 @@
+/*
+**==============================================================================
+**
+** Copyright (c) Microsoft Corporation. All rights reserved. See file LICENSE
+** for license information.
+**
+**==============================================================================
+*/
+
+/*
+Open Instrumentation for binary OMI tracing
+
+The events are recorded into the binary trace rings (base/oibinary.h) when
+their group is enabled, and are written to the log file like with
+oi_file.h. The debug events are still recorded in release builds (they are
+only left out of the log file).
+
+Each argument type comes with its kind (see OIBinaryArg).
+*/
+
+#ifndef _oi_binary_h
+#define _oi_binary_h
+
+#include "oi_file.h"
+#include <base/oibinary.h>
+
+BEGIN_EXTERNC
+
+#define OILOGSYSTEM_BINARY
+
+#define BINARY_RECORD0(eventId, priority)                                                           \
+    if (OIBinary_IsEnabled(eventId))                                                                \
+        OIBinary_Put(eventId, priority, "", NULL, 0);
+
+#define BINARY_RECORD1(eventId, priority, K0)                                                       \
+    if (OIBinary_IsEnabled(eventId))                                                                \
+    {                                                                                               \
+        OIBinaryArg args[1];                                                                        \
+        OIBINARY_ARG_##K0(args[0], a0);                                                             \
+        OIBinary_Put(eventId, priority, #K0, args, 1);                                              \
+    }
+
+#define BINARY_RECORD2(eventId, priority, K0, K1)                                                   \
+    if (OIBinary_IsEnabled(eventId))                                                                \
+    {                                                                                               \
+        OIBinaryArg args[2];                                                                        \
+        OIBINARY_ARG_##K0(args[0], a0);                                                             \
+        OIBINARY_ARG_##K1(args[1], a1);                                                             \
+        OIBinary_Put(eventId, priority, #K0 #K1, args, 2);                                          \
+    }
+
+#define BINARY_RECORD3(eventId, priority, K0, K1, K2)                                               \
+    if (OIBinary_IsEnabled(eventId))                                                                \
+    {                                                                                               \
+        OIBinaryArg args[3];                                                                        \
+        OIBINARY_ARG_##K0(args[0], a0);                                                             \
+        OIBINARY_ARG_##K1(args[1], a1);                                                             \
+        OIBINARY_ARG_##K2(args[2], a2);                                                             \
+        OIBinary_Put(eventId, priority, #K0 #K1 #K2, args, 3);                                      \
+    }
+
+#define BINARY_RECORD4(eventId, priority, K0, K1, K2, K3)                                           \
+    if (OIBinary_IsEnabled(eventId))                                                                \
+    {                                                                                               \
+        OIBinaryArg args[4];                                                                        \
+        OIBINARY_ARG_##K0(args[0], a0);                                                             \
+        OIBINARY_ARG_##K1(args[1], a1);                                                             \
+        OIBINARY_ARG_##K2(args[2], a2);                                                             \
+        OIBINARY_ARG_##K3(args[3], a3);                                                             \
+        OIBinary_Put(eventId, priority, #K0 #K1 #K2 #K3, args, 4);                                  \
+    }
+
+#define BINARY_RECORD5(eventId, priority, K0, K1, K2, K3, K4)                                       \
+    if (OIBinary_IsEnabled(eventId))                                                                \
+    {                                                                                               \
+        OIBinaryArg args[5];                                                                        \
+        OIBINARY_ARG_##K0(args[0], a0);                                                             \
+        OIBINARY_ARG_##K1(args[1], a1);                                                             \
+        OIBINARY_ARG_##K2(args[2], a2);                                                             \
+        OIBINARY_ARG_##K3(args[3], a3);                                                             \
+        OIBINARY_ARG_##K4(args[4], a4);                                                             \
+        OIBinary_Put(eventId, priority, #K0 #K1 #K2 #K3 #K4, args, 5);                              \
+    }
+
+#define BINARY_RECORD6(eventId, priority, K0, K1, K2, K3, K4, K5)                                   \
+    if (OIBinary_IsEnabled(eventId))                                                                \
+    {                                                                                               \
+        OIBinaryArg args[6];                                                                        \
+        OIBINARY_ARG_##K0(args[0], a0);                                                             \
+        OIBINARY_ARG_##K1(args[1], a1);                                                             \
+        OIBINARY_ARG_##K2(args[2], a2);                                                             \
+        OIBINARY_ARG_##K3(args[3], a3);                                                             \
+        OIBINARY_ARG_##K4(args[4], a4);                                                             \
+        OIBINARY_ARG_##K5(args[5], a5);                                                             \
+        OIBinary_Put(eventId, priority, #K0 #K1 #K2 #K3 #K4 #K5, args, 6);                          \
+    }
+
+#define BINARY_RECORD7(eventId, priority, K0, K1, K2, K3, K4, K5, K6)                               \
+    if (OIBinary_IsEnabled(eventId))                                                                \
+    {                                                                                               \
+        OIBinaryArg args[7];                                                                        \
+        OIBINARY_ARG_##K0(args[0], a0);                                                             \
+        OIBINARY_ARG_##K1(args[1], a1);                                                             \
+        OIBINARY_ARG_##K2(args[2], a2);                                                             \
+        OIBINARY_ARG_##K3(args[3], a3);                                                             \
+        OIBINARY_ARG_##K4(args[4], a4);                                                             \
+        OIBINARY_ARG_##K5(args[5], a5);                                                             \
+        OIBINARY_ARG_##K6(args[6], a6);                                                             \
+        OIBinary_Put(eventId, priority, #K0 #K1 #K2 #K3 #K4 #K5 #K6, args, 7);                      \
+    }
+
+#define BINARY_RECORD8(eventId, priority, K0, K1, K2, K3, K4, K5, K6, K7)                           \
+    if (OIBinary_IsEnabled(eventId))                                                                \
+    {                                                                                               \
+        OIBinaryArg args[8];                                                                        \
+        OIBINARY_ARG_##K0(args[0], a0);                                                             \
+        OIBINARY_ARG_##K1(args[1], a1);                                                             \
+        OIBINARY_ARG_##K2(args[2], a2);                                                             \
+        OIBINARY_ARG_##K3(args[3], a3);                                                             \
+        OIBINARY_ARG_##K4(args[4], a4);                                                             \
+        OIBINARY_ARG_##K5(args[5], a5);                                                             \
+        OIBINARY_ARG_##K6(args[6], a6);                                                             \
+        OIBINARY_ARG_##K7(args[7], a7);                                                             \
+        OIBinary_Put(eventId, priority, #K0 #K1 #K2 #K3 #K4 #K5 #K6 #K7, args, 8);                  \
+    }
+
+#define BINARY_RECORD9(eventId, priority, K0, K1, K2, K3, K4, K5, K6, K7, K8)                       \
+    if (OIBinary_IsEnabled(eventId))                                                                \
+    {                                                                                               \
+        OIBinaryArg args[9];                                                                        \
+        OIBINARY_ARG_##K0(args[0], a0);                                                             \
+        OIBINARY_ARG_##K1(args[1], a1);                                                             \
+        OIBINARY_ARG_##K2(args[2], a2);                                                             \
+        OIBINARY_ARG_##K3(args[3], a3);                                                             \
+        OIBINARY_ARG_##K4(args[4], a4);                                                             \
+        OIBINARY_ARG_##K5(args[5], a5);                                                             \
+        OIBINARY_ARG_##K6(args[6], a6);                                                             \
+        OIBINARY_ARG_##K7(args[7], a7);                                                             \
+        OIBINARY_ARG_##K8(args[8], a8);                                                             \
+        OIBinary_Put(eventId, priority, #K0 #K1 #K2 #K3 #K4 #K5 #K6 #K7 #K8, args, 9);              \
+    }
+
+#define BINARY_RECORD10(eventId, priority, K0, K1, K2, K3, K4, K5, K6, K7, K8, K9)                  \
+    if (OIBinary_IsEnabled(eventId))                                                                \
+    {                                                                                               \
+        OIBinaryArg args[10];                                                                       \
+        OIBINARY_ARG_##K0(args[0], a0);                                                             \
+        OIBINARY_ARG_##K1(args[1], a1);                                                             \
+        OIBINARY_ARG_##K2(args[2], a2);                                                             \
+        OIBINARY_ARG_##K3(args[3], a3);                                                             \
+        OIBINARY_ARG_##K4(args[4], a4);                                                             \
+        OIBINARY_ARG_##K5(args[5], a5);                                                             \
+        OIBINARY_ARG_##K6(args[6], a6);                                                             \
+        OIBINARY_ARG_##K7(args[7], a7);                                                             \
+        OIBINARY_ARG_##K8(args[8], a8);                                                             \
+        OIBINARY_ARG_##K9(args[9], a9);                                                             \
+        OIBinary_Put(eventId, priority, #K0 #K1 #K2 #K3 #K4 #K5 #K6 #K7 #K8 #K9, args, 10);         \
+    }
+
+#ifndef BINARY_EVENT0
+#define BINARY_EVENT0(eventId, eventName, priority, format)                                         \
+PAL_INLINE void eventName(const char * file, int line)                                              \
+{                                                                                                   \
+    BINARY_RECORD0(eventId, priority)                                                               \
+    FilePutLog(priority, eventId, file, line, format);                                              \
+}
+#endif
+
+#ifndef BINARY_EVENT1
+#define BINARY_EVENT1(eventId, eventName, priority, format, T0, K0)                                 \
+PAL_INLINE void eventName(const char * file, int line, T0 a0)                                       \
+{                                                                                                   \
+    BINARY_RECORD1(eventId, priority, K0)                                                           \
+    FilePutLog(priority, eventId, file, line, format, a0);                                          \
+}
+#endif
+
+#ifndef BINARY_EVENT2
+#define BINARY_EVENT2(eventId, eventName, priority, format, T0, K0, T1, K1)                         \
+PAL_INLINE void eventName(const char * file, int line, T0 a0, T1 a1)                                \
+{                                                                                                   \
+    BINARY_RECORD2(eventId, priority, K0, K1)                                                       \
+    FilePutLog(priority, eventId, file, line, format, a0, a1);                                      \
+}
+#endif
+
+#ifndef BINARY_EVENT3
+#define BINARY_EVENT3(eventId, eventName, priority, format, T0, K0, T1, K1, T2, K2)                 \
+PAL_INLINE void eventName(const char * file, int line, T0 a0, T1 a1, T2 a2)                         \
+{                                                                                                   \
+    BINARY_RECORD3(eventId, priority, K0, K1, K2)                                                   \
+    FilePutLog(priority, eventId, file, line, format, a0, a1, a2);                                  \
+}
+#endif
+
+#ifndef BINARY_EVENT4
+#define BINARY_EVENT4(eventId, eventName, priority, format, T0, K0, T1, K1, T2, K2, T3, K3)         \
+PAL_INLINE void eventName(const char * file, int line, T0 a0, T1 a1, T2 a2, T3 a3)                  \
+{                                                                                                   \
+    BINARY_RECORD4(eventId, priority, K0, K1, K2, K3)                                               \
+    FilePutLog(priority, eventId, file, line, format, a0, a1, a2, a3);                              \
+}
+#endif
+
+#ifndef BINARY_EVENT5
+#define BINARY_EVENT5(eventId, eventName, priority, format, T0, K0, T1, K1, T2, K2, T3, K3, T4, K4) \
+PAL_INLINE void eventName(const char * file, int line, T0 a0, T1 a1, T2 a2, T3 a3, T4 a4)           \
+{                                                                                                   \
+    BINARY_RECORD5(eventId, priority, K0, K1, K2, K3, K4)                                           \
+    FilePutLog(priority, eventId, file, line, format, a0, a1, a2, a3, a4);                          \
+}
+#endif
+
+#ifndef BINARY_EVENT6
+#define BINARY_EVENT6(eventId, eventName, priority, format, T0, K0, T1, K1, T2, K2, T3, K3, T4, K4, T5, K5)\
+PAL_INLINE void eventName(const char * file, int line, T0 a0, T1 a1, T2 a2, T3 a3, T4 a4, T5 a5)    \
+{                                                                                                   \
+    BINARY_RECORD6(eventId, priority, K0, K1, K2, K3, K4, K5)                                       \
+    FilePutLog(priority, eventId, file, line, format, a0, a1, a2, a3, a4, a5);                      \
+}
+#endif
+
+#ifndef BINARY_EVENT7
+#define BINARY_EVENT7(eventId, eventName, priority, format, T0, K0, T1, K1, T2, K2, T3, K3, T4, K4, T5, K5, T6, K6)\
+PAL_INLINE void eventName(const char * file, int line, T0 a0, T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6)\
+{                                                                                                   \
+    BINARY_RECORD7(eventId, priority, K0, K1, K2, K3, K4, K5, K6)                                   \
+    FilePutLog(priority, eventId, file, line, format, a0, a1, a2, a3, a4, a5, a6);                  \
+}
+#endif
+
+#ifndef BINARY_EVENT8
+#define BINARY_EVENT8(eventId, eventName, priority, format, T0, K0, T1, K1, T2, K2, T3, K3, T4, K4, T5, K5, T6, K6, T7, K7)\
+PAL_INLINE void eventName(const char * file, int line, T0 a0, T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7)\
+{                                                                                                   \
+    BINARY_RECORD8(eventId, priority, K0, K1, K2, K3, K4, K5, K6, K7)                               \
+    FilePutLog(priority, eventId, file, line, format, a0, a1, a2, a3, a4, a5, a6, a7);              \
+}
+#endif
+
+#ifndef BINARY_EVENT9
+#define BINARY_EVENT9(eventId, eventName, priority, format, T0, K0, T1, K1, T2, K2, T3, K3, T4, K4, T5, K5, T6, K6, T7, K7, T8, K8)\
+PAL_INLINE void eventName(const char * file, int line, T0 a0, T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7, T8 a8)\
+{                                                                                                   \
+    BINARY_RECORD9(eventId, priority, K0, K1, K2, K3, K4, K5, K6, K7, K8)                           \
+    FilePutLog(priority, eventId, file, line, format, a0, a1, a2, a3, a4, a5, a6, a7, a8);          \
+}
+#endif
+
+#ifndef BINARY_EVENT10
+#define BINARY_EVENT10(eventId, eventName, priority, format, T0, K0, T1, K1, T2, K2, T3, K3, T4, K4, T5, K5, T6, K6, T7, K7, T8, K8, T9, K9)\
+PAL_INLINE void eventName(const char * file, int line, T0 a0, T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7, T8 a8, T9 a9)\
+{                                                                                                   \
+    BINARY_RECORD10(eventId, priority, K0, K1, K2, K3, K4, K5, K6, K7, K8, K9)                      \
+    FilePutLog(priority, eventId, file, line, format, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9);      \
+}
+#endif
+
+/* Debug versions (only recorded in release builds) */
+
+#if defined(CONFIG_ENABLE_DEBUG)
+#define BINARY_EVENTD0(eventId, eventName, priority, format)                                        \
+BINARY_EVENT0(eventId, eventName, priority, format)
+#else
+#define BINARY_EVENTD0(eventId, eventName, priority, format)                                        \
+PAL_INLINE void eventName(const char * file, int line)                                              \
+{                                                                                                   \
+    BINARY_RECORD0(eventId, priority)                                                               \
+}
+#endif
+
+#if defined(CONFIG_ENABLE_DEBUG)
+#define BINARY_EVENTD1(eventId, eventName, priority, format, T0, K0)                                \
+BINARY_EVENT1(eventId, eventName, priority, format, T0, K0)
+#else
+#define BINARY_EVENTD1(eventId, eventName, priority, format, T0, K0)                                \
+PAL_INLINE void eventName(const char * file, int line, T0 a0)                                       \
+{                                                                                                   \
+    BINARY_RECORD1(eventId, priority, K0)                                                           \
+}
+#endif
+
+#if defined(CONFIG_ENABLE_DEBUG)
+#define BINARY_EVENTD2(eventId, eventName, priority, format, T0, K0, T1, K1)                        \
+BINARY_EVENT2(eventId, eventName, priority, format, T0, K0, T1, K1)
+#else
+#define BINARY_EVENTD2(eventId, eventName, priority, format, T0, K0, T1, K1)                        \
+PAL_INLINE void eventName(const char * file, int line, T0 a0, T1 a1)                                \
+{                                                                                                   \
+    BINARY_RECORD2(eventId, priority, K0, K1)                                                       \
+}
+#endif
+
+#if defined(CONFIG_ENABLE_DEBUG)
+#define BINARY_EVENTD3(eventId, eventName, priority, format, T0, K0, T1, K1, T2, K2)                \
+BINARY_EVENT3(eventId, eventName, priority, format, T0, K0, T1, K1, T2, K2)
+#else
+#define BINARY_EVENTD3(eventId, eventName, priority, format, T0, K0, T1, K1, T2, K2)                \
+PAL_INLINE void eventName(const char * file, int line, T0 a0, T1 a1, T2 a2)                         \
+{                                                                                                   \
+    BINARY_RECORD3(eventId, priority, K0, K1, K2)                                                   \
+}
+#endif
+
+#if defined(CONFIG_ENABLE_DEBUG)
+#define BINARY_EVENTD4(eventId, eventName, priority, format, T0, K0, T1, K1, T2, K2, T3, K3)        \
+BINARY_EVENT4(eventId, eventName, priority, format, T0, K0, T1, K1, T2, K2, T3, K3)
+#else
+#define BINARY_EVENTD4(eventId, eventName, priority, format, T0, K0, T1, K1, T2, K2, T3, K3)        \
+PAL_INLINE void eventName(const char * file, int line, T0 a0, T1 a1, T2 a2, T3 a3)                  \
+{                                                                                                   \
+    BINARY_RECORD4(eventId, priority, K0, K1, K2, K3)                                               \
+}
+#endif
+
+#if defined(CONFIG_ENABLE_DEBUG)
+#define BINARY_EVENTD5(eventId, eventName, priority, format, T0, K0, T1, K1, T2, K2, T3, K3, T4, K4)\
+BINARY_EVENT5(eventId, eventName, priority, format, T0, K0, T1, K1, T2, K2, T3, K3, T4, K4)
+#else
+#define BINARY_EVENTD5(eventId, eventName, priority, format, T0, K0, T1, K1, T2, K2, T3, K3, T4, K4)\
+PAL_INLINE void eventName(const char * file, int line, T0 a0, T1 a1, T2 a2, T3 a3, T4 a4)           \
+{                                                                                                   \
+    BINARY_RECORD5(eventId, priority, K0, K1, K2, K3, K4)                                           \
+}
+#endif
+
+#if defined(CONFIG_ENABLE_DEBUG)
+#define BINARY_EVENTD6(eventId, eventName, priority, format, T0, K0, T1, K1, T2, K2, T3, K3, T4, K4, T5, K5)\
+BINARY_EVENT6(eventId, eventName, priority, format, T0, K0, T1, K1, T2, K2, T3, K3, T4, K4, T5, K5)
+#else
+#define BINARY_EVENTD6(eventId, eventName, priority, format, T0, K0, T1, K1, T2, K2, T3, K3, T4, K4, T5, K5)\
+PAL_INLINE void eventName(const char * file, int line, T0 a0, T1 a1, T2 a2, T3 a3, T4 a4, T5 a5)    \
+{                                                                                                   \
+    BINARY_RECORD6(eventId, priority, K0, K1, K2, K3, K4, K5)                                       \
+}
+#endif
+
+#if defined(CONFIG_ENABLE_DEBUG)
+#define BINARY_EVENTD7(eventId, eventName, priority, format, T0, K0, T1, K1, T2, K2, T3, K3, T4, K4, T5, K5, T6, K6)\
+BINARY_EVENT7(eventId, eventName, priority, format, T0, K0, T1, K1, T2, K2, T3, K3, T4, K4, T5, K5, T6, K6)
+#else
+#define BINARY_EVENTD7(eventId, eventName, priority, format, T0, K0, T1, K1, T2, K2, T3, K3, T4, K4, T5, K5, T6, K6)\
+PAL_INLINE void eventName(const char * file, int line, T0 a0, T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6)\
+{                                                                                                   \
+    BINARY_RECORD7(eventId, priority, K0, K1, K2, K3, K4, K5, K6)                                   \
+}
+#endif
+
+#if defined(CONFIG_ENABLE_DEBUG)
+#define BINARY_EVENTD8(eventId, eventName, priority, format, T0, K0, T1, K1, T2, K2, T3, K3, T4, K4, T5, K5, T6, K6, T7, K7)\
+BINARY_EVENT8(eventId, eventName, priority, format, T0, K0, T1, K1, T2, K2, T3, K3, T4, K4, T5, K5, T6, K6, T7, K7)
+#else
+#define BINARY_EVENTD8(eventId, eventName, priority, format, T0, K0, T1, K1, T2, K2, T3, K3, T4, K4, T5, K5, T6, K6, T7, K7)\
+PAL_INLINE void eventName(const char * file, int line, T0 a0, T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7)\
+{                                                                                                   \
+    BINARY_RECORD8(eventId, priority, K0, K1, K2, K3, K4, K5, K6, K7)                               \
+}
+#endif
+
+#if defined(CONFIG_ENABLE_DEBUG)
+#define BINARY_EVENTD9(eventId, eventName, priority, format, T0, K0, T1, K1, T2, K2, T3, K3, T4, K4, T5, K5, T6, K6, T7, K7, T8, K8)\
+BINARY_EVENT9(eventId, eventName, priority, format, T0, K0, T1, K1, T2, K2, T3, K3, T4, K4, T5, K5, T6, K6, T7, K7, T8, K8)
+#else
+#define BINARY_EVENTD9(eventId, eventName, priority, format, T0, K0, T1, K1, T2, K2, T3, K3, T4, K4, T5, K5, T6, K6, T7, K7, T8, K8)\
+PAL_INLINE void eventName(const char * file, int line, T0 a0, T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7, T8 a8)\
+{                                                                                                   \
+    BINARY_RECORD9(eventId, priority, K0, K1, K2, K3, K4, K5, K6, K7, K8)                           \
+}
+#endif
+
+#if defined(CONFIG_ENABLE_DEBUG)
+#define BINARY_EVENTD10(eventId, eventName, priority, format, T0, K0, T1, K1, T2, K2, T3, K3, T4, K4, T5, K5, T6, K6, T7, K7, T8, K8, T9, K9)\
+BINARY_EVENT10(eventId, eventName, priority, format, T0, K0, T1, K1, T2, K2, T3, K3, T4, K4, T5, K5, T6, K6, T7, K7, T8, K8, T9, K9)
+#else
+#define BINARY_EVENTD10(eventId, eventName, priority, format, T0, K0, T1, K1, T2, K2, T3, K3, T4, K4, T5, K5, T6, K6, T7, K7, T8, K8, T9, K9)\
+PAL_INLINE void eventName(const char * file, int line, T0 a0, T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7, T8 a8, T9 a9)\
+{                                                                                                   \
+    BINARY_RECORD10(eventId, priority, K0, K1, K2, K3, K4, K5, K6, K7, K8, K9)                      \
+}
+#endif
+
+END_EXTERNC
+
+#endif /* _oi_binary_h */
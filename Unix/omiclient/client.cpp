@@ -14,6 +14,7 @@
 #include <base/paths.h>
 #include <pal/thread.h>
 #include <base/log.h>
+#include <base/list.h>
 
 #if 0
 # define D(X) X
@@ -61,7 +62,7 @@ static String _StrToString(const char* str)
 {
     String r;
 
-    while (str)
+    while (*str)
     {
         MI_Char c = *str++;
         r.Append(&c, 1);
@@ -409,6 +410,86 @@ public:
     Result m_result;
 };
 
+//==============================================================================
+//
+// class FutureRep
+//
+//==============================================================================
+
+class FutureRep
+{
+public:
+
+    enum Kind
+    {
+        GET_INSTANCE,
+        CREATE_INSTANCE,
+        MODIFY_INSTANCE,
+        DELETE_INSTANCE,
+        ENUMERATE_INSTANCES,
+        INVOKE,
+        ASSOCIATOR_INSTANCES,
+        REFERENCE_INSTANCES
+    };
+
+    FutureRep(Kind kind, const String& nameSpace, Handler* handler) :
+        m_refs(1),
+        m_kind(kind),
+        m_operationId(_NextOperationId()),
+        m_nameSpace(nameSpace),
+        m_deepInheritance(false),
+        m_handler(handler),
+        m_done(false),
+        m_result(MI_RESULT_OK),
+        m_next(0)
+    {
+    }
+
+    // The client and its futures are used from a single thread
+    void AddRef()
+    {
+        m_refs++;
+    }
+
+    void Release()
+    {
+        if (--m_refs == 0)
+            delete this;
+    }
+
+    void Complete(MI_Result result)
+    {
+        m_result = result;
+        m_done = true;
+    }
+
+    Uint32 m_refs;
+    Kind m_kind;
+    Uint64 m_operationId;
+
+    // Parameters, kept until the operation is issued
+    String m_nameSpace;
+    DInstance m_instance;
+    DInstance m_inParameters;
+    String m_className;
+    String m_resultClass;
+    String m_role;
+    String m_resultRole;
+    String m_queryLanguage;
+    String m_queryExpression;
+    bool m_deepInheritance;
+
+    // Outcome
+    Handler* m_handler;
+    bool m_done;
+    Result m_result;
+    String m_errorMessage;
+    Array<DInstance> m_instances;
+
+    // Next in the queue or in the in-flight list
+    FutureRep* m_next;
+};
+
 //==============================================================================
 //
 // class ClientRep
@@ -431,10 +512,43 @@ public:
     Handler* handler;
     ConnectState connectState;
 
+    // Requests waiting for the protocol to acknowledge the one being sent
+    bool sending;
+    ListElem* sendHead;
+    ListElem* sendTail;
+
+    // Pipelined operations, queued until the window has room then in
+    // flight until their result arrives
+    Uint32 window;
+    Uint32 inFlightCount;
+    FutureRep* inFlight;
+    FutureRep* queueHead;
+    FutureRep* queueTail;
+
     static void MessageCallback(
         ClientRep * rep,
         Message* msg);
 
+    void Send(Message* msg);
+
+    void SendNext();
+
+    void Submit(FutureRep* future);
+
+    void IssueQueued();
+
+    bool Issue(FutureRep* future);
+
+    void HandleFutureMessage(FutureRep* future, Message* msg);
+
+    void FailAll();
+
+    static FutureRep* NewFuture(
+        FutureRep::Kind kind,
+        const String& nameSpace,
+        Future& future,
+        Handler* handler);
+
     bool NoOpAsync(
         Uint64 operationId);
 
@@ -499,6 +613,16 @@ void ClientRep::MessageCallback(
 
     DEBUG_ASSERT(msg != 0);
 
+    // Responses of pipelined operations:
+    for (FutureRep* p = clientRep->inFlight; p; p = p->m_next)
+    {
+        if (p->m_operationId == msg->operationId)
+        {
+            clientRep->HandleFutureMessage(p, msg);
+            return;
+        }
+    }
+
     switch (msg->tag)
     {
         case NoOpRspTag:
@@ -550,6 +674,219 @@ void ClientRep::MessageCallback(
     }
 }
 
+void ClientRep::Send(Message* msg)
+{
+    // The protocol takes one request at a time, the next one is posted
+    // once it acknowledges the previous one (see _Client_Ack())
+    if (sending)
+    {
+        Message_AddRef(msg);
+        List_Append(&sendHead, &sendTail, (ListElem*)msg);
+        return;
+    }
+
+    sending = true;
+    Strand_SchedulePost(&strand, msg);
+}
+
+void ClientRep::SendNext()
+{
+    Message* msg = (Message*)sendHead;
+
+    if (!msg)
+    {
+        sending = false;
+        return;
+    }
+
+    List_Remove(&sendHead, &sendTail, (ListElem*)msg);
+    Strand_SchedulePost(&strand, msg);
+    Message_Release(msg);
+}
+
+void ClientRep::Submit(FutureRep* future)
+{
+    // The queue holds a reference until the operation completes
+    future->AddRef();
+    future->m_next = 0;
+
+    if (queueTail)
+        queueTail->m_next = future;
+    else
+        queueHead = future;
+    queueTail = future;
+
+    IssueQueued();
+}
+
+void ClientRep::IssueQueued()
+{
+    while (queueHead && inFlightCount < window)
+    {
+        FutureRep* future = queueHead;
+
+        queueHead = future->m_next;
+        if (!queueHead)
+            queueTail = 0;
+
+        future->m_next = inFlight;
+        inFlight = future;
+        inFlightCount++;
+
+        if (!Issue(future))
+        {
+            inFlight = future->m_next;
+            inFlightCount--;
+            future->Complete(MI_RESULT_FAILED);
+            future->Release();
+        }
+    }
+}
+
+bool ClientRep::Issue(FutureRep* f)
+{
+    bool result = false;
+
+    switch (f->m_kind)
+    {
+        case FutureRep::GET_INSTANCE:
+            result = GetInstanceAsync(f->m_nameSpace, f->m_instance,
+                f->m_operationId);
+            break;
+        case FutureRep::CREATE_INSTANCE:
+            result = CreateInstanceAsync(f->m_nameSpace, f->m_instance,
+                f->m_operationId);
+            break;
+        case FutureRep::MODIFY_INSTANCE:
+            result = ModifyInstanceAsync(f->m_nameSpace, f->m_instance,
+                f->m_operationId);
+            break;
+        case FutureRep::DELETE_INSTANCE:
+            result = DeleteInstanceAsync(f->m_nameSpace, f->m_instance,
+                f->m_operationId);
+            break;
+        case FutureRep::ENUMERATE_INSTANCES:
+            result = EnumerateInstancesAsync(f->m_nameSpace, f->m_className,
+                f->m_deepInheritance, f->m_queryLanguage, f->m_queryExpression,
+                f->m_operationId);
+            break;
+        case FutureRep::INVOKE:
+        {
+            DInstance outParameters;
+            result = InvokeAsync(f->m_nameSpace, f->m_instance, f->m_className,
+                f->m_inParameters, outParameters, f->m_operationId);
+            break;
+        }
+        case FutureRep::ASSOCIATOR_INSTANCES:
+            result = AssociatorInstancesAsync(f->m_nameSpace, f->m_instance,
+                f->m_className, f->m_resultClass, f->m_role, f->m_resultRole,
+                f->m_operationId);
+            break;
+        case FutureRep::REFERENCE_INSTANCES:
+            result = ReferenceInstancesAsync(f->m_nameSpace, f->m_instance,
+                f->m_resultClass, f->m_role, f->m_operationId);
+            break;
+    }
+
+    // The request message holds its own copy of the parameters
+    f->m_instance = DInstance();
+    f->m_inParameters = DInstance();
+
+    return result;
+}
+
+void ClientRep::HandleFutureMessage(FutureRep* future, Message* msg)
+{
+    switch (msg->tag)
+    {
+        case PostInstanceMsgTag:
+        {
+            PostInstanceMsg* rsp = (PostInstanceMsg*)msg;
+
+            if (rsp->instance)
+            {
+                DInstance di(rsp->instance, DInstance::CLONE);
+
+                if (future->m_handler)
+                    future->m_handler->HandleInstance(future->m_operationId, di);
+                else
+                    future->m_instances.PushBack(di);
+            }
+            break;
+        }
+        case PostResultMsgTag:
+        {
+            PostResultMsg* rsp = (PostResultMsg*)msg;
+
+            if (rsp->errorMessage)
+                future->m_errorMessage = String(rsp->errorMessage);
+
+            if (future->m_handler)
+            {
+                if (rsp->cimError)
+                {
+                    DInstance di((MI_Instance*)(rsp->cimError), DInstance::CLONE);
+                    future->m_handler->HandleResult(future->m_operationId,
+                        rsp->result, rsp->errorMessage, &di);
+                }
+                else
+                {
+                    future->m_handler->HandleResult(future->m_operationId,
+                        rsp->result, rsp->errorMessage, NULL);
+                }
+            }
+
+            // Remove from the in-flight list:
+            for (FutureRep** p = &inFlight; *p; p = &(*p)->m_next)
+            {
+                if (*p == future)
+                {
+                    *p = future->m_next;
+                    break;
+                }
+            }
+            inFlightCount--;
+
+            future->Complete(rsp->result);
+            future->Release();
+
+            IssueQueued();
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void ClientRep::FailAll()
+{
+    while (inFlight)
+    {
+        FutureRep* future = inFlight;
+        inFlight = future->m_next;
+        future->Complete(MI_RESULT_FAILED);
+        future->Release();
+    }
+    inFlightCount = 0;
+
+    while (queueHead)
+    {
+        FutureRep* future = queueHead;
+        queueHead = future->m_next;
+        future->Complete(MI_RESULT_FAILED);
+        future->Release();
+    }
+    queueTail = 0;
+
+    while (sendHead)
+    {
+        Message* msg = (Message*)sendHead;
+        List_Remove(&sendHead, &sendTail, (ListElem*)msg);
+        Message_Release(msg);
+    }
+    sending = false;
+}
+
 bool ClientRep::NoOpAsync(
     Uint64 operationId)
 {
@@ -576,7 +913,7 @@ bool ClientRep::NoOpAsync(
 
     // Send the message:
     {
-        Strand_SchedulePost(&strand,&req->base.base);
+        Send(&req->base.base);
     }
 
 done:
@@ -640,7 +977,7 @@ bool ClientRep::GetInstanceAsync(
 
     // Send the messages:
     {
-        Strand_SchedulePost(&strand,&req->base.base);
+        Send(&req->base.base);
     }
 
 done:
@@ -703,7 +1040,7 @@ bool ClientRep::CreateInstanceAsync(
 
     // Send the messages:
     {
-        Strand_SchedulePost(&strand,&req->base.base);
+        Send(&req->base.base);
     }
 
 done:
@@ -765,7 +1102,7 @@ bool ClientRep::ModifyInstanceAsync(
     }
 
     // Send the messages:
-    Strand_SchedulePost(&strand,&req->base.base);
+    Send(&req->base.base);
 
 done:
     if (req)
@@ -826,7 +1163,7 @@ bool ClientRep::DeleteInstanceAsync(
     }
 
     // Send the messages:
-    Strand_SchedulePost(&strand,&req->base.base);
+    Send(&req->base.base);
 
 done:
     if (req)
@@ -855,7 +1192,7 @@ bool ClientRep::EnumerateInstancesAsync(
 
     // Create the request message:
     {
-        req = EnumerateInstancesReq_New(operationId, BinaryProtocolFlag);
+        req = EnumerateInstancesReq_New(operationId, BinaryProtocolFlag | BinaryCompactInstancesFlag);
 
         if (!req)
         {
@@ -901,7 +1238,7 @@ bool ClientRep::EnumerateInstancesAsync(
     }
 
     // Send the messages:
-    Strand_SchedulePost(&strand,&req->base.base);
+    Send(&req->base.base);
 
 done:
     if (req)
@@ -1000,7 +1337,7 @@ bool ClientRep::InvokeAsync(
     }
 
     // Send the messages:
-    Strand_SchedulePost(&strand,&req->base.base);
+    Send(&req->base.base);
 
 done:
     if (req)
@@ -1030,7 +1367,7 @@ bool ClientRep::AssociatorInstancesAsync(
 
     // Create the request message:
     {
-        req = AssociationsOfReq_New(operationId, BinaryProtocolFlag, AssociatorsOfReqTag);
+        req = AssociationsOfReq_New(operationId, BinaryProtocolFlag | BinaryCompactInstancesFlag, AssociatorsOfReqTag);
 
         if (!req)
         {
@@ -1109,7 +1446,7 @@ bool ClientRep::AssociatorInstancesAsync(
     }
 
     // Send the messages:
-    Strand_SchedulePost(&strand,&req->base.base);
+    Send(&req->base.base);
 
 done:
     if (req)
@@ -1139,7 +1476,7 @@ bool ClientRep::ReferenceInstancesAsync(
 
     // Create the request message:
     {
-        req = AssociationsOfReq_New(operationId, BinaryProtocolFlag, ReferencesOfReqTag);
+        req = AssociationsOfReq_New(operationId, BinaryProtocolFlag | BinaryCompactInstancesFlag, ReferencesOfReqTag);
 
         if (!req)
         {
@@ -1196,7 +1533,7 @@ bool ClientRep::ReferenceInstancesAsync(
     }
 
     // Send the messages:
-    Strand_SchedulePost(&strand,&req->base.base);
+    Send(&req->base.base);
 
 done:
     if (req)
@@ -1246,10 +1583,14 @@ MI_EXTERN_C void _Client_PostControl( _In_ Strand* self_, _In_ Message* msg)
     }
 }
 
-MI_EXTERN_C void _Client_Ack( _In_ Strand* self )
+MI_EXTERN_C void _Client_Ack( _In_ Strand* self_ )
 {
+    ClientRep* rep = FromOffset(ClientRep,strand,self_);
+
     trace_Client_Ack();
-    // We are not streaming any results, so no need to manage flow control on Ack
+    // The request being sent went out, post the next one
+    if (rep->sending)
+        rep->SendNext();
 }
 
 MI_EXTERN_C void _Client_Cancel( _In_ Strand* self )
@@ -1265,6 +1606,8 @@ MI_EXTERN_C void _Client_Close( _In_ Strand* self_ )
     trace_Client_Close();
     // most management done by strand implementation
 
+    rep->FailAll();
+
     if (handler)
         handler->HandleDisconnect();
     rep->connectState = ClientRep::CONNECTSTATE_DISCONNECTED;
@@ -1285,7 +1628,8 @@ MI_EXTERN_C void _Client_Finish( _In_ Strand* self_ )
     - Post just passed the operation to tries to ClientRep::MessageCallback
        if that fails it sends the Ack immediately
     - Post control is used to notify connected state (connect succeeded/failed)
-    - Ack does not do anything at this point (as there are no secondary messages)
+    - Ack posts the next request queued by ClientRep::Send (the protocol
+       takes one request at a time)
     - Cancel is not used
     - Puts it on disconnected state if not there already
     - Shutdown:
@@ -1320,6 +1664,14 @@ Client::Client(Handler* handler)
     m_rep->protocol = 0;
     m_rep->connectState = ClientRep::CONNECTSTATE_DISCONNECTED;
     m_rep->handler = handler;
+    m_rep->sending = false;
+    m_rep->sendHead = 0;
+    m_rep->sendTail = 0;
+    m_rep->window = 32;
+    m_rep->inFlightCount = 0;
+    m_rep->inFlight = 0;
+    m_rep->queueHead = 0;
+    m_rep->queueTail = 0;
 
     //Log_OpenStdErr();
     //Log_SetLevel(LOG_DEBUG);
@@ -1330,6 +1682,7 @@ Client::Client(Handler* handler)
 Client::~Client()
 {
     Disconnect();
+    m_rep->FailAll();
     delete m_rep->handler;
     delete m_rep;
 }
@@ -1478,6 +1831,8 @@ bool Client::Disconnect()
         m_rep->protocol = 0;
     }
 
+    m_rep->FailAll();
+
     m_rep->connectState = ClientRep::CONNECTSTATE_DISCONNECTED;
 
 done:
@@ -1603,6 +1958,209 @@ bool Client::ReferenceInstancesAsync(
         role, operationId);
 }
 
+void Client::SetWindow(Uint32 window)
+{
+    m_rep->window = window ? window : 1;
+    m_rep->IssueQueued();
+}
+
+FutureRep* ClientRep::NewFuture(
+    FutureRep::Kind kind,
+    const String& nameSpace,
+    Future& future,
+    Handler* handler)
+{
+    FutureRep* rep = new FutureRep(kind, nameSpace, handler);
+
+    if (future.m_rep)
+        future.m_rep->Release();
+    future.m_rep = rep;
+
+    return rep;
+}
+
+static bool _Submitted(const FutureRep* rep)
+{
+    return !rep->m_done || rep->m_result != MI_RESULT_FAILED;
+}
+
+bool Client::SubmitGetInstance(
+    const String& nameSpace,
+    const DInstance& instanceName,
+    Future& future,
+    Handler* handler)
+{
+    FutureRep* rep = m_rep->NewFuture(FutureRep::GET_INSTANCE, nameSpace, future,
+        handler);
+
+    rep->m_instance = instanceName;
+    m_rep->Submit(rep);
+    return _Submitted(rep);
+}
+
+bool Client::SubmitCreateInstance(
+    const String& nameSpace,
+    const DInstance& instance,
+    Future& future,
+    Handler* handler)
+{
+    FutureRep* rep = m_rep->NewFuture(FutureRep::CREATE_INSTANCE, nameSpace, future,
+        handler);
+
+    rep->m_instance = instance;
+    m_rep->Submit(rep);
+    return _Submitted(rep);
+}
+
+bool Client::SubmitModifyInstance(
+    const String& nameSpace,
+    const DInstance& instance,
+    Future& future,
+    Handler* handler)
+{
+    FutureRep* rep = m_rep->NewFuture(FutureRep::MODIFY_INSTANCE, nameSpace, future,
+        handler);
+
+    rep->m_instance = instance;
+    m_rep->Submit(rep);
+    return _Submitted(rep);
+}
+
+bool Client::SubmitDeleteInstance(
+    const String& nameSpace,
+    const DInstance& instanceName,
+    Future& future,
+    Handler* handler)
+{
+    FutureRep* rep = m_rep->NewFuture(FutureRep::DELETE_INSTANCE, nameSpace, future,
+        handler);
+
+    rep->m_instance = instanceName;
+    m_rep->Submit(rep);
+    return _Submitted(rep);
+}
+
+bool Client::SubmitEnumerateInstances(
+    const String& nameSpace,
+    const String& className,
+    bool deepInheritance,
+    const String& queryLanguage,
+    const String& queryExpression,
+    Future& future,
+    Handler* handler)
+{
+    FutureRep* rep = m_rep->NewFuture(FutureRep::ENUMERATE_INSTANCES, nameSpace,
+        future, handler);
+
+    rep->m_className = className;
+    rep->m_deepInheritance = deepInheritance;
+    rep->m_queryLanguage = queryLanguage;
+    rep->m_queryExpression = queryExpression;
+    m_rep->Submit(rep);
+    return _Submitted(rep);
+}
+
+bool Client::SubmitInvoke(
+    const String& nameSpace,
+    const DInstance& instanceName,
+    const String& methodName,
+    const DInstance& inParameters,
+    Future& future,
+    Handler* handler)
+{
+    FutureRep* rep = m_rep->NewFuture(FutureRep::INVOKE, nameSpace, future, handler);
+
+    rep->m_instance = instanceName;
+    rep->m_className = methodName;
+    rep->m_inParameters = inParameters;
+    m_rep->Submit(rep);
+    return _Submitted(rep);
+}
+
+bool Client::SubmitAssociatorInstances(
+    const String& nameSpace,
+    const DInstance& instanceName,
+    const String& assocClass,
+    const String& resultClass,
+    const String& role,
+    const String& resultRole,
+    Future& future,
+    Handler* handler)
+{
+    FutureRep* rep = m_rep->NewFuture(FutureRep::ASSOCIATOR_INSTANCES, nameSpace,
+        future, handler);
+
+    rep->m_instance = instanceName;
+    rep->m_className = assocClass;
+    rep->m_resultClass = resultClass;
+    rep->m_role = role;
+    rep->m_resultRole = resultRole;
+    m_rep->Submit(rep);
+    return _Submitted(rep);
+}
+
+bool Client::SubmitReferenceInstances(
+    const String& nameSpace,
+    const DInstance& instanceName,
+    const String& resultClass,
+    const String& role,
+    Future& future,
+    Handler* handler)
+{
+    FutureRep* rep = m_rep->NewFuture(FutureRep::REFERENCE_INSTANCES, nameSpace,
+        future, handler);
+
+    rep->m_instance = instanceName;
+    rep->m_resultClass = resultClass;
+    rep->m_role = role;
+    m_rep->Submit(rep);
+    return _Submitted(rep);
+}
+
+bool Client::Wait(const Future& future, Uint64 timeOutUsec)
+{
+    Uint64 endTime, now;
+
+    if (!future.m_rep)
+        return false;
+
+    if (PAL_Time(&now) != PAL_TRUE)
+        return false;
+
+    endTime = now + timeOutUsec;
+
+    while (!future.m_rep->m_done && m_rep->protocol && endTime >= now)
+    {
+        Protocol_Run(&m_rep->protocol->internalProtocolBase, SELECT_BASE_TIMEOUT_MSEC * 1000);
+
+        if (PAL_Time(&now) != PAL_TRUE)
+            break;
+    }
+
+    return future.m_rep->m_done;
+}
+
+bool Client::WaitAll(Uint64 timeOutUsec)
+{
+    Uint64 endTime, now;
+
+    if (PAL_Time(&now) != PAL_TRUE)
+        return false;
+
+    endTime = now + timeOutUsec;
+
+    while ((m_rep->inFlight || m_rep->queueHead) && m_rep->protocol &&
+        endTime >= now)
+    {
+        Protocol_Run(&m_rep->protocol->internalProtocolBase, SELECT_BASE_TIMEOUT_MSEC * 1000);
+
+        if (PAL_Time(&now) != PAL_TRUE)
+            break;
+    }
+
+    return !m_rep->inFlight && !m_rep->queueHead;
+}
+
 bool Client::GetInstance(
     const String& nameSpace,
     const DInstance& instanceName,
@@ -2059,4 +2617,63 @@ done:
     return flag;
 }
 
+//==============================================================================
+//
+// class Future
+//
+//==============================================================================
+
+Future::Future() : m_rep(0)
+{
+}
+
+Future::Future(const Future& x) : m_rep(x.m_rep)
+{
+    if (m_rep)
+        m_rep->AddRef();
+}
+
+Future::~Future()
+{
+    if (m_rep)
+        m_rep->Release();
+}
+
+Future& Future::operator=(const Future& x)
+{
+    if (x.m_rep)
+        x.m_rep->AddRef();
+    if (m_rep)
+        m_rep->Release();
+    m_rep = x.m_rep;
+    return *this;
+}
+
+Uint64 Future::GetOperationId() const
+{
+    return m_rep ? m_rep->m_operationId : 0;
+}
+
+bool Future::IsDone() const
+{
+    return m_rep ? m_rep->m_done : false;
+}
+
+MI_Result Future::GetResult() const
+{
+    return m_rep ? m_rep->m_result : MI_RESULT_FAILED;
+}
+
+const String& Future::GetErrorMessage() const
+{
+    static const String empty;
+    return m_rep ? m_rep->m_errorMessage : empty;
+}
+
+const Array<DInstance>& Future::GetInstances() const
+{
+    static const Array<DInstance> empty;
+    return m_rep ? m_rep->m_instances : empty;
+}
+
 MI_END_NAMESPACE
@@ -17,6 +17,50 @@
 MI_BEGIN_NAMESPACE
 
 class ClientRep;
+class FutureRep;
+
+//==============================================================================
+//
+// class Future
+//
+//     Outcome of an operation issued by one of the Client::Submit methods,
+//     filled in as its responses arrive while the client runs (Run(),
+//     Wait(), WaitAll()). Copies share the same outcome.
+//
+//==============================================================================
+
+class OMICLIENT_LINKAGE Future
+{
+public:
+
+    Future();
+
+    Future(const Future& x);
+
+    ~Future();
+
+    Future& operator=(const Future& x);
+
+    // Id of the operation (0 if nothing was submitted)
+    Uint64 GetOperationId() const;
+
+    // True once the final result arrived, or the operation failed to be
+    // issued or was cut by the disconnection
+    bool IsDone() const;
+
+    MI_Result GetResult() const;
+
+    const String& GetErrorMessage() const;
+
+    // Instances received (the output parameters for Invoke), unless they
+    // were streamed to the handler given to the Submit method
+    const Array<DInstance>& GetInstances() const;
+
+private:
+    friend class Client;
+    friend class ClientRep;
+    FutureRep* m_rep;
+};
 
 class OMICLIENT_LINKAGE Client
 {
@@ -98,6 +142,83 @@ public:
         const String& role,
         Uint64& operationId);
 
+    //
+    // Pipelined operations: many operations share the connection, matched
+    // by their operation id. An operation is issued at once while fewer
+    // than the window (see SetWindow()) are waiting for their result and
+    // queued until one of them completes otherwise. The instances and the
+    // result of an operation are streamed to 'handler' (when not null) as
+    // they arrive, the result is also recorded in 'future'.
+    //
+
+    // Maximum number of pipelined operations in flight (32 by default)
+    void SetWindow(Uint32 window);
+
+    bool SubmitGetInstance(
+        const String& nameSpace,
+        const DInstance& instanceName,
+        Future& future,
+        Handler* handler = 0);
+
+    bool SubmitCreateInstance(
+        const String& nameSpace,
+        const DInstance& instance,
+        Future& future,
+        Handler* handler = 0);
+
+    bool SubmitModifyInstance(
+        const String& nameSpace,
+        const DInstance& instance,
+        Future& future,
+        Handler* handler = 0);
+
+    bool SubmitDeleteInstance(
+        const String& nameSpace,
+        const DInstance& instanceName,
+        Future& future,
+        Handler* handler = 0);
+
+    bool SubmitEnumerateInstances(
+        const String& nameSpace,
+        const String& className,
+        bool deepInheritance,
+        const String& queryLanguage,
+        const String& queryExpression,
+        Future& future,
+        Handler* handler = 0);
+
+    bool SubmitInvoke(
+        const String& nameSpace,
+        const DInstance& instanceName,
+        const String& methodName,
+        const DInstance& inParameters,
+        Future& future,
+        Handler* handler = 0);
+
+    bool SubmitAssociatorInstances(
+        const String& nameSpace,
+        const DInstance& instanceName,
+        const String& assocClass,
+        const String& resultClass,
+        const String& role,
+        const String& resultRole,
+        Future& future,
+        Handler* handler = 0);
+
+    bool SubmitReferenceInstances(
+        const String& nameSpace,
+        const DInstance& instanceName,
+        const String& resultClass,
+        const String& role,
+        Future& future,
+        Handler* handler = 0);
+
+    // Runs the client until the operation completes
+    bool Wait(const Future& future, Uint64 timeOutUsec);
+
+    // Runs the client until all the pipelined operations complete
+    bool WaitAll(Uint64 timeOutUsec);
+
     bool NoOp(Uint64 timeOutUsec);
 
     bool GetInstance(
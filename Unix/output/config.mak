@@ -0,0 +1,84 @@
+# CAUTION: This file was generated by 'configure' script.
+
+BUILDTOOL=/root/repo/Unix/buildtool
+BUILDTOOLOPTS=
+
+CONFIG_PRODUCT=OMI
+CONFIG_FULLPRODUCT=Open Management Infrastructure
+CONFIG_VERSION=1.0.8
+CONFIG_MAJOR=1
+CONFIG_MINOR=0
+CONFIG_REVISION=8
+CONFIG_PATCH_LEVEL=6
+CONFIG_DATE=Sun Oct 18 23:17:03 UTC 2026
+
+CONFIG_MAK=1
+LINUX_X86_64_GNU=1
+PLATFORM=LINUX_X86_64_GNU
+OS=LINUX
+ARCH=X86_64
+COMPILER=GNU
+
+ROOT=/root/repo/Unix
+SRCDIR=/root/repo/Unix
+OUTPUTDIR=/root/repo/Unix/output
+OUTPUTDIRNAME=output
+LIBDIR=/root/repo/Unix/output/lib
+BINDIR=/root/repo/Unix/output/bin
+OBJDIR=/root/repo/Unix/output/obj
+INCDIR=/root/repo/Unix/output/include
+TMPDIR=/root/repo/Unix/output/tmp
+PKGCONFIG=/usr/bin/pkg-config
+CONFIGUREDIR=/root/repo/Unix
+
+CONFIG_SRCDIR=/root/repo/Unix
+CONFIG_TARGET=
+
+OPENSSL=/usr/bin/openssl
+OPENSSLCFLAGS=
+OPENSSLLIBS=-lssl -lcrypto 
+OPENSSLLIBDIR=/usr/lib/x86_64-linux-gnu
+
+WITH_CC=gcc
+WITH_CXX=g++
+WITH_AR=ar
+
+CONFIG_PREFIX=/root/repo/Unix
+CONFIG_BINDIR=/root/repo/Unix/output/bin
+CONFIG_LIBDIR=/root/repo/Unix/output/lib
+CONFIG_INCLUDEDIR=/root/repo/Unix/output/include
+CONFIG_DATADIR=/root/repo/Unix/share
+CONFIG_LOCALSTATEDIR=/root/repo/Unix/output/var
+CONFIG_SYSCONFDIR=/root/repo/Unix/output/etc
+CONFIG_PROVIDERDIR=/root/repo/Unix/output/lib
+CONFIG_CERTSDIR=/root/repo/Unix/output/etc/ssl/certs
+CONFIG_CREDSDIR=/root/repo/Unix/output/etc/creds
+CONFIG_AUTHDIR=/root/repo/Unix/output/var/omiauth
+CONFIG_NAMESPACE=root/cimv2
+CONFIG_HTTPPORT=5985
+CONFIG_HTTPSPORT=5986
+
+ENABLE_DEBUG=1
+ENABLE_GCOV=
+ENABLE_WERROR=1
+ENABLE_32BIT=
+DISABLE_RTTI=
+DISABLE_LIBPATH=
+DISABLE_TEMPLATES=
+DISABLE_LOCALSESSION=
+DISABLE_INDICATION=
+DISABLE_SHELL=
+CONFIG_CIMSCHEMA=CIM-2.32.0
+CONFIG_SINGLEIMAGE=
+CONFIG_TIMESTAMP=TIMESTAMP_2013_Feb_6_12_35_30
+ENABLE_HTTPHEADERS=
+ENABLE_PREEXEC=
+ENABLE_SECTIONS=
+ENABLE_FAULTINJECTION=1
+ENABLE_COMPRESSION=1
+DISABLE_ENCRYPT_DECRYPT=
+DISABLE_AUTHORIZATION=
+GSSLIB=gssapi_krb5
+TRAVIS_CI=
+ENABLE_NATIVE_KITS=
+ENABLE_ULINUX=
@@ -0,0 +1,84 @@
+/* CAUTION: This file was generated by 'configure' script. */
+#ifndef _config_h
+#define _config_h
+
+#define CONFIG_PRODUCT "OMI"
+#define CONFIG_FULLPRODUCT "Open Management Infrastructure"
+#define CONFIG_VERSION "1.0.8-6"
+#define CONFIG_MAJOR 1
+#define CONFIG_MINOR 0
+#define CONFIG_REVISION 8
+#define CONFIG_DATE "Sun Oct 18 23:17:03 UTC 2026"
+#define CONFIG_PLATFORM "LINUX_X86_64_GNU"
+#define CONFIG_OS "LINUX"
+#define CONFIG_ARCH "X86_64"
+#define CONFIG_COMPILER "GNU"
+#define CONFIG_PLATFORM_LINUX_X86_64_GNU
+#define CONFIG_OS_LINUX
+#define CONFIG_ARCH_X86_64
+#define CONFIG_COMPILER_GNU
+#define CONFIG_POSIX
+#define CONFIG_TARGET ""
+#define CONFIG_SRCDIR "/root/repo/Unix"
+#define CONFIG_PREFIX "/root/repo/Unix"
+#define CONFIG_LIBDIR "/root/repo/Unix/output/lib"
+#define CONFIG_INCLUDEDIR "/root/repo/Unix/output/include"
+#define CONFIG_DATADIR "/root/repo/Unix/share"
+#define CONFIG_BINDIR "/root/repo/Unix/output/bin"
+#define CONFIG_LOCALSTATEDIR "/root/repo/Unix/output/var"
+#define CONFIG_SYSCONFDIR "/root/repo/Unix/output/etc"
+#define CONFIG_PROVIDERDIR "/root/repo/Unix/output/lib"
+#define CONFIG_CERTSDIR "/root/repo/Unix/output/etc/ssl/certs"
+#define CONFIG_CREDSDIR "/root/repo/Unix/output/etc/creds"
+#define CONFIG_AUTHDIR "/root/repo/Unix/output/var/omiauth"
+#define CONFIG_NAMESPACE "root/cimv2"
+#define CONFIG_HTTPPORT 5985
+#define CONFIG_HTTPSPORT 5986
+#define CONFIG_TMPDIR "/root/repo/Unix/output/tmp"
+#define CONFIG_CIMSCHEMA "CIM-2.32.0"
+#define CONFIG_GSSLIB "libgssapi_krb5.so"
+#define CONFIG_KRB5LIB "libkrb5.so"
+#define CONFIG_SUPPORTS_NTLM 1
+#define CONFIG_UUID ""
+#define CONFIG_ENABLE_DEBUG
+/* #define CONFIG_ENABLE_GCOV */
+#define CONFIG_ENABLE_WERROR
+/* #define CONFIG_DISABLE_RTTI */
+/* #define CONFIG_DISABLE_LIBPATH */
+/* #define CONFIG_DISABLE_TEMPLATES */
+/* #define DISABLE_LOCALSESSION */
+/* #define DISABLE_INDICATION */
+/* #define DISABLE_SHELL */
+/* #define CONFIG_SINGLEIMAGE */
+#define CONFIG_HAVE_FUNCTION_MACRO
+#define CONFIG_HAVE_BUILTIN_CTZ
+#define CONFIG_HAVE_BUILTIN_PREFETCH
+#define CONFIG_HAVE_SCHED_GETCPU
+#define CONFIG_HAVE_WCSTOLL
+#define CONFIG_HAVE_WCSDUP
+#define CONFIG_HAVE_WCSCASECMP
+#define CONFIG_HAVE_VSWSCANF
+#define CONFIG_HAVE_VA_COPY
+#define CONFIG_HAVE_BACKTRACE
+#define CONFIG_HAVE_SYNC_SYNCHRONIZE
+#define CONFIG_HAVE_ATOMIC_INTRINSICS
+#define CONFIG_HAVE_SEM_TIMEDWAIT
+#define CONFIG_HAVE_STRERROR_R
+#define CONFIG_HAVE_GSSAPI_EXT
+#define CONFIG_SHLIBEXT "so" 
+#define CONFIG_TIMESTAMP "TIMESTAMP_2013_Feb_6_12_35_30" 
+/* #define CONFIG_ENABLE_HTTPHEADERS */
+#define CONFIG_SEMNAMELOCALPREFIX "/" CONFIG_UUID
+#define CONFIG_SEMNAMEGLOBALPREFIX "/" CONFIG_UUID
+#define CONFIG_SHMNAMELOCALPREFIX "/" CONFIG_UUID
+#define CONFIG_SHMNAMEGLOBALPREFIX "/" CONFIG_UUID
+/* #define CONFIG_ENABLE_PREEXEC */
+/* #define CONFIG_ENABLE_SECTIONS */
+#define AUTHORIZATION 1
+#define ENCRYPT_DECRYPT 1
+#define CONFIG_ENABLE_COMPRESSION
+#define CONFIG_ENABLE_FAULTINJECTION
+/* #define CONFIG_VSNPRINTF_RETURN_MINUSONE_WITH_NULLBUFFER */
+/* #define TRAVIS_CI */
+
+#endif /* _config_h */
@@ -0,0 +1,26 @@
+CONFIG_PREFIX=/root/repo/Unix
+LIBDIR=$(OMI_ROOT)//root/repo/Unix/output/lib
+BINDIR=$(OMI_ROOT)//root/repo/Unix/output/bin
+INCLUDEDIR=$(OMI_ROOT)//root/repo/Unix/output/include
+SYSCONFDIR=$(OMI_ROOT)//root/repo/Unix/output/etc
+CXXLIBS = -L$(LIBDIR) -lmicxx
+
+__OBJECTS = $(SOURCES:.c=.o)
+OBJECTS = $(__OBJECTS:.cpp=.o)
+INCLUDES += -I$(INCLUDEDIR)
+
+CC=gcc
+CXX=g++
+
+ifndef DEBUG
+  CFLAGS=-g -fPIC -Wall -fvisibility=hidden -fno-strict-aliasing -fstack-protector-all -D_GNU_SOURCE -D_XOPEN_SOURCE=600 -DENCRYPT_DECRPYT -DGSS_USE_IOV=1 -D_BSD_SOURCE
+  CXXFLAGS=-std=gnu++98 -g -fPIC -Wall -fvisibility=hidden -fno-strict-aliasing -fstack-protector-all -D_GNU_SOURCE -D_XOPEN_SOURCE=600 -DENCRYPT_DECRPYT -DGSS_USE_IOV=1 -D_BSD_SOURCE
+else
+  CFLAGS=cflags: unknown option: --optim
+  CXXFLAGS=cxxflags: unknown option: --optim
+endif
+
+CSHLIBFLAGS=-shared -Wl,-rpath=/root/repo/Unix/output/lib
+CXXSHLIBFLAGS=-shared -Wl,-rpath=/root/repo/Unix/output/lib
+LIBRARY = lib$(PROVIDER).so
+